@@ -49,7 +49,7 @@ DNDecoderConnectionImpl::run(
   connection_->configure(builder, *configuration_);
   if(reset)
   {
-    connection_->decoder().reset();
+    connection_->decoder().resetDecoder();
   }
   connection_->receiver().receiveBuffer(pBuffer + byteOffset, bytesUsed);
 }
@@ -129,6 +129,7 @@ namespace QuickFAST{
         , strict_(rhs.strict_)
         , asynchReads_(false)
         , templateFileName_(rhs.templateFileName_)
+        , templateImageFileName_(rhs.templateImageFileName_)
         , fastFileName_(rhs.fastFileName_)
         , verboseFileName_(rhs.verboseFileName_)
         , pcapFileName_(rhs.pcapFileName_)
@@ -191,6 +192,12 @@ namespace QuickFAST{
         return templateFileName_;
       }
 
+      /// @brief The name of the precompiled template image file
+      const std::string & templateImageFileName()const
+      {
+        return templateImageFileName_;
+      }
+
       /// @brief The name of a data file containing Raw FAST records
       const std::string & fastFileName()const
       {
@@ -456,6 +463,16 @@ namespace QuickFAST{
         templateFileName_ = templateFileName;
       }
 
+      /// @brief The name of the precompiled template image file
+      ///
+      /// The image is loaded instead of parsing the template file if it was
+      /// compiled from the current template file.  Otherwise the template file
+      /// is parsed and the image is rewritten.
+      void setTemplateImageFileName(const std::string & templateImageFileName)
+      {
+        templateImageFileName_ = templateImageFileName;
+      }
+
       /// @brief The name of a data file containing Raw FAST records
       void setFastFileName(const std::string & fastFileName)
       {
@@ -742,6 +759,9 @@ namespace QuickFAST{
       void usage(std::ostream & out) const
       {
         out << "  -t file              : Template file (required)." << std::endl;
+        out << "  -tb file             : Precompiled template image.  Loaded instead of" << std::endl;
+        out << "                         the template file if it is up to date," << std::endl;
+        out << "                         otherwise it is rewritten." << std::endl;
         out << "  -limit n             : Process only the first 'n' messages." << std::endl;
         out << "  -reset               : Toggle 'reset decoder on" << std::endl;
         out << "                         every message' (default false)." << std::endl;
@@ -848,6 +868,11 @@ namespace QuickFAST{
           setTemplateFileName(argv[1]);
           consumed = 2;
         }
+        else if(opt == "-tb" && argc > 1)
+        {
+          setTemplateImageFileName(argv[1]);
+          consumed = 2;
+        }
         else if(opt == "-limit" && argc > 1)
         {
           setHead(boost::lexical_cast<size_t>(argv[1]));
@@ -1154,6 +1179,8 @@ namespace QuickFAST{
 
       /// @brief The name of the template file
       std::string templateFileName_;
+      /// @brief The name of the precompiled template image file
+      std::string templateImageFileName_;
       /// @brief The name of a data file containing Raw FAST records
       std::string fastFileName_;
       /// @brief The name of a file to which verbose output will be written.
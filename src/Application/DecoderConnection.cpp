@@ -6,12 +6,14 @@
 #include "DecoderConnection.h"
 #include <Application/DecoderConfiguration_fwd.h>
 #include <Codecs/XMLTemplateParser.h>
+#include <Codecs/BinaryTemplateParser.h>
 #include <Codecs/MessagePerPacketAssembler.h>
 #include <Codecs/StreamingAssembler.h>
 #include <Codecs/NoHeaderAnalyzer.h>
 #include <Codecs/FixedSizeHeaderAnalyzer.h>
 #include <Codecs/FastEncodedHeaderAnalyzer.h>
 #include <Codecs/TemplateRegistry.h>
+#include <Codecs/TemplateRegistryPublisher.h>
 #include <Codecs/DataSource.h>
 
 #include <Communication/MulticastReceiver.h>
@@ -22,6 +24,7 @@
 #include <Communication/AsynchFileReceiver.h>
 #include <Communication/BufferReceiver.h>
 #include <Communication/AsioService.h>
+#include <boost/filesystem.hpp>
 
 using namespace QuickFAST;
 using namespace Application;
@@ -33,6 +36,39 @@ namespace
 #else
   const std::ios::openmode binaryMode = static_cast<std::ios::openmode>(0);
 #endif
+
+  /// Replace the template image file.
+  ///
+  /// The image is written beside the old one and renamed into place so
+  /// a process that is loading the old image never sees a partial file.
+  /// @returns false with an explanation if the image could not be written.
+  bool writeTemplateImage(const std::string & imageFileName, const std::string & image, std::string & error)
+  {
+    boost::filesystem::path target(imageFileName);
+    boost::filesystem::path temporary(imageFileName + boost::filesystem::unique_path(".%%%%%%%%.tmp").string());
+    {
+      std::ofstream out(temporary.string().c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+      out.write(image.data(), std::streamsize(image.size()));
+      out.close();
+      if(!out)
+      {
+        boost::system::error_code ignored;
+        boost::filesystem::remove(temporary, ignored);
+        error = "Can't write template image: " + temporary.string();
+        return false;
+      }
+    }
+    boost::system::error_code renameError;
+    boost::filesystem::rename(temporary, target, renameError);
+    if(renameError)
+    {
+      boost::system::error_code ignored;
+      boost::filesystem::remove(temporary, ignored);
+      error = "Can't replace template image " + imageFileName + ": " + renameError.message();
+      return false;
+    }
+    return true;
+  }
 }
 
 
@@ -158,11 +194,50 @@ DecoderConnection::configure(
           << configuration.templateFileName();
         throw std::invalid_argument(msg.str());
     }
-    Codecs::XMLTemplateParser parser;
-    parser.setVerboseOutput(*verboseFile_);
-    parser.setNonstandard(configuration.nonstandard());
-
-    registry_ = parser.parse(templates);
+    const std::string & imageFileName = configuration.templateImageFileName();
+    if(!imageFileName.empty())
+    {
+      Codecs::BinaryTemplateParser imageParser;
+      imageParser.setNonstandard(configuration.nonstandard());
+      imageParser.requireSource(templates);
+      try
+      {
+        registry_ = imageParser.parseFile(imageFileName);
+      }
+      catch(const TemplateDefinitionError & ex)
+      {
+        // missing or out of date.  Recompile it below.
+        if(verboseFile_ != 0)
+        {
+          *verboseFile_ << ex.what() << std::endl;
+        }
+      }
+      templates.clear();
+      templates.seekg(0, std::ios::beg);
+    }
+    if(!registry_)
+    {
+      Codecs::XMLTemplateParser parser;
+      parser.setVerboseOutput(*verboseFile_);
+      parser.setNonstandard(configuration.nonstandard());
+      if(imageFileName.empty())
+      {
+        registry_ = parser.parse(templates);
+      }
+      else
+      {
+        // Build the registry before touching the image file.  The image is
+        // only a cache, so failing to write it must not stop the decoder.
+        std::ostringstream image(std::ios::out | std::ios::binary);
+        registry_ = parser.compile(templates, image);
+        std::string error;
+        if(!writeTemplateImage(imageFileName, image.str(), error))
+        {
+          std::ostream & log = verboseFile_ != 0 ? *verboseFile_ : std::cerr;
+          log << error << std::endl;
+        }
+      }
+    }
   }
 
   if((configuration.nonstandard() & 4) != 0)
@@ -318,6 +393,8 @@ DecoderConnection::configure(
 
   assembler_->setReset(configuration.reset());
   assembler_->setStrict(configuration.strict());
+  publisher_.reset(new Codecs::TemplateRegistryPublisher(registry_));
+  assembler_->decoder().followRegistry(publisher_);
 
   switch(configuration.receiverType())
   {
@@ -440,3 +517,23 @@ DecoderConnection::decoder() const
   return assembler_->decoder();
 }
 
+Codecs::TemplateRegistryPtr
+DecoderConnection::registry() const
+{
+  if(publisher_)
+  {
+    return publisher_->current();
+  }
+  if(!registry_)
+  {
+    throw UsageError("Coding Error","Using DecoderConnection registry before it is configured.");
+  }
+  return registry_;
+}
+
+void
+DecoderConnection::publishTemplates(Codecs::TemplateRegistryPtr registry)
+{
+  templatePublisher().publish(registry);
+}
+
@@ -12,6 +12,7 @@
 
 #include <Common/Exceptions.h>
 #include <Codecs/TemplateRegistry_fwd.h>
+#include <Codecs/TemplateRegistryPublisher_fwd.h>
 #include <Codecs/HeaderAnalyzer_fwd.h>
 #include <Codecs/Decoder_fwd.h>
 #include <Communication/Assembler_fwd.h>
@@ -104,14 +105,10 @@ namespace QuickFAST{
       //////////////////////////////////////
 
       /// @brief provide access to the template registry
-      Codecs::TemplateRegistryPtr & registry()
-      {
-        if(!registry_)
-        {
-          throw UsageError("Coding Error","Using DecoderConnection registry before it is configured.");
-        }
-        return registry_;
-      }
+      ///
+      /// Once the connection is configured this is the registry most recently
+      /// published via publishTemplates().
+      Codecs::TemplateRegistryPtr registry() const;
 
       /// @brief Forward compatibility
       /// @deprecated use packetHeaderAnalyzer or messageHeaderAnalyzer
@@ -163,6 +160,25 @@ namespace QuickFAST{
       /// @brief Access the decoder.
       Codecs::Decoder & decoder() const;
 
+      /// @brief Switch to new templates without stopping the connection.
+      ///
+      /// Parse and finalize the new registry on any thread, then publish it here.
+      /// The decoder starts using it before the next message it decodes, and the
+      /// old registry is released once the decoder has moved on.  The dictionaries
+      /// are reset when the templates change.
+      /// @param registry the new templates.  It must not be changed after it is published.
+      void publishTemplates(Codecs::TemplateRegistryPtr registry);
+
+      /// @brief Access the publisher the decoder takes its templates from.
+      Codecs::TemplateRegistryPublisher & templatePublisher() const
+      {
+        if(!publisher_)
+        {
+          throw UsageError("Coding Error","Using DecoderConnection template publisher before it is configured.");
+        }
+        return *publisher_;
+      }
+
     private:
       std::istream * fastFile_;
       std::ostream * echoFile_;
@@ -170,7 +186,9 @@ namespace QuickFAST{
       bool ownEchoFile_;
       bool ownVerboseFile_;
 
+      /// The registry the connection was configured with.  The publisher owns later ones.
       Codecs::TemplateRegistryPtr registry_;
+      Codecs::TemplateRegistryPublisherPtr publisher_;
       boost::scoped_ptr<boost::asio::io_service> ioService_;
       boost::scoped_ptr<Codecs::HeaderAnalyzer> packetHeaderAnalyzer_;
       boost::scoped_ptr<Codecs::HeaderAnalyzer> messageHeaderAnalyzer_;
@@ -0,0 +1,321 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "Benchmark.h"
+#include <Codecs/XMLTemplateParser.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/DataSourceBuffer.h>
+#include <Messages/Message.h>
+#include <Common/Exceptions.h>
+
+using namespace QuickFAST;
+using namespace Benchmarks;
+
+volatile uint64 Benchmarks::benchmarkSink = 0;
+
+Benchmark::Benchmark(const std::string & name)
+  : name_(name)
+{
+}
+
+Benchmark::~Benchmark()
+{
+}
+
+void
+Benchmark::setup()
+{
+}
+
+Codecs::TemplateRegistryPtr
+Benchmarks::parseTemplates(const std::string & xml)
+{
+  Codecs::XMLTemplateParser parser;
+  std::stringstream templateStream(xml);
+  return parser.parse(templateStream);
+}
+
+Codecs::TemplateRegistryPtr
+Benchmarks::parseTemplateFile(const std::string & fileName)
+{
+  std::ifstream templateStream(fileName.c_str());
+  if(!templateStream.good())
+  {
+    throw UsageError("Benchmark", ("Can't open template file " + fileName).c_str());
+  }
+  Codecs::XMLTemplateParser parser;
+  return parser.parse(templateStream);
+}
+
+/////////////
+// MessageSet
+
+MessageSet::MessageSet(Codecs::TemplateRegistryPtr registry)
+  : registry_(registry)
+{
+}
+
+void
+MessageSet::add(template_id_t templateId, const Messages::MessagePtr & message)
+{
+  templateIds_.push_back(templateId);
+  messages_.push_back(message);
+}
+
+void
+MessageSet::encode(std::string & fast)const
+{
+  Codecs::Encoder encoder(registry_);
+  Codecs::DataDestination destination;
+  for(size_t nMessage = 0; nMessage < messages_.size(); ++nMessage)
+  {
+    encoder.encodeMessage(destination, templateIds_[nMessage], *messages_[nMessage]);
+  }
+  destination.toString(fast);
+}
+
+//////////////////
+// DecodeBenchmark
+
+DecodeBenchmark::DecodeBenchmark(const std::string & name, MessageSetPtr messages)
+  : Benchmark(name)
+  , messages_(messages)
+  , decoder_(messages->registry_)
+{
+}
+
+void
+DecodeBenchmark::setup()
+{
+  messages_->encode(fast_);
+}
+
+void
+DecodeBenchmark::run(size_t count)
+{
+  size_t messageCount = messages_->messages_.size();
+  while(count > 0)
+  {
+    size_t batch = count < messageCount ? count : messageCount;
+    decoder_.reset();
+    Codecs::DataSourceBuffer source(
+      reinterpret_cast<const unsigned char *>(fast_.data()), fast_.size());
+    for(size_t nMessage = 0; nMessage < batch; ++nMessage)
+    {
+      decoder_.decodeMessage(source, builder_);
+    }
+    count -= batch;
+  }
+  consume(builder_.messageCount());
+}
+
+//////////////////
+// EncodeBenchmark
+
+EncodeBenchmark::EncodeBenchmark(const std::string & name, MessageSetPtr messages)
+  : Benchmark(name)
+  , messages_(messages)
+  , encoder_(messages->registry_)
+{
+}
+
+void
+EncodeBenchmark::run(size_t count)
+{
+  size_t messageCount = messages_->messages_.size();
+  while(count > 0)
+  {
+    size_t batch = count < messageCount ? count : messageCount;
+    encoder_.reset();
+    destination_.clear();
+    for(size_t nMessage = 0; nMessage < batch; ++nMessage)
+    {
+      encoder_.encodeMessage(destination_, messages_->templateIds_[nMessage], *messages_->messages_[nMessage]);
+    }
+    consume(destination_.size());
+    count -= batch;
+  }
+}
+
+//////////////
+// NullBuilder
+
+NullBuilder::NullBuilder()
+  : messageCount_(0)
+{
+}
+
+NullBuilder::~NullBuilder()
+{
+}
+
+const std::string &
+NullBuilder::getApplicationType()const
+{
+  static const std::string type("null");
+  return type;
+}
+
+const std::string &
+NullBuilder::getApplicationTypeNs()const
+{
+  static const std::string ns;
+  return ns;
+}
+
+void
+NullBuilder::addValue(const Messages::FieldIdentity & /*identity*/, ValueType::Type /*type*/, const int64 value)
+{
+  consume(uint64(value));
+}
+
+void
+NullBuilder::addValue(const Messages::FieldIdentity & /*identity*/, ValueType::Type /*type*/, const uint64 value)
+{
+  consume(value);
+}
+
+void
+NullBuilder::addValue(const Messages::FieldIdentity & /*identity*/, ValueType::Type /*type*/, const int32 value)
+{
+  consume(uint64(value));
+}
+
+void
+NullBuilder::addValue(const Messages::FieldIdentity & /*identity*/, ValueType::Type /*type*/, const uint32 value)
+{
+  consume(value);
+}
+
+void
+NullBuilder::addValue(const Messages::FieldIdentity & /*identity*/, ValueType::Type /*type*/, const int16 value)
+{
+  consume(uint64(value));
+}
+
+void
+NullBuilder::addValue(const Messages::FieldIdentity & /*identity*/, ValueType::Type /*type*/, const uint16 value)
+{
+  consume(value);
+}
+
+void
+NullBuilder::addValue(const Messages::FieldIdentity & /*identity*/, ValueType::Type /*type*/, const int8 value)
+{
+  consume(uint64(value));
+}
+
+void
+NullBuilder::addValue(const Messages::FieldIdentity & /*identity*/, ValueType::Type /*type*/, const uchar value)
+{
+  consume(value);
+}
+
+void
+NullBuilder::addValue(const Messages::FieldIdentity & /*identity*/, ValueType::Type /*type*/, const Decimal& value)
+{
+  consume(uint64(value.getMantissa()));
+}
+
+void
+NullBuilder::addValue(const Messages::FieldIdentity & /*identity*/, ValueType::Type /*type*/, const unsigned char * value, size_t length)
+{
+  consume(length == 0 ? 0 : value[0] + length);
+}
+
+Messages::ValueMessageBuilder &
+NullBuilder::startMessage(
+  const std::string & /*applicationType*/,
+  const std::string & /*applicationTypeNamespace*/,
+  size_t /*size*/)
+{
+  return *this;
+}
+
+bool
+NullBuilder::endMessage(Messages::ValueMessageBuilder & /*messageBuilder*/)
+{
+  ++messageCount_;
+  return true;
+}
+
+bool
+NullBuilder::ignoreMessage(Messages::ValueMessageBuilder & /*messageBuilder*/)
+{
+  return true;
+}
+
+Messages::ValueMessageBuilder &
+NullBuilder::startSequence(
+  const Messages::FieldIdentity & /*identity*/,
+  const std::string & /*applicationType*/,
+  const std::string & /*applicationTypeNamespace*/,
+  size_t /*fieldCount*/,
+  const Messages::FieldIdentity & /*lengthIdentity*/,
+  size_t /*length*/)
+{
+  return *this;
+}
+
+void
+NullBuilder::endSequence(
+  const Messages::FieldIdentity & /*identity*/,
+  Messages::ValueMessageBuilder & /*sequenceBuilder*/)
+{
+}
+
+Messages::ValueMessageBuilder &
+NullBuilder::startSequenceEntry(
+  const std::string & /*applicationType*/,
+  const std::string & /*applicationTypeNamespace*/,
+  size_t /*size*/)
+{
+  return *this;
+}
+
+void
+NullBuilder::endSequenceEntry(Messages::ValueMessageBuilder & /*entry*/)
+{
+}
+
+Messages::ValueMessageBuilder &
+NullBuilder::startGroup(
+  const Messages::FieldIdentity & /*identity*/,
+  const std::string & /*applicationType*/,
+  const std::string & /*applicationTypeNamespace*/,
+  size_t /*size*/)
+{
+  return *this;
+}
+
+void
+NullBuilder::endGroup(
+  const Messages::FieldIdentity & /*identity*/,
+  Messages::ValueMessageBuilder & /*groupBuilder*/)
+{
+}
+
+bool
+NullBuilder::wantLog(unsigned short /*level*/)
+{
+  return false;
+}
+
+bool
+NullBuilder::logMessage(unsigned short /*level*/, const std::string & /*logMessage*/)
+{
+  return true;
+}
+
+bool
+NullBuilder::reportDecodingError(const std::string & errorMessage)
+{
+  throw EncodingError(errorMessage);
+}
+
+bool
+NullBuilder::reportCommunicationError(const std::string & errorMessage)
+{
+  throw CommunicationError(errorMessage);
+}
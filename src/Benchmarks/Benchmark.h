@@ -0,0 +1,223 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+#include <Common/Types.h>
+#include <Codecs/TemplateRegistry_fwd.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/DataDestination.h>
+#include <Messages/Message_fwd.h>
+#include <Messages/ValueMessageBuilder.h>
+
+namespace QuickFAST{
+  /// @brief Micro-benchmarks for the codec primitives.
+  namespace Benchmarks{
+    /// @brief Keep the optimizer from discarding a result.
+    ///
+    /// Benchmarks should pass something derived from each result to consume().
+    extern volatile uint64 benchmarkSink;
+
+    /// @brief Consume a result.
+    inline
+    void consume(uint64 value)
+    {
+      benchmarkSink += value;
+    }
+
+    /// @brief Base class for a micro-benchmark.
+    ///
+    /// A benchmark performs one operation (decoding one integer, one message, etc.)
+    /// a requested number of times.  The BenchmarkRunner decides how many times
+    /// and reports the time per operation.
+    class Benchmark
+    {
+    public:
+      /// @brief Construct
+      /// @param name identifies the benchmark in reports and baselines.
+      explicit Benchmark(const std::string & name);
+
+      /// @brief Typical virtual destructor.
+      virtual ~Benchmark();
+
+      /// @brief The name of the benchmark.
+      const std::string & name()const
+      {
+        return name_;
+      }
+
+      /// @brief Prepare the input.
+      ///
+      /// Called once before the benchmark is timed.  Not included in the timing.
+      virtual void setup();
+
+      /// @brief Perform the operation.
+      /// @param count is how many times the operation should be done.
+      virtual void run(size_t count) = 0;
+
+    private:
+      std::string name_;
+    };
+
+    /// @brief Pointer to a Benchmark.
+    typedef boost::shared_ptr<Benchmark> BenchmarkPtr;
+    /// @brief A collection of benchmarks.
+    typedef std::vector<BenchmarkPtr> BenchmarkList;
+
+    /// @brief A ValueMessageBuilder that does as little as possible.
+    ///
+    /// So decoding benchmarks measure the decoder rather than the builder.
+    class NullBuilder : public Messages::ValueMessageBuilder
+    {
+    public:
+      NullBuilder();
+      virtual ~NullBuilder();
+
+      /// @brief How many messages have been built.
+      size_t messageCount()const
+      {
+        return messageCount_;
+      }
+
+      ///////////////////////////////////////////
+      // Implement ValueMessageBuilder interface
+      virtual const std::string & getApplicationType()const;
+      virtual const std::string & getApplicationTypeNs()const;
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int64 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uint64 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int32 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uint32 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int16 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uint16 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int8 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uchar value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const Decimal& value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const unsigned char * value, size_t length);
+      virtual ValueMessageBuilder & startMessage(
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t size);
+      virtual bool endMessage(Messages::ValueMessageBuilder & messageBuilder);
+      virtual bool ignoreMessage(Messages::ValueMessageBuilder & messageBuilder);
+      virtual Messages::ValueMessageBuilder & startSequence(
+        const Messages::FieldIdentity & identity,
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t fieldCount,
+        const Messages::FieldIdentity & lengthIdentity,
+        size_t length);
+      virtual void endSequence(
+        const Messages::FieldIdentity & identity,
+        Messages::ValueMessageBuilder & sequenceBuilder);
+      virtual Messages::ValueMessageBuilder & startSequenceEntry(
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t size) ;
+      virtual void endSequenceEntry(Messages::ValueMessageBuilder & entry);
+      virtual Messages::ValueMessageBuilder & startGroup(
+        const Messages::FieldIdentity & identity,
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t size) ;
+      virtual void endGroup(
+        const Messages::FieldIdentity & identity,
+        Messages::ValueMessageBuilder & groupBuilder);
+
+      /////////////////////////////
+      // Implement Logger interface
+      virtual bool wantLog(unsigned short level);
+      virtual bool logMessage(unsigned short level, const std::string & logMessage);
+      virtual bool reportDecodingError(const std::string & errorMessage);
+      virtual bool reportCommunicationError(const std::string & errorMessage);
+
+    private:
+      size_t messageCount_;
+    };
+
+    /// @brief Messages to be encoded or decoded by a benchmark.
+    struct MessageSet
+    {
+      /// @brief Construct
+      /// @param registry contains the templates used to encode the messages.
+      explicit MessageSet(Codecs::TemplateRegistryPtr registry);
+
+      /// @brief Add a message to the set.
+      void add(template_id_t templateId, const Messages::MessagePtr & message);
+
+      /// @brief Encode all the messages, starting with a fresh dictionary.
+      void encode(std::string & fast)const;
+
+      /// The templates
+      Codecs::TemplateRegistryPtr registry_;
+      /// The template to use for each message.
+      std::vector<template_id_t> templateIds_;
+      /// The messages
+      std::vector<Messages::MessagePtr> messages_;
+    };
+    /// @brief Pointer to a MessageSet.
+    typedef boost::shared_ptr<MessageSet> MessageSetPtr;
+
+    /// @brief Decode a set of messages (op = one message)
+    ///
+    /// The decoder is reset each time it starts over at the first message.
+    class DecodeBenchmark : public Benchmark
+    {
+    public:
+      /// @brief Construct
+      /// @param name identifies the benchmark.
+      /// @param messages will be encoded by setup() to provide the input.
+      DecodeBenchmark(const std::string & name, MessageSetPtr messages);
+
+      virtual void setup();
+      virtual void run(size_t count);
+
+    private:
+      MessageSetPtr messages_;
+      std::string fast_;
+      Codecs::Decoder decoder_;
+      NullBuilder builder_;
+    };
+
+    /// @brief Encode a set of messages (op = one message)
+    ///
+    /// The encoder is reset each time it starts over at the first message.
+    class EncodeBenchmark : public Benchmark
+    {
+    public:
+      /// @brief Construct
+      /// @param name identifies the benchmark.
+      /// @param messages to be encoded.
+      EncodeBenchmark(const std::string & name, MessageSetPtr messages);
+
+      virtual void run(size_t count);
+
+    private:
+      MessageSetPtr messages_;
+      Codecs::Encoder encoder_;
+      Codecs::DataDestination destination_;
+    };
+
+    /// @brief Parse templates from a string.
+    Codecs::TemplateRegistryPtr parseTemplates(const std::string & xml);
+
+    /// @brief Parse templates from a file.
+    Codecs::TemplateRegistryPtr parseTemplateFile(const std::string & fileName);
+
+    /// @brief Add the integer and presence map benchmarks.
+    void addPrimitiveBenchmarks(BenchmarkList & benchmarks);
+    /// @brief Add the string and byte vector benchmarks.
+    void addStringBenchmarks(BenchmarkList & benchmarks);
+    /// @brief Add the field operator benchmarks.
+    void addFieldOpBenchmarks(BenchmarkList & benchmarks);
+    /// @brief Add the Decimal benchmarks.
+    void addDecimalBenchmarks(BenchmarkList & benchmarks);
+    /// @brief Add benchmarks based on the templates in Tests/resources.
+    /// @param resourceDirectory contains the template files.
+    void addResourceBenchmarks(BenchmarkList & benchmarks, const std::string & resourceDirectory);
+  }
+}
+#endif // BENCHMARK_H
@@ -0,0 +1,313 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "BenchmarkRunner.h"
+#include <Common/Profiler.h>
+
+using namespace QuickFAST;
+using namespace Benchmarks;
+
+BenchmarkRunner::BenchmarkRunner()
+  : samples_(15)
+  , sampleMsec_(20)
+  , threshold_(5.0)
+  , list_(false)
+{
+  const char * root = std::getenv("QUICKFAST_ROOT");
+  if(root != 0)
+  {
+    resourceDirectory_ = root;
+    resourceDirectory_ += "/src/Tests/resources";
+  }
+}
+
+BenchmarkRunner::~BenchmarkRunner()
+{
+}
+
+bool
+BenchmarkRunner::init(int argc, char* argv[])
+{
+  commandArgParser_.addHandler(this);
+  return commandArgParser_.parse(argc, argv);
+}
+
+int
+BenchmarkRunner::parseSingleArg(int argc, char * argv[])
+{
+  int consumed = 0;
+  std::string opt(argv[0]);
+  try
+  {
+    if(opt == "-filter" && argc > 1)
+    {
+      filter_ = argv[1];
+      consumed = 2;
+    }
+    else if(opt == "-samples" && argc > 1)
+    {
+      samples_ = boost::lexical_cast<size_t>(argv[1]);
+      consumed = 2;
+    }
+    else if(opt == "-ms" && argc > 1)
+    {
+      sampleMsec_ = boost::lexical_cast<unsigned long>(argv[1]);
+      consumed = 2;
+    }
+    else if(opt == "-save" && argc > 1)
+    {
+      saveFileName_ = argv[1];
+      consumed = 2;
+    }
+    else if(opt == "-compare" && argc > 1)
+    {
+      compareFileName_ = argv[1];
+      consumed = 2;
+    }
+    else if(opt == "-threshold" && argc > 1)
+    {
+      threshold_ = boost::lexical_cast<double>(argv[1]);
+      consumed = 2;
+    }
+    else if(opt == "-resources" && argc > 1)
+    {
+      resourceDirectory_ = argv[1];
+      consumed = 2;
+    }
+    else if(opt == "-list")
+    {
+      list_ = true;
+      consumed = 1;
+    }
+  }
+  catch (std::exception & ex)
+  {
+    std::cerr << ex.what() << " while interpreting " << opt << std::endl;
+    consumed = 0;
+  }
+  return consumed;
+}
+
+void
+BenchmarkRunner::usage(std::ostream & out) const
+{
+  out << "  -filter text   : Run only benchmarks whose names contain text" << std::endl;
+  out << "  -samples n     : Number of samples per benchmark (default 15)" << std::endl;
+  out << "  -ms n          : Milliseconds per sample (default 20)" << std::endl;
+  out << "  -save file     : Save the results as a baseline" << std::endl;
+  out << "  -compare file  : Compare the results to a saved baseline" << std::endl;
+  out << "  -threshold pct : Percent slower than the baseline that counts as a regression (default 5)" << std::endl;
+  out << "  -resources dir : Directory containing the test templates (default $QUICKFAST_ROOT/src/Tests/resources)" << std::endl;
+  out << "  -list          : List the benchmarks without running them" << std::endl;
+}
+
+bool
+BenchmarkRunner::applyArgs()
+{
+  bool ok = true;
+  if(samples_ < 3)
+  {
+    std::cerr << "ERROR: -samples must be at least 3." << std::endl;
+    ok = false;
+  }
+  if(sampleMsec_ == 0)
+  {
+    std::cerr << "ERROR: -ms must be positive." << std::endl;
+    ok = false;
+  }
+  if(ok)
+  {
+    addPrimitiveBenchmarks(benchmarks_);
+    addStringBenchmarks(benchmarks_);
+    addFieldOpBenchmarks(benchmarks_);
+    addDecimalBenchmarks(benchmarks_);
+    if(!resourceDirectory_.empty())
+    {
+      try
+      {
+        addResourceBenchmarks(benchmarks_, resourceDirectory_);
+      }
+      catch(const std::exception & ex)
+      {
+        std::cerr << "ERROR: " << ex.what() << std::endl;
+        ok = false;
+      }
+    }
+    else
+    {
+      std::cerr << "WARNING: QUICKFAST_ROOT is not set and -resources was not given." << std::endl
+        << "         Benchmarks based on Tests/resources will not be run." << std::endl;
+    }
+  }
+  if(!ok)
+  {
+    commandArgParser_.usage(std::cerr);
+  }
+  return ok;
+}
+
+double
+BenchmarkRunner::sample(Benchmark & benchmark, size_t count)
+{
+  uint64 start = ProfileClock::ticks();
+  benchmark.run(count);
+  uint64 lapse = ProfileClock::ticks() - start;
+  return ProfileClock::toNanoseconds(double(lapse));
+}
+
+void
+BenchmarkRunner::measure(Benchmark & benchmark, Result & result)
+{
+  // find a count that fills the sample period
+  double target = double(sampleMsec_) * 1.0e6;
+  size_t count = 1;
+  double lapse = sample(benchmark, count);
+  while(lapse < target / 4)
+  {
+    count *= (lapse < target / 100) ? 10 : 2;
+    lapse = sample(benchmark, count);
+  }
+  count = size_t(double(count) * target / lapse) + 1;
+
+  std::vector<double> perOperation;
+  perOperation.reserve(samples_);
+  for(size_t nSample = 0; nSample < samples_; ++nSample)
+  {
+    perOperation.push_back(sample(benchmark, count) / double(count));
+  }
+  std::sort(perOperation.begin(), perOperation.end());
+  result.median_ = perOperation[samples_ / 2];
+  result.minimum_ = perOperation.front();
+  result.maximum_ = perOperation.back();
+
+  std::vector<double> deviations;
+  deviations.reserve(samples_);
+  for(size_t nSample = 0; nSample < samples_; ++nSample)
+  {
+    deviations.push_back(std::fabs(perOperation[nSample] - result.median_));
+  }
+  std::sort(deviations.begin(), deviations.end());
+  result.spread_ = result.median_ > 0 ? deviations[samples_ / 2] / result.median_ : 0.0;
+}
+
+bool
+BenchmarkRunner::readBaseline(Baseline & baseline)
+{
+  std::ifstream in(compareFileName_.c_str());
+  if(!in.good())
+  {
+    std::cerr << "ERROR: Can't open baseline file: " << compareFileName_ << std::endl;
+    return false;
+  }
+  std::string line;
+  while(std::getline(in, line))
+  {
+    std::string::size_type tab = line.rfind('\t');
+    if(line.empty() || line[0] == '#' || tab == std::string::npos)
+    {
+      continue;
+    }
+    try
+    {
+      baseline[line.substr(0, tab)] = boost::lexical_cast<double>(line.substr(tab + 1));
+    }
+    catch(const boost::bad_lexical_cast &)
+    {
+      std::cerr << "WARNING: Ignoring baseline line: " << line << std::endl;
+    }
+  }
+  return true;
+}
+
+int
+BenchmarkRunner::run()
+{
+  Baseline baseline;
+  if(!compareFileName_.empty() && !readBaseline(baseline))
+  {
+    return 1;
+  }
+  std::ofstream save;
+  if(!saveFileName_.empty())
+  {
+    save.open(saveFileName_.c_str());
+    if(!save.good())
+    {
+      std::cerr << "ERROR: Can't open baseline file: " << saveFileName_ << std::endl;
+      return 1;
+    }
+    save << "# name\tns/op" << std::endl;
+  }
+
+  size_t regressions = 0;
+  std::cout << std::left << std::setw(40) << "benchmark" << std::right
+    << std::setw(12) << "ns/op"
+    << std::setw(12) << "min"
+    << std::setw(12) << "max"
+    << std::setw(9) << "+/-%";
+  if(!baseline.empty())
+  {
+    std::cout << std::setw(12) << "baseline" << std::setw(10) << "change%";
+  }
+  std::cout << std::endl;
+
+  for(BenchmarkList::iterator it = benchmarks_.begin(); it != benchmarks_.end(); ++it)
+  {
+    Benchmark & benchmark = **it;
+    if(!filter_.empty() && benchmark.name().find(filter_) == std::string::npos)
+    {
+      continue;
+    }
+    std::cout << std::left << std::setw(40) << benchmark.name() << std::right << std::flush;
+    if(list_)
+    {
+      std::cout << std::endl;
+      continue;
+    }
+    Result result;
+    try
+    {
+      benchmark.setup();
+      measure(benchmark, result);
+    }
+    catch(const std::exception & ex)
+    {
+      std::cout << " FAILED: " << ex.what() << std::endl;
+      ++regressions;
+      continue;
+    }
+    std::cout << std::fixed << std::setprecision(2)
+      << std::setw(12) << result.median_
+      << std::setw(12) << result.minimum_
+      << std::setw(12) << result.maximum_
+      << std::setprecision(1) << std::setw(9) << result.spread_ * 100.0;
+    Baseline::const_iterator old = baseline.find(benchmark.name());
+    if(old != baseline.end() && old->second > 0.0)
+    {
+      double change = (result.median_ - old->second) / old->second * 100.0;
+      std::cout << std::setprecision(2) << std::setw(12) << old->second
+        << std::setprecision(1) << std::setw(10) << change;
+      // a regression must exceed both the threshold and the noise in this run
+      if(change > threshold_ && change > result.spread_ * 100.0)
+      {
+        std::cout << "  SLOWER";
+        ++regressions;
+      }
+      else if(-change > threshold_ && -change > result.spread_ * 100.0)
+      {
+        std::cout << "  faster";
+      }
+    }
+    std::cout << std::endl;
+    if(save.is_open())
+    {
+      save << benchmark.name() << '\t' << std::fixed << std::setprecision(3) << result.median_ << std::endl;
+    }
+  }
+  if(regressions != 0)
+  {
+    std::cout << regressions << " benchmark(s) regressed or failed." << std::endl;
+  }
+  return regressions == 0 ? 0 : 1;
+}
@@ -0,0 +1,78 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+#include <Benchmarks/Benchmark.h>
+#include <Application/CommandArgParser.h>
+
+namespace QuickFAST{
+  namespace Benchmarks{
+    /// @brief Run the benchmarks and report the results.
+    ///
+    /// Each benchmark is run enough times to fill a sample period, then
+    /// sampled repeatedly.  The median time per operation is reported along
+    /// with the spread of the samples.
+    ///
+    /// The results can be saved as a baseline, and later results compared
+    /// to it.  A benchmark that is slower than its baseline by more than the
+    /// threshold (and by more than its own spread) is reported as a
+    /// regression and makes run() return a non-zero exit code.
+    ///
+    /// Run the program with a -? command line option for detailed usage information.
+    class BenchmarkRunner : public Application::CommandArgHandler
+    {
+    public:
+      BenchmarkRunner();
+      ~BenchmarkRunner();
+
+      /// @brief parse command line arguments, and initialize.
+      /// @param argc from main
+      /// @param argv from main
+      /// @returns true if everything is ok.
+      bool init(int argc, char * argv[]);
+
+      /// @brief run the benchmarks
+      /// @returns a value to be used as an exit code of the program (0 means all is well)
+      int run();
+
+    private:
+      virtual int parseSingleArg(int argc, char * argv[]);
+      virtual void usage(std::ostream & out) const;
+      virtual bool applyArgs();
+
+    private:
+      /// The measurements for one benchmark.
+      struct Result
+      {
+        double median_;
+        double minimum_;
+        double maximum_;
+        /// median absolute deviation as a fraction of the median.
+        double spread_;
+      };
+      typedef std::map<std::string, double> Baseline;
+
+      void measure(Benchmark & benchmark, Result & result);
+      double sample(Benchmark & benchmark, size_t count);
+      bool readBaseline(Baseline & baseline);
+
+    private:
+      std::string filter_;
+      size_t samples_;
+      unsigned long sampleMsec_;
+      std::string saveFileName_;
+      std::string compareFileName_;
+      double threshold_;
+      std::string resourceDirectory_;
+      bool list_;
+
+      BenchmarkList benchmarks_;
+      Application::CommandArgParser commandArgParser_;
+    };
+  }
+}
+#endif // BENCHMARKRUNNER_H
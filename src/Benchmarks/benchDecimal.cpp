@@ -0,0 +1,178 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "Benchmark.h"
+#include <Common/Decimal.h>
+
+using namespace QuickFAST;
+using namespace Benchmarks;
+
+namespace
+{
+  /// How many values each benchmark cycles through.
+  const size_t valueCount = 256;
+
+  /// Prices similar to those found in market data.
+  Decimal price(size_t n)
+  {
+    return Decimal(mantissa_t(1234500 + n * 25), exponent_t(-4 + int(n % 3)), false);
+  }
+
+  /// A benchmark that cycles through a set of Decimal values.
+  class DecimalBenchmark : public Benchmark
+  {
+  public:
+    explicit DecimalBenchmark(const std::string & name)
+      : Benchmark(name)
+    {
+    }
+
+    virtual void setup()
+    {
+      for(size_t nValue = 0; nValue < valueCount; ++nValue)
+      {
+        values_.push_back(price(nValue));
+      }
+    }
+
+  protected:
+    std::vector<Decimal> values_;
+  };
+
+  /// Format into a caller supplied buffer (op = one value)
+  class FormatBufferBenchmark : public DecimalBenchmark
+  {
+  public:
+    FormatBufferBenchmark()
+      : DecimalBenchmark("decimal toString buffer")
+    {
+    }
+
+    virtual void run(size_t count)
+    {
+      char buffer[Decimal::maxStringLength];
+      size_t total = 0;
+      for(size_t n = 0; n < count; ++n)
+      {
+        total += values_[n % valueCount].toString(buffer, sizeof(buffer));
+      }
+      consume(total);
+    }
+  };
+
+  /// Format into a std::string (op = one value)
+  class FormatStringBenchmark : public DecimalBenchmark
+  {
+  public:
+    FormatStringBenchmark()
+      : DecimalBenchmark("decimal toString string")
+    {
+    }
+
+    virtual void run(size_t count)
+    {
+      size_t total = 0;
+      for(size_t n = 0; n < count; ++n)
+      {
+        values_[n % valueCount].toString(string_);
+        total += string_.size();
+      }
+      consume(total);
+    }
+
+  private:
+    std::string string_;
+  };
+
+  /// Parse from a character buffer (op = one value)
+  class ParseBenchmark : public DecimalBenchmark
+  {
+  public:
+    ParseBenchmark()
+      : DecimalBenchmark("decimal parse")
+    {
+    }
+
+    virtual void setup()
+    {
+      DecimalBenchmark::setup();
+      for(size_t nValue = 0; nValue < valueCount; ++nValue)
+      {
+        std::string text;
+        values_[nValue].toString(text);
+        strings_.push_back(text);
+      }
+    }
+
+    virtual void run(size_t count)
+    {
+      Decimal value;
+      uint64 total = 0;
+      for(size_t n = 0; n < count; ++n)
+      {
+        const std::string & text = strings_[n % valueCount];
+        value.parse(text.data(), text.size());
+        total += value.getMantissa();
+      }
+      consume(total);
+    }
+
+  private:
+    std::vector<std::string> strings_;
+  };
+
+  /// Compare values with different exponents (op = one comparison)
+  class CompareBenchmark : public DecimalBenchmark
+  {
+  public:
+    CompareBenchmark()
+      : DecimalBenchmark("decimal compare")
+    {
+    }
+
+    virtual void run(size_t count)
+    {
+      size_t less = 0;
+      for(size_t n = 0; n < count; ++n)
+      {
+        if(values_[n % valueCount] < values_[(n + 1) % valueCount])
+        {
+          ++less;
+        }
+      }
+      consume(less);
+    }
+  };
+
+  /// Convert to double (op = one conversion)
+  class DoubleBenchmark : public DecimalBenchmark
+  {
+  public:
+    DoubleBenchmark()
+      : DecimalBenchmark("decimal to double")
+    {
+    }
+
+    virtual void run(size_t count)
+    {
+      double total = 0.0;
+      for(size_t n = 0; n < count; ++n)
+      {
+        double value = values_[n % valueCount];
+        total += value;
+      }
+      consume(uint64(total));
+    }
+  };
+}
+
+void
+Benchmarks::addDecimalBenchmarks(BenchmarkList & benchmarks)
+{
+  benchmarks.push_back(BenchmarkPtr(new FormatBufferBenchmark));
+  benchmarks.push_back(BenchmarkPtr(new FormatStringBenchmark));
+  benchmarks.push_back(BenchmarkPtr(new ParseBenchmark));
+  benchmarks.push_back(BenchmarkPtr(new CompareBenchmark));
+  benchmarks.push_back(BenchmarkPtr(new DoubleBenchmark));
+}
@@ -0,0 +1,139 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "Benchmark.h"
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Template.h>
+#include <Codecs/FieldInstruction.h>
+#include <Messages/Message.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldInt64.h>
+#include <Messages/FieldDecimal.h>
+#include <Messages/FieldAscii.h>
+#include <Messages/FieldUtf8.h>
+#include <Messages/FieldByteVector.h>
+
+using namespace QuickFAST;
+using namespace Benchmarks;
+
+namespace
+{
+  /// How many messages are in each message set.
+  const size_t messageCount = 1024;
+  const template_id_t templateId = 1;
+
+  /// Wrap a single field named Value in a template.
+  std::string singleFieldTemplate(const std::string & field)
+  {
+    return
+      "<templates xmlns=\"http://www.fixprotocol.org/ns/template-definition\">"
+      "  <template name=\"Benchmark\" id=\"1\">"
+      "    " + field +
+      "  </template>"
+      "</templates>";
+  }
+
+  /// Describes the value of the field in the n'th message.
+  typedef Messages::FieldCPtr (*ValueFunction)(size_t n);
+
+  Messages::FieldCPtr steadyUInt32(size_t n)
+  {
+    // mostly repeats so copy has something to do
+    return Messages::FieldUInt32::create(uint32(1000 + n / 4));
+  }
+
+  Messages::FieldCPtr countingUInt32(size_t n)
+  {
+    return Messages::FieldUInt32::create(uint32(1000000 + n));
+  }
+
+  Messages::FieldCPtr walkingInt64(size_t n)
+  {
+    return Messages::FieldInt64::create(int64(1234567890123LL + (n % 7) * 3 - (n % 5) * 4));
+  }
+
+  Messages::FieldCPtr walkingDecimal(size_t n)
+  {
+    return Messages::FieldDecimal::create(mantissa_t(1234500 + (n % 7) * 25 - (n % 5) * 20), -4);
+  }
+
+  std::string symbol(size_t n)
+  {
+    std::string result("QFAST.");
+    result += char('A' + n % 26);
+    result += char('A' + (n / 26) % 26);
+    return result;
+  }
+
+  Messages::FieldCPtr tailAscii(size_t n)
+  {
+    return Messages::FieldAscii::create(symbol(n));
+  }
+
+  Messages::FieldCPtr plainAscii(size_t n)
+  {
+    return Messages::FieldAscii::create(symbol(n) + " Ordinary Shares");
+  }
+
+  Messages::FieldCPtr plainUtf8(size_t n)
+  {
+    return Messages::FieldUtf8::create(symbol(n) + " Ordinary Shares");
+  }
+
+  Messages::FieldCPtr plainByteVector(size_t n)
+  {
+    return Messages::FieldByteVector::create(symbol(n) + " Ordinary Shares");
+  }
+
+  MessageSetPtr singleFieldMessages(
+    const std::string & field,
+    ValueFunction value)
+  {
+    MessageSetPtr messages(new MessageSet(parseTemplates(singleFieldTemplate(field))));
+    Codecs::TemplateCPtr templ;
+    messages->registry_->getTemplate(templateId, templ);
+    // use the template's identity which includes the namespace.
+    const Messages::FieldIdentity & identity = templ->getInstruction(0)->getIdentity();
+    for(size_t nMessage = 0; nMessage < messageCount; ++nMessage)
+    {
+      Messages::MessagePtr message(new Messages::Message(messages->registry_->maxFieldCount()));
+      message->addField(identity, value(nMessage));
+      messages->add(templateId, message);
+    }
+    return messages;
+  }
+
+  void addEncodeDecode(
+    BenchmarkList & benchmarks,
+    const std::string & name,
+    const std::string & field,
+    ValueFunction value)
+  {
+    MessageSetPtr messages = singleFieldMessages(field, value);
+    benchmarks.push_back(BenchmarkPtr(new DecodeBenchmark("decode " + name, messages)));
+    benchmarks.push_back(BenchmarkPtr(new EncodeBenchmark("encode " + name, messages)));
+  }
+}
+
+void
+Benchmarks::addFieldOpBenchmarks(BenchmarkList & benchmarks)
+{
+  addEncodeDecode(benchmarks, "copy uInt32",
+    "<uInt32 name=\"Value\"><copy/></uInt32>", steadyUInt32);
+  addEncodeDecode(benchmarks, "increment uInt32",
+    "<uInt32 name=\"Value\"><increment/></uInt32>", countingUInt32);
+  addEncodeDecode(benchmarks, "delta int64",
+    "<int64 name=\"Value\"><delta/></int64>", walkingInt64);
+  addEncodeDecode(benchmarks, "delta decimal",
+    "<decimal name=\"Value\"><delta/></decimal>", walkingDecimal);
+  addEncodeDecode(benchmarks, "tail ascii",
+    "<string name=\"Value\"><tail/></string>", tailAscii);
+  addEncodeDecode(benchmarks, "nop ascii",
+    "<string name=\"Value\"/>", plainAscii);
+  addEncodeDecode(benchmarks, "nop utf8",
+    "<string name=\"Value\" charset=\"unicode\"/>", plainUtf8);
+  addEncodeDecode(benchmarks, "nop byteVector",
+    "<byteVector name=\"Value\"/>", plainByteVector);
+}
@@ -0,0 +1,222 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "Benchmark.h"
+#include <Codecs/FieldInstruction.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/DataSourceBuffer.h>
+#include <Codecs/PresenceMap.h>
+
+using namespace QuickFAST;
+using namespace Benchmarks;
+
+namespace
+{
+  /// How many values are encoded in the input buffer.
+  const size_t valueCount = 1024;
+
+  /// Decode values from a buffer, starting over when the buffer is used up.
+  class BufferBenchmark : public Benchmark
+  {
+  public:
+    explicit BufferBenchmark(const std::string & name)
+      : Benchmark(name)
+      , decoder_(Codecs::TemplateRegistryPtr(new Codecs::TemplateRegistry))
+    {
+    }
+
+    virtual void run(size_t count)
+    {
+      while(count > 0)
+      {
+        size_t batch = count < valueCount ? count : valueCount;
+        Codecs::DataSourceBuffer source(
+          reinterpret_cast<const unsigned char *>(data_.data()), data_.size());
+        decode(source, batch);
+        count -= batch;
+      }
+    }
+
+  protected:
+    /// Decode the first count values in the source.
+    virtual void decode(Codecs::DataSource & source, size_t count) = 0;
+
+  protected:
+    std::string data_;
+    Codecs::Decoder decoder_;
+  };
+
+  const std::string fieldName("benchmark");
+
+  template<typename UnsignedType>
+  class UnsignedIntegerBenchmark : public BufferBenchmark
+  {
+  public:
+    UnsignedIntegerBenchmark(const std::string & name, UnsignedType value)
+      : BufferBenchmark(name)
+      , value_(value)
+    {
+    }
+
+    virtual void setup()
+    {
+      Codecs::DataDestination destination;
+      WorkingBuffer buffer;
+      for(size_t nValue = 0; nValue < valueCount; ++nValue)
+      {
+        Codecs::FieldInstruction::encodeUnsignedInteger(destination, buffer, value_);
+      }
+      destination.toString(data_);
+    }
+
+  protected:
+    virtual void decode(Codecs::DataSource & source, size_t count)
+    {
+      UnsignedType total = 0;
+      for(size_t nValue = 0; nValue < count; ++nValue)
+      {
+        UnsignedType value = 0;
+        Codecs::FieldInstruction::decodeUnsignedInteger(source, decoder_, value, fieldName);
+        total += value;
+      }
+      consume(total);
+    }
+
+  private:
+    UnsignedType value_;
+  };
+
+  template<typename SignedType>
+  class SignedIntegerBenchmark : public BufferBenchmark
+  {
+  public:
+    SignedIntegerBenchmark(const std::string & name, SignedType value)
+      : BufferBenchmark(name)
+      , value_(value)
+    {
+    }
+
+    virtual void setup()
+    {
+      Codecs::DataDestination destination;
+      WorkingBuffer buffer;
+      for(size_t nValue = 0; nValue < valueCount; ++nValue)
+      {
+        Codecs::FieldInstruction::encodeSignedInteger(destination, buffer, value_);
+      }
+      destination.toString(data_);
+    }
+
+  protected:
+    virtual void decode(Codecs::DataSource & source, size_t count)
+    {
+      SignedType total = 0;
+      for(size_t nValue = 0; nValue < count; ++nValue)
+      {
+        SignedType value = 0;
+        Codecs::FieldInstruction::decodeSignedInteger(source, decoder_, value, fieldName);
+        total += value;
+      }
+      consume(uint64(total));
+    }
+
+  private:
+    SignedType value_;
+  };
+
+  /// Encode unsigned integers (op = one integer)
+  class EncodeIntegerBenchmark : public Benchmark
+  {
+  public:
+    EncodeIntegerBenchmark(const std::string & name, uint64 value)
+      : Benchmark(name)
+      , value_(value)
+    {
+    }
+
+    virtual void run(size_t count)
+    {
+      while(count > 0)
+      {
+        size_t batch = count < valueCount ? count : valueCount;
+        destination_.clear();
+        for(size_t nValue = 0; nValue < batch; ++nValue)
+        {
+          Codecs::FieldInstruction::encodeUnsignedInteger(destination_, buffer_, value_ + nValue);
+        }
+        consume(destination_.size());
+        count -= batch;
+      }
+    }
+
+  private:
+    uint64 value_;
+    Codecs::DataDestination destination_;
+    WorkingBuffer buffer_;
+  };
+
+  /// Decode presence maps, then check every bit (op = one presence map)
+  class PresenceMapBenchmark : public BufferBenchmark
+  {
+  public:
+    PresenceMapBenchmark(const std::string & name, size_t bits)
+      : BufferBenchmark(name)
+      , bits_(bits)
+    {
+    }
+
+    virtual void setup()
+    {
+      Codecs::DataDestination destination;
+      for(size_t nValue = 0; nValue < valueCount; ++nValue)
+      {
+        Codecs::PresenceMap pmap(bits_);
+        for(size_t nBit = 0; nBit < bits_; ++nBit)
+        {
+          pmap.setNextField(((nBit + nValue) % 3) == 0);
+        }
+        pmap.encode(destination);
+      }
+      destination.toString(data_);
+    }
+
+  protected:
+    virtual void decode(Codecs::DataSource & source, size_t count)
+    {
+      Codecs::PresenceMap pmap(bits_);
+      size_t present = 0;
+      for(size_t nValue = 0; nValue < count; ++nValue)
+      {
+        pmap.decode(source);
+        for(size_t nBit = 0; nBit < bits_; ++nBit)
+        {
+          if(pmap.checkNextField())
+          {
+            ++present;
+          }
+        }
+      }
+      consume(present);
+    }
+
+  private:
+    size_t bits_;
+  };
+}
+
+void
+Benchmarks::addPrimitiveBenchmarks(BenchmarkList & benchmarks)
+{
+  benchmarks.push_back(BenchmarkPtr(new UnsignedIntegerBenchmark<uint32>("decode uint32 1 byte", 100)));
+  benchmarks.push_back(BenchmarkPtr(new UnsignedIntegerBenchmark<uint32>("decode uint32 3 bytes", 1000000)));
+  benchmarks.push_back(BenchmarkPtr(new UnsignedIntegerBenchmark<uint32>("decode uint32 5 bytes", 4000000000UL)));
+  benchmarks.push_back(BenchmarkPtr(new UnsignedIntegerBenchmark<uint64>("decode uint64 10 bytes", ~uint64(0))));
+  benchmarks.push_back(BenchmarkPtr(new SignedIntegerBenchmark<int32>("decode int32 2 bytes", -1000)));
+  benchmarks.push_back(BenchmarkPtr(new SignedIntegerBenchmark<int64>("decode int64 9 bytes", -4000000000000000000LL)));
+  benchmarks.push_back(BenchmarkPtr(new EncodeIntegerBenchmark("encode uint32 3 bytes", 1000000)));
+  benchmarks.push_back(BenchmarkPtr(new PresenceMapBenchmark("decode pmap 7 bits", 7)));
+  benchmarks.push_back(BenchmarkPtr(new PresenceMapBenchmark("decode pmap 21 bits", 21)));
+}
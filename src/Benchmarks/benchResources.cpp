@@ -0,0 +1,169 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "Benchmark.h"
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Template.h>
+#include <Codecs/FieldInstruction.h>
+#include <Codecs/FieldOp.h>
+#include <Messages/Message.h>
+#include <Messages/FieldInt32.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldInt64.h>
+#include <Messages/FieldUInt64.h>
+#include <Messages/FieldDecimal.h>
+#include <Messages/FieldAscii.h>
+#include <Messages/FieldUtf8.h>
+#include <Messages/FieldByteVector.h>
+#include <Common/Exceptions.h>
+
+using namespace QuickFAST;
+using namespace Benchmarks;
+
+namespace
+{
+  /// How many messages are synthesized for each template.
+  const size_t messageCount = 64;
+
+  /// The template files in Tests/resources.
+  const char * const resourceFiles[] =
+  {
+    "biggest_value.xml",
+    "smallest_value.xml",
+    "unittest_mandatory.xml",
+    "unittest_optional.xml"
+  };
+
+  std::string readFile(const std::string & fileName)
+  {
+    std::ifstream file(fileName.c_str());
+    if(!file.good())
+    {
+      throw UsageError("Benchmark", ("Can't open template file " + fileName).c_str());
+    }
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+  }
+
+  /// Parse a template file (op = one parse)
+  class ParseBenchmark : public Benchmark
+  {
+  public:
+    ParseBenchmark(const std::string & name, const std::string & fileName)
+      : Benchmark(name)
+      , fileName_(fileName)
+    {
+    }
+
+    virtual void setup()
+    {
+      xml_ = readFile(fileName_);
+    }
+
+    virtual void run(size_t count)
+    {
+      for(size_t n = 0; n < count; ++n)
+      {
+        Codecs::TemplateRegistryPtr registry = parseTemplates(xml_);
+        consume(registry->size());
+      }
+    }
+
+  private:
+    std::string fileName_;
+    std::string xml_;
+  };
+
+  /// Supply a value for the n'th message that any of the resource templates will accept.
+  /// @returns false if no value should be supplied.
+  bool synthesizeValue(
+    const Codecs::FieldInstruction & instruction,
+    size_t n,
+    Messages::FieldCPtr & field)
+  {
+    if(instruction.getFieldOp()->opType() == Codecs::FieldOp::CONSTANT)
+    {
+      // mandatory constants need no value; leave optional constants absent.
+      return false;
+    }
+    if(!instruction.isMandatory() && n % 4 == 3)
+    {
+      return false;
+    }
+    std::string text("value ");
+    text += char('a' + n % 26);
+    switch(instruction.fieldInstructionType())
+    {
+    case ValueType::INT32:
+      field = Messages::FieldInt32::create(int32(n) - 16);
+      return true;
+    case ValueType::UINT32:
+      field = Messages::FieldUInt32::create(uint32(100 + n / 2));
+      return true;
+    case ValueType::INT64:
+      field = Messages::FieldInt64::create(int64(5000000000LL + n * 3));
+      return true;
+    case ValueType::UINT64:
+      field = Messages::FieldUInt64::create(uint64(6000000000ULL + n / 2));
+      return true;
+    case ValueType::DECIMAL:
+      field = Messages::FieldDecimal::create(mantissa_t(12345 + n * 5), -4);
+      return true;
+    case ValueType::ASCII:
+      field = Messages::FieldAscii::create(text);
+      return true;
+    case ValueType::UTF8:
+      field = Messages::FieldUtf8::create(text);
+      return true;
+    case ValueType::BYTEVECTOR:
+      field = Messages::FieldByteVector::create(text);
+      return true;
+    default:
+      // groups, sequences and template references do not appear in the resources.
+      return false;
+    }
+  }
+
+  /// Synthesize messages for every template in the registry.
+  MessageSetPtr synthesizeMessages(Codecs::TemplateRegistryPtr registry)
+  {
+    MessageSetPtr messages(new MessageSet(registry));
+    for(size_t nMessage = 0; nMessage < messageCount; ++nMessage)
+    {
+      for(Codecs::TemplateRegistry::const_iterator it = registry->begin();
+        it != registry->end();
+        ++it)
+      {
+        const Codecs::Template & templ = *it->second;
+        Messages::MessagePtr message(new Messages::Message(registry->maxFieldCount()));
+        for(size_t nField = 0; nField < templ.size(); ++nField)
+        {
+          const Codecs::FieldInstructionCPtr & instruction = templ.getInstruction(nField);
+          Messages::FieldCPtr field;
+          if(synthesizeValue(*instruction, nMessage, field))
+          {
+            message->addField(instruction->getIdentity(), field);
+          }
+        }
+        messages->add(it->first, message);
+      }
+    }
+    return messages;
+  }
+}
+
+void
+Benchmarks::addResourceBenchmarks(BenchmarkList & benchmarks, const std::string & resourceDirectory)
+{
+  for(size_t nFile = 0; nFile < sizeof(resourceFiles)/sizeof(resourceFiles[0]); ++nFile)
+  {
+    std::string name(resourceFiles[nFile]);
+    std::string fileName = resourceDirectory + "/" + name;
+    benchmarks.push_back(BenchmarkPtr(new ParseBenchmark("parse " + name, fileName)));
+    MessageSetPtr messages = synthesizeMessages(parseTemplateFile(fileName));
+    benchmarks.push_back(BenchmarkPtr(new DecodeBenchmark("decode " + name, messages)));
+    benchmarks.push_back(BenchmarkPtr(new EncodeBenchmark("encode " + name, messages)));
+  }
+}
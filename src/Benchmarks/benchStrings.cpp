@@ -0,0 +1,136 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "Benchmark.h"
+#include <Codecs/FieldInstruction.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/DataSourceBuffer.h>
+#include <Common/StringBuffer.h>
+#include <Common/WorkingBuffer.h>
+
+using namespace QuickFAST;
+using namespace Benchmarks;
+
+namespace
+{
+  /// How many strings are encoded in the input buffer.
+  const size_t stringCount = 1024;
+  const std::string fieldName("benchmark");
+
+  std::string makeString(size_t length, size_t seed)
+  {
+    std::string result;
+    for(size_t pos = 0; pos < length; ++pos)
+    {
+      result += char('A' + (pos + seed) % 26);
+    }
+    return result;
+  }
+
+  /// Decode stop bit encoded ASCII strings (op = one string)
+  class AsciiBenchmark : public Benchmark
+  {
+  public:
+    AsciiBenchmark(const std::string & name, size_t length)
+      : Benchmark(name)
+      , length_(length)
+    {
+    }
+
+    virtual void setup()
+    {
+      Codecs::DataDestination destination;
+      for(size_t nString = 0; nString < stringCount; ++nString)
+      {
+        Codecs::FieldInstruction::encodeAscii(destination, StringBuffer(makeString(length_, nString)));
+      }
+      destination.toString(data_);
+    }
+
+    virtual void run(size_t count)
+    {
+      while(count > 0)
+      {
+        size_t batch = count < stringCount ? count : stringCount;
+        Codecs::DataSourceBuffer source(
+          reinterpret_cast<const unsigned char *>(data_.data()), data_.size());
+        size_t total = 0;
+        for(size_t nString = 0; nString < batch; ++nString)
+        {
+          Codecs::FieldInstruction::decodeAscii(source, buffer_);
+          total += buffer_.size();
+        }
+        consume(total);
+        count -= batch;
+      }
+    }
+
+  private:
+    size_t length_;
+    std::string data_;
+    WorkingBuffer buffer_;
+  };
+
+  /// Decode length prefixed byte vectors (op = one vector)
+  /// UTF-8 strings are decoded the same way.
+  class ByteVectorBenchmark : public Benchmark
+  {
+  public:
+    ByteVectorBenchmark(const std::string & name, size_t length)
+      : Benchmark(name)
+      , length_(length)
+      , decoder_(Codecs::TemplateRegistryPtr(new Codecs::TemplateRegistry))
+    {
+    }
+
+    virtual void setup()
+    {
+      Codecs::DataDestination destination;
+      WorkingBuffer buffer;
+      for(size_t nString = 0; nString < stringCount; ++nString)
+      {
+        Codecs::FieldInstruction::encodeUnsignedInteger(destination, buffer, length_);
+        Codecs::FieldInstruction::encodeBlobData(destination, StringBuffer(makeString(length_, nString)));
+      }
+      destination.toString(data_);
+    }
+
+    virtual void run(size_t count)
+    {
+      while(count > 0)
+      {
+        size_t batch = count < stringCount ? count : stringCount;
+        Codecs::DataSourceBuffer source(
+          reinterpret_cast<const unsigned char *>(data_.data()), data_.size());
+        size_t total = 0;
+        for(size_t nString = 0; nString < batch; ++nString)
+        {
+          uint32 length = 0;
+          Codecs::FieldInstruction::decodeUnsignedInteger(source, decoder_, length, fieldName);
+          Codecs::FieldInstruction::decodeByteVector(decoder_, source, fieldName, buffer_, length);
+          total += buffer_.size();
+        }
+        consume(total);
+        count -= batch;
+      }
+    }
+
+  private:
+    size_t length_;
+    std::string data_;
+    Codecs::Decoder decoder_;
+    WorkingBuffer buffer_;
+  };
+}
+
+void
+Benchmarks::addStringBenchmarks(BenchmarkList & benchmarks)
+{
+  benchmarks.push_back(BenchmarkPtr(new AsciiBenchmark("decode ascii 8 chars", 8)));
+  benchmarks.push_back(BenchmarkPtr(new AsciiBenchmark("decode ascii 32 chars", 32)));
+  benchmarks.push_back(BenchmarkPtr(new ByteVectorBenchmark("decode byteVector 16 bytes", 16)));
+  benchmarks.push_back(BenchmarkPtr(new ByteVectorBenchmark("decode byteVector 256 bytes", 256)));
+}
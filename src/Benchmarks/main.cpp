@@ -0,0 +1,19 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include <Benchmarks/BenchmarkRunner.h>
+
+using namespace QuickFAST;
+using namespace Benchmarks;
+
+int main(int argc, char* argv[])
+{
+  int result = -1;
+  BenchmarkRunner runner;
+  if(runner.init(argc, argv))
+  {
+    result = runner.run();
+  }
+  return result;
+}
@@ -80,7 +80,7 @@ BasePacketAssembler::decodeBuffer(const unsigned char * buffer, size_t size)
         // the decoder is NOT reset for each one.
         if(reset_)
         {
-          decoder_.reset();
+          decoder_.resetDecoder();
         }
         while(bytesAvailable() > 0)
         {
@@ -103,7 +103,7 @@ BasePacketAssembler::decodeBuffer(const unsigned char * buffer, size_t size)
           }
           else
           {
-            decoder_.decodeMessage(*this, builder_);
+            decoder_.decodeMessage(*this, builder_, messageSize);
           }
         }
       }
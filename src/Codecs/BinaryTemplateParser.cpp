@@ -0,0 +1,266 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "BinaryTemplateParser.h"
+#include <Codecs/TemplateSchemaBuilder.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Common/Exceptions.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Codecs;
+
+namespace
+{
+  /// @brief Read little-endian values from an image with bounds checking.
+  class ImageReader
+  {
+  public:
+    ImageReader(const unsigned char * image, size_t size)
+      : image_(image)
+      , size_(size)
+      , position_(0)
+    {
+    }
+
+    void need(size_t count)
+    {
+      if(count > size_ - position_)
+      {
+        throw TemplateDefinitionError("Template image is truncated.");
+      }
+    }
+
+    unsigned char getByte()
+    {
+      need(1);
+      return image_[position_++];
+    }
+
+    uint32 getUInt32()
+    {
+      need(4);
+      uint32 value = 0;
+      for(size_t nByte = 0; nByte < 4; ++nByte)
+      {
+        value |= uint32(image_[position_++]) << (8 * nByte);
+      }
+      return value;
+    }
+
+    uint64 getUInt64()
+    {
+      need(8);
+      uint64 value = 0;
+      for(size_t nByte = 0; nByte < 8; ++nByte)
+      {
+        value |= uint64(image_[position_++]) << (8 * nByte);
+      }
+      return value;
+    }
+
+    const char * getBytes(size_t count)
+    {
+      need(count);
+      const char * result = reinterpret_cast<const char *>(image_ + position_);
+      position_ += count;
+      return result;
+    }
+
+  private:
+    const unsigned char * image_;
+    size_t size_;
+    size_t position_;
+  };
+
+  const std::string & lookup(const std::vector<std::string> & strings, uint32 index)
+  {
+    if(index >= strings.size())
+    {
+      throw TemplateDefinitionError("Template image is damaged: bad string index.");
+    }
+    return strings[index];
+  }
+
+  void check(size_t expected, size_t actual, const char * what)
+  {
+    if(expected != actual)
+    {
+      std::stringstream msg;
+      msg << "Template image does not match this version of QuickFAST: "
+        << what << " was " << expected << " when compiled but is " << actual << " now.";
+      throw TemplateDefinitionError(msg.str());
+    }
+  }
+}
+
+const char BinaryTemplateParser::magic[4] = {'Q', 'F', 'T', 'I'};
+const uint32 BinaryTemplateParser::formatVersion;
+
+BinaryTemplateParser::BinaryTemplateParser()
+  : checkSource_(false)
+  , sourceHash_(0)
+  , nonstandard_(0)
+{
+}
+
+BinaryTemplateParser::~BinaryTemplateParser()
+{
+}
+
+uint64
+BinaryTemplateParser::hash(const unsigned char * data, size_t size)
+{
+  uint64 result = 14695981039346656037ULL;
+  for(size_t pos = 0; pos < size; ++pos)
+  {
+    result ^= data[pos];
+    result *= 1099511628211ULL;
+  }
+  return result;
+}
+
+void
+BinaryTemplateParser::requireSource(uint64 sourceHash)
+{
+  checkSource_ = true;
+  sourceHash_ = sourceHash;
+}
+
+void
+BinaryTemplateParser::requireSource(std::istream & xmlData)
+{
+  std::string xml;
+  std::copy(
+    std::istreambuf_iterator<char>(xmlData),
+    std::istreambuf_iterator<char>(),
+    std::back_inserter(xml));
+  requireSource(hash(reinterpret_cast<const unsigned char *>(xml.data()), xml.size()));
+}
+
+void
+BinaryTemplateParser::setNonstandard(unsigned long nonstandard)
+{
+  nonstandard_ = nonstandard;
+}
+
+TemplateRegistryPtr
+BinaryTemplateParser::parse(std::istream & image)
+{
+  if(!image.good())
+  {
+    throw TemplateDefinitionError("Can't read template image.");
+  }
+  std::string data;
+  std::copy(
+    std::istreambuf_iterator<char>(image),
+    std::istreambuf_iterator<char>(),
+    std::back_inserter(data));
+  return parse(reinterpret_cast<const unsigned char *>(data.data()), data.size());
+}
+
+TemplateRegistryPtr
+BinaryTemplateParser::parseFile(const std::string & fileName)
+{
+  try
+  {
+    boost::interprocess::file_mapping file(fileName.c_str(), boost::interprocess::read_only);
+    boost::interprocess::mapped_region region(file, boost::interprocess::read_only);
+    return parse(static_cast<const unsigned char *>(region.get_address()), region.get_size());
+  }
+  catch(const boost::interprocess::interprocess_exception & ex)
+  {
+    std::stringstream msg;
+    msg << "Can't map template image " << fileName << ": " << ex.what();
+    throw TemplateDefinitionError(msg.str());
+  }
+}
+
+TemplateRegistryPtr
+BinaryTemplateParser::parse(const unsigned char * image, size_t size)
+{
+  const size_t checksumSize = 8;
+  if(size < sizeof(magic) + checksumSize || std::memcmp(image, magic, sizeof(magic)) != 0)
+  {
+    throw TemplateDefinitionError("Not a template image.");
+  }
+  ImageReader checksum(image + size - checksumSize, checksumSize);
+  if(checksum.getUInt64() != hash(image, size - checksumSize))
+  {
+    throw TemplateDefinitionError("Template image is damaged: bad checksum.");
+  }
+
+  ImageReader reader(image, size - checksumSize);
+  reader.getBytes(sizeof(magic));
+  uint32 version = reader.getUInt32();
+  if(version != formatVersion)
+  {
+    std::stringstream msg;
+    msg << "Template image version " << version << " is not supported.  Expecting " << formatVersion;
+    throw TemplateDefinitionError(msg.str());
+  }
+  uint64 sourceHash = reader.getUInt64();
+  if(checkSource_ && sourceHash != sourceHash_)
+  {
+    throw TemplateDefinitionError("Template image was not compiled from these templates.");
+  }
+  uint32 nonstandard = reader.getUInt32();
+  if(nonstandard != nonstandard_)
+  {
+    throw TemplateDefinitionError("Template image was compiled with different nonstandard features.");
+  }
+  uint32 presenceMapBits = reader.getUInt32();
+  uint32 dictionarySize = reader.getUInt32();
+  uint32 maxFieldCount = reader.getUInt32();
+  uint32 templateCount = reader.getUInt32();
+  uint32 stringCount = reader.getUInt32();
+  uint32 elementCount = reader.getUInt32();
+
+  std::vector<std::string> strings;
+  // each string needs at least four bytes, so this protects reserve() from a bad count.
+  reader.need(size_t(stringCount) * 4);
+  strings.reserve(stringCount);
+  for(uint32 nString = 0; nString < stringCount; ++nString)
+  {
+    uint32 length = reader.getUInt32();
+    strings.push_back(std::string(reader.getBytes(length), length));
+  }
+
+  TemplateRegistryPtr registry(new TemplateRegistry);
+  TemplateSchemaBuilder builder(registry, 0, nonstandard_);
+  TemplateSchemaBuilder::AttributeMap attributes;
+  for(uint32 nElement = 0; nElement < elementCount; ++nElement)
+  {
+    unsigned char kind = reader.getByte();
+    const std::string & tag = lookup(strings, reader.getUInt32());
+    if(kind == 'S')
+    {
+      attributes.clear();
+      uint32 attributeCount = reader.getUInt32();
+      for(uint32 nAttribute = 0; nAttribute < attributeCount; ++nAttribute)
+      {
+        const std::string & name = lookup(strings, reader.getUInt32());
+        attributes[name] = lookup(strings, reader.getUInt32());
+      }
+      builder.startElement(tag, attributes);
+    }
+    else if(kind == 'E')
+    {
+      builder.endElement(tag);
+    }
+    else
+    {
+      throw TemplateDefinitionError("Template image is damaged: bad element.");
+    }
+  }
+  builder.endDocument();
+
+  check(presenceMapBits, registry->presenceMapBits(), "presence map bits");
+  check(dictionarySize, registry->dictionarySize(), "dictionary size");
+  check(maxFieldCount, registry->maxFieldCount(), "field count");
+  check(templateCount, registry->size(), "template count");
+  return registry;
+}
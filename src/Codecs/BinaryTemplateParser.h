@@ -0,0 +1,99 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+
+#ifndef BINARYTEMPLATEPARSER_H
+#define BINARYTEMPLATEPARSER_H
+
+#include "BinaryTemplateParser_fwd.h"
+#include <Codecs/TemplateRegistry_fwd.h>
+#include <Common/QuickFAST_Export.h>
+#include <Common/Types.h>
+
+namespace QuickFAST
+{
+  namespace Codecs
+  {
+    /// @brief Load a TemplateRegistry from a precompiled template image.
+    ///
+    /// A template image is written by XMLTemplateParser::compile().  It holds the
+    /// elements and attributes of the XML template file in a compact binary form,
+    /// so loading it needs neither Xerces nor any XML text processing.  The image
+    /// is replayed into the same TemplateSchemaBuilder that the XMLTemplateParser
+    /// uses, so the resulting registry is identical to one parsed from the XML.
+    ///
+    /// The image also records:<ul>
+    /// <li>a hash of the XML it was compiled from.  Call requireSource() to reject
+    ///     an image that is out of date.</li>
+    /// <li>the nonstandard features that were enabled when it was compiled.</li>
+    /// <li>the presence map bits, dictionary size, field count and template count
+    ///     of the finalized registry.  These are checked after loading to detect
+    ///     an image compiled by an incompatible version of QuickFAST.</li>
+    /// <li>a checksum of the entire image to detect a damaged file.</li></ul>
+    ///
+    /// Any problem with the image is reported by throwing a TemplateDefinitionError.
+    /// An application that keeps an image as a cache of the XML can catch it and
+    /// fall back to parsing (and recompiling) the XML.
+    class QuickFAST_Export BinaryTemplateParser
+    {
+    public:
+      /// @brief Identifies a template image.
+      static const char magic[4];
+      /// @brief The version of the image layout.  Increment if the layout changes.
+      static const uint32 formatVersion = 1;
+
+      BinaryTemplateParser();
+      ~BinaryTemplateParser();
+
+      /// @brief Load an image from memory.
+      /// @param image points to the image
+      /// @param size is the number of bytes in the image.
+      /// @returns a TemplateRegistry containing the templates.
+      TemplateRegistryPtr parse(const unsigned char * image, size_t size);
+
+      /// @brief Load an image from a stream.
+      /// @param image is the stream that supplies the image.  It should be opened in binary mode.
+      /// @returns a TemplateRegistry containing the templates.
+      TemplateRegistryPtr parse(std::istream & image);
+
+      /// @brief Load an image by mapping a file into memory.
+      /// @param fileName names the image file.
+      /// @returns a TemplateRegistry containing the templates.
+      TemplateRegistryPtr parseFile(const std::string & fileName);
+
+      /// @brief Accept only an image compiled from this XML.
+      /// @param xmlData is the stream that supplies the XML template file.
+      void requireSource(std::istream & xmlData);
+
+      /// @brief Accept only an image compiled from XML with this hash.
+      /// @param sourceHash as calculated by hash()
+      void requireSource(uint64 sourceHash);
+
+      /// @brief Accept only an image compiled with these nonstandard features.
+      /// @param nonstandard is a bitwise OR of XMLTemplateParser::NonstandardFeatures
+      void setNonstandard(unsigned long nonstandard);
+
+      /// @brief Calculate the hash used to identify a template source or image.
+      /// @param data points to the data to be hashed.
+      /// @param size is the number of bytes to hash.
+      /// @returns the 64 bit FNV-1a hash of the data.
+      static uint64 hash(const unsigned char * data, size_t size);
+
+    private:
+      // forbid copy constructor
+      BinaryTemplateParser(const BinaryTemplateParser &);
+      // forbid assignment
+      BinaryTemplateParser & operator = (const BinaryTemplateParser &);
+
+    private:
+      bool checkSource_;
+      uint64 sourceHash_;
+      unsigned long nonstandard_;
+    };
+  }
+}
+
+#endif /* BINARYTEMPLATEPARSER_H */
@@ -0,0 +1,119 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "BinaryTemplateWriter.h"
+#include <Codecs/BinaryTemplateParser.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Common/Exceptions.h>
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Codecs;
+
+namespace
+{
+  void appendUInt32(std::string & out, uint32 value)
+  {
+    for(size_t nByte = 0; nByte < 4; ++nByte)
+    {
+      out += char(value & 0xFF);
+      value >>= 8;
+    }
+  }
+
+  void appendUInt64(std::string & out, uint64 value)
+  {
+    for(size_t nByte = 0; nByte < 8; ++nByte)
+    {
+      out += char(value & 0xFF);
+      value >>= 8;
+    }
+  }
+}
+
+BinaryTemplateWriter::BinaryTemplateWriter()
+  : elementCount_(0)
+{
+}
+
+BinaryTemplateWriter::~BinaryTemplateWriter()
+{
+}
+
+uint32
+BinaryTemplateWriter::intern(const std::string & value)
+{
+  StringIndex::const_iterator it = stringIndex_.find(value);
+  if(it != stringIndex_.end())
+  {
+    return it->second;
+  }
+  uint32 index = uint32(strings_.size());
+  strings_.push_back(value);
+  stringIndex_[value] = index;
+  return index;
+}
+
+void
+BinaryTemplateWriter::append(uint32 value)
+{
+  appendUInt32(elements_, value);
+}
+
+void
+BinaryTemplateWriter::startElement(
+  const std::string & tag,
+  const TemplateSchemaBuilder::AttributeMap & attributes)
+{
+  elements_ += 'S';
+  append(intern(tag));
+  append(uint32(attributes.size()));
+  for(TemplateSchemaBuilder::AttributeMap::const_iterator it = attributes.begin();
+    it != attributes.end();
+    ++it)
+  {
+    append(intern(it->first));
+    append(intern(it->second));
+  }
+  ++elementCount_;
+}
+
+void
+BinaryTemplateWriter::endElement(const std::string & tag)
+{
+  elements_ += 'E';
+  append(intern(tag));
+  ++elementCount_;
+}
+
+void
+BinaryTemplateWriter::write(
+  std::ostream & image,
+  const TemplateRegistry & registry,
+  uint64 sourceHash,
+  unsigned long nonstandard) const
+{
+  std::string out(BinaryTemplateParser::magic, sizeof(BinaryTemplateParser::magic));
+  appendUInt32(out, BinaryTemplateParser::formatVersion);
+  appendUInt64(out, sourceHash);
+  appendUInt32(out, uint32(nonstandard));
+  appendUInt32(out, uint32(registry.presenceMapBits()));
+  appendUInt32(out, uint32(registry.dictionarySize()));
+  appendUInt32(out, uint32(registry.maxFieldCount()));
+  appendUInt32(out, uint32(registry.size()));
+  appendUInt32(out, uint32(strings_.size()));
+  appendUInt32(out, elementCount_);
+  for(size_t nString = 0; nString < strings_.size(); ++nString)
+  {
+    appendUInt32(out, uint32(strings_[nString].size()));
+    out += strings_[nString];
+  }
+  out += elements_;
+  appendUInt64(out, BinaryTemplateParser::hash(
+    reinterpret_cast<const unsigned char *>(out.data()), out.size()));
+  image.write(out.data(), std::streamsize(out.size()));
+  if(!image.good())
+  {
+    throw TemplateDefinitionError("Can't write template image.");
+  }
+}
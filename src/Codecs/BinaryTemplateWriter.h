@@ -0,0 +1,86 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+
+#ifndef BINARYTEMPLATEWRITER_H
+#define BINARYTEMPLATEWRITER_H
+
+#include "BinaryTemplateWriter_fwd.h"
+#include <Codecs/TemplateSchemaBuilder.h>
+#include <Codecs/TemplateRegistry_fwd.h>
+#include <Common/QuickFAST_Export.h>
+#include <Common/Types.h>
+
+namespace QuickFAST
+{
+  namespace Codecs
+  {
+    /// @brief Record the elements of a template file and write them as a template image.
+    ///
+    /// Normally used via XMLTemplateParser::compile().  The image can be loaded
+    /// by a BinaryTemplateParser.
+    ///
+    /// Image layout.  All integers are little-endian.<pre>
+    ///   magic            4 bytes "QFTI"
+    ///   version          uint32
+    ///   source hash      uint64
+    ///   nonstandard      uint32
+    ///   pmap bits        uint32
+    ///   dictionary size  uint32
+    ///   max field count  uint32
+    ///   template count   uint32
+    ///   string count     uint32
+    ///   element count    uint32
+    ///   strings          for each: uint32 length, then the characters
+    ///   elements         start: 'S', uint32 tag, uint32 attribute count,
+    ///                           then uint32 name and uint32 value for each attribute
+    ///                    end:   'E', uint32 tag
+    ///   checksum         uint64 hash of everything above.
+    /// </pre>
+    /// Tags, attribute names and attribute values are indexes into the strings.
+    class QuickFAST_Export BinaryTemplateWriter
+    {
+    public:
+      BinaryTemplateWriter();
+      ~BinaryTemplateWriter();
+
+      /// @brief Record the start of an element
+      /// @param tag is the element's local name
+      /// @param attributes are the element's attributes
+      void startElement(
+        const std::string & tag,
+        const TemplateSchemaBuilder::AttributeMap & attributes);
+
+      /// @brief Record the end of an element
+      /// @param tag is the element's local name
+      void endElement(const std::string & tag);
+
+      /// @brief Write the image.
+      /// @param image receives the image.  It should be opened in binary mode.
+      /// @param registry was built from the recorded elements.
+      /// @param sourceHash identifies the XML the elements came from.
+      /// @param nonstandard features enabled while building the registry.
+      void write(
+        std::ostream & image,
+        const TemplateRegistry & registry,
+        uint64 sourceHash,
+        unsigned long nonstandard) const;
+
+    private:
+      uint32 intern(const std::string & value);
+      void append(uint32 value);
+
+    private:
+      typedef std::map<std::string, uint32> StringIndex;
+      StringIndex stringIndex_;
+      std::vector<std::string> strings_;
+      std::string elements_;
+      uint32 elementCount_;
+    };
+  }
+}
+
+#endif /* BINARYTEMPLATEWRITER_H */
@@ -0,0 +1,21 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+
+#ifndef BINARYTEMPLATEWRITER_FWD_H
+#define BINARYTEMPLATEWRITER_FWD_H
+#ifndef QUICKFAST_HEADERS
+#error Please include <Application/QuickFAST.h> preferably as a precompiled header file.
+#endif //QUICKFAST_HEADERS
+
+namespace QuickFAST
+{
+  namespace Codecs
+  {
+    class BinaryTemplateWriter;
+  }
+}
+#endif // BINARYTEMPLATEWRITER_FWD_H
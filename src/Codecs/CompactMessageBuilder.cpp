@@ -0,0 +1,262 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "CompactMessageBuilder.h"
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Codecs;
+
+CompactMessageBuilder::CompactMessageBuilder(CompactMessageConsumer & consumer)
+: consumer_(consumer)
+{
+}
+
+CompactMessageBuilder::~CompactMessageBuilder()
+{
+}
+
+size_t
+CompactMessageBuilder::nextSlot()
+{
+  Frame & frame = frames_.back();
+  if(frame.used_ == frame.capacity_)
+  {
+    size_t capacity = std::max(size_t(4), frame.capacity_ * 2);
+    frame.first_ = message_.relocate(frame.first_, frame.used_, capacity, frame.owner_, frame.topLevel_);
+    frame.capacity_ = capacity;
+  }
+  return frame.first_ + frame.used_++;
+}
+
+void
+CompactMessageBuilder::push(
+  size_t owner,
+  size_t size,
+  const Messages::FieldIdentity * identity,
+  const std::string & applicationType,
+  const std::string & applicationTypeNamespace)
+{
+  Frame frame;
+  frame.owner_ = owner;
+  frame.first_ = message_.allocate(size);
+  frame.capacity_ = size;
+  frame.used_ = 0;
+  frame.topLevel_ = false;
+  frame.identity_ = identity;
+  frame.applicationType_ = &applicationType;
+  frame.applicationTypeNamespace_ = &applicationTypeNamespace;
+  frames_.push_back(frame);
+}
+
+void
+CompactMessageBuilder::pop()
+{
+  const Frame & frame = frames_.back();
+  message_.setNestedSize(frame.owner_, frame.used_, frame.topLevel_);
+  frames_.pop_back();
+}
+
+const std::string &
+CompactMessageBuilder::getApplicationType()const
+{
+  if(frames_.empty())
+  {
+    return message_.getApplicationType();
+  }
+  return *frames_.back().applicationType_;
+}
+
+const std::string &
+CompactMessageBuilder::getApplicationTypeNs()const
+{
+  if(frames_.empty())
+  {
+    return message_.getApplicationTypeNs();
+  }
+  return *frames_.back().applicationTypeNamespace_;
+}
+
+void
+CompactMessageBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int64 value)
+{
+  message_.setSigned(nextSlot(), identity, type, value);
+}
+
+void
+CompactMessageBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uint64 value)
+{
+  message_.setUnsigned(nextSlot(), identity, type, value);
+}
+
+void
+CompactMessageBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int32 value)
+{
+  message_.setSigned(nextSlot(), identity, type, value);
+}
+
+void
+CompactMessageBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uint32 value)
+{
+  message_.setUnsigned(nextSlot(), identity, type, value);
+}
+
+void
+CompactMessageBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int16 value)
+{
+  message_.setSigned(nextSlot(), identity, type, value);
+}
+
+void
+CompactMessageBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uint16 value)
+{
+  message_.setUnsigned(nextSlot(), identity, type, value);
+}
+
+void
+CompactMessageBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int8 value)
+{
+  message_.setSigned(nextSlot(), identity, type, value);
+}
+
+void
+CompactMessageBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uchar value)
+{
+  message_.setUnsigned(nextSlot(), identity, type, value);
+}
+
+void
+CompactMessageBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const Decimal& value)
+{
+  message_.setDecimal(nextSlot(), identity, type, value);
+}
+
+void
+CompactMessageBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const unsigned char * value, size_t length)
+{
+  message_.setString(nextSlot(), identity, type, value, length);
+}
+
+Messages::ValueMessageBuilder &
+CompactMessageBuilder::startMessage(
+  const std::string & applicationType,
+  const std::string & applicationTypeNamespace,
+  size_t size)
+{
+  frames_.clear();
+  message_.start(applicationType, applicationTypeNamespace, size);
+  Frame frame;
+  frame.owner_ = 0;
+  frame.first_ = 0;
+  frame.capacity_ = size;
+  frame.used_ = 0;
+  frame.topLevel_ = true;
+  frame.identity_ = 0;
+  frame.applicationType_ = &applicationType;
+  frame.applicationTypeNamespace_ = &applicationTypeNamespace;
+  frames_.push_back(frame);
+  return *this;
+}
+
+bool
+CompactMessageBuilder::endMessage(Messages::ValueMessageBuilder & /*messageBuilder*/)
+{
+  pop();
+  frames_.clear();
+  return consumer_.consumeMessage(message_);
+}
+
+bool
+CompactMessageBuilder::ignoreMessage(Messages::ValueMessageBuilder & /*messageBuilder*/)
+{
+  frames_.clear();
+  message_.clear();
+  return true;
+}
+
+Messages::ValueMessageBuilder &
+CompactMessageBuilder::startSequence(
+  const Messages::FieldIdentity & identity,
+  const std::string & applicationType,
+  const std::string & applicationTypeNamespace,
+  size_t /*fieldCount*/,
+  const Messages::FieldIdentity & /*lengthIdentity*/,
+  size_t length)
+{
+  size_t slot = nextSlot();
+  push(slot, length, &identity, applicationType, applicationTypeNamespace);
+  message_.setNested(slot, identity, ValueType::SEQUENCE, frames_.back().first_, 0);
+  return *this;
+}
+
+void
+CompactMessageBuilder::endSequence(
+  const Messages::FieldIdentity & /*identity*/,
+  Messages::ValueMessageBuilder & /*sequenceBuilder*/)
+{
+  pop();
+}
+
+Messages::ValueMessageBuilder &
+CompactMessageBuilder::startSequenceEntry(
+  const std::string & applicationType,
+  const std::string & applicationTypeNamespace,
+  size_t size)
+{
+  const Messages::FieldIdentity & identity = *frames_.back().identity_;
+  size_t slot = nextSlot();
+  push(slot, size, 0, applicationType, applicationTypeNamespace);
+  message_.setNested(slot, identity, ValueType::GROUP, frames_.back().first_, 0);
+  return *this;
+}
+
+void
+CompactMessageBuilder::endSequenceEntry(Messages::ValueMessageBuilder & /*entry*/)
+{
+  pop();
+}
+
+Messages::ValueMessageBuilder &
+CompactMessageBuilder::startGroup(
+  const Messages::FieldIdentity & identity,
+  const std::string & applicationType,
+  const std::string & applicationTypeNamespace,
+  size_t size)
+{
+  size_t slot = nextSlot();
+  push(slot, size, 0, applicationType, applicationTypeNamespace);
+  message_.setNested(slot, identity, ValueType::GROUP, frames_.back().first_, 0);
+  return *this;
+}
+
+void
+CompactMessageBuilder::endGroup(
+  const Messages::FieldIdentity & /*identity*/,
+  Messages::ValueMessageBuilder & /*groupBuilder*/)
+{
+  pop();
+}
+
+bool
+CompactMessageBuilder::wantLog(unsigned short level)
+{
+  return consumer_.wantLog(level);
+}
+
+bool
+CompactMessageBuilder::logMessage(unsigned short level, const std::string & logMessage)
+{
+  return consumer_.logMessage(level, logMessage);
+}
+
+bool
+CompactMessageBuilder::reportDecodingError(const std::string & errorMessage)
+{
+  return consumer_.reportDecodingError(errorMessage);
+}
+
+bool
+CompactMessageBuilder::reportCommunicationError(const std::string & errorMessage)
+{
+  return consumer_.reportCommunicationError(errorMessage);
+}
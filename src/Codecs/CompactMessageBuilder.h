@@ -0,0 +1,126 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef COMPACTMESSAGEBUILDER_H
+#define COMPACTMESSAGEBUILDER_H
+#include <Common/QuickFAST_Export.h>
+#include <Codecs/CompactMessageConsumer.h>
+#include <Messages/ValueMessageBuilder.h>
+#include <Messages/CompactMessage.h>
+
+namespace QuickFAST{
+  namespace Codecs{
+    /// @brief Build CompactMessages during decoding.
+    ///
+    /// Values are written directly into the message's block; no Field objects
+    /// are created.  Groups, sequences and sequence entries are handled by this
+    /// builder too, so startGroup() and friends return *this.
+    ///
+    /// The slots for a group or sequence are allocated when it starts, using the
+    /// field count from the template.  If more fields arrive than the template
+    /// promised they are moved to a larger run.
+    class QuickFAST_Export CompactMessageBuilder : public Messages::ValueMessageBuilder
+    {
+    public:
+      /// @brief Construct given the consumer to receive the built messages.
+      /// @param consumer will receive the messages after they are built.
+      explicit CompactMessageBuilder(CompactMessageConsumer & consumer);
+
+      /// @brief Virtual destructor
+      virtual ~CompactMessageBuilder();
+
+      ///////////////////////////////
+      // Implement ValueMessageBuilder
+      virtual const std::string & getApplicationType()const;
+      virtual const std::string & getApplicationTypeNs()const;
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int64 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uint64 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int32 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uint32 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int16 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uint16 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int8 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uchar value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const Decimal& value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const unsigned char * value, size_t length);
+
+      virtual Messages::ValueMessageBuilder & startMessage(
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t size);
+      virtual bool endMessage(Messages::ValueMessageBuilder & messageBuilder);
+      virtual bool ignoreMessage(Messages::ValueMessageBuilder & messageBuilder);
+
+      virtual Messages::ValueMessageBuilder & startSequence(
+        const Messages::FieldIdentity & identity,
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t fieldCount,
+        const Messages::FieldIdentity & lengthIdentity,
+        size_t length);
+      virtual void endSequence(
+        const Messages::FieldIdentity & identity,
+        Messages::ValueMessageBuilder & sequenceBuilder);
+
+      virtual Messages::ValueMessageBuilder & startSequenceEntry(
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t size);
+      virtual void endSequenceEntry(Messages::ValueMessageBuilder & entry);
+
+      virtual Messages::ValueMessageBuilder & startGroup(
+        const Messages::FieldIdentity & identity,
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t size);
+      virtual void endGroup(
+        const Messages::FieldIdentity & identity,
+        Messages::ValueMessageBuilder & groupBuilder);
+
+      ///////////////////
+      // Implement Logger
+      virtual bool wantLog(unsigned short level);
+      virtual bool logMessage(unsigned short level, const std::string & logMessage);
+      virtual bool reportDecodingError(const std::string & errorMessage);
+      virtual bool reportCommunicationError(const std::string & errorMessage);
+
+    private:
+      /// @brief Claim the next slot in the current message, group or sequence.
+      size_t nextSlot();
+      void push(
+        size_t owner,
+        size_t size,
+        const Messages::FieldIdentity * identity,
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace);
+      void pop();
+
+    private:
+      CompactMessageBuilder(const CompactMessageBuilder &);
+      CompactMessageBuilder & operator = (const CompactMessageBuilder &);
+
+    private:
+      /// A run of slots being filled
+      struct Frame
+      {
+        /// The slot that refers to the run.
+        size_t owner_;
+        size_t first_;
+        size_t capacity_;
+        size_t used_;
+        bool topLevel_;
+        /// Names the entries of a sequence.
+        const Messages::FieldIdentity * identity_;
+        const std::string * applicationType_;
+        const std::string * applicationTypeNamespace_;
+      };
+      CompactMessageConsumer & consumer_;
+      Messages::CompactMessage message_;
+      std::vector<Frame> frames_;
+    };
+  }
+}
+#endif // COMPACTMESSAGEBUILDER_H
@@ -0,0 +1,40 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef COMPACTMESSAGECONSUMER_H
+#define COMPACTMESSAGECONSUMER_H
+#include <Common/QuickFAST_Export.h>
+#include <Messages/CompactMessage_fwd.h>
+#include <Common/Logger.h>
+
+namespace QuickFAST{
+  namespace Codecs{
+    /// @brief interface to be implemented by a consumer of messages built by a CompactMessageBuilder.
+    class CompactMessageConsumer : public Common::Logger
+    {
+    public:
+      virtual ~CompactMessageConsumer(){}
+      /// @brief Accept a decoded message
+      ///
+      /// To keep the message, swap() it with a message the consumer owns.
+      /// The builder will reuse whatever storage it gets back.
+      /// @param message is the decoded message, valid for the life of this call.
+      /// @returns true if decoding should continue; false to stop decoding
+      virtual bool consumeMessage(Messages::CompactMessage & message) = 0;
+
+      /// @brief Notify consumer when decoding starts.
+      ///
+      /// This will be called before any call to consumeMessage().
+      virtual void decodingStarted() = 0;
+
+      /// @brief notify consumer that decoding has stopped.
+      ///
+      /// No calls to consumeMessage() will be generated after this call.
+      virtual void decodingStopped() = 0;
+    };
+  }
+}
+#endif /* COMPACTMESSAGECONSUMER_H */
@@ -17,6 +17,7 @@ Context::Context(Codecs::TemplateRegistryCPtr registry)
 , templateRegistry_(registry)
 , templateId_(~0U)
 , strict_(true)
+, validateUtf8_(false)
 , indexedDictionarySize_(registry->dictionarySize())
 //, indexedDictionary_(new Messages::FieldCPtr[indexedDictionarySize_])
 , indexedDictionary_(new Value[indexedDictionarySize_])
@@ -40,6 +41,19 @@ Context::reset(bool resetTemplateId /*= true*/)
   }
 }
 
+void
+Context::setTemplateRegistry(TemplateRegistryCPtr registry)
+{
+  if(!registry)
+  {
+    throw UsageError("Coding Error", "Template registry required.");
+  }
+  IndexedDictionary dictionary(new Value[registry->dictionarySize()]);
+  templateRegistry_ = registry;
+  indexedDictionarySize_ = registry->dictionarySize();
+  indexedDictionary_.swap(dictionary);
+  templateId_ = ~0U;
+}
 
 bool
 Context::findTemplate(const std::string & name, const std::string & nameSpace, TemplateCPtr & result) const
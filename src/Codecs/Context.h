@@ -57,6 +57,22 @@ namespace QuickFAST
         return strict_;
       }
 
+      /// @brief Enable/disable checking that decoded UTF-8 strings are well formed.
+      ///
+      /// A string that is not is reported as [ERR R2].  The default is false.
+      /// @param validate true to check each decoded UTF-8 string.
+      void setValidateUtf8(bool validate)
+      {
+        validateUtf8_ = validate;
+      }
+
+      /// @brief Are decoded UTF-8 strings checked?
+      /// @returns true if they are.
+      bool getValidateUtf8()const
+      {
+        return validateUtf8_;
+      }
+
       /// @brief Reset decoding state to initial conditions
       /// @param resetTemplateId Normally you want to reset the template ID
       ///        however there are cases when you don't.
@@ -81,6 +97,13 @@ namespace QuickFAST
         return templateRegistry_;
       }
 
+      /// @brief Use a different TemplateRegistry.
+      ///
+      /// The dictionaries are sized for the new registry and start out empty,
+      /// just as they would after reset().
+      /// @param registry a finalized registry.
+      void setTemplateRegistry(TemplateRegistryCPtr registry);
+
       /// @brief Find a template in the TemplateRepository used by this Context
       /// @param name of the template being sought
       /// @param nameSpace that qualifies name
@@ -144,6 +167,34 @@ namespace QuickFAST
         indexedDictionary_[index].setValue(value, length);
       }
 
+      /// @brief Replace part of a string value in the dictionary in place
+      ///
+      /// An entry that does not hold a string is treated as an empty string.
+      /// @param index identifies the dictionary entry corresponding to this field
+      /// @param pos is the first byte to replace
+      /// @param count is the number of bytes to replace
+      /// @param value points to the replacement bytes
+      /// @param length is the number of replacement bytes
+      /// @param[out] result points to the updated value in the dictionary
+      /// @param[out] resultLength is the length of the updated value.
+      void replaceDictionaryString(
+        size_t index,
+        size_t pos,
+        size_t count,
+        const unsigned char * value,
+        size_t length,
+        const unsigned char *& result,
+        size_t & resultLength)
+      {
+        if(index >= indexedDictionarySize_)
+        {
+          throw TemplateDefinitionError("Illegal dictionary index.");
+        }
+        Value & entry = indexedDictionary_[index];
+        entry.replaceString(pos, count, value, length);
+        (void)entry.getValue(result, resultLength);
+      }
+
       /// @brief Get a value from the dictionary
       /// @param index identifies the dictionary entry corresponding to this field
       /// @param value receives the stored value
@@ -351,6 +402,8 @@ namespace QuickFAST
 
       /// false makes the Xcoder more forgiving
       bool strict_;
+      /// true checks UTF-8 strings as they are decoded
+      bool validateUtf8_;
     private:
       size_t indexedDictionarySize_;
       typedef boost::scoped_array<Value> IndexedDictionary;
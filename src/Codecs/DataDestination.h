@@ -109,6 +109,45 @@ namespace QuickFAST{
         return active_;
       }
 
+      /// @brief Set aside space in the current buffer to be filled in later.
+      ///
+      /// This lets an encoder write a presence map in front of the fields it
+      /// describes without using a separate buffer.
+      /// @param count is the most bytes that are expected to be needed.
+      /// @returns the offset of the reserved space to be passed to fillReserved().
+      size_t reserve(size_t count)
+      {
+        BufferHandle handle = getBuffer();
+        size_t offset = buffers_[handle].size();
+        for(size_t pos = 0; pos < count; ++pos)
+        {
+          buffers_[handle].push(0);
+        }
+        return offset;
+      }
+
+      /// @brief Fill in space set aside by reserve() in the current buffer.
+      ///
+      /// Reserved bytes that are not needed are removed by moving the bytes that
+      /// follow them.  If more bytes are needed than were reserved room is made for them.
+      /// @param offset is the value returned by reserve().
+      /// @param count is the number of bytes that were reserved.
+      /// @param data points to the bytes to be written.
+      /// @param size is the number of bytes to be written.
+      void fillReserved(size_t offset, size_t count, const uchar * data, size_t size)
+      {
+        buffers_[getBuffer()].replace(offset, count, data, size);
+        if(verboseOut_)
+        {
+          (*verboseOut_) << std::endl << "**FILL[" << offset << ':' << size << '/' << count << ']' << std::hex << std::setfill('0');
+          for(size_t pos = 0; pos < size; ++pos)
+          {
+            (*verboseOut_) << ' ' << std::setw(2) << static_cast<unsigned short>(data[pos]);
+          }
+          (*verboseOut_) << std::setfill(' ') << std::dec << std::endl;
+        }
+      }
+
       /// @brief Set the target for subsequent bytes
       /// @param handle is the handle as returned by startBuffer() or getBuffer()
       void selectBuffer(BufferHandle handle)
@@ -116,6 +155,16 @@ namespace QuickFAST{
         active_ = handle;
       }
 
+      /// @brief Exchange the storage of a buffer with an external WorkingBuffer.
+      ///
+      /// This lets encoded data be handed off without being copied.
+      /// @param handle identifies the buffer as returned by startBuffer() or getBuffer()
+      /// @param buffer receives the contents of the buffer and supplies its replacement.
+      void swapBuffer(BufferHandle handle, WorkingBuffer & buffer)
+      {
+        buffers_[handle].swap(buffer);
+      }
+
       /// @brief Discard all buffered data.  Ready to start a new encoding cycle.
       void clear()
       {
@@ -11,6 +11,7 @@ DataSource::DataSource()
 : buffer_(0)
 , size_(0)
 , position_(0)
+, consumed_(0)
 , echo_(0)
 , raw_(false)
 , hex_(true)
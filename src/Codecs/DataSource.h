@@ -65,6 +65,16 @@ namespace QuickFAST{
           return size_ - position_;
       }
 
+      /// @brief How many bytes have been consumed from this source?
+      ///
+      /// Counts every byte delivered by getByte() or skipped by skipContiguous()
+      /// across all buffers, whether or not echo is enabled.
+      /// @returns the number of bytes consumed.
+      size_t bytesConsumed() const
+      {
+        return consumed_ + position_;
+      }
+
       /// @brief Check for contiguous bytes in current buffer
       /// @param needed is the number of contiguous bytes needed
       /// @param[out] buffer points to beginning of contiguous area if return is true
@@ -116,6 +126,7 @@ namespace QuickFAST{
         }
         else if(getBuffer(buffer_, size_))
         {
+          consumed_ += position_;
           position_ = 0;
           byte = buffer_[position_++];
         }
@@ -177,6 +188,7 @@ namespace QuickFAST{
       /// @brief Discard any remaining contents and prepare for new data.
       void reset()
       {
+        consumed_ += position_;
         size_ = 0;
         position_ = 0;
         buffer_ = 0;
@@ -203,6 +215,8 @@ namespace QuickFAST{
       size_t size_;
       /// position within current buffer
       size_t position_;
+      /// bytes consumed from buffers before the current one
+      size_t consumed_;
     protected:
       /// Where echo output gets written
       std::ostream * echo_;
@@ -8,6 +8,8 @@
 #include <Codecs/PresenceMap.h>
 #include <Codecs/TemplateRegistry.h>
 #include <Codecs/FieldInstruction.h>
+#include <Codecs/FieldInstructionDecimal.h>
+#include <Codecs/FieldOp.h>
 #include <Messages/ValueMessageBuilder.h>
 #include <Common/Profiler.h>
 
@@ -16,9 +18,167 @@ using namespace ::QuickFAST::Codecs;
 
 Decoder::Decoder(Codecs::TemplateRegistryPtr registry)
 : Context(registry)
+, selection_(0)
+, swap_(SWAP_AT_MESSAGE)
+, generation_(0)
 {
 }
 
+void
+Decoder::followRegistry(TemplateRegistryPublisherPtr publisher, RegistrySwap when)
+{
+  publisher_ = publisher;
+  swap_ = when;
+  if(publisher_)
+  {
+    generation_ = publisher_->generation() - 1;
+    (void)adoptPublishedRegistry();
+  }
+}
+
+bool
+Decoder::adoptPublishedRegistry()
+{
+  if(!publisher_)
+  {
+    return false;
+  }
+  long generation;
+  TemplateRegistryPtr registry = publisher_->current(generation);
+  if(generation == generation_)
+  {
+    return false;
+  }
+  generation_ = generation;
+  if(registry == getTemplateRegistry())
+  {
+    return false;
+  }
+  setTemplateRegistry(registry);
+  if(fieldFilter_)
+  {
+    // Other decoders may share the filter, so build a new index rather than change it.
+    finalizedFilter_ = fieldFilter_->finalize(*registry);
+  }
+  selection_ = 0;
+  DictionaryOnlyMap suppressed;
+  suppressed.swap(dictionaryOnly_);
+  for(DictionaryOnlyMap::const_iterator it = suppressed.begin(); it != suppressed.end(); ++it)
+  {
+    setDictionaryOnly(it->first);
+  }
+  return true;
+}
+
+void
+Decoder::resetDecoder(bool resetTemplateId)
+{
+  if(publisher_ && publisher_->generation() != generation_)
+  {
+    template_id_t templateId = templateId_;
+    if(adoptPublishedRegistry())
+    {
+      // the new registry starts with empty dictionaries.
+      if(!resetTemplateId)
+      {
+        templateId_ = templateId;
+      }
+      return;
+    }
+  }
+  Context::reset(resetTemplateId);
+}
+
+void
+Decoder::setFieldFilter(FieldFilterPtr filter)
+{
+  finalizedFilter_.reset();
+  if(filter)
+  {
+    registryIsRequired();
+    finalizedFilter_ = filter->finalize(*getTemplateRegistry());
+  }
+  fieldFilter_ = filter;
+  selection_ = 0;
+}
+
+namespace
+{
+  /// True if decoding this field can change a dictionary entry.
+  bool usesDictionary(const FieldInstruction & instruction)
+  {
+    if(instruction.getFieldOp()->usesDictionary())
+    {
+      return true;
+    }
+    // A split decimal keeps its operators on the exponent and mantissa.
+    const FieldInstructionDecimal * decimal = dynamic_cast<const FieldInstructionDecimal *>(&instruction);
+    if(decimal != 0)
+    {
+      FieldInstructionCPtr part;
+      if(decimal->getExponentInstruction(part) && part->getFieldOp()->usesDictionary())
+      {
+        return true;
+      }
+      if(decimal->getMantissaInstruction(part) && part->getFieldOp()->usesDictionary())
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// True if decoding this segment can change a dictionary entry.
+  bool hasDictionarySideEffects(const SegmentBody & segment)
+  {
+    FieldInstructionCPtr length;
+    if(segment.getLengthInstruction(length) && length->getFieldOp()->usesDictionary())
+    {
+      return true;
+    }
+    for(size_t nField = 0; nField < segment.size(); ++nField)
+    {
+      const FieldInstructionCPtr & instruction = segment.getInstruction(nField);
+      SegmentBodyPtr body;
+      if(instruction->fieldInstructionType() == ValueType::TEMPLATEREF)
+      {
+        // the target may not be known until the message is decoded
+        return true;
+      }
+      else if(instruction->getSegmentBody(body))
+      {
+        if(hasDictionarySideEffects(*body))
+        {
+          return true;
+        }
+      }
+      else if(usesDictionary(*instruction))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+}
+
+void
+Decoder::setDictionaryOnly(template_id_t templateId, bool dictionaryOnly)
+{
+  if(!dictionaryOnly)
+  {
+    dictionaryOnly_.erase(templateId);
+    return;
+  }
+  registryIsRequired();
+  bool skippable = false;
+  Codecs::TemplateCPtr templatePtr;
+  if(getTemplateRegistry()->getTemplate(templateId, templatePtr))
+  {
+    skippable = !hasDictionarySideEffects(*templatePtr);
+  }
+  dictionaryOnly_[templateId] = skippable;
+}
+
 //Decoder::Decoder()
 //{
 //}
@@ -28,10 +188,27 @@ void
 Decoder::decodeMessage(
    DataSource & source,
    Messages::ValueMessageBuilder & messageBuilder)
+{
+  decodeMessage(source, messageBuilder, 0);
+}
+
+void
+Decoder::decodeMessage(
+   DataSource & source,
+   Messages::ValueMessageBuilder & messageBuilder,
+   size_t messageSize)
 {
   PROFILE_POINT("decode");
+  checkPublishedRegistry();
   source.beginMessage();
 
+  // Skipping by size is only possible if the whole message is in the current buffer.
+  const uchar * messageStart = 0;
+  if(messageSize > 0 && !source.hasContiguous(messageSize, messageStart))
+  {
+    messageStart = 0;
+  }
+
   Codecs::PresenceMap pmap(getTemplateRegistry()->presenceMapBits());
   if(this->verboseOut_)
   {
@@ -59,7 +236,33 @@ Decoder::decodeMessage(
   {
     if(templatePtr->getReset())
     {
-      reset(false);
+      // the templates must not change in the middle of a message.
+      Context::reset(false);
+    }
+    if(!dictionaryOnly_.empty())
+    {
+      DictionaryOnlyMap::const_iterator suppressed = dictionaryOnly_.find(templateId_);
+      if(suppressed != dictionaryOnly_.end())
+      {
+        const uchar * position = 0;
+        (void)source.hasContiguous(0, position);
+        if(suppressed->second && messageStart != 0 && position >= messageStart
+          && size_t(position - messageStart) <= messageSize)
+        {
+          source.skipContiguous(messageSize - (position - messageStart));
+        }
+        else
+        {
+          selection_ = 0;
+          decodeSegmentBody(source, pmap, templatePtr, discardBuilder_);
+        }
+        return;
+      }
+    }
+    selection_ = 0;
+    if(finalizedFilter_)
+    {
+      selection_ = finalizedFilter_->getSelection(templateId_);
     }
     Messages::ValueMessageBuilder & bodyBuilder(
       messageBuilder.startMessage(
@@ -79,7 +282,7 @@ Decoder::decodeMessage(
   }
   else if(templateId_ == SCPResetTemplateId)
   {
-    reset(false);
+    resetDecoder(false);
   }
   else
   {
@@ -123,7 +326,8 @@ Decoder::decodeNestedTemplate(
   {
     if(templatePtr->getReset())
     {
-      reset(false);
+      // the templates must not change in the middle of a message.
+      Context::reset(false);
     }
     Messages::ValueMessageBuilder & groupBuilder(
       messageBuilder.startGroup(
@@ -174,6 +378,11 @@ Decoder::decodeSegmentBody(
   const Codecs::SegmentBodyCPtr & segment,
   Messages::ValueMessageBuilder & messageBuilder)
 {
+  const FieldFilter::Disposition * dispositions = 0;
+  if(selection_ != 0)
+  {
+    dispositions = selection_->dispositions(*segment);
+  }
   size_t instructionCount = segment->size();
   for( size_t nField = 0; nField < instructionCount; ++nField)
   {
@@ -184,6 +393,43 @@ Decoder::decodeSegmentBody(
       (*verboseOut_) <<std::endl << "Decode instruction[" <<nField << "]: " << instruction->getIdentity().name() << std::endl;
     }
     source.beginField(instruction->getIdentity().name());
-    (void)instruction->decode(source, pmap, *this, messageBuilder);
+    if(dispositions == 0)
+    {
+      (void)instruction->decode(source, pmap, *this, messageBuilder);
+    }
+    else
+    {
+      decodeFilteredField(source, pmap, *instruction, dispositions[nField], messageBuilder);
+    }
+  }
+}
+
+void
+Decoder::decodeFilteredField(
+  DataSource & source,
+  PresenceMap & pmap,
+  const FieldInstruction & instruction,
+  FieldFilter::Disposition disposition,
+  Messages::ValueMessageBuilder & messageBuilder)
+{
+  const FieldFilter::Selection * selection = selection_;
+  switch(disposition)
+  {
+  case FieldFilter::DELIVER:
+    // everything nested within a selected field is delivered
+    selection_ = 0;
+    instruction.decode(source, pmap, *this, messageBuilder);
+    break;
+  case FieldFilter::SELECTIVE:
+    instruction.decode(source, pmap, *this, messageBuilder);
+    break;
+  case FieldFilter::DISCARD:
+    selection_ = 0;
+    instruction.decode(source, pmap, *this, discardBuilder_);
+    break;
+  case FieldFilter::SKIP:
+    instruction.skipNop(source, pmap, *this);
+    break;
   }
+  selection_ = selection;
 }
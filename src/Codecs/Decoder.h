@@ -13,7 +13,11 @@
 #include <Codecs/PresenceMap_fwd.h>
 #include <Codecs/Template.h>
 #include <Codecs/SegmentBody_fwd.h>
+#include <Codecs/FieldFilter.h>
+#include <Codecs/TemplateRegistryPublisher.h>
 #include <Messages/ValueMessageBuilder_fwd.h>
+#include <Messages/DiscardMessageBuilder.h>
+#include <Messages/SequenceColumns.h>
 
 #include <Common/Exceptions.h>
 
@@ -27,10 +31,76 @@ namespace QuickFAST{
     class QuickFAST_Export Decoder : public Context
     {
     public:
+      /// @brief When templates published to a followed TemplateRegistryPublisher are used.
+      enum RegistrySwap
+      {
+        /// Before the next message is decoded.
+        SWAP_AT_MESSAGE,
+        /// Only when the decoder is reset by resetDecoder() or by an SCP reset message.
+        SWAP_ON_RESET
+      };
+
       /// @brief Construct with a TemplateRegistry containing all templates to be used.
       /// @param registry A registry containing all templates to be used to decode messages.
       explicit Decoder(TemplateRegistryPtr registry);
 
+      /// @brief Pick up new templates while decoding continues.
+      ///
+      /// The registry currently published is adopted immediately.  After that
+      /// each newly published registry is adopted between messages, so a message
+      /// is always decoded with a single set of templates.  Adopting a registry
+      /// resets the dictionaries because dictionary entries belong to the
+      /// templates that defined them.  Use SWAP_ON_RESET if the sender is expected
+      /// to reset its encoder when it changes templates.
+      ///
+      /// The field filter and dictionary-only templates are carried over to the
+      /// new registry.
+      /// @param publisher supplies the registries.  An empty pointer stops following.
+      /// @param when the new templates should be used.
+      void followRegistry(
+        TemplateRegistryPublisherPtr publisher,
+        RegistrySwap when = SWAP_AT_MESSAGE);
+
+      /// @brief Adopt the published registry now if it has changed.
+      ///
+      /// Do not call this while a message is being decoded.
+      /// @returns true if the templates changed.
+      bool adoptPublishedRegistry();
+
+      /// @brief Reset decoding state to initial conditions
+      ///
+      /// A registry published since the last one was adopted is adopted now.
+      /// Context::reset() resets the dictionaries without looking for new templates.
+      /// @param resetTemplateId Normally you want to reset the template ID
+      ///        however there are cases when you don't.
+      void resetDecoder(bool resetTemplateId = true);
+
+      /// @brief Deliver only selected fields to the message builder.
+      ///
+      /// Unselected fields are decoded only as far as needed to maintain the
+      /// dictionaries and presence map.  The decoder uses a copy of the filter
+      /// finalized against its template registry, so the filter may be shared.
+      /// Fields selected after this call are not seen until it is called again.
+      /// @param filter selects the fields to be delivered.  An empty pointer delivers all fields.
+      void setFieldFilter(FieldFilterPtr filter);
+
+      /// @brief Decode messages from a template only to keep the dictionaries current.
+      ///
+      /// No calls are made to the message builder for these messages.  If the
+      /// template has no dictionary side effects and the size of the message is
+      /// passed to decodeMessage(), the message is skipped without being decoded.
+      /// @param templateId identifies the template.
+      /// @param dictionaryOnly true to suppress the messages; false to deliver them again.
+      void setDictionaryOnly(template_id_t templateId, bool dictionaryOnly = true);
+
+      /// @brief Are messages from this template decoded only to update the dictionaries?
+      /// @param templateId identifies the template.
+      /// @returns true if setDictionaryOnly() has suppressed the template.
+      bool isDictionaryOnly(template_id_t templateId) const
+      {
+        return dictionaryOnly_.find(templateId) != dictionaryOnly_.end();
+      }
+
       /// @brief Decode the next message.
       /// @param[in] source where to read the incoming message(s).
       /// @param[out] message an empty message into which the decoded fields will be stored.
@@ -38,6 +108,18 @@ namespace QuickFAST{
         DataSource & source,
         Messages::ValueMessageBuilder & message);
 
+      /// @brief Decode the next message when its size is known.
+      ///
+      /// The size normally comes from a block size in the message header.
+      /// It lets messages from dictionary-only templates be skipped.
+      /// @param[in] source where to read the incoming message(s).
+      /// @param[out] message an empty message into which the decoded fields will be stored.
+      /// @param[in] messageSize the number of bytes in the message. Zero means unknown.
+      void decodeMessage(
+        DataSource & source,
+        Messages::ValueMessageBuilder & message,
+        size_t messageSize);
+
       /// @brief Decode a group field.
       ///
       /// If the application type of the group matches the application type of the
@@ -77,6 +159,48 @@ namespace QuickFAST{
         PresenceMap & pmap,
         const SegmentBodyCPtr & segment,
         Messages::ValueMessageBuilder & messageBuilder);
+
+      /// @brief Storage for sequences delivered in columnar form.
+      ///
+      /// Used by FieldInstructionSequence.  Reused for every sequence.
+      /// @see Messages::ValueMessageBuilder::wantSequenceColumns()
+      Messages::SequenceColumns & sequenceColumns()
+      {
+        return sequenceColumns_;
+      }
+
+    private:
+      void checkPublishedRegistry()
+      {
+        if(publisher_ && swap_ == SWAP_AT_MESSAGE && publisher_->generation() != generation_)
+        {
+          (void)adoptPublishedRegistry();
+        }
+      }
+
+      void decodeFilteredField(
+        DataSource & source,
+        PresenceMap & pmap,
+        const FieldInstruction & instruction,
+        FieldFilter::Disposition disposition,
+        Messages::ValueMessageBuilder & messageBuilder);
+
+    private:
+      /// Template IDs that are decoded only for their dictionary side effects.
+      /// The value is true if the message may be skipped entirely.
+      typedef std::map<template_id_t, bool> DictionaryOnlyMap;
+      DictionaryOnlyMap dictionaryOnly_;
+      FieldFilterPtr fieldFilter_;
+      /// fieldFilter_ indexed for the current registry.  Never shared with other decoders.
+      FieldFilterCPtr finalizedFilter_;
+      /// Fields selected from the current message. Zero means deliver everything.
+      const FieldFilter::Selection * selection_;
+      Messages::DiscardMessageBuilder discardBuilder_;
+      Messages::SequenceColumns sequenceColumns_;
+      TemplateRegistryPublisherPtr publisher_;
+      RegistrySwap swap_;
+      /// The generation of the published registry in use.
+      long generation_;
     };
   }
 }
@@ -15,6 +15,7 @@ using namespace ::QuickFAST::Codecs;
 
 Encoder::Encoder(Codecs::TemplateRegistryPtr registry)
 : Context(registry)
+, singlePass_(false)
 {
 }
 
@@ -57,8 +58,19 @@ Encoder::encodeSegment(
 
     Codecs::PresenceMap pmap(templatePtr->presenceMapBitCount());
 
-    DataDestination::BufferHandle header = destination.startBuffer();
-    destination.startBuffer();
+    // the presence map bit count includes the template ID.
+    size_t pmapReserved = (templatePtr->presenceMapBitCount() + 6) / 7;
+    size_t pmapOffset = 0;
+    DataDestination::BufferHandle header = DataDestination::NotABuffer;
+    if(singlePass_)
+    {
+      pmapOffset = destination.reserve(pmapReserved);
+    }
+    else
+    {
+      header = destination.startBuffer();
+      destination.startBuffer();
+    }
     // can we "copy" the template ID?
     if(templateId == templateId_)
     {
@@ -72,13 +84,20 @@ Encoder::encodeSegment(
     }
 
     encodeSegmentBody(destination, pmap, templatePtr, accessor);
-    DataDestination::BufferHandle savedBuffer = destination.getBuffer();
-    destination.selectBuffer(header);
     static Messages::FieldIdentity pmapIdentity("PMAP", "Message");
-    destination.startField(pmapIdentity);
-    pmap.encode(destination);
-    destination.endField(pmapIdentity);
-    destination.selectBuffer(savedBuffer);
+    if(singlePass_)
+    {
+      fillPresenceMap(destination, pmap, pmapOffset, pmapReserved, pmapIdentity);
+    }
+    else
+    {
+      DataDestination::BufferHandle savedBuffer = destination.getBuffer();
+      destination.selectBuffer(header);
+      destination.startField(pmapIdentity);
+      pmap.encode(destination);
+      destination.endField(pmapIdentity);
+      destination.selectBuffer(savedBuffer);
+    }
   }
   else
   {
@@ -96,6 +115,19 @@ Encoder::encodeGroup(
   Codecs::PresenceMap pmap(presenceMapBits);
   pmap.setVerbose(this->verboseOut_);
 
+  static Messages::FieldIdentity pmapIdentity("PMAP", "Group");
+  if(singlePass_)
+  {
+    size_t pmapReserved = (presenceMapBits + 6) / 7;
+    size_t pmapOffset = destination.reserve(pmapReserved);
+    encodeSegmentBody(destination, pmap, group, accessor);
+    if(presenceMapBits > 0)
+    {
+      fillPresenceMap(destination, pmap, pmapOffset, pmapReserved, pmapIdentity);
+    }
+    return;
+  }
+
   // The presence map for the group will go into the current buffer
   // that will be the last thing to appear in that buffer
   DataDestination::BufferHandle pmapBuffer = destination.getBuffer();
@@ -110,7 +142,6 @@ Encoder::encodeGroup(
   if(presenceMapBits > 0)
   {
     destination.selectBuffer(pmapBuffer);
-    static Messages::FieldIdentity pmapIdentity("PMAP", "Group");
     destination.startField(pmapIdentity);
     pmap.encode(destination);
     destination.endField(pmapIdentity);
@@ -119,6 +150,21 @@ Encoder::encodeGroup(
   destination.selectBuffer(bodyBuffer);
 }
 
+void
+Encoder::fillPresenceMap(
+  DataDestination & destination,
+  Codecs::PresenceMap & pmap,
+  size_t offset,
+  size_t reserved,
+  const Messages::FieldIdentity & identity)
+{
+  const uchar * bytes = 0;
+  size_t size = 0;
+  pmap.getEncoded(bytes, size);
+  destination.startField(identity);
+  destination.fillReserved(offset, reserved, bytes, size);
+  destination.endField(identity);
+}
 
 void
 Encoder::encodeSegmentBody(
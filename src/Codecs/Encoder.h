@@ -31,6 +31,26 @@ namespace QuickFAST{
       /// @param registry A registry containing all templates to be used to encode messages.
       Encoder(Codecs::TemplateRegistryPtr registry);
 
+      /// @brief Encode each message into a single contiguous buffer.
+      ///
+      /// By default presence maps are written into separate buffers in the
+      /// DataDestination which are spliced together when the data is retrieved.
+      /// In single pass mode the worst case presence map space is reserved in
+      /// line, then filled in and compacted once the fields have been encoded,
+      /// so all messages end up in one buffer with no intermediate copies.
+      /// @param singlePass true to enable single pass encoding.
+      void setSinglePass(bool singlePass)
+      {
+        singlePass_ = singlePass;
+      }
+
+      /// @brief Is single pass encoding enabled?
+      /// @returns true if presence maps are written in line.
+      bool getSinglePass()const
+      {
+        return singlePass_;
+      }
+
       /// @brief Encode messages until the accessor is satisfied.
       ///
       /// MessageAccessor::pickTemplate() will be called to select a template.
@@ -86,6 +106,16 @@ namespace QuickFAST{
         const Codecs::SegmentBodyCPtr & segment,
         const Messages::MessageAccessor & accessor);
     private:
+      /// @brief Write the presence map into space reserved ahead of the fields.
+      void fillPresenceMap(
+        DataDestination & destination,
+        Codecs::PresenceMap & pmap,
+        size_t offset,
+        size_t reserved,
+        const Messages::FieldIdentity & identity);
+
+    private:
+      bool singlePass_;
     };
   }
 }
@@ -0,0 +1,119 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "FieldFilter.h"
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Template.h>
+#include <Codecs/SegmentBody.h>
+#include <Codecs/FieldInstruction.h>
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Codecs;
+
+bool
+FieldFilter::Selection::isSelected(const FieldInstruction & instruction) const
+{
+  const Messages::FieldIdentity & identity = instruction.getIdentity();
+  if(names_.find(identity.getLocalName()) != names_.end()
+    || names_.find(identity.name()) != names_.end())
+  {
+    return true;
+  }
+  return !identity.id().empty() && ids_.find(identity.id()) != ids_.end();
+}
+
+FieldFilter::FieldFilter()
+{
+}
+
+FieldFilter::~FieldFilter()
+{
+}
+
+void
+FieldFilter::selectField(template_id_t templateId, const std::string & name)
+{
+  selections_[templateId].names_.insert(name);
+}
+
+void
+FieldFilter::selectFieldId(template_id_t templateId, const field_id_t & id)
+{
+  selections_[templateId].ids_.insert(id);
+}
+
+FieldFilterCPtr
+FieldFilter::finalize(const TemplateRegistry & registry) const
+{
+  FieldFilterPtr result(new FieldFilter(*this));
+  for(SelectionMap::iterator sit = result->selections_.begin();
+    sit != result->selections_.end();
+    ++sit)
+  {
+    Selection & selection = sit->second;
+    selection.segments_.clear();
+    // Index every template, not just the selected one, so segments
+    // reached through a templateRef are filtered too.
+    for(TemplateRegistry::const_iterator tit = registry.begin();
+      tit != registry.end();
+      ++tit)
+    {
+      (void)result->indexSegment(selection, *tit->second);
+    }
+  }
+  return result;
+}
+
+bool
+FieldFilter::indexSegment(Selection & selection, const SegmentBody & segment)
+{
+  Selection::SegmentMap::const_iterator found = selection.segments_.find(&segment);
+  if(found != selection.segments_.end())
+  {
+    const Selection::Dispositions & known = found->second;
+    for(size_t pos = 0; pos < known.size(); ++pos)
+    {
+      if(known[pos] == DELIVER || known[pos] == SELECTIVE)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool anySelected = false;
+  size_t count = segment.size();
+  Selection::Dispositions dispositions(count, DISCARD);
+  for(size_t pos = 0; pos < count; ++pos)
+  {
+    const FieldInstructionCPtr & instruction = segment.getInstruction(pos);
+    SegmentBodyPtr body;
+    if(selection.isSelected(*instruction))
+    {
+      dispositions[pos] = DELIVER;
+      anySelected = true;
+    }
+    else if(instruction->getSegmentBody(body))
+    {
+      if(indexSegment(selection, *body))
+      {
+        dispositions[pos] = SELECTIVE;
+        anySelected = true;
+      }
+    }
+    else if(instruction->fieldInstructionType() == ValueType::TEMPLATEREF)
+    {
+      // The target template is indexed separately.  Its fields
+      // will be filtered when it is decoded.
+      dispositions[pos] = SELECTIVE;
+      anySelected = true;
+    }
+    else if(instruction->getFieldOp()->opType() == FieldOp::NOP)
+    {
+      dispositions[pos] = SKIP;
+    }
+  }
+  selection.segments_[&segment].swap(dispositions);
+  return anySelected;
+}
@@ -0,0 +1,139 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef FIELDFILTER_H
+#define FIELDFILTER_H
+#include "FieldFilter_fwd.h"
+#include <Common/QuickFAST_Export.h>
+#include <Common/Types.h>
+#include <Codecs/TemplateRegistry_fwd.h>
+#include <Codecs/SegmentBody_fwd.h>
+#include <Codecs/FieldInstruction_fwd.h>
+#include <set>
+
+namespace QuickFAST{
+  namespace Codecs{
+    /// @brief Select the fields the application wants delivered from each template.
+    ///
+    /// Fields are selected per template ID by name or by id.  Messages decoded from
+    /// a template that has no selection are delivered in full.
+    ///
+    /// Fields that are not selected are still decoded as far as necessary to keep the
+    /// presence map and the dictionaries in step with the encoder, but they are never
+    /// passed to the ValueMessageBuilder.  Unselected fields with no field operator
+    /// are stepped over in the input without being copied at all.
+    ///
+    /// Selecting a group or sequence delivers all of its contents.  Selecting a field
+    /// inside a group or sequence delivers the group or sequence containing just the
+    /// selected fields.
+    ///
+    /// Use Decoder::setFieldFilter() to apply a filter.  The decoder works from a
+    /// finalized copy, so one filter may be shared by decoders using different
+    /// template registries.
+    class QuickFAST_Export FieldFilter
+    {
+    public:
+      /// @brief How the decoder should treat a field instruction
+      enum Disposition
+      {
+        /// Deliver the field and everything in it.
+        DELIVER,
+        /// Deliver the group or sequence, but filter its contents.
+        SELECTIVE,
+        /// Decode the field to update the dictionary, but do not deliver it.
+        DISCARD,
+        /// Step over the field in the input. It has no dictionary or presence map side effects.
+        SKIP
+      };
+
+      /// @brief The fields selected from one template.
+      class QuickFAST_Export Selection
+      {
+      public:
+        /// @brief Is this field instruction explicitly selected by name or id?
+        /// @param instruction the field instruction to check.
+        /// @returns true if the field is selected.
+        bool isSelected(const FieldInstruction & instruction) const;
+
+        /// @brief Find the disposition of each instruction in a segment.
+        /// @param segment the segment body being decoded
+        /// @returns an array parallel to the segment's instructions or zero
+        ///          meaning everything in the segment should be delivered.
+        const Disposition * dispositions(const SegmentBody & segment) const
+        {
+          SegmentMap::const_iterator it = segments_.find(&segment);
+          if(it == segments_.end() || it->second.empty())
+          {
+            return 0;
+          }
+          return &it->second[0];
+        }
+
+      private:
+        friend class FieldFilter;
+        typedef std::vector<Disposition> Dispositions;
+        typedef std::map<const SegmentBody *, Dispositions> SegmentMap;
+        std::set<std::string> names_;
+        std::set<field_id_t> ids_;
+        SegmentMap segments_;
+      };
+
+    public:
+      /// @brief Construct an empty filter.  All fields will be delivered.
+      FieldFilter();
+
+      /// @brief a typical destructor.
+      ~FieldFilter();
+
+      /// @brief Deliver the named field from messages using this template.
+      /// @param templateId identifies the template.
+      /// @param name is the name of the field (localname or namespace qualified name).
+      void selectField(template_id_t templateId, const std::string & name);
+
+      /// @brief Deliver the field with this id from messages using this template.
+      /// @param templateId identifies the template.
+      /// @param id is the id= attribute of the field.
+      void selectFieldId(template_id_t templateId, const field_id_t & id);
+
+      /// @brief Does this filter restrict the fields for a template?
+      /// @param templateId identifies the template.
+      /// @returns true if fields have been selected for the template.
+      bool hasSelection(template_id_t templateId) const
+      {
+        return selections_.find(templateId) != selections_.end();
+      }
+
+      /// @brief Find the selection to use for a template.
+      /// @param templateId identifies the template
+      /// @returns the selection, or zero if all fields should be delivered.
+      const Selection * getSelection(template_id_t templateId) const
+      {
+        SelectionMap::const_iterator it = selections_.find(templateId);
+        if(it == selections_.end())
+        {
+          return 0;
+        }
+        return &it->second;
+      }
+
+      /// @brief Resolve the selected names and ids against the templates.
+      ///
+      /// Called by Decoder::setFieldFilter() and when a decoder adopts new templates.
+      /// This filter is not changed.  Fields selected afterward are not seen by the copy.
+      /// @param registry contains the templates that will be used to decode.
+      /// @returns a copy of this filter indexed for the registry.  It is never modified.
+      FieldFilterCPtr finalize(const TemplateRegistry & registry) const;
+
+    private:
+      bool indexSegment(Selection & selection, const SegmentBody & segment);
+
+    private:
+      typedef std::map<template_id_t, Selection> SelectionMap;
+      SelectionMap selections_;
+    };
+  }
+}
+#endif // FIELDFILTER_H
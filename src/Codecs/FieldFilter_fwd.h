@@ -0,0 +1,22 @@
+// Copyright (c) 2009, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef FIELDFILTER_FWD_H
+#define FIELDFILTER_FWD_H
+#ifndef QUICKFAST_HEADERS
+#error Please include <Application/QuickFAST.h> preferably as a precompiled header file.
+#endif //QUICKFAST_HEADERS
+
+namespace QuickFAST{
+  namespace Codecs{
+    class FieldFilter;
+    /// @brief A smart pointer to a FieldFilter.
+    typedef boost::shared_ptr<FieldFilter> FieldFilterPtr;
+    /// @brief A smart pointer to a const FieldFilter.
+    typedef boost::shared_ptr<const FieldFilter> FieldFilterCPtr;
+  }
+}
+#endif // FIELDFILTER_FWD_H
@@ -8,6 +8,8 @@
 #include <Codecs/FieldOpNop.h>
 #include <Codecs/Decoder.h>
 #include <Codecs/Encoder.h>
+#include <Messages/DiscardMessageBuilder.h>
+#include <Common/ByteScan.h>
 
 using namespace ::QuickFAST;
 using namespace ::QuickFAST::Codecs;
@@ -174,6 +176,16 @@ FieldInstruction::decodeTail(
   decoder.reportFatal("[ERR S2]", "Tail Field Operator not supported for this data type.", identity_);
 }
 
+void
+FieldInstruction::skipNop(
+  Codecs::DataSource & source,
+  Codecs::PresenceMap & pmap,
+  Codecs::Decoder & decoder) const
+{
+  Messages::DiscardMessageBuilder discard;
+  decodeNop(source, pmap, decoder, discard);
+}
+
 void
 FieldInstruction::encodeConstant(
   Codecs::DataDestination & /*destination*/,
@@ -242,22 +254,42 @@ FieldInstruction::decodeAscii(
   WorkingBuffer & workingBuffer)
 {
   workingBuffer.clear(false);
-  uchar byte = 0;
-  if(!source.getByte(byte))
-  {
-    return false;
-  }
-  while((byte & stopBit) == 0)
+  for(;;)
   {
-    workingBuffer.push(byte);
-    if(!source.getByte(byte))
+    // Scan whatever the source has on hand for the byte with the stop bit.
+    const uchar * data = 0;
+    (void)source.hasContiguous(0, data);
+    size_t available = source.currentBytesAvailable();
+    if(available == 0)
+    {
+      // Let the source find more data.
+      uchar byte = 0;
+      if(!source.getByte(byte))
+      {
+        // todo: exception?
+        return false;
+      }
+      if((byte & stopBit) != 0)
+      {
+        workingBuffer.push(byte & dataBits);
+        return true;
+      }
+      workingBuffer.push(byte);
+    }
+    else
     {
-      // todo: exception?
-      return false;
+      size_t length = ByteScan::findStopBit(data, available);
+      if(length < available)
+      {
+        workingBuffer.append(data, length);
+        workingBuffer.push(data[length] & dataBits);
+        source.skipContiguous(length + 1);
+        return true;
+      }
+      workingBuffer.append(data, available);
+      source.skipContiguous(available);
     }
   }
-  workingBuffer.push(byte & dataBits);
-  return true;
 }
 
 bool
@@ -298,6 +330,13 @@ FieldInstruction::decodeByteVector(
   size_t length)
 {
   buffer.clear(false, length);
+  const uchar * data = 0;
+  if(source.hasContiguous(length, data))
+  {
+    buffer.append(data, length);
+    source.skipContiguous(length);
+    return;
+  }
   for(size_t pos = 0;
     pos < length;
     ++pos)
@@ -707,17 +746,29 @@ FieldInstruction::encodeUnsignedInteger(DataDestination & destination, WorkingBu
 void
 FieldInstruction::encodeNullableAscii(DataDestination & destination, const StringBuffer & value)
 {
-  if(value.empty() || value[0] == '\0')
+  encodeNullableAscii(destination, value.data(), value.size());
+}
+
+void
+FieldInstruction::encodeAscii(DataDestination & destination, const StringBuffer & value)
+{
+  encodeAscii(destination, value.data(), value.size());
+}
+
+void
+FieldInstruction::encodeNullableAscii(DataDestination & destination, const uchar * value, size_t length)
+{
+  if(length == 0 || value[0] == '\0')
   {
     destination.putByte(nullableStringPreamble);
   }
-  encodeAscii(destination, value);
+  encodeAscii(destination, value, length);
 }
 
 void
-FieldInstruction::encodeAscii(DataDestination & destination, const StringBuffer & value)
+FieldInstruction::encodeAscii(DataDestination & destination, const uchar * value, size_t length)
 {
-  if(value.empty())
+  if(length == 0)
   {
     destination.putByte(emptyString);
   }
@@ -727,11 +778,11 @@ FieldInstruction::encodeAscii(DataDestination & destination, const StringBuffer
     {
       destination.putByte(leadingZeroBytePreamble);
     }
-    for(size_t pos = 0; pos + 1 < value.size(); ++pos)
+    for(size_t pos = 0; pos + 1 < length; ++pos)
     {
-      destination.putByte(static_cast<uchar>(value[pos]));
+      destination.putByte(value[pos]);
     }
-    destination.putByte(value[value.size() - 1] | stopBit);
+    destination.putByte(value[length - 1] | stopBit);
   }
 }
 
@@ -739,9 +790,15 @@ FieldInstruction::encodeAscii(DataDestination & destination, const StringBuffer
 void
 FieldInstruction::encodeBlobData(DataDestination & destination, const StringBuffer & value)
 {
-  for(size_t pos = 0; pos < value.size(); ++pos)
+  encodeBlobData(destination, value.data(), value.size());
+}
+
+void
+FieldInstruction::encodeBlobData(DataDestination & destination, const uchar * value, size_t length)
+{
+  for(size_t pos = 0; pos < length; ++pos)
   {
-    destination.putByte(static_cast<uchar>(value[pos]));
+    destination.putByte(value[pos]);
   }
 }
 
@@ -750,9 +807,29 @@ FieldInstruction::longestMatchingPrefix(
   const std::string & previous,
   const std::string & value)
 {
-  size_t plen = previous.length();
-  size_t vlen = value.length();
-  size_t len = std::min(plen, vlen);
+  return longestMatchingPrefix(
+    reinterpret_cast<const uchar *>(previous.data()), previous.length(),
+    reinterpret_cast<const uchar *>(value.data()), value.length());
+}
+
+size_t
+FieldInstruction::longestMatchingSuffix(
+  const std::string & previous,
+  const std::string & value)
+{
+  return longestMatchingSuffix(
+    reinterpret_cast<const uchar *>(previous.data()), previous.length(),
+    reinterpret_cast<const uchar *>(value.data()), value.length());
+}
+
+size_t
+FieldInstruction::longestMatchingPrefix(
+  const uchar * previous,
+  size_t previousLength,
+  const uchar * value,
+  size_t valueLength)
+{
+  size_t len = std::min(previousLength, valueLength);
   size_t result = 0;
   while(result < len && previous[result] == value[result])
   {
@@ -763,11 +840,13 @@ FieldInstruction::longestMatchingPrefix(
 
 size_t
 FieldInstruction::longestMatchingSuffix(
-  const std::string & previous,
-  const std::string & value)
+  const uchar * previous,
+  size_t previousLength,
+  const uchar * value,
+  size_t valueLength)
 {
-  size_t ppos = previous.length();
-  size_t vpos = value.length();
+  size_t ppos = previousLength;
+  size_t vpos = valueLength;
   size_t result = 0;
   while(ppos > 0 && vpos > 0 && previous[ppos-1] == value[vpos - 1])
   {
@@ -366,6 +366,20 @@ namespace QuickFAST{
         Codecs::Decoder & decoder,
         Messages::ValueMessageBuilder & builder) const;
 
+      /// @brief Step over a field the application does not want.
+      ///
+      /// Only used when no field operation is specified, so there are no dictionary
+      /// side effects.  The default implementation decodes the field and discards the
+      /// result.  Derived classes may override this to avoid copying the data.
+      /// @see FieldFilter
+      /// @param[in] source for the FAST data
+      /// @param[in] pmap indicating field presence
+      /// @param[in] decoder driving this process
+      virtual void skipNop(
+        Codecs::DataSource & source,
+        Codecs::PresenceMap & pmap,
+        Codecs::Decoder & decoder) const;
+
       ///////////////////
       // Encoding support
 
@@ -472,11 +486,29 @@ namespace QuickFAST{
       /// @param value to be written.
       static void encodeAscii(DataDestination & destination, const StringBuffer & value);
 
+      /// @brief Encode a string that's nullable, but not null.
+      /// @param destination to which the string will be written.
+      /// @param value points to the characters to be written.
+      /// @param length is the number of characters.
+      static void encodeNullableAscii(DataDestination & destination, const uchar * value, size_t length);
+
+      /// @brief Encode a string.
+      /// @param destination to which the string will be written.
+      /// @param value points to the characters to be written.
+      /// @param length is the number of characters.
+      static void encodeAscii(DataDestination & destination, const uchar * value, size_t length);
+
       /// @brief Helper routine to encode a blob represented as a string; into a destination
       /// @param destination to which the data will be written
       /// @param value to be written to the destination
       static void encodeBlobData(DataDestination & destination, const StringBuffer & value);
 
+      /// @brief Helper routine to encode the bytes of a blob into a destination
+      /// @param destination to which the data will be written
+      /// @param value points to the bytes to be written
+      /// @param length is the number of bytes
+      static void encodeBlobData(DataDestination & destination, const uchar * value, size_t length);
+
       /// @brief Encode signed integer
       ///
       /// Works with all signed integer types.  Variable byte length encoding
@@ -580,6 +612,30 @@ namespace QuickFAST{
         const std::string & previous,
         const std::string & value);
 
+      /// @brief Helper method to find the longest match at the beginning of two byte strings
+      /// @param previous points to one of the strings
+      /// @param previousLength is the length of previous
+      /// @param value points to the other string
+      /// @param valueLength is the length of value
+      /// @returns a count of bytes that match exactly at the beginning of the strings
+      static size_t longestMatchingPrefix(
+        const uchar * previous,
+        size_t previousLength,
+        const uchar * value,
+        size_t valueLength);
+
+      /// @brief Helper method to find the longest match at the end of two byte strings
+      /// @param previous points to one of the strings
+      /// @param previousLength is the length of previous
+      /// @param value points to the other string
+      /// @param valueLength is the length of value
+      /// @returns a count of bytes that match exactly at the end of the strings
+      static size_t longestMatchingSuffix(
+        const uchar * previous,
+        size_t previousLength,
+        const uchar * value,
+        size_t valueLength);
+
 
       /// @brief Basic decoding for ByteVectors and Utf8 strings
       ///
@@ -72,6 +72,24 @@ FieldInstructionAscii::decodeNop(
   }
 }
 
+void
+FieldInstructionAscii::skipNop(
+  Codecs::DataSource & source,
+  Codecs::PresenceMap & /*pmap*/,
+  Codecs::Decoder & decoder) const
+{
+  PROFILE_POINT("ascii::skipNop");
+  // Null, empty, and ordinary strings all end at the first stop bit.
+  uchar byte = 0;
+  do
+  {
+    if(!source.getByte(byte))
+    {
+      decoder.reportFatal("[ERR U03]", "End of file without stop bit in ASCII field.", identity_);
+    }
+  } while((byte & stopBit) == 0);
+}
+
 void
 FieldInstructionAscii::decodeConstant(
   Codecs::DataSource & /*source*/,
@@ -217,27 +235,24 @@ FieldInstructionAscii::decodeDelta(
       return;
     }
   }
-  std::string deltaValue;
   WorkingBuffer & buffer = decoder.getWorkingBuffer();
-  if(decodeAsciiFromSource(source, true, buffer))
+  (void)decodeAsciiFromSource(source, true, buffer);
+
+  // The delta is applied to the dictionary entry in place.
+  const uchar * previousValue = 0;
+  size_t previousLength = 0;
+  Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue, previousLength);
+  if(previousStatus == Context::UNDEFINED_VALUE && fieldOp_->hasValue())
   {
-    deltaValue = std::string(
-      reinterpret_cast<const char *>(buffer.begin()),
-      buffer.size());
+    fieldOp_->setDictionaryValue(decoder, fieldOp_->getValue());
+    previousLength = fieldOp_->getValue().length();
   }
-
-
-  std::string previousValue;
-  Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue);
-  if(previousStatus == Context::UNDEFINED_VALUE)
+  else if(previousStatus != Context::OK_VALUE)
   {
-    if(fieldOp_->hasValue())
-    {
-      previousValue = fieldOp_->getValue();
-    }
+    previousLength = 0;
   }
 
-  size_t previousLength = previousValue.length();
+  size_t replacePosition = 0;
   if( deltaLength < 0)
   {
     // operate on front of string
@@ -249,13 +264,6 @@ FieldInstructionAscii::decodeDelta(
       decoder.reportError("[ERR D7]", "ASCII tail delta front length exceeds length of previous string.", identity_);
       deltaLength = QuickFAST::int32(previousLength);
     }
-    std::string value = deltaValue + previousValue.substr(deltaLength);
-    builder.addValue(
-      identity_,
-      ValueType::ASCII,
-      reinterpret_cast<const uchar *>(value.c_str()),
-      value.size());
-    fieldOp_->setDictionaryValue(decoder, value);
   }
   else
   { // operate on end of string
@@ -268,14 +276,13 @@ FieldInstructionAscii::decodeDelta(
       decoder.reportError("[ERR D7]", "ASCII tail delta back length exceeds length of previous string.", identity_);
       deltaLength = QuickFAST::uint32(previousLength);
     }
-    std::string value = previousValue.substr(0, previousLength - deltaLength) + deltaValue;
-    builder.addValue(
-      identity_,
-      ValueType::ASCII,
-      reinterpret_cast<const uchar *>(value.c_str()),
-      value.size());
-    fieldOp_->setDictionaryValue(decoder, value);
+    replacePosition = previousLength - deltaLength;
   }
+  const uchar * value = 0;
+  size_t valueSize = 0;
+  fieldOp_->replaceDictionaryString(
+    decoder, replacePosition, deltaLength, buffer.begin(), buffer.size(), value, valueSize);
+  builder.addValue(identity_, ValueType::ASCII, value, valueSize);
 }
 
 void
@@ -292,30 +299,35 @@ FieldInstructionAscii::decodeTail(
     WorkingBuffer & buffer = decoder.getWorkingBuffer();
     if(decodeAsciiFromSource(source, isMandatory(), buffer))
     {
-      const std::string tailValue(reinterpret_cast<const char *>(buffer.begin()), buffer.size());
-      size_t tailLength = tailValue.length();
-      std::string previousValue;
-      Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue);
-      if(previousStatus == Context::UNDEFINED_VALUE)
+      size_t tailLength = buffer.size();
+      const uchar * previousValue = 0;
+      size_t previousLength = 0;
+      Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue, previousLength);
+      if(previousStatus == Context::UNDEFINED_VALUE && fieldOp_->hasValue())
+      {
+        fieldOp_->setDictionaryValue(decoder, fieldOp_->getValue());
+        previousLength = fieldOp_->getValue().length();
+      }
+      else if(previousStatus != Context::OK_VALUE)
       {
-        if(fieldOp_->hasValue())
-        {
-          previousValue = fieldOp_->getValue();
-          fieldOp_->setDictionaryValue(decoder, previousValue);
-        }
+        previousLength = 0;
       }
-      size_t previousLength = previousValue.length();
       if(tailLength > previousLength)
       {
         tailLength = previousLength;
       }
-      std::string value(previousValue.substr(0, previousLength - tailLength) + tailValue);
-      builder.addValue(
-        identity_,
-        ValueType::ASCII,
-        reinterpret_cast<const uchar *>(value.c_str()),
-        value.size());
-      fieldOp_->setDictionaryValue(decoder, value);
+      // replace the tail of the dictionary entry in place
+      const uchar * value = 0;
+      size_t valueSize = 0;
+      fieldOp_->replaceDictionaryString(
+        decoder,
+        previousLength - tailLength,
+        tailLength,
+        buffer.begin(),
+        buffer.size(),
+        value,
+        valueSize);
+      builder.addValue(identity_, ValueType::ASCII, value, valueSize);
     }
     else // null
     {
@@ -324,15 +336,12 @@ FieldInstructionAscii::decodeTail(
   }
   else // pmap says not in stream
   {
-    std::string previousValue;
-    Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue);
+    const uchar * previousValue = 0;
+    size_t previousLength = 0;
+    Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue, previousLength);
     if(previousStatus == Context::OK_VALUE)
     {
-      Messages::FieldCPtr field = Messages::FieldAscii::create(previousValue);
-      builder.addValue(identity_,
-        ValueType::ASCII,
-        reinterpret_cast<const uchar *>(previousValue.c_str()),
-        previousValue.size());
+      builder.addValue(identity_, ValueType::ASCII, previousValue, previousLength);
     }
     else if(fieldOp_->hasValue())
     {
@@ -551,30 +560,40 @@ FieldInstructionAscii::encodeDelta(
   const Messages::MessageAccessor & accessor) const
 {
   // get information from the dictionary
-  std::string previousValue;
-  Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(encoder, previousValue);
+  const uchar * previousValue = 0;
+  size_t previousLength = 0;
+  Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(encoder, previousValue, previousLength);
   if(previousStatus == Context::UNDEFINED_VALUE)
   {
     if(fieldOp_->hasValue())
     {
-      previousValue = fieldOp_->getValue();
-      fieldOp_->setDictionaryValue(encoder, previousValue);
+      const std::string & initialValue = fieldOp_->getValue();
+      previousValue = reinterpret_cast<const uchar *>(initialValue.data());
+      previousLength = initialValue.length();
+      fieldOp_->setDictionaryValue(encoder, initialValue);
     }
   }
+  else if(previousStatus != Context::OK_VALUE)
+  {
+    previousLength = 0;
+  }
   // get the value from the application data
   const StringBuffer * valueBuffer;
   if(accessor.getString(identity_, ValueType::ASCII, valueBuffer))
   {
-    std::string value(*valueBuffer);
-    size_t prefix = longestMatchingPrefix(previousValue, value);
-    size_t suffix = longestMatchingSuffix(previousValue, value);
-    int32 deltaCount = QuickFAST::uint32(previousValue.length() - prefix);
-    std::string deltaValue = value.substr(prefix);
+    const uchar * value = valueBuffer->data();
+    size_t valueLength = valueBuffer->size();
+    size_t prefix = longestMatchingPrefix(previousValue, previousLength, value, valueLength);
+    size_t suffix = longestMatchingSuffix(previousValue, previousLength, value, valueLength);
+    int32 deltaCount = QuickFAST::uint32(previousLength - prefix);
+    const uchar * deltaValue = value + prefix;
+    size_t deltaLength = valueLength - prefix;
     if(prefix < suffix)
     {
-      deltaCount = -int32(previousValue.length() - suffix);
+      deltaCount = -int32(previousLength - suffix);
       deltaCount -= 1; // allow +/- 0 values;
-      deltaValue = value.substr(0, value.length() - suffix);
+      deltaValue = value;
+      deltaLength = valueLength - suffix;
     }
     if(!isMandatory() && deltaCount >= 0)
     {
@@ -582,16 +601,16 @@ FieldInstructionAscii::encodeDelta(
     }
 #if 0 // handy when debugging
     std::cout << "Encode ascii delta prefix: " << prefix  << " suffix: " << suffix << std::endl;
-    std::cout << "Previous["<<previousValue <<"]" << std::endl;
-    std::cout << "   value[" << value <<      "]" << std::endl;
-    std::cout << "count:" << deltaCount << " Delta["<< deltaValue << ']' << std::endl;
+    std::cout << "count:" << deltaCount << " Delta length: "<< deltaLength << std::endl;
 #endif
     encodeSignedInteger(destination, encoder.getWorkingBuffer(), deltaCount);
-    encodeAscii(destination, deltaValue);
+    encodeAscii(destination, deltaValue, deltaLength);
 
-    if(previousStatus != Context::OK_VALUE  || value != previousValue)
+    if(previousStatus != Context::OK_VALUE
+      || prefix != valueLength
+      || valueLength != previousLength)
     {
-      fieldOp_->setDictionaryValue(encoder, value);
+      fieldOp_->setDictionaryValue(encoder, value, valueLength);
     }
   }
   else // not defined in accessor
@@ -612,14 +631,17 @@ FieldInstructionAscii::encodeTail(
   const Messages::MessageAccessor & accessor) const
 {
   // get information from the dictionary
-  std::string previousValue;
-  Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(encoder, previousValue);
+  const uchar * previousValue = 0;
+  size_t previousLength = 0;
+  Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(encoder, previousValue, previousLength);
   if(previousStatus == Context::UNDEFINED_VALUE)
   {
     if(fieldOp_->hasValue())
     {
-      previousValue = fieldOp_->getValue();
-      fieldOp_->setDictionaryValue(encoder, previousValue);
+      const std::string & initialValue = fieldOp_->getValue();
+      previousValue = reinterpret_cast<const uchar *>(initialValue.data());
+      previousLength = initialValue.length();
+      fieldOp_->setDictionaryValue(encoder, initialValue);
       // pretend we got the data from the dictionary
       previousStatus = Context::OK_VALUE;
     }
@@ -630,15 +652,19 @@ FieldInstructionAscii::encodeTail(
       previousStatus = Context::NULL_VALUE;
     }
   }
+  if(previousStatus != Context::OK_VALUE)
+  {
+    previousLength = 0;
+  }
 
   // get the value from the application data
   const StringBuffer * valueBuffer;
   if(accessor.getString(identity_, ValueType::ASCII, valueBuffer))
   {
-    std::string value(*valueBuffer);
-    size_t prefix = longestMatchingPrefix(previousValue, value);
-    std::string tailValue = value.substr(prefix);
-    if(tailValue.empty())
+    const uchar * value = valueBuffer->data();
+    size_t valueLength = valueBuffer->size();
+    size_t prefix = longestMatchingPrefix(previousValue, previousLength, value, valueLength);
+    if(prefix == valueLength)
     {
       pmap.setNextField(false);
     }
@@ -647,16 +673,18 @@ FieldInstructionAscii::encodeTail(
       pmap.setNextField(true);
       if(!isMandatory())
       {
-        encodeNullableAscii(destination, tailValue);
+        encodeNullableAscii(destination, value + prefix, valueLength - prefix);
       }
       else
       {
-        encodeAscii(destination, tailValue);
+        encodeAscii(destination, value + prefix, valueLength - prefix);
       }
     }
-    if(previousStatus != Context::OK_VALUE  || value != previousValue)
+    if(previousStatus != Context::OK_VALUE
+      || prefix != valueLength
+      || valueLength != previousLength)
     {
-      fieldOp_->setDictionaryValue(encoder, value);
+      fieldOp_->setDictionaryValue(encoder, value, valueLength);
     }
   }
   else // not defined in accessor
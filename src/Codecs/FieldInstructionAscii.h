@@ -63,6 +63,11 @@ namespace QuickFAST{
         Codecs::Decoder & decoder,
         Messages::ValueMessageBuilder & builder) const;
 
+      virtual void skipNop(
+        Codecs::DataSource & source,
+        Codecs::PresenceMap & pmap,
+        Codecs::Decoder & decoder) const;
+
       virtual void encodeNop(
         Codecs::DataDestination & destination,
         Codecs::PresenceMap & pmap,
@@ -9,6 +9,7 @@
 #include <Codecs/Encoder.h>
 #include <Messages/ValueMessageBuilder.h>
 #include <Messages/Field.h>
+#include <Common/ByteScan.h>
 
 using namespace ::QuickFAST;
 using namespace ::QuickFAST::Codecs;
@@ -52,6 +53,18 @@ FieldInstructionBlob::decodeBlobFromSource(
   return true;
 }
 
+void
+FieldInstructionBlob::checkDecodedValue(
+  Codecs::Context & context,
+  const uchar * value,
+  size_t valueSize) const
+{
+  if(type_ == ValueType::UTF8 && context.getValidateUtf8() && !ByteScan::isValidUtf8(value, valueSize))
+  {
+    context.reportError("[ERR R2]", "Invalid UTF-8 string.", identity_);
+  }
+}
+
 void
 FieldInstructionBlob::decodeNop(
   Codecs::DataSource & source,
@@ -67,10 +80,43 @@ FieldInstructionBlob::decodeNop(
   {
     const uchar * value = buffer.begin();
     size_t valueSize = buffer.size();
+    checkDecodedValue(decoder, value, valueSize);
     builder.addValue(identity_, type_, value, valueSize);
   }
 }
 
+void
+FieldInstructionBlob::skipNop(
+  Codecs::DataSource & source,
+  Codecs::PresenceMap & /*pmap*/,
+  Codecs::Decoder & decoder) const
+{
+  PROFILE_POINT("blob::skipNop");
+  uint32 length;
+  decodeUnsignedInteger(source, decoder, length, identity_.name());
+  if(!isMandatory())
+  {
+    if(checkNullInteger(length))
+    {
+      return;
+    }
+  }
+  const uchar * contiguous = 0;
+  if(source.hasContiguous(length, contiguous))
+  {
+    source.skipContiguous(length);
+    return;
+  }
+  for(size_t pos = 0; pos < length; ++pos)
+  {
+    uchar byte = 0;
+    if(!source.getByte(byte))
+    {
+      decoder.reportFatal("[ERR U03]", "End of file: Too few bytes in ByteVector.", identity_);
+    }
+  }
+}
+
 void
 FieldInstructionBlob::decodeConstant(
   Codecs::DataSource & /*source*/,
@@ -119,6 +165,7 @@ FieldInstructionBlob::decodeDefault(
     {
       const uchar * value = buffer.begin();
       size_t valueSize = buffer.size();
+      checkDecodedValue(decoder, value, valueSize);
       builder.addValue(
         identity_,
         type_,
@@ -160,6 +207,7 @@ FieldInstructionBlob::decodeCopy(
   {
     const uchar * value = buffer.begin();
     size_t valueSize = buffer.size();
+      checkDecodedValue(decoder, value, valueSize);
       builder.addValue(
         identity_,
         type_,
@@ -220,26 +268,24 @@ FieldInstructionBlob::decodeDelta(
     }
   }
 
-  std::string deltaValue;
   WorkingBuffer& buffer = decoder.getWorkingBuffer();
-  if(decodeBlobFromSource(source, decoder, true /*isMandatory()*/, buffer))
+  (void)decodeBlobFromSource(source, decoder, true /*isMandatory()*/, buffer);
+
+  // The delta is applied to the dictionary entry in place.
+  const uchar * previousValue = 0;
+  size_t previousLength = 0;
+  Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue, previousLength);
+  if(previousStatus == Context::UNDEFINED_VALUE && fieldOp_->hasValue())
   {
-    const uchar * value = buffer.begin();
-    size_t valueSize = buffer.size();
-    deltaValue = std::string(reinterpret_cast<const char *>(value), valueSize);
+    fieldOp_->setDictionaryValue(decoder, fieldOp_->getValue());
+    previousLength = fieldOp_->getValue().size();
   }
-
-  std::string previousValue;
-  Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue);
-  if(previousStatus == Context::UNDEFINED_VALUE)
+  else if(previousStatus != Context::OK_VALUE)
   {
-    if(fieldOp_->hasValue())
-    {
-      previousValue = fieldOp_->getValue();
-    }
+    previousLength = 0;
   }
-  size_t previousLength = previousValue.size();
 
+  size_t replacePosition = 0;
   if( deltaLength < 0)
   {
     // operate on front of string
@@ -251,13 +297,6 @@ FieldInstructionBlob::decodeDelta(
       decoder.reportError("[ERR D7]", "String tail delta front length exceeds length of previous string.", identity_);
       deltaLength = QuickFAST::int32(previousLength);
     }
-    std::string value = deltaValue + previousValue.substr(deltaLength);
-    builder.addValue(
-      identity_,
-      type_,
-      reinterpret_cast<const uchar *>(value.c_str()),
-      value.size());
-    fieldOp_->setDictionaryValue(decoder, value);
   }
   else
   { // operate on end of string
@@ -270,15 +309,14 @@ FieldInstructionBlob::decodeDelta(
       decoder.reportError("[ERR D7]", "String tail delta back length exceeds length of previous string.", identity_);
       deltaLength = QuickFAST::uint32(previousLength);
     }
-
-    std::string value = previousValue.substr(0, previousLength - deltaLength) + deltaValue;
-    builder.addValue(
-      identity_,
-      type_,
-      reinterpret_cast<const uchar *>(value.c_str()),
-      value.size());
-    fieldOp_->setDictionaryValue(decoder, value);
+    replacePosition = previousLength - deltaLength;
   }
+  const uchar * value = 0;
+  size_t valueSize = 0;
+  fieldOp_->replaceDictionaryString(
+    decoder, replacePosition, deltaLength, buffer.begin(), buffer.size(), value, valueSize);
+  checkDecodedValue(decoder, value, valueSize);
+  builder.addValue(identity_, type_, value, valueSize);
 }
 
 void
@@ -296,30 +334,35 @@ FieldInstructionBlob::decodeTail(
     if(decodeBlobFromSource(source, decoder, isMandatory(), buffer))
     {
       size_t tailLength = buffer.size();
-      std::string tailValue(reinterpret_cast<const char *>(buffer.begin()), tailLength);
-
-      std::string previousValue;
-      Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue);
-      if(previousStatus == Context::UNDEFINED_VALUE)
+      const uchar * previousValue = 0;
+      size_t previousLength = 0;
+      Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue, previousLength);
+      if(previousStatus == Context::UNDEFINED_VALUE && fieldOp_->hasValue())
       {
-        if(fieldOp_->hasValue())
-        {
-          previousValue = fieldOp_->getValue();
-          fieldOp_->setDictionaryValue(decoder, previousValue);
-        }
+        fieldOp_->setDictionaryValue(decoder, fieldOp_->getValue());
+        previousLength = fieldOp_->getValue().size();
+      }
+      else if(previousStatus != Context::OK_VALUE)
+      {
+        previousLength = 0;
       }
-      size_t previousLength = previousValue.length();
       if(tailLength > previousLength)
       {
         tailLength = previousLength;
       }
-      std::string value(previousValue.substr(0, previousLength - tailLength) + tailValue);
-      builder.addValue(
-        identity_,
-        type_,
-        reinterpret_cast<const uchar *>(value.c_str()),
-        value.size());
-      fieldOp_->setDictionaryValue(decoder, value);
+      // replace the tail of the dictionary entry in place
+      const uchar * value = 0;
+      size_t valueSize = 0;
+      fieldOp_->replaceDictionaryString(
+        decoder,
+        previousLength - tailLength,
+        tailLength,
+        buffer.begin(),
+        buffer.size(),
+        value,
+        valueSize);
+      checkDecodedValue(decoder, value, valueSize);
+      builder.addValue(identity_, type_, value, valueSize);
     }
     else // null
     {
@@ -328,16 +371,12 @@ FieldInstructionBlob::decodeTail(
   }
   else // pmap says not in stream
   {
-    std::string previousValue;
-    Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue);
+    const uchar * previousValue = 0;
+    size_t previousLength = 0;
+    Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue, previousLength);
     if(previousStatus == Context::OK_VALUE)
     {
-
-      builder.addValue(
-        identity_,
-        type_,
-        reinterpret_cast<const uchar *>(previousValue.c_str()),
-        previousValue.size());
+      builder.addValue(identity_, type_, previousValue, previousLength);
     }
     else if(fieldOp_->hasValue())
     {
@@ -357,25 +396,46 @@ FieldInstructionBlob::decodeTail(
 void
 FieldInstructionBlob::encodeNullableBlob(
   Codecs::DataDestination & destination,
-  Codecs::Context & /*context*/,
+  Codecs::Context & context,
+  WorkingBuffer & buffer,
+  const StringBuffer & value) const
+{
+  encodeNullableBlob(destination, context, buffer, value.data(), value.size());
+}
+
+void
+FieldInstructionBlob::encodeBlob(
+  Codecs::DataDestination & destination,
   WorkingBuffer & buffer,
   const StringBuffer & value) const
 {
-    uint32 length = QuickFAST::uint32(value.length());
+  encodeBlob(destination, buffer, value.data(), value.size());
+}
+
+void
+FieldInstructionBlob::encodeNullableBlob(
+  Codecs::DataDestination & destination,
+  Codecs::Context & /*context*/,
+  WorkingBuffer & buffer,
+  const uchar * value,
+  size_t valueLength) const
+{
+    uint32 length = QuickFAST::uint32(valueLength);
     length += 1;
     encodeUnsignedInteger(destination, buffer, length);
-    encodeBlobData(destination, value);
+    encodeBlobData(destination, value, valueLength);
 }
 
 void
 FieldInstructionBlob::encodeBlob(
   Codecs::DataDestination & destination,
   WorkingBuffer & buffer,
-  const StringBuffer & value) const
+  const uchar * value,
+  size_t valueLength) const
 {
-    uint32 length = QuickFAST::uint32(value.length());
+    uint32 length = QuickFAST::uint32(valueLength);
     encodeUnsignedInteger(destination, buffer, length);
-    encodeBlobData(destination, value);
+    encodeBlobData(destination, value, valueLength);
 }
 
 void
@@ -564,30 +624,40 @@ FieldInstructionBlob::encodeDelta(
   const Messages::MessageAccessor & accessor) const
 {
   // get information from the dictionary
-  std::string previousValue;
-  Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(encoder, previousValue);
+  const uchar * previousValue = 0;
+  size_t previousLength = 0;
+  Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(encoder, previousValue, previousLength);
   if(previousStatus == Context::UNDEFINED_VALUE)
   {
     if(fieldOp_->hasValue())
     {
-      previousValue = fieldOp_->getValue();
-      fieldOp_->setDictionaryValue(encoder, previousValue);
+      const std::string & initialValue = fieldOp_->getValue();
+      previousValue = reinterpret_cast<const uchar *>(initialValue.data());
+      previousLength = initialValue.size();
+      fieldOp_->setDictionaryValue(encoder, initialValue);
     }
   }
+  else if(previousStatus != Context::OK_VALUE)
+  {
+    previousLength = 0;
+  }
 
-  const StringBuffer * value;
-  if(accessor.getString(identity_, type_, value))
+  const StringBuffer * valueBuffer;
+  if(accessor.getString(identity_, type_, valueBuffer))
   {
-    size_t prefix = longestMatchingPrefix(previousValue, *value);
-    size_t suffix = longestMatchingSuffix(previousValue, *value);
-    int32 deltaCount = QuickFAST::uint32(previousValue.length() - prefix);
-    // Performance: add substr to StringBuffer
-    std::string deltaValue = static_cast<std::string>(*value).substr(prefix);
+    const uchar * value = valueBuffer->data();
+    size_t valueLength = valueBuffer->size();
+    size_t prefix = longestMatchingPrefix(previousValue, previousLength, value, valueLength);
+    size_t suffix = longestMatchingSuffix(previousValue, previousLength, value, valueLength);
+    int32 deltaCount = QuickFAST::uint32(previousLength - prefix);
+    const uchar * deltaValue = value + prefix;
+    size_t deltaLength = valueLength - prefix;
     if(prefix < suffix)
     {
-      deltaCount = -int32(previousValue.length() - suffix);
+      deltaCount = -int32(previousLength - suffix);
       deltaCount -= 1; // allow +/- 0 values;
-      deltaValue = static_cast<std::string>(*value).substr(0, value->length() - suffix);
+      deltaValue = value;
+      deltaLength = valueLength - suffix;
     }
     if(!isMandatory() && deltaCount >= 0)
     {
@@ -595,16 +665,16 @@ FieldInstructionBlob::encodeDelta(
     }
 #if 0 // handy when debugging
     std::cout << "Encode blob delta prefix: " << prefix  << " suffix: " << suffix << std::endl;
-    std::cout << "Previous["<<previousValue <<"]" << std::endl;
-    std::cout << "   value[" << value <<      "]" << std::endl;
-    std::cout << "count:" << deltaCount << " Delta["<< deltaValue << ']' << std::endl;
+    std::cout << "count:" << deltaCount << " Delta length: "<< deltaLength << std::endl;
 #endif
     encodeSignedInteger(destination, encoder.getWorkingBuffer(), deltaCount);
-    encodeBlob(destination, encoder.getWorkingBuffer(), deltaValue);
+    encodeBlob(destination, encoder.getWorkingBuffer(), deltaValue, deltaLength);
 
-    if(previousStatus != Context::OK_VALUE  || *value != previousValue)
+    if(previousStatus != Context::OK_VALUE
+      || prefix != valueLength
+      || valueLength != previousLength)
     {
-      fieldOp_->setDictionaryValue(encoder, *value);
+      fieldOp_->setDictionaryValue(encoder, value, valueLength);
     }
 
   }
@@ -626,14 +696,17 @@ FieldInstructionBlob::encodeTail(
   const Messages::MessageAccessor & accessor) const
 {
   // get information from the dictionary
-  std::string previousValue;
-  Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(encoder, previousValue);
+  const uchar * previousValue = 0;
+  size_t previousLength = 0;
+  Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(encoder, previousValue, previousLength);
   if(previousStatus == Context::UNDEFINED_VALUE)
   {
     if(fieldOp_->hasValue())
     {
-      previousValue = fieldOp_->getValue();
-      fieldOp_->setDictionaryValue(encoder, previousValue);
+      const std::string & initialValue = fieldOp_->getValue();
+      previousValue = reinterpret_cast<const uchar *>(initialValue.data());
+      previousLength = initialValue.size();
+      fieldOp_->setDictionaryValue(encoder, initialValue);
       // pretend we got the data from the dictionary
       previousStatus = Context::OK_VALUE;
     }
@@ -644,14 +717,18 @@ FieldInstructionBlob::encodeTail(
       previousStatus = Context::NULL_VALUE;
     }
   }
+  if(previousStatus != Context::OK_VALUE)
+  {
+    previousLength = 0;
+  }
 
-  const StringBuffer * value;
-  if(accessor.getString(identity_, type_, value))
+  const StringBuffer * valueBuffer;
+  if(accessor.getString(identity_, type_, valueBuffer))
   {
-    size_t prefix = longestMatchingPrefix(previousValue, *value);
-    // performance: add substr method to StringBuffer
-    std::string tailValue = static_cast<std::string>(*value).substr(prefix);
-    if(tailValue.empty())
+    const uchar * value = valueBuffer->data();
+    size_t valueLength = valueBuffer->size();
+    size_t prefix = longestMatchingPrefix(previousValue, previousLength, value, valueLength);
+    if(prefix == valueLength)
     {
       pmap.setNextField(false);
     }
@@ -660,16 +737,18 @@ FieldInstructionBlob::encodeTail(
       pmap.setNextField(true);
       if(!isMandatory())
       {
-        encodeNullableBlob(destination, encoder, encoder.getWorkingBuffer(), tailValue);
+        encodeNullableBlob(destination, encoder, encoder.getWorkingBuffer(), value + prefix, valueLength - prefix);
       }
       else
       {
-        encodeBlob(destination, encoder.getWorkingBuffer(), tailValue);
+        encodeBlob(destination, encoder.getWorkingBuffer(), value + prefix, valueLength - prefix);
       }
     }
-    if(previousStatus != Context::OK_VALUE  || *value != previousValue)
+    if(previousStatus != Context::OK_VALUE
+      || prefix != valueLength
+      || valueLength != previousLength)
     {
-      fieldOp_->setDictionaryValue(encoder, *value);
+      fieldOp_->setDictionaryValue(encoder, value, valueLength);
     }
   }
   else // not defined in accessor
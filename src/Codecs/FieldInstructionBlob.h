@@ -68,6 +68,11 @@ namespace QuickFAST{
         Codecs::Decoder & decoder,
         Messages::ValueMessageBuilder & builder) const;
 
+      virtual void skipNop(
+        Codecs::DataSource & source,
+        Codecs::PresenceMap & pmap,
+        Codecs::Decoder & decoder) const;
+
       virtual void encodeNop(
         Codecs::DataDestination & destination,
         Codecs::PresenceMap & pmap,
@@ -134,6 +139,14 @@ namespace QuickFAST{
         bool mandatory,
         WorkingBuffer & buffer) const;
 
+      /// @brief check a value decoded from the stream before it is delivered
+      ///
+      /// UTF-8 strings are checked if the context asks for it.
+      void checkDecodedValue(
+        Codecs::Context & context,
+        const uchar * value,
+        size_t valueSize) const;
+
       /// @brief helper routine to encode a nullable, but not null value
       void encodeNullableBlob(
         Codecs::DataDestination & destination,
@@ -146,6 +159,21 @@ namespace QuickFAST{
         Codecs::DataDestination & destination,
         WorkingBuffer & buffer,
         const StringBuffer & value) const;
+
+      /// @brief helper routine to encode a nullable, but not null value
+      void encodeNullableBlob(
+        Codecs::DataDestination & destination,
+        Codecs::Context & context,
+        WorkingBuffer & buffer,
+        const uchar * value,
+        size_t valueLength) const;
+
+      /// @brief helper routine to encode a non-nullable value
+      void encodeBlob(
+        Codecs::DataDestination & destination,
+        WorkingBuffer & buffer,
+        const uchar * value,
+        size_t valueLength) const;
     protected:
       /// @brief the actual data type (UTF8, BITVECTOR)
       ValueType::Type type_;
@@ -19,6 +19,18 @@
 using namespace QuickFAST;
 using namespace QuickFAST::Codecs;
 
+namespace
+{
+  const int64 powersOfTen[] =
+  {
+    1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL,
+    100000000LL, 1000000000LL, 10000000000LL, 100000000000LL, 1000000000000LL,
+    10000000000000LL, 100000000000000LL, 1000000000000000LL, 10000000000000000LL,
+    100000000000000000LL, 1000000000000000000LL
+  };
+  const int powersOfTenCount = int(sizeof(powersOfTen) / sizeof(powersOfTen[0]));
+}
+
 
 FieldInstructionDecimal::FieldInstructionDecimal(
       const std::string & name,
@@ -28,6 +40,10 @@ FieldInstructionDecimal::FieldInstructionDecimal(
   , typedExponent_(0)
   , typedMantissa_(0)
   , typedValue_(0,0)
+  , mantissaValue_(0)
+  , exponentValue_(0)
+  , fixedPoint_(false)
+  , fixedPointExponent_(0)
 {
 }
 
@@ -36,6 +52,10 @@ FieldInstructionDecimal::FieldInstructionDecimal()
   , typedExponent_(0)
   , typedMantissa_(0)
   , typedValue_(0,0)
+  , mantissaValue_(0)
+  , exponentValue_(0)
+  , fixedPoint_(false)
+  , fixedPointExponent_(0)
 {
 }
 
@@ -63,7 +83,23 @@ FieldInstructionDecimal::decodeNop(
 {
   PROFILE_POINT("decimal::decodeNop");
 
-  if(bool(exponentInstruction_))
+  if(exponentValue_ != 0 && mantissaValue_ != 0)
+  {
+    // decode the exponent and mantissa directly, applying their operators
+    int32 exponent = 0;
+    if(!exponentValue_->decodeValue(source, pmap, decoder, exponent))
+    {
+      // null field
+      return;
+    }
+    mantissa_t mantissa = 0;
+    if(!mantissaValue_->decodeValue(source, pmap, decoder, mantissa))
+    {
+      mantissa = 0;
+    }
+    addDecimal(decoder, accessor, Decimal(mantissa, exponent_t(exponent), false));
+  }
+  else if(bool(exponentInstruction_))
   {
     Messages::SingleValueBuilder<int32> exponentBuilder;
     exponentInstruction_->decode(source, pmap, decoder, exponentBuilder);
@@ -83,7 +119,7 @@ FieldInstructionDecimal::decodeNop(
     }
 
     Decimal value(mantissa, exponent, false);
-    accessor.addValue(identity_, ValueType::DECIMAL, value);
+    addDecimal(decoder, accessor, value);
   }
   else
   {
@@ -99,28 +135,67 @@ FieldInstructionDecimal::decodeNop(
     mantissa_t mantissa;
     decodeSignedInteger(source, decoder, mantissa, identity_.name());
     Decimal value(mantissa, exponent);
-    accessor.addValue(
-      identity_,
-      ValueType::DECIMAL,
-      value);
+    addDecimal(decoder, accessor, value);
   }
   return;
 }
 
+void
+FieldInstructionDecimal::addDecimal(
+  Context & context,
+  Messages::ValueMessageBuilder & builder,
+  const Decimal & value) const
+{
+  if(!fixedPoint_)
+  {
+    builder.addValue(identity_, ValueType::DECIMAL, value);
+    return;
+  }
+  mantissa_t mantissa = value.getMantissa();
+  int shift = int(value.getExponent()) - int(fixedPointExponent_);
+  int64 result = mantissa;
+  if(shift > 0)
+  {
+    int64 limit = (shift < powersOfTenCount) ? LLONG_MAX / powersOfTen[shift] : 0;
+    if(mantissa > limit || mantissa < -limit)
+    {
+      context.reportError("[ERR R4]", "Decimal value overflows fixed point representation.", identity_);
+      result = (mantissa < 0) ? LLONG_MIN : LLONG_MAX;
+    }
+    else
+    {
+      // Only zero survives a shift beyond the table.
+      result = (shift < powersOfTenCount) ? mantissa * powersOfTen[shift] : 0;
+    }
+  }
+  else if(shift < 0)
+  {
+    bool truncated = (mantissa != 0);
+    result = 0;
+    if(-shift < powersOfTenCount)
+    {
+      result = mantissa / powersOfTen[-shift];
+      truncated = (mantissa % powersOfTen[-shift] != 0);
+    }
+    if(truncated)
+    {
+      context.reportError("[ERR U12]", "Decimal value loses precision in fixed point representation.", identity_);
+    }
+  }
+  builder.addValue(identity_, ValueType::INT64, result);
+}
+
 void
 FieldInstructionDecimal::decodeConstant(
   Codecs::DataSource & /*source*/,
   Codecs::PresenceMap & pmap,
-  Codecs::Decoder & /*decoder*/,
+  Codecs::Decoder & decoder,
   Messages::ValueMessageBuilder & accessor) const
 {
   PROFILE_POINT("decimal::decodeConstant");
   if(isMandatory() || pmap.checkNextField())
   {
-    accessor.addValue(
-      identity_,
-      ValueType::DECIMAL,
-      typedValue_);
+    addDecimal(decoder, accessor, typedValue_);
   }
 }
 
@@ -146,19 +221,13 @@ FieldInstructionDecimal::decodeDefault(
     mantissa_t mantissa;
     decodeSignedInteger(source, decoder, mantissa, identity_.name());
     Decimal value(mantissa, exponent);
-    accessor.addValue(
-      identity_,
-      ValueType::DECIMAL,
-      value);
+    addDecimal(decoder, accessor, value);
   }
   else // field not in stream
   {
     if(typedValueIsDefined_)
     {
-      accessor.addValue(
-        identity_,
-        ValueType::DECIMAL,
-        typedValue_);
+      addDecimal(decoder, accessor, typedValue_);
     }
     else if(isMandatory())
     {
@@ -184,10 +253,7 @@ FieldInstructionDecimal::decodeCopy(
     {
       decodeSignedInteger(source, decoder, mantissa, identity_.name());
       Decimal value(mantissa, exponent, false);
-      accessor.addValue(
-        identity_,
-        ValueType::DECIMAL,
-        value);
+      addDecimal(decoder, accessor, value);
       fieldOp_->setDictionaryValue(decoder, value);
     }
     else
@@ -201,10 +267,7 @@ FieldInstructionDecimal::decodeCopy(
       {
         decodeSignedInteger(source, decoder, mantissa, identity_.name());
         Decimal value(mantissa, exponent, false);
-        accessor.addValue(
-          identity_,
-          ValueType::DECIMAL,
-          value);
+        addDecimal(decoder, accessor, value);
         fieldOp_->setDictionaryValue(decoder, value);
       }
     }
@@ -220,10 +283,7 @@ FieldInstructionDecimal::decodeCopy(
       // not a problem..  use initial value if it's available
       if(fieldOp_->hasValue())
       {
-        accessor.addValue(
-          identity_,
-          ValueType::DECIMAL,
-          typedValue_);
+        addDecimal(decoder, accessor, typedValue_);
         fieldOp_->setDictionaryValue(decoder, typedValue_);
       }
       else
@@ -236,10 +296,7 @@ FieldInstructionDecimal::decodeCopy(
     }
     else if(previousStatus == Context::OK_VALUE)
     {
-      accessor.addValue(
-        identity_,
-        ValueType::DECIMAL,
-        value);
+      addDecimal(decoder, accessor, value);
     }
     //else previous was null so don't put anything in the record
   }
@@ -270,10 +327,7 @@ FieldInstructionDecimal::decodeDelta(
   (void)fieldOp_->getDictionaryValue(decoder, value);
   value.setExponent(exponent_t(value.getExponent() + exponentDelta));
   value.setMantissa(mantissa_t(value.getMantissa() + mantissaDelta));
-  accessor.addValue(
-    identity_,
-    ValueType::DECIMAL,
-    value);
+  addDecimal(decoder, accessor, value);
   fieldOp_->setDictionaryValue(decoder, value);
 }
 
@@ -586,7 +640,7 @@ FieldInstructionDecimal::encodeDelta(
 void
 FieldInstructionDecimal::interpretValue(const std::string & value)
 {
-  typedValue_.parse(value);
+  typedValue_.parse(value.data(), value.size());
   typedValueIsDefined_ = true;
   typedMantissa_ = typedValue_.getMantissa();
   typedExponent_ = typedValue_.getExponent();
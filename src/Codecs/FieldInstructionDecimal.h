@@ -37,6 +37,7 @@ namespace QuickFAST{
       virtual void setMantissaInstruction(FieldInstructionPtr mantissa)
       {
         mantissaInstruction_ = mantissa;
+        mantissaValue_ = dynamic_cast<const FieldInstructionMantissa *>(mantissa.get());
       }
 
       /// @brief Get the mantissa field instruction.
@@ -52,6 +53,7 @@ namespace QuickFAST{
       virtual void setExponentInstruction(FieldInstructionPtr exponent)
       {
         exponentInstruction_ = exponent;
+        exponentValue_ = dynamic_cast<const FieldInstructionExponent *>(exponent.get());
         if(!isMandatory())
         {
           exponentInstruction_->setPresence(false);
@@ -74,6 +76,32 @@ namespace QuickFAST{
         typedValue_ = Decimal(mantissa, exponent);
       }
 
+      /// @brief Deliver decoded values as fixed-point integers.
+      ///
+      /// The decoded value is rescaled to the given exponent and delivered
+      /// as an int64 (ValueType::INT64) rather than as a Decimal.
+      /// For example with an exponent of -4, 12.5 is delivered as 125000.
+      /// A value that does not fit is reported as [ERR R4] and one that would lose
+      /// digits is reported as [ERR U12] via Context::reportError().
+      /// If reportError() returns, the value is clamped or truncated respectively.
+      /// Encoding is not affected.
+      /// May also be set with the fixed_point_exponent= attribute in the XML template.
+      /// @param exponent is the scale of the delivered values.
+      void setFixedPointExponent(exponent_t exponent)
+      {
+        fixedPoint_ = true;
+        fixedPointExponent_ = exponent;
+      }
+
+      /// @brief Are decoded values delivered as fixed-point integers?
+      /// @param[out] exponent is the scale of the delivered values.
+      /// @returns true if setFixedPointExponent() has been called.
+      bool getFixedPointExponent(exponent_t & exponent)const
+      {
+        exponent = fixedPointExponent_;
+        return fixedPoint_;
+      }
+
       // virtual methods defined and documented in FieldInstruction
       virtual void decodeNop(
         Codecs::DataSource & source,
@@ -158,6 +186,11 @@ namespace QuickFAST{
         exponent_t exponent,
         mantissa_t mantissa) const;
 
+      void addDecimal(
+        Context & context,
+        Messages::ValueMessageBuilder & builder,
+        const Decimal & value) const;
+
     private:
       void interpretValue(const std::string & value);
 
@@ -169,6 +202,12 @@ namespace QuickFAST{
       Decimal typedValue_;
       FieldInstructionPtr mantissaInstruction_;
       FieldInstructionPtr exponentInstruction_;
+      // the same instructions with their concrete types so decoding
+      // can bypass operator dispatch and the ValueMessageBuilder.
+      const FieldInstructionMantissa * mantissaValue_;
+      const FieldInstructionExponent * exponentValue_;
+      bool fixedPoint_;
+      exponent_t fixedPointExponent_;
     };
   }
 }
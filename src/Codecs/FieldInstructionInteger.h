@@ -55,6 +55,21 @@ namespace QuickFAST{
         typedValueIsDefined_ = true;
       }
 
+      /// @brief Decode this field without delivering it to a ValueMessageBuilder.
+      ///
+      /// Applies the field operator, including any dictionary update.
+      /// Used by instructions that combine several integer fields into a single value.
+      /// @param[in] source for the FAST data
+      /// @param[in] pmap indicating field presence
+      /// @param[in] decoder driving this process
+      /// @param[out] value receives the decoded value
+      /// @returns true if a value was decoded; false if the field is absent or null.
+      bool decodeValue(
+        Codecs::DataSource & source,
+        Codecs::PresenceMap & pmap,
+        Codecs::Decoder & decoder,
+        INTEGER_TYPE & value) const;
+
       virtual void decodeNop(
         Codecs::DataSource & source,
         Codecs::PresenceMap & pmap,
@@ -141,6 +156,39 @@ namespace QuickFAST{
 
       virtual ValueType::Type fieldInstructionType()const;
 
+    private:
+      bool decodeNopValue(
+        Codecs::DataSource & source,
+        Codecs::Decoder & decoder,
+        INTEGER_TYPE & value) const;
+
+      bool decodeConstantValue(
+        Codecs::PresenceMap & pmap,
+        INTEGER_TYPE & value) const;
+
+      bool decodeDefaultValue(
+        Codecs::DataSource & source,
+        Codecs::PresenceMap & pmap,
+        Codecs::Decoder & decoder,
+        INTEGER_TYPE & value) const;
+
+      bool decodeCopyValue(
+        Codecs::DataSource & source,
+        bool pmapValue,
+        Codecs::Decoder & decoder,
+        INTEGER_TYPE & value) const;
+
+      bool decodeDeltaValue(
+        Codecs::DataSource & source,
+        Codecs::Decoder & decoder,
+        INTEGER_TYPE & value) const;
+
+      bool decodeIncrementValue(
+        Codecs::DataSource & source,
+        bool pmapValue,
+        Codecs::Decoder & decoder,
+        INTEGER_TYPE & value) const;
+
     private:
       FieldInstructionInteger(const FieldInstructionInteger<INTEGER_TYPE, VALUE_TYPE, SIGNED> &);
       FieldInstructionInteger<INTEGER_TYPE, VALUE_TYPE, SIGNED> & operator=(const FieldInstructionInteger<INTEGER_TYPE, VALUE_TYPE, SIGNED> &);
@@ -210,6 +258,35 @@ namespace QuickFAST{
       }
     }
 
+    template<typename INTEGER_TYPE, ValueType::Type VALUE_TYPE, bool SIGNED>
+    bool
+    FieldInstructionInteger<INTEGER_TYPE, VALUE_TYPE, SIGNED>::
+    decodeValue(
+      Codecs::DataSource & source,
+      Codecs::PresenceMap & pmap,
+      Codecs::Decoder & decoder,
+      INTEGER_TYPE & value) const
+    {
+      switch(fieldOp_->opType())
+      {
+      case FieldOp::NOP:
+        return decodeNopValue(source, decoder, value);
+      case FieldOp::CONSTANT:
+        return decodeConstantValue(pmap, value);
+      case FieldOp::DEFAULT:
+        return decodeDefaultValue(source, pmap, decoder, value);
+      case FieldOp::COPY:
+        return decodeCopyValue(source, pmap.checkNextField(), decoder, value);
+      case FieldOp::DELTA:
+        return decodeDeltaValue(source, decoder, value);
+      case FieldOp::INCREMENT:
+        return decodeIncrementValue(source, pmap.checkNextField(), decoder, value);
+      default:
+        decoder.reportFatal("[ERR S2]", "Unsupported operator for integer field.", identity_);
+        return false;
+      }
+    }
+
     template<typename INTEGER_TYPE, ValueType::Type VALUE_TYPE, bool SIGNED>
     void
     FieldInstructionInteger<INTEGER_TYPE, VALUE_TYPE, SIGNED>::
@@ -218,12 +295,30 @@ namespace QuickFAST{
       Codecs::PresenceMap & /*pmap*/,
       Codecs::Decoder & decoder,
       Messages::ValueMessageBuilder & builder) const
+    {
+      INTEGER_TYPE value = 0;
+      if(decodeNopValue(source, decoder, value))
+      {
+        builder.addValue(
+          identity_,
+          VALUE_TYPE,
+          value);
+      }
+    }
+
+    template<typename INTEGER_TYPE, ValueType::Type VALUE_TYPE, bool SIGNED>
+    bool
+    FieldInstructionInteger<INTEGER_TYPE, VALUE_TYPE, SIGNED>::
+    decodeNopValue(
+      Codecs::DataSource & source,
+      Codecs::Decoder & decoder,
+      INTEGER_TYPE & value) const
     {
       PROFILE_POINT("int::decodeNop");
 
       // note NOP never uses pmap.  It uses a null value instead for optional fields
       // so it's always safe to do the basic decode.
-      INTEGER_TYPE value = 0;
+      value = 0;
       if(SIGNED) // expect compile-time optimization here
       {
         decodeSignedInteger(source, decoder, value, identity_.name(), false, ignoreOverflow_);
@@ -232,47 +327,44 @@ namespace QuickFAST{
       {
         decodeUnsignedInteger(source, decoder, value, identity_.name(), ignoreOverflow_);
       }
-      if(isMandatory())
+      // not mandatory means it's nullable
+      return isMandatory() || !checkNullInteger(value);
+    }
+
+    template<typename INTEGER_TYPE, ValueType::Type VALUE_TYPE, bool SIGNED>
+    void
+    FieldInstructionInteger<INTEGER_TYPE, VALUE_TYPE, SIGNED>::
+    decodeConstant(
+      Codecs::DataSource & /*source*/,
+      Codecs::PresenceMap & pmap,
+      Codecs::Decoder & /*decoder*/,
+      Messages::ValueMessageBuilder & builder) const
+    {
+      INTEGER_TYPE value = 0;
+      if(decodeConstantValue(pmap, value))
       {
         builder.addValue(
           identity_,
           VALUE_TYPE,
           value);
       }
-      else
-      {
-        // not mandatory means it's nullable
-        if(!checkNullInteger(value))
-        {
-          builder.addValue(
-            identity_,
-            VALUE_TYPE,
-            value);
-        }
-      }
     }
 
     template<typename INTEGER_TYPE, ValueType::Type VALUE_TYPE, bool SIGNED>
-    void
+    bool
     FieldInstructionInteger<INTEGER_TYPE, VALUE_TYPE, SIGNED>::
-    decodeConstant(
-      Codecs::DataSource & /*source*/,
+    decodeConstantValue(
       Codecs::PresenceMap & pmap,
-      Codecs::Decoder & /*decoder*/,
-      Messages::ValueMessageBuilder & builder) const
+      INTEGER_TYPE & value) const
     {
       PROFILE_POINT("int::decodeConstant");
       if(!isMandatory() && !pmap.checkNextField())
       {
         // nothing to say
+        return false;
       }
-      else
-      {
-        builder.addValue(
-          identity_,
-          VALUE_TYPE,
-          typedValue_);
-      }
+      value = typedValue_;
+      return true;
     }
 
     template<typename INTEGER_TYPE, ValueType::Type VALUE_TYPE, bool SIGNED>
@@ -295,11 +387,30 @@ namespace QuickFAST{
         bool pmapValue,
         Codecs::Decoder & decoder,
         Messages::ValueMessageBuilder & builder) const
+    {
+      INTEGER_TYPE value = 0;
+      if(decodeCopyValue(source, pmapValue, decoder, value))
+      {
+        builder.addValue(
+          identity_,
+          VALUE_TYPE,
+          value);
+      }
+    }
+
+    template<typename INTEGER_TYPE, ValueType::Type VALUE_TYPE, bool SIGNED>
+    bool
+    FieldInstructionInteger<INTEGER_TYPE, VALUE_TYPE, SIGNED>::
+    decodeCopyValue(
+        Codecs::DataSource & source,
+        bool pmapValue,
+        Codecs::Decoder & decoder,
+        INTEGER_TYPE & value) const
     {
       PROFILE_POINT("int::decodeCopy");
       if(pmapValue)
       {
-        INTEGER_TYPE value = typedValue_;
+        value = typedValue_;
         // present in stream
         if(SIGNED) // expect compile-time optimization here
         {
@@ -310,31 +421,14 @@ namespace QuickFAST{
           decodeUnsignedInteger(source, decoder, value, identity_.name(), ignoreOverflow_);
         }
 
-        if(isMandatory())
-        {
-          builder.addValue(
-            identity_,
-            VALUE_TYPE,
-            value);
-          fieldOp_->setDictionaryValue(decoder, value);
-        }
-        else
+        // not mandatory means it's nullable
+        if(!isMandatory() && checkNullInteger(value))
         {
-          // not mandatory means it's nullable
-          if(checkNullInteger(value))
-          {
-            fieldOp_->setDictionaryValueNull(decoder);
-          }
-          else
-          {
-            builder.addValue(
-              identity_,
-              VALUE_TYPE,
-              value);
-            fieldOp_->setDictionaryValue(decoder, value);
-          }
+          fieldOp_->setDictionaryValueNull(decoder);
+          return false;
         }
-
+        fieldOp_->setDictionaryValue(decoder, value);
+        return true;
       }
       else // pmap says not present, use copy
       {
@@ -342,10 +436,8 @@ namespace QuickFAST{
         Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue);
         if(previousStatus == Context::OK_VALUE)
         {
-          builder.addValue(
-            identity_,
-            VALUE_TYPE,
-            previousValue);
+          value = previousValue;
+          return true;
         }
         else if(previousStatus == Context::UNDEFINED_VALUE)
         {
@@ -353,11 +445,9 @@ namespace QuickFAST{
           // not a problem..  use initial value if it's available
           if(fieldOp_->hasValue())
           {
-            builder.addValue(
-              identity_,
-              VALUE_TYPE,
-              typedValue_);
+            value = typedValue_;
             fieldOp_->setDictionaryValue(decoder, typedValue_);
+            return true;
           }
           else
           {
@@ -367,11 +457,9 @@ namespace QuickFAST{
                 "[ERR D5]",
                 "Copy operator missing mandatory integer field/no initial value",
                 identity_);
-              builder.addValue(
-                identity_,
-                VALUE_TYPE,
-                INTEGER_TYPE(0));
+              value = INTEGER_TYPE(0);
               fieldOp_->setDictionaryValue(decoder, INTEGER_TYPE(0));
+              return true;
             }
           }
         }
@@ -385,14 +473,13 @@ namespace QuickFAST{
               "[ERR D5]",
               "Copy operator mandatory integer field, but previous value was NULL",
               identity_);
-            builder.addValue(
-              identity_,
-              VALUE_TYPE,
-              INTEGER_TYPE(0));
+            value = INTEGER_TYPE(0);
             fieldOp_->setDictionaryValue(decoder, INTEGER_TYPE(0));
+            return true;
           }
         }
       }
+      return false;
     }
 
     template<typename INTEGER_TYPE, ValueType::Type VALUE_TYPE, bool SIGNED>
@@ -403,12 +490,31 @@ namespace QuickFAST{
       Codecs::PresenceMap & pmap,
       Codecs::Decoder & decoder,
       Messages::ValueMessageBuilder & builder) const
+    {
+      INTEGER_TYPE value = 0;
+      if(decodeDefaultValue(source, pmap, decoder, value))
+      {
+        builder.addValue(
+          identity_,
+          VALUE_TYPE,
+          value);
+      }
+    }
+
+    template<typename INTEGER_TYPE, ValueType::Type VALUE_TYPE, bool SIGNED>
+    bool
+    FieldInstructionInteger<INTEGER_TYPE, VALUE_TYPE, SIGNED>::
+    decodeDefaultValue(
+      Codecs::DataSource & source,
+      Codecs::PresenceMap & pmap,
+      Codecs::Decoder & decoder,
+      INTEGER_TYPE & value) const
     {
       PROFILE_POINT("int::decodeDefault");
       if(pmap.checkNextField())
       {
         PROFILE_POINT("int::decodeDefault:present");
-        INTEGER_TYPE value = 0;
+        value = 0;
         if(SIGNED)
         {
           decodeSignedInteger(source, decoder, value, identity_.name(), false,  ignoreOverflow_);
@@ -417,24 +523,7 @@ namespace QuickFAST{
         {
           decodeUnsignedInteger(source, decoder, value, identity_.name(), ignoreOverflow_);
         }
-        if(isMandatory())
-        {
-          builder.addValue(
-            identity_,
-            VALUE_TYPE,
-            value);
-        }
-        else
-        {
-          if(!checkNullInteger(value))
-          {
-            PROFILE_POINT("int::decodeDefault:,addexplicit");
-            builder.addValue(
-              identity_,
-              VALUE_TYPE,
-              value);
-          }
-        }
+        return isMandatory() || !checkNullInteger(value);
       }
       else // field not in stream
       {
@@ -442,16 +531,15 @@ namespace QuickFAST{
         if(fieldOp_->hasValue())
         {
           PROFILE_POINT("int::decodeDefault:adddefault");
-          builder.addValue(
-            identity_,
-            VALUE_TYPE,
-            typedValue_);
+          value = typedValue_;
+          return true;
         }
         else if(isMandatory())
         {
           decoder.reportError("[ERR D5]", "Mandatory default operator with no value.", identity_);
         }
       }
+      return false;
     }
 
     template<typename INTEGER_TYPE, ValueType::Type VALUE_TYPE, bool SIGNED>
@@ -462,6 +550,24 @@ namespace QuickFAST{
       Codecs::PresenceMap & /*pmap*/,
       Codecs::Decoder & decoder,
       Messages::ValueMessageBuilder & builder) const
+    {
+      INTEGER_TYPE value = 0;
+      if(decodeDeltaValue(source, decoder, value))
+      {
+        builder.addValue(
+          identity_,
+          VALUE_TYPE,
+          value);
+      }
+    }
+
+    template<typename INTEGER_TYPE, ValueType::Type VALUE_TYPE, bool SIGNED>
+    bool
+    FieldInstructionInteger<INTEGER_TYPE, VALUE_TYPE, SIGNED>::
+    decodeDeltaValue(
+      Codecs::DataSource & source,
+      Codecs::Decoder & decoder,
+      INTEGER_TYPE & value) const
     {
       PROFILE_POINT("int::decodeDelta");
       int64 delta;
@@ -470,10 +576,10 @@ namespace QuickFAST{
       {
         if(checkNullInteger(delta))
         {
-          return; // nothing in Message; no change to saved value
+          return false; // nothing in Message; no change to saved value
         }
       }
-      INTEGER_TYPE value = typedValue_;
+      value = typedValue_;
       Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, value);
       if(previousStatus == Context::UNDEFINED_VALUE)
       {
@@ -485,11 +591,8 @@ namespace QuickFAST{
       // Apply delta
       value = INTEGER_TYPE(value + delta);
       // Save the results
-      builder.addValue(
-        identity_,
-        VALUE_TYPE,
-        value);
       fieldOp_->setDictionaryValue(decoder, value);
+      return true;
     }
 
 
@@ -513,12 +616,31 @@ namespace QuickFAST{
         bool pmapValue,
         Codecs::Decoder & decoder,
         Messages::ValueMessageBuilder & builder) const
+    {
+      INTEGER_TYPE value = 0;
+      if(decodeIncrementValue(source, pmapValue, decoder, value))
+      {
+        builder.addValue(
+          identity_,
+          VALUE_TYPE,
+          value);
+      }
+    }
+
+    template<typename INTEGER_TYPE, ValueType::Type VALUE_TYPE, bool SIGNED>
+    bool
+    FieldInstructionInteger<INTEGER_TYPE, VALUE_TYPE, SIGNED>::
+    decodeIncrementValue(
+        Codecs::DataSource & source,
+        bool pmapValue,
+        Codecs::Decoder & decoder,
+        INTEGER_TYPE & value) const
     {
       PROFILE_POINT("int::decodeIncrement");
       if(pmapValue)
       {
         //PROFILE_POINT("int::decodeIncrement::present");
-        INTEGER_TYPE value = 0;
+        value = 0;
         if(SIGNED) // expect compile-time optimization here
         {
           decodeSignedInteger(source, decoder, value, identity_.name(), false, ignoreOverflow_);
@@ -527,36 +649,20 @@ namespace QuickFAST{
         {
           decodeUnsignedInteger(source, decoder, value, identity_.name(), ignoreOverflow_);
         }
-        if(isMandatory())
-        {
-          builder.addValue(
-            identity_,
-            VALUE_TYPE,
-            value);
-          fieldOp_->setDictionaryValue(decoder, value);
-        }
-        else
+        //PROFILE_POINT("int::decodeIncrement::optional");
+        // not mandatory means it's nullable
+        if(!isMandatory() && checkNullInteger(value))
         {
-          //PROFILE_POINT("int::decodeIncrement::optional");
-          // not mandatory means it's nullable
-          if(checkNullInteger(value))
-          {
-            fieldOp_->setDictionaryValueNull(decoder);
-          }
-          else
-          {
-            builder.addValue(
-              identity_,
-              VALUE_TYPE,
-              value);
-            fieldOp_->setDictionaryValue(decoder, value);
-          }
+          fieldOp_->setDictionaryValueNull(decoder);
+          return false;
         }
+        fieldOp_->setDictionaryValue(decoder, value);
+        return true;
       }
       else
       {
         //PROFILE_POINT("int::decodeIncrement::absent");
-        INTEGER_TYPE value = typedValue_;
+        value = typedValue_;
         Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, value);
         if(previousStatus == Context::OK_VALUE)
         {
@@ -578,7 +684,7 @@ namespace QuickFAST{
             else
             {
               // missing value for optional field.  We're done
-              return;
+              return false;
             }
           }
         }
@@ -592,14 +698,11 @@ namespace QuickFAST{
           else
           {
             // missing value for optional field.  We're done
-            return;
+            return false;
           }
         }
-        builder.addValue(
-          identity_,
-          VALUE_TYPE,
-          value);
         fieldOp_->setDictionaryValue(decoder, value);
+        return true;
       }
     }
 
@@ -21,10 +21,12 @@ FieldInstructionSequence::FieldInstructionSequence(
   const std::string & name,
   const std::string & fieldNamespace)
   : FieldInstruction(name, fieldNamespace)
+  , isColumnar_(false)
 {
 }
 
 FieldInstructionSequence::FieldInstructionSequence()
+  : isColumnar_(false)
 {
 }
 
@@ -49,6 +51,12 @@ FieldInstructionSequence::finalize(TemplateRegistry & templateRegistry)
       setPresence(false);
     }
   }
+  isColumnar_ = segment_->size() > 0;
+  for(size_t nField = 0; isColumnar_ && nField < segment_->size(); ++nField)
+  {
+    ValueType::Type type = segment_->getInstruction(nField)->fieldInstructionType();
+    isColumnar_ = (type >= ValueType::INT8 && type <= ValueType::DECIMAL);
+  }
   FieldInstruction::finalize(templateRegistry);
 }
 
@@ -80,6 +88,11 @@ FieldInstructionSequence::decodeNop(
   if(lengthSet.isSet())
   {
     length = lengthSet.value();
+    if(isColumnar_ && builder.wantSequenceColumns())
+    {
+      decodeColumns(source, decoder, lengthSet.identity(), length, builder);
+      return;
+    }
 
     Messages::ValueMessageBuilder & sequenceBuilder = builder.startSequence(
       identity_,
@@ -110,6 +123,43 @@ FieldInstructionSequence::decodeNop(
   }
 }
 
+void
+FieldInstructionSequence::decodeColumns(
+  Codecs::DataSource & source,
+  Codecs::Decoder & decoder,
+  const Messages::FieldIdentity & lengthIdentity,
+  size_t length,
+  Messages::ValueMessageBuilder & builder) const
+{
+  Messages::SequenceColumns & columns = decoder.sequenceColumns();
+  columns.reset(
+    segment_->getApplicationType(),
+    segment_->getApplicationTypeNamespace(),
+    lengthIdentity,
+    length);
+  size_t fieldCount = segment_->size();
+  for(size_t nField = 0; nField < fieldCount; ++nField)
+  {
+    columns.defineColumn(segment_->getInstruction(nField)->getIdentity());
+  }
+
+  // one presence map serves every entry
+  size_t presenceMapBits = segment_->presenceMapBitCount();
+  Codecs::PresenceMap pmap(presenceMapBits);
+  static const std::string pm("PMAP");
+  for(size_t nEntry = 0; nEntry < length; ++nEntry)
+  {
+    columns.setRow(nEntry);
+    if(presenceMapBits > 0)
+    {
+      source.beginField(pm);
+      pmap.decode(source);
+    }
+    decoder.decodeSegmentBody(source, pmap, segment_, columns);
+  }
+  builder.addSequenceColumns(identity_, columns);
+}
+
 void
 FieldInstructionSequence::encodeNop(
   Codecs::DataDestination & destination,
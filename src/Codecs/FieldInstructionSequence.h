@@ -73,10 +73,26 @@ namespace QuickFAST{
       virtual ValueType::Type fieldInstructionType()const;
       virtual void displayBody(std::ostream & output, size_t indent)const;
 
+      /// @brief Can entries be delivered in columnar form?
+      ///
+      /// True after finalize() if every field in an entry is an integer or a decimal.
+      /// @see Messages::SequenceColumns
+      bool isColumnar()const
+      {
+        return isColumnar_;
+      }
+
     private:
       void interpretValue(const std::string & value);
+      void decodeColumns(
+        Codecs::DataSource & source,
+        Codecs::Decoder & decoder,
+        const Messages::FieldIdentity & lengthIdentity,
+        size_t length,
+        Messages::ValueMessageBuilder & builder) const;
     private:
       Codecs::SegmentBodyPtr segment_;
+      bool isColumnar_;
     };
   }
 }
@@ -51,6 +51,17 @@ FieldInstructionStaticTemplateRef::finalize(TemplateRegistry & templateRegistry)
     throw QuickFAST::TemplateDefinitionError(exception.str());
   }
   target->finalize(templateRegistry);
+  // Bind the target now so Xcoding does not look it up for every message.
+  // If the target is still being finalized this is a recursive reference.
+  // Leave it unbound to avoid a reference cycle between the templates.
+  if(target->isFinalized())
+  {
+    target_ = target;
+  }
+  else
+  {
+    target_.reset();
+  }
   // subtract one for the template ID
   presenceMapBitsUsed_ = target->presenceMapBitCount() - 1;
   fieldCount_ = target->fieldCount();
@@ -64,8 +75,9 @@ FieldInstructionStaticTemplateRef::decodeNop(
   Codecs::Decoder & decoder,
   Messages::ValueMessageBuilder & messageBuilder) const
 {
-  TemplateCPtr target;
-  if(!decoder.findTemplate(templateName_, templateNamespace_, target))
+  TemplateCPtr found;
+  const TemplateCPtr & target = target_ ? target_ : found;
+  if(!target_ && !decoder.findTemplate(templateName_, templateNamespace_, found))
   {
     decoder.reportFatal("[ERR D9]", "Unknown template name for static templateref.", identity_);
   }
@@ -108,8 +120,9 @@ FieldInstructionStaticTemplateRef::encodeNop(
 {
   // static templateRef
   // static
-  TemplateCPtr target;
-  if(!encoder.findTemplate(templateName_, templateNamespace_, target))
+  TemplateCPtr found;
+  const TemplateCPtr & target = target_ ? target_ : found;
+  if(!target_ && !encoder.findTemplate(templateName_, templateNamespace_, found))
   {
     encoder.reportFatal("[ERR D9]", "Unknown template name for static templateref.", identity_);
   }
@@ -7,6 +7,7 @@
 #ifndef FIELDINSTRUCTIONTEMPLATEREF_H
 #define FIELDINSTRUCTIONTEMPLATEREF_H
 #include <Codecs/FieldInstruction.h>
+#include <Codecs/Template_fwd.h>
 namespace QuickFAST{
   namespace Codecs{
     /// @brief Implement static &lt;templateRef> field instruction.
@@ -26,6 +27,18 @@ namespace QuickFAST{
       /// @brief a typical virtual destructor.
       virtual ~FieldInstructionStaticTemplateRef();
 
+      /// @brief The name of the target template.
+      const std::string & getTemplateName()const
+      {
+        return templateName_;
+      }
+
+      /// @brief The namespace of the target template.
+      const std::string & getTemplateNamespace()const
+      {
+        return templateNamespace_;
+      }
+
       ///////////////////////////////////////
       /// Implement FieldInstruction methods
       virtual void finalize(TemplateRegistry & templateRegistry);
@@ -51,6 +64,9 @@ namespace QuickFAST{
       std::string templateNamespace_;
       bool isFinalized_;
       size_t fieldCount_; // how many fields are in the target template (valid after finalize has been called)
+      /// The target template bound at finalize time.
+      /// Empty if the reference is recursive; then the target is found by name for each message.
+      TemplateCPtr target_;
     };
 
     /// @brief Implement dynamic &lt;templateRef> field instruction.
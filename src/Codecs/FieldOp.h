@@ -271,6 +271,26 @@ namespace QuickFAST{
         context.setDictionaryValue(dictionaryIndex_, value);
       }
 
+      /// @brief edit the string in the dictionary entry for this field in place
+      /// @param context holds the dictionary
+      /// @param pos is the first byte to replace
+      /// @param count is the number of bytes to replace
+      /// @param value points to the replacement bytes
+      /// @param length is the number of replacement bytes
+      /// @param[out] result points to the updated value in the dictionary
+      /// @param[out] resultLength is the length of the updated value.
+      void replaceDictionaryString(
+        Context & context,
+        size_t pos,
+        size_t count,
+        const unsigned char * value,
+        size_t length,
+        const unsigned char *& result,
+        size_t & resultLength)
+      {
+        context.replaceDictionaryString(dictionaryIndex_, pos, count, value, length, result, resultLength);
+      }
+
       /// @brief retrieve the value of the dictionary entry for this field
       /// @param context holds the dictionary
       /// @param value is the value that was found
@@ -8,6 +8,7 @@
 #include <Messages/Group.h>
 #include <Messages/FieldSequence.h>
 #include <Messages/FieldGroup.h>
+#include <Messages/MessagePool.h>
 #include <Common/Exceptions.h>
 
 using namespace QuickFAST;
@@ -18,6 +19,7 @@ using namespace Codecs;
 
 GenericSequenceBuilder::GenericSequenceBuilder(MessageBuilder * parent)
 : parent_(parent)
+, pool_(0)
 {
 }
 
@@ -45,7 +47,14 @@ GenericSequenceBuilder::initialize(
   size_t length
   )
 {
-  this->sequence_.reset(new Messages::Sequence(lengthIdentity, length));
+  if(pool_ != 0)
+  {
+    this->sequence_ = pool_->sequence(lengthIdentity, length);
+  }
+  else
+  {
+    this->sequence_.reset(new Messages::Sequence(lengthIdentity, length));
+  }
 }
 
 const std::string &
@@ -105,6 +114,7 @@ GenericSequenceBuilder::startSequence(
   if(!sequenceBuilder_)
   {
     sequenceBuilder_.reset(new GenericSequenceBuilder(this));
+    sequenceBuilder_->setMessagePool(pool_);
   }
   sequenceBuilder_->initialize(
     identity,
@@ -142,7 +152,14 @@ GenericSequenceBuilder::startSequenceEntry(
   const std::string & applicationTypeNamespace,
   size_t size)
 {
-  fieldSet_.reset(new Messages::FieldSet(size));
+  if(pool_ != 0)
+  {
+    fieldSet_ = pool_->fieldSet(size);
+  }
+  else
+  {
+    fieldSet_.reset(new Messages::FieldSet(size));
+  }
   fieldSet_->setApplicationType(
     applicationType,
     applicationTypeNamespace);
@@ -170,6 +187,7 @@ GenericSequenceBuilder::startGroup(
   if(!groupBuilder_)
   {
     groupBuilder_.reset(new GenericGroupBuilder(this));
+    groupBuilder_->setMessagePool(pool_);
   }
   groupBuilder_->initialize(
     identity,
@@ -204,6 +222,20 @@ GenericSequenceBuilder::reset()
   sequence_.reset();
 }
 
+void
+GenericSequenceBuilder::setMessagePool(Messages::MessagePool * pool)
+{
+  pool_ = pool;
+  if(sequenceBuilder_)
+  {
+    sequenceBuilder_->setMessagePool(pool);
+  }
+  if(groupBuilder_)
+  {
+    groupBuilder_->setMessagePool(pool);
+  }
+}
+
 bool
 GenericSequenceBuilder::wantLog(unsigned short level)
 {
@@ -234,6 +266,7 @@ GenericSequenceBuilder::reportCommunicationError(const std::string & errorMessag
 
 GenericGroupBuilder::GenericGroupBuilder(MessageBuilder * parent)
 : parent_(parent)
+, pool_(0)
 {
 }
 
@@ -258,7 +291,14 @@ GenericGroupBuilder::initialize(
   const std::string & applicationTypeNamespace,
   size_t size)
 {
-  group_.reset(new Messages::FieldSet(size));
+  if(pool_ != 0)
+  {
+    group_ = pool_->fieldSet(size);
+  }
+  else
+  {
+    group_.reset(new Messages::FieldSet(size));
+  }
   group_->setApplicationType(applicationType, applicationTypeNamespace);
 }
 
@@ -318,6 +358,7 @@ GenericGroupBuilder::startSequence(
   if(!sequenceBuilder_)
   {
     sequenceBuilder_.reset(new GenericSequenceBuilder(this));
+    sequenceBuilder_->setMessagePool(pool_);
   }
   sequenceBuilder_->initialize(
     identity,
@@ -377,6 +418,7 @@ GenericGroupBuilder::startGroup(
   if(!groupBuilder_)
   {
     groupBuilder_.reset(new GenericGroupBuilder(this));
+    groupBuilder_->setMessagePool(pool_);
   }
   groupBuilder_->initialize(
     identity,
@@ -411,6 +453,20 @@ GenericGroupBuilder::reset()
   group_.reset();
 }
 
+void
+GenericGroupBuilder::setMessagePool(Messages::MessagePool * pool)
+{
+  pool_ = pool;
+  if(sequenceBuilder_)
+  {
+    sequenceBuilder_->setMessagePool(pool);
+  }
+  if(groupBuilder_)
+  {
+    groupBuilder_->setMessagePool(pool);
+  }
+}
+
 bool
 GenericGroupBuilder::wantLog(unsigned short level)
 {
@@ -458,6 +514,14 @@ GenericMessageBuilder::~GenericMessageBuilder()
 {
 }
 
+void
+GenericMessageBuilder::setMessagePool(const Messages::MessagePoolPtr & pool)
+{
+  pool_ = pool;
+  sequenceBuilder_.setMessagePool(pool_.get());
+  groupBuilder_.setMessagePool(pool_.get());
+}
+
 const std::string &
 GenericMessageBuilder::getApplicationType()const
 {
@@ -484,7 +548,14 @@ GenericMessageBuilder::startMessage(
   const std::string & applicationTypeNamespace,
   size_t size)
 {
-  message_.reset(new Messages::Message(size));
+  if(pool_)
+  {
+    message_ = pool_->message(size);
+  }
+  else
+  {
+    message_.reset(new Messages::Message(size));
+  }
   message_->setApplicationType(applicationType, applicationTypeNamespace);
   return *this;
 }
@@ -495,9 +566,10 @@ GenericMessageBuilder::endMessage(Messages::ValueMessageBuilder &)
   ///////////////////////////////
   // This is where the message is
   // bassed to the MessageConsumer
-  bool more = consumer_.consumeMessage(*message());
+  bool more = consumer_.consumeSharedMessage(message());
 
-  // Once it's consumed, the message is no longer needed.
+  // Once it's consumed, the message is no longer needed here.
+  // If the consumer kept a reference it stays alive until the consumer lets go.
   message_.reset();
   return more;
 }
@@ -13,6 +13,7 @@
 #include <Messages/FieldSet_fwd.h>
 #include <Messages/Sequence_fwd.h>
 #include <Messages/Group_fwd.h>
+#include <Messages/MessagePool_fwd.h>
 namespace QuickFAST{
   namespace Codecs{
     class GenericSequenceBuilder;
@@ -54,6 +55,10 @@ namespace QuickFAST{
       /// @brief start over on a new sequence
       void reset();
 
+      /// @brief Take the sequences and groups built from here down from a pool.
+      /// @param pool supplies the objects, or null to allocate them.
+      void setMessagePool(Messages::MessagePool * pool);
+
       //////////////////////////
       // Implement MessageBuilder
 
@@ -112,6 +117,7 @@ namespace QuickFAST{
 
     private:
       Messages::MessageBuilder * parent_;
+      Messages::MessagePool * pool_;
       Messages::FieldSetPtr fieldSet_;
       Messages::SequencePtr sequence_;
       boost::scoped_ptr<GenericSequenceBuilder> sequenceBuilder_;
@@ -152,6 +158,10 @@ namespace QuickFAST{
       /// @brief prepare to start over with a new group
       void reset();
 
+      /// @brief Take the groups and sequences built from here down from a pool.
+      /// @param pool supplies the objects, or null to allocate them.
+      void setMessagePool(Messages::MessagePool * pool);
+
       //////////////////////////
       // Implement MessageBuilder
 
@@ -205,6 +215,7 @@ namespace QuickFAST{
       const Messages::GroupPtr & groupPtr()const;
     private:
       Messages::MessageBuilder * parent_;
+      Messages::MessagePool * pool_;
       Messages::FieldSetPtr fieldSetx_;
       Messages::GroupPtr group_;
 
@@ -224,6 +235,14 @@ namespace QuickFAST{
       /// @brief Virtual destructor
       virtual ~GenericMessageBuilder();
 
+      /// @brief Build messages from recycled storage.
+      ///
+      /// Messages, groups, and sequences are taken from the pool and go
+      /// back to it when the consumer and anyone it shares them with let go.
+      /// Set the pool before decoding starts.
+      /// @param pool supplies the objects, or an empty pointer to allocate them.
+      void setMessagePool(const Messages::MessagePoolPtr & pool);
+
       //////////////////////////
       // Implement MessageBuilder
       virtual const std::string & getApplicationType()const;
@@ -278,6 +297,7 @@ namespace QuickFAST{
       const Messages::MessagePtr & message()const;
     private:
       MessageConsumer & consumer_;
+      Messages::MessagePoolPtr pool_;
       Messages::MessagePtr message_;
       GenericSequenceBuilder sequenceBuilder_;
       GenericGroupBuilder groupBuilder_;
@@ -23,6 +23,22 @@ namespace QuickFAST{
       /// @returns true if decoding should continue; false to stop decoding
       virtual bool consumeMessage(Messages::Message & message) = 0;
 
+      /// @brief Accept a decoded message that may be kept after the call returns.
+      ///
+      /// A consumer that hands messages to another thread can hold on to the
+      /// pointer instead of copying the message.  If the message came from a
+      /// MessagePool it goes back to the pool when the last reference is released.
+      ///
+      /// New method added to the interface.  It's not pure virtual to avoid
+      /// breaking existing implementations.  The default passes the message to
+      /// consumeMessage().
+      /// @param message is the decoded message.
+      /// @returns true if decoding should continue; false to stop decoding
+      virtual bool consumeSharedMessage(const Messages::MessagePtr & message)
+      {
+        return consumeMessage(*message);
+      }
+
       /// @brief Notify consumer when decoding starts.
       ///
       /// This will be called before any call to consumeMessage().
@@ -0,0 +1,298 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "MessageHandoff.h"
+#include <Messages/Message.h>
+
+using namespace QuickFAST;
+using namespace Codecs;
+
+namespace
+{
+  /// Positions wrap, so compare them by their difference.
+  inline
+  long distance(long from, long to)
+  {
+    return long(static_cast<unsigned long>(to) - static_cast<unsigned long>(from));
+  }
+}
+
+MessageHandoff::MessageHandoff(size_t capacity, Policy policy, Common::Logger & logger)
+  : policy_(policy)
+  , logger_(logger)
+  , spinCount_(1000)
+  , mask_(0)
+  , head_(0)
+  , tail_(0)
+{
+  size_t size = 2;
+  while(size < capacity)
+  {
+    size <<= 1;
+  }
+  ring_.resize(size);
+  mask_ = static_cast<unsigned long>(size - 1);
+  for(size_t pos = 0; pos < size; ++pos)
+  {
+    ring_[pos].sequence_ = long(pos);
+  }
+}
+
+MessageHandoff::~MessageHandoff()
+{
+}
+
+size_t
+MessageHandoff::capacity()const
+{
+  return ring_.size();
+}
+
+size_t
+MessageHandoff::size()const
+{
+  return size_t(distance(tail_, head_));
+}
+
+size_t
+MessageHandoff::dropped()const
+{
+  return size_t(long(dropped_));
+}
+
+size_t
+MessageHandoff::blocked()const
+{
+  return size_t(long(blocked_));
+}
+
+void
+MessageHandoff::setSpinCount(size_t spinCount)
+{
+  spinCount_ = spinCount;
+}
+
+bool
+MessageHandoff::push(const Messages::MessagePtr & message)
+{
+  // Only the decoding thread moves the head.
+  long position = head_;
+  Slot & slot = ring_[static_cast<unsigned long>(position) & mask_];
+  if(distance(position, atomic_read_long(&slot.sequence_)) != 0)
+  {
+    // The consumer has not taken the message that was here a lap ago.
+    return false;
+  }
+  slot.message_ = message;
+  head_ = position + 1;
+  publish(slot, position + 1);
+  return true;
+}
+
+bool
+MessageHandoff::take(Messages::MessagePtr & message)
+{
+  // The decoding thread takes from the tail, too, when it drops the oldest message.
+  for(;;)
+  {
+    long position = tail_;
+    Slot & slot = ring_[static_cast<unsigned long>(position) & mask_];
+    long ahead = distance(position + 1, atomic_read_long(&slot.sequence_));
+    if(ahead < 0)
+    {
+      return false;
+    }
+    if(ahead == 0 && tail_.CAS(position, position + 1))
+    {
+      message.swap(slot.message_);
+      slot.message_.reset();
+      publish(slot, position + long(ring_.size()));
+      return true;
+    }
+  }
+}
+
+void
+MessageHandoff::publish(Slot & slot, long sequence)
+{
+  // Whoever claimed the slot owns it, so this succeeds.  The compare and
+  // swap is used for its memory barrier.
+  long current = slot.sequence_;
+  CASLong(&slot.sequence_, current, sequence);
+}
+
+bool
+MessageHandoff::hasRoom()const
+{
+  long position = head_;
+  return distance(position, atomic_read_long(&ring_[static_cast<unsigned long>(position) & mask_].sequence_)) == 0;
+}
+
+bool
+MessageHandoff::hasMessage()const
+{
+  long position = tail_;
+  return stopped_ != 0
+    || distance(position + 1, atomic_read_long(&ring_[static_cast<unsigned long>(position) & mask_].sequence_)) >= 0;
+}
+
+void
+MessageHandoff::wait(AtomicCounter & waiting, bool (MessageHandoff::*ready)()const)
+{
+  boost::mutex::scoped_lock lock(waitMutex_);
+  ++waiting;
+  // Check again now that the other thread knows to wake us.
+  if(!(this->*ready)())
+  {
+    waitCondition_.timed_wait(lock, boost::posix_time::milliseconds(10));
+  }
+  --waiting;
+}
+
+void
+MessageHandoff::wake(AtomicCounter & waiting)
+{
+  if(waiting != 0)
+  {
+    boost::mutex::scoped_lock lock(waitMutex_);
+    waitCondition_.notify_all();
+  }
+}
+
+bool
+MessageHandoff::pop(Messages::MessagePtr & message)
+{
+  if(take(message))
+  {
+    wake(producerWaiting_);
+    return true;
+  }
+  return false;
+}
+
+bool
+MessageHandoff::popWait(Messages::MessagePtr & message)
+{
+  size_t spins = 0;
+  for(;;)
+  {
+    if(pop(message))
+    {
+      return true;
+    }
+    if(stopped_ != 0)
+    {
+      // A message may have arrived just before decoding stopped.
+      return pop(message);
+    }
+    if(++spins < spinCount_)
+    {
+      boost::this_thread::yield();
+    }
+    else
+    {
+      wait(consumerWaiting_, &MessageHandoff::hasMessage);
+    }
+  }
+}
+
+bool
+MessageHandoff::consumeSharedMessage(const Messages::MessagePtr & message)
+{
+  if(!push(message))
+  {
+    switch(policy_)
+    {
+    case BLOCK:
+      {
+        ++blocked_;
+        size_t spins = 0;
+        while(!push(message))
+        {
+          if(++spins < spinCount_)
+          {
+            boost::this_thread::yield();
+          }
+          else
+          {
+            wait(producerWaiting_, &MessageHandoff::hasRoom);
+          }
+        }
+        break;
+      }
+    case DROP_OLDEST:
+      {
+        do
+        {
+          // The consumer may take it first, which makes room just as well.
+          Messages::MessagePtr oldest;
+          if(take(oldest))
+          {
+            ++dropped_;
+          }
+        } while(!push(message));
+        break;
+      }
+    case COUNT_AND_DROP:
+    default:
+      {
+        ++dropped_;
+        return true;
+      }
+    }
+  }
+  wake(consumerWaiting_);
+  return true;
+}
+
+bool
+MessageHandoff::consumeMessage(Messages::Message & message)
+{
+  // The message will be reused when this returns, so pass on a copy.
+  // Fields are immutable, so the copy shares them.
+  Messages::MessagePtr copy(new Messages::Message(message.size()));
+  copy->setApplicationType(message.getApplicationType(), message.getApplicationTypeNs());
+  for(Messages::FieldSet::const_iterator it = message.begin(); it != message.end(); ++it)
+  {
+    copy->addField(it->getIdentity(), it->getField());
+  }
+  return consumeSharedMessage(copy);
+}
+
+void
+MessageHandoff::decodingStarted()
+{
+  stopped_.CAS(1, 0);
+}
+
+void
+MessageHandoff::decodingStopped()
+{
+  stopped_.CAS(0, 1);
+  wake(consumerWaiting_);
+}
+
+bool
+MessageHandoff::wantLog(unsigned short level)
+{
+  return logger_.wantLog(level);
+}
+
+bool
+MessageHandoff::logMessage(unsigned short level, const std::string & logMessage)
+{
+  return logger_.logMessage(level, logMessage);
+}
+
+bool
+MessageHandoff::reportDecodingError(const std::string & errorMessage)
+{
+  return logger_.reportDecodingError(errorMessage);
+}
+
+bool
+MessageHandoff::reportCommunicationError(const std::string & errorMessage)
+{
+  return logger_.reportCommunicationError(errorMessage);
+}
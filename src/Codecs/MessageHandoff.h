@@ -0,0 +1,142 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef MESSAGEHANDOFF_H
+#define MESSAGEHANDOFF_H
+#include "MessageHandoff_fwd.h"
+#include <Common/QuickFAST_Export.h>
+#include <Common/AtomicCounter.h>
+#include <Codecs/MessageConsumer.h>
+
+namespace QuickFAST{
+  namespace Codecs{
+    /// @brief Pass decoded messages from the decoding thread to one application thread.
+    ///
+    /// The handoff is the MessageConsumer for a GenericMessageBuilder.  Each
+    /// message the decoder finishes is placed in a preallocated ring without
+    /// copying it and without taking a lock.  The application thread takes
+    /// messages out with pop() or popWait().
+    ///
+    /// Give the builder a MessagePool (GenericMessageBuilder::setMessagePool)
+    /// and a message goes back to the decoder's pool as soon as the application
+    /// thread releases it.
+    ///
+    /// One thread may put messages in and one thread may take them out.
+    /// Log messages and errors are passed to a Logger from the decoding thread.
+    class QuickFAST_Export MessageHandoff : public MessageConsumer
+    {
+    public:
+      /// @brief What to do when a message arrives and the ring is full.
+      enum Policy
+      {
+        /// Wait for the application to make room.  Nothing is lost but decoding stalls.
+        BLOCK,
+        /// Discard the oldest waiting message to make room for the new one.
+        DROP_OLDEST,
+        /// Discard the new message.
+        COUNT_AND_DROP
+      };
+
+      /// @brief Construct
+      /// @param capacity is the number of messages the ring holds.  It is rounded up to a power of two.
+      /// @param policy says what to do when the ring is full.
+      /// @param logger receives log messages and error reports from the decoding thread.
+      MessageHandoff(size_t capacity, Policy policy, Common::Logger & logger);
+      virtual ~MessageHandoff();
+
+      /// @brief Take the next message without waiting.
+      /// @param[out] message receives the message.
+      /// @returns false if no message is waiting.
+      bool pop(Messages::MessagePtr & message);
+
+      /// @brief Take the next message, waiting for one to arrive.
+      /// @param[out] message receives the message.
+      /// @returns false if decoding has stopped and every message has been taken.
+      bool popWait(Messages::MessagePtr & message);
+
+      /// @brief How many messages the ring holds.
+      size_t capacity()const;
+
+      /// @brief How many messages are waiting.
+      size_t size()const;
+
+      /// @brief How many messages were discarded because the ring was full.
+      size_t dropped()const;
+
+      /// @brief How many times the decoding thread had to wait for room.
+      size_t blocked()const;
+
+      /// @brief Set how many times a waiting thread checks the ring before it sleeps.
+      ///
+      /// Spinning keeps latency down at the cost of a busy CPU.
+      void setSpinCount(size_t spinCount);
+
+      //////////////////////////
+      // Implement MessageConsumer
+      virtual bool consumeMessage(Messages::Message & message);
+      virtual bool consumeSharedMessage(const Messages::MessagePtr & message);
+      virtual void decodingStarted();
+      virtual void decodingStopped();
+
+      ///////////////////
+      // Implement Logger
+      virtual bool wantLog(unsigned short level);
+      virtual bool logMessage(unsigned short level, const std::string & logMessage);
+      virtual bool reportDecodingError(const std::string & errorMessage);
+      virtual bool reportCommunicationError(const std::string & errorMessage);
+
+    private:
+      /// One position in the ring.
+      struct Slot
+      {
+        Slot()
+          : sequence_(0)
+        {
+        }
+        /// Equals the position for the producer, or position + 1 for a consumer.
+        /// Read it with atomic_read_long() before touching message_.
+        volatile long sequence_;
+        Messages::MessagePtr message_;
+      };
+
+      bool push(const Messages::MessagePtr & message);
+      bool take(Messages::MessagePtr & message);
+      void publish(Slot & slot, long sequence);
+      bool hasRoom()const;
+      bool hasMessage()const;
+      void wait(AtomicCounter & waiting, bool (MessageHandoff::*ready)()const);
+      void wake(AtomicCounter & waiting);
+
+    private:
+      MessageHandoff(const MessageHandoff &);
+      MessageHandoff & operator=(const MessageHandoff &);
+
+    private:
+      Policy policy_;
+      Common::Logger & logger_;
+      size_t spinCount_;
+      std::vector<Slot> ring_;
+      unsigned long mask_;
+
+      // The producer and the consumer update these from different threads,
+      // so keep them away from each other's cache lines.
+      char pad0_[64];
+      volatile long head_;
+      char pad1_[64];
+      AtomicCounter tail_;
+      char pad2_[64];
+
+      AtomicCounter dropped_;
+      AtomicCounter blocked_;
+      AtomicCounter stopped_;
+      AtomicCounter producerWaiting_;
+      AtomicCounter consumerWaiting_;
+      boost::mutex waitMutex_;
+      boost::condition_variable waitCondition_;
+    };
+  }
+}
+#endif // MESSAGEHANDOFF_H
@@ -0,0 +1,20 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef MESSAGEHANDOFF_FWD_H
+#define MESSAGEHANDOFF_FWD_H
+#ifndef QUICKFAST_HEADERS
+#error Please include <Application/QuickFAST.h> preferably as a precompiled header file.
+#endif //QUICKFAST_HEADERS
+
+namespace QuickFAST{
+  namespace Codecs{
+    class MessageHandoff;
+    /// @brief A smart pointer to a MessageHandoff.
+    typedef boost::shared_ptr<MessageHandoff> MessageHandoffPtr;
+  }
+}
+#endif // MESSAGEHANDOFF_FWD_H
@@ -93,7 +93,7 @@ MulticastDecoder::reset()
 {
   if(assembler_)
   {
-    assembler_->decoder().reset();
+    assembler_->decoder().resetDecoder();
   }
 }
 
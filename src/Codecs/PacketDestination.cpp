@@ -0,0 +1,156 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "PacketDestination.h"
+#include <Communication/Sender.h>
+#include <Common/Exceptions.h>
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Codecs;
+
+PacketDestination::PacketDestination(size_t maxPacketSize)
+: maxPacketSize_(maxPacketSize)
+, sender_(0)
+, useSequenceNumber_(false)
+, bigEndian_(true)
+, sequenceNumber_(0)
+, headerSize_(0)
+, messageStart_(0)
+, packetCount_(0)
+, allocated_(0)
+, idle_(0)
+{
+  startPacket();
+}
+
+PacketDestination::~PacketDestination()
+{
+  for(size_t pos = 0; pos < packets_.size(); ++pos)
+  {
+    delete packets_[pos];
+  }
+}
+
+void
+PacketDestination::setSequenceNumber(uint32 first, bool bigEndian)
+{
+  if(messageStart_ != headerSize_)
+  {
+    throw UsageError("Coding error", "PacketDestination: sequence number set after encoding started.");
+  }
+  useSequenceNumber_ = true;
+  bigEndian_ = bigEndian;
+  sequenceNumber_ = first;
+  startPacket();
+}
+
+void
+PacketDestination::startPacket()
+{
+  clear();
+  headerSize_ = 0;
+  if(useSequenceNumber_)
+  {
+    for(size_t pos = 0; pos < sizeof(uint32); ++pos)
+    {
+      size_t shift = bigEndian_ ? (sizeof(uint32) - 1 - pos) * 8 : pos * 8;
+      putByte(uchar(sequenceNumber_ >> shift));
+    }
+    ++sequenceNumber_;
+    headerSize_ = sizeof(uint32);
+  }
+  messageStart_ = headerSize_;
+}
+
+void
+PacketDestination::packMessage()
+{
+  if(size() != 1)
+  {
+    throw UsageError("Coding error", "PacketDestination: encoder must be in single pass mode.");
+  }
+  BufferHandle handle = getBuffer();
+  size_t used = (*this)[handle].size();
+  if(used > maxPacketSize_ && messageStart_ > headerSize_)
+  {
+    // The latest message does not fit.  Send the packet without it
+    // and start the next packet with the overflowing message.
+    size_t overflowStart = messageStart_;
+    Packet * packet = allocatePacket();
+    swapBuffer(handle, packet->data_);
+    startPacket();
+    WorkingBuffer & full = packet->data_;
+    size_t overflowSize = full.size() - overflowStart;
+    fillReserved(reserve(0), 0, full.begin() + overflowStart, overflowSize);
+    full.replace(overflowStart, overflowSize, 0, 0);
+    send(packet);
+    used = (*this)[handle].size();
+  }
+  messageStart_ = used;
+  if(used >= maxPacketSize_)
+  {
+    flush();
+  }
+}
+
+void
+PacketDestination::flush()
+{
+  if(size() == 0)
+  {
+    return;
+  }
+  BufferHandle handle = getBuffer();
+  if((*this)[handle].size() > headerSize_)
+  {
+    Packet * packet = allocatePacket();
+    swapBuffer(handle, packet->data_);
+    startPacket();
+    send(packet);
+  }
+}
+
+void
+PacketDestination::send(Packet * packet)
+{
+  if(sender_ == 0)
+  {
+    recycle(&packet->link_);
+    throw UsageError("Coding error", "PacketDestination: no sender.");
+  }
+  packet->link_.setExternal(packet->data_.begin(), packet->data_.size(), packet);
+  packet->link_.link(0);
+  ++packetCount_;
+  sender_->send(&packet->link_);
+}
+
+PacketDestination::Packet *
+PacketDestination::allocatePacket()
+{
+  boost::mutex::scoped_lock lock(poolMutex_);
+  Packet * packet = idle_;
+  if(packet != 0)
+  {
+    idle_ = packet->next_;
+  }
+  else
+  {
+    packet = new Packet;
+    packet->link_.setExtra(packet);
+    packet->data_.clear(false, maxPacketSize_);
+    packets_.push_back(packet);
+    ++allocated_;
+  }
+  packet->next_ = 0;
+  return packet;
+}
+
+void
+PacketDestination::recycle(Communication::LinkedBuffer * emptyBuffer)
+{
+  Packet * packet = static_cast<Packet *>(emptyBuffer->extra());
+  boost::mutex::scoped_lock lock(poolMutex_);
+  packet->next_ = idle_;
+  idle_ = packet;
+}
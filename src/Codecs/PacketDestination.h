@@ -0,0 +1,128 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef PACKETDESTINATION_H
+#define PACKETDESTINATION_H
+#include "PacketDestination_fwd.h"
+#include <Common/QuickFAST_Export.h>
+#include <Common/Types.h>
+#include <Common/WorkingBuffer.h>
+#include <Codecs/DataDestination.h>
+#include <Communication/BufferRecycler.h>
+#include <Communication/LinkedBuffer.h>
+#include <Communication/Sender_fwd.h>
+
+namespace QuickFAST{
+  namespace Codecs{
+    /// @brief A DataDestination that packs encoded messages into packets for a Sender.
+    ///
+    /// Messages are encoded directly into the buffer that will be sent.  When the
+    /// next message would not fit in the maximum packet size, the packet is handed
+    /// to the Sender as a LinkedBuffer that wraps the encoded data.  When the Sender
+    /// recycles the LinkedBuffer its storage is reused for a later packet, so once
+    /// the pool has warmed up no memory is allocated and no encoded data is copied
+    /// except for the single message that overflows a packet.
+    ///
+    /// Each packet may start with a sequence number.
+    ///
+    /// The Encoder must be in single pass mode (see Encoder::setSinglePass()).
+    /// Call packMessage() after each call to Encoder::encodeMessage(), and flush() to
+    /// send a partially filled packet.
+    ///
+    /// The Sender may recycle buffers from another thread.
+    class QuickFAST_Export PacketDestination
+      : public DataDestination
+      , public Communication::BufferRecycler
+    {
+    public:
+      /// @brief Construct
+      /// @param maxPacketSize is the largest packet to be sent (typically the MTU less IP and UDP headers)
+      explicit PacketDestination(size_t maxPacketSize = 1472);
+
+      /// @brief Typical virtual destructor.
+      virtual ~PacketDestination();
+
+      /// @brief Identify the Sender to receive the packets.
+      ///
+      /// The Sender should be constructed with this object as its BufferRecycler.
+      /// @param sender will send the packets.
+      void setSender(Communication::Sender & sender)
+      {
+        sender_ = &sender;
+      }
+
+      /// @brief Start each packet with a four byte sequence number.
+      ///
+      /// Compatible with a FixedSizeHeaderAnalyzer with a four byte sequence number at offset zero.
+      /// Must be called before the first message is encoded.
+      /// @param first is the sequence number for the next packet.
+      /// @param bigEndian true for network byte order.
+      void setSequenceNumber(uint32 first, bool bigEndian = true);
+
+      /// @brief The sequence number that will be given to the next packet started.
+      uint32 getSequenceNumber()const
+      {
+        return sequenceNumber_;
+      }
+
+      /// @brief Notify this object that a complete message has been encoded.
+      ///
+      /// If the message does not fit, the packet is sent without it and
+      /// the message moves to the next packet.  If the packet is full it is sent.
+      /// A message that is too large for an empty packet is sent by itself.
+      void packMessage();
+
+      /// @brief Send any messages that are waiting in a partially filled packet.
+      void flush();
+
+      /// @brief How many packets have been sent.
+      size_t packetCount()const
+      {
+        return packetCount_;
+      }
+
+      /// @brief How many buffers have been allocated for the pool.
+      size_t allocatedCount()const
+      {
+        return allocated_;
+      }
+
+      ////////////////////////////
+      // Implement BufferRecycler
+      virtual void recycle(Communication::LinkedBuffer * emptyBuffer);
+
+    private:
+      /// A LinkedBuffer and the storage it wraps.
+      struct Packet
+      {
+        Communication::LinkedBuffer link_;
+        WorkingBuffer data_;
+        Packet * next_;
+      };
+
+      void startPacket();
+      void send(Packet * packet);
+      Packet * allocatePacket();
+
+    private:
+      size_t maxPacketSize_;
+      Communication::Sender * sender_;
+      bool useSequenceNumber_;
+      bool bigEndian_;
+      uint32 sequenceNumber_;
+      size_t headerSize_;
+      /// where the most recent message begins in the current packet.
+      size_t messageStart_;
+      size_t packetCount_;
+      size_t allocated_;
+
+      boost::mutex poolMutex_;
+      Packet * idle_;
+      std::vector<Packet *> packets_;
+    };
+  }
+}
+#endif // PACKETDESTINATION_H
@@ -0,0 +1,20 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef PACKETDESTINATION_FWD_H
+#define PACKETDESTINATION_FWD_H
+#ifndef QUICKFAST_HEADERS
+#error Please include <Application/QuickFAST.h> preferably as a precompiled header file.
+#endif //QUICKFAST_HEADERS
+
+namespace QuickFAST{
+  namespace Codecs{
+    class PacketDestination;
+    /// @brief A smart pointer to a PacketDestination.
+    typedef boost::shared_ptr<PacketDestination> PacketDestinationPtr;
+  }
+}
+#endif // PACKETDESTINATION_FWD_H
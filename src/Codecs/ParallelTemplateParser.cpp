@@ -0,0 +1,173 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "ParallelTemplateParser.h"
+#include <Codecs/TemplateRegistry.h>
+#include <Common/Exceptions.h>
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Codecs;
+
+ParallelTemplateParser::ParallelTemplateParser()
+: threadCount_(0)
+, nonstandard_(0)
+, finalizedInParallel_(0)
+{
+}
+
+ParallelTemplateParser::~ParallelTemplateParser()
+{
+}
+
+void
+ParallelTemplateParser::addFile(const std::string & fileName)
+{
+  Source source;
+  source.name_ = fileName;
+  source.isFile_ = true;
+  source.finalized_ = false;
+  sources_.push_back(source);
+}
+
+void
+ParallelTemplateParser::addTemplates(const std::string & name, const std::string & xml)
+{
+  Source source;
+  source.name_ = name;
+  source.isFile_ = false;
+  source.xml_ = xml;
+  source.finalized_ = false;
+  sources_.push_back(source);
+}
+
+void
+ParallelTemplateParser::setThreadCount(size_t threads)
+{
+  threadCount_ = threads;
+}
+
+void
+ParallelTemplateParser::setNonstandard(unsigned long nonstandard)
+{
+  nonstandard_ = nonstandard;
+}
+
+TemplateRegistryPtr
+ParallelTemplateParser::parse()
+{
+  size_t threads = threadCount_;
+  if(threads == 0)
+  {
+    threads = boost::thread::hardware_concurrency();
+  }
+  threads = std::max(size_t(1), std::min(threads, sources_.size()));
+
+  // Xerces must be initialized before parsing starts on other threads,
+  // so the parsers are created here.
+  std::vector<boost::shared_ptr<XMLTemplateParser> > parsers;
+  for(size_t nThread = 0; nThread < threads; ++nThread)
+  {
+    boost::shared_ptr<XMLTemplateParser> parser(new XMLTemplateParser);
+    parser->setNonstandard(nonstandard_);
+    parser->setFinalize(false);
+    parsers.push_back(parser);
+  }
+
+  next_ = AtomicCounter(0);
+  if(threads == 1)
+  {
+    work(*parsers[0]);
+  }
+  else
+  {
+    boost::thread_group workers;
+    for(size_t nThread = 0; nThread < threads; ++nThread)
+    {
+      workers.create_thread(
+        boost::bind(&ParallelTemplateParser::work, this, boost::ref(*parsers[nThread])));
+    }
+    workers.join_all();
+  }
+
+  // Merge in the order the sources were added so the result does not
+  // depend on which thread finished first.
+  TemplateRegistryPtr registry(new TemplateRegistry);
+  finalizedInParallel_ = 0;
+  for(std::vector<Source>::iterator it = sources_.begin(); it != sources_.end(); ++it)
+  {
+    Source & source = *it;
+    try
+    {
+      if(!source.error_.empty())
+      {
+        throw TemplateDefinitionError(source.error_);
+      }
+      registry->merge(*source.registry_);
+    }
+    catch (const std::exception & ex)
+    {
+      throw TemplateDefinitionError(source.name_ + ": " + ex.what());
+    }
+    if(source.finalized_)
+    {
+      ++finalizedInParallel_;
+    }
+    source.registry_.reset();
+    source.error_.clear();
+  }
+  registry->finalize();
+  return registry;
+}
+
+void
+ParallelTemplateParser::work(XMLTemplateParser & parser)
+{
+  for(;;)
+  {
+    size_t index = size_t(++next_) - 1;
+    if(index >= sources_.size())
+    {
+      return;
+    }
+    Source & source = sources_[index];
+    try
+    {
+      parseSource(parser, source);
+    }
+    catch (const std::exception & ex)
+    {
+      source.error_ = ex.what();
+      if(source.error_.empty())
+      {
+        source.error_ = "Unknown error.";
+      }
+    }
+  }
+}
+
+void
+ParallelTemplateParser::parseSource(XMLTemplateParser & parser, Source & source)
+{
+  source.finalized_ = false;
+  if(source.isFile_)
+  {
+    std::ifstream xml(source.name_.c_str(), std::ios::in | std::ios::binary);
+    if(!xml.good())
+    {
+      throw TemplateDefinitionError("[ERR S1] Can't open template file.");
+    }
+    source.registry_ = parser.parse(xml);
+  }
+  else
+  {
+    std::stringstream xml(source.xml_);
+    source.registry_ = parser.parse(xml);
+  }
+  // Templates that refer to other files wait until everything is merged.
+  if(source.registry_->isSelfContained())
+  {
+    source.registry_->finalize();
+    source.finalized_ = true;
+  }
+}
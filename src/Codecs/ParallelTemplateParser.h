@@ -0,0 +1,99 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+
+#ifndef PARALLELTEMPLATEPARSER_H
+#define PARALLELTEMPLATEPARSER_H
+#include "ParallelTemplateParser_fwd.h"
+#include <Codecs/TemplateRegistry_fwd.h>
+#include <Codecs/XMLTemplateParser.h>
+#include <Common/AtomicCounter.h>
+#include <Common/QuickFAST_Export.h>
+
+namespace QuickFAST
+{
+  namespace Codecs
+  {
+    /// @brief Parse many XML template files into one TemplateRegistry using several threads.
+    ///
+    /// Each file is read and parsed by a worker thread into a registry of its own.
+    /// A file whose static templateRefs all name templates in the same file is
+    /// also finalized by the worker.  The registries are then merged in the order
+    /// the files were added and the merged registry is finalized.  Only the
+    /// templates that refer to other files and the dictionary indexing are left
+    /// for that step.
+    ///
+    /// The result is the same as parsing a single file that contains all of the
+    /// &lt;template> elements in the order the files were added. In particular
+    /// the dictionary indexes do not depend on the number of threads or on which
+    /// file finishes first.  Fields in the global dictionary are shared by
+    /// templates from all of the files.
+    ///
+    /// A template ID or name that is defined in more than one file is an error.
+    class QuickFAST_Export ParallelTemplateParser
+    {
+    public:
+      ParallelTemplateParser();
+      ~ParallelTemplateParser();
+
+      /// @brief Add a template file.
+      /// @param fileName names the file.  It is read by a worker thread.
+      void addFile(const std::string & fileName);
+
+      /// @brief Add templates that are already in memory.
+      /// @param name identifies the templates in error messages.
+      /// @param xml is the XML text.
+      void addTemplates(const std::string & name, const std::string & xml);
+
+      /// @brief How many worker threads to use.
+      /// @param threads the number of threads.  Zero, the default, uses one thread per processor.
+      void setThreadCount(size_t threads);
+
+      /// @brief Enable nonstandard behavior.
+      /// @param nonstandard is a bitwise OR of XMLTemplateParser::NonstandardFeatures
+      void setNonstandard(unsigned long nonstandard);
+
+      /// @brief Parse everything that has been added.
+      /// @returns the finalized registry
+      /// @throws TemplateDefinitionError naming the first file that could not be parsed.
+      TemplateRegistryPtr parse();
+
+      /// @brief How many files were finalized by the worker threads during the last parse().
+      size_t finalizedInParallel()const
+      {
+        return finalizedInParallel_;
+      }
+
+    private:
+      struct Source
+      {
+        std::string name_;
+        bool isFile_;
+        std::string xml_;
+        TemplateRegistryPtr registry_;
+        bool finalized_;
+        std::string error_;
+      };
+
+      void work(XMLTemplateParser & parser);
+      void parseSource(XMLTemplateParser & parser, Source & source);
+
+    private:
+      // forbid copy constructor
+      ParallelTemplateParser(const ParallelTemplateParser &);
+      // forbid assignment
+      ParallelTemplateParser & operator = (const ParallelTemplateParser &);
+
+    private:
+      std::vector<Source> sources_;
+      size_t threadCount_;
+      unsigned long nonstandard_;
+      AtomicCounter next_;
+      size_t finalizedInParallel_;
+    };
+  }
+}
+#endif // PARALLELTEMPLATEPARSER_H
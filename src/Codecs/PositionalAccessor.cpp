@@ -0,0 +1,190 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "PositionalAccessor.h"
+#include <Codecs/SegmentBody.h>
+#include <Codecs/FieldInstruction.h>
+#include <Common/Exceptions.h>
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Codecs;
+
+PositionalAccessor::PositionalAccessor(const SegmentBodyCPtr & segment)
+: segment_(segment)
+, slots_(segment->size())
+, cursor_(0)
+{
+  for(size_t index = 0; index < slots_.size(); ++index)
+  {
+    slots_[index].identity_ = &segment_->getInstruction(index)->getIdentity();
+  }
+}
+
+PositionalAccessor::~PositionalAccessor()
+{
+}
+
+bool
+PositionalAccessor::fieldIndex(const std::string & name, size_t & index)const
+{
+  for(size_t pos = 0; pos < slots_.size(); ++pos)
+  {
+    const Messages::FieldIdentity & identity = *slots_[pos].identity_;
+    if(identity.getLocalName() == name || identity.name() == name)
+    {
+      index = pos;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+PositionalAccessor::getSegmentBody(size_t index, SegmentBodyPtr & segment)const
+{
+  return index < slots_.size() && segment_->getInstruction(index)->getSegmentBody(segment);
+}
+
+void
+PositionalAccessor::clear()
+{
+  for(size_t index = 0; index < slots_.size(); ++index)
+  {
+    slots_[index].present_ = false;
+  }
+  cursor_ = 0;
+}
+
+PositionalAccessor::Slot &
+PositionalAccessor::slot(size_t index)
+{
+  if(index >= slots_.size())
+  {
+    throw UsageError("Coding error", "PositionalAccessor: field index out of range.");
+  }
+  return slots_[index];
+}
+
+const PositionalAccessor::Slot *
+PositionalAccessor::find(const Messages::FieldIdentity & identity)const
+{
+  size_t count = slots_.size();
+  size_t pos = cursor_;
+  for(size_t probe = 0; probe < count; ++probe)
+  {
+    if(slots_[pos].identity_ == &identity)
+    {
+      cursor_ = pos;
+      return &slots_[pos];
+    }
+    if(++pos == count)
+    {
+      pos = 0;
+    }
+  }
+  return 0;
+}
+
+bool
+PositionalAccessor::isPresent(const Messages::FieldIdentity & identity)const
+{
+  const Slot * found = find(identity);
+  return found != 0 && found->present_;
+}
+
+bool
+PositionalAccessor::getUnsignedInteger(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, uint64 & value)const
+{
+  const Slot * found = find(identity);
+  if(found == 0 || !found->present_)
+  {
+    return false;
+  }
+  value = found->unsignedInteger_;
+  return true;
+}
+
+bool
+PositionalAccessor::getSignedInteger(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, int64 & value)const
+{
+  const Slot * found = find(identity);
+  if(found == 0 || !found->present_)
+  {
+    return false;
+  }
+  value = found->signedInteger_;
+  return true;
+}
+
+bool
+PositionalAccessor::getDecimal(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, Decimal & value)const
+{
+  const Slot * found = find(identity);
+  if(found == 0 || !found->present_)
+  {
+    return false;
+  }
+  value = found->decimal_;
+  return true;
+}
+
+bool
+PositionalAccessor::getString(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const StringBuffer *& value)const
+{
+  const Slot * found = find(identity);
+  if(found == 0 || !found->present_)
+  {
+    return false;
+  }
+  value = &found->string_;
+  return true;
+}
+
+bool
+PositionalAccessor::getGroup(const Messages::FieldIdentity & identity, const Messages::MessageAccessor *& group)const
+{
+  const Slot * found = find(identity);
+  if(found == 0 || !found->present_ || found->group_ == 0)
+  {
+    return false;
+  }
+  group = found->group_;
+  return true;
+}
+
+bool
+PositionalAccessor::getSequenceLength(const Messages::FieldIdentity & identity, size_t & length)const
+{
+  const Slot * found = find(identity);
+  if(found == 0 || !found->present_)
+  {
+    return false;
+  }
+  length = found->length_;
+  return true;
+}
+
+bool
+PositionalAccessor::getSequenceEntry(const Messages::FieldIdentity & identity, size_t index, const Messages::MessageAccessor *& entry)const
+{
+  const Slot * found = find(identity);
+  if(found == 0 || !found->present_ || index >= found->length_)
+  {
+    return false;
+  }
+  entry = found->entries_[index];
+  return entry != 0;
+}
+
+const std::string &
+PositionalAccessor::getApplicationType()const
+{
+  return segment_->getApplicationType();
+}
+
+const std::string &
+PositionalAccessor::getApplicationTypeNs()const
+{
+  return segment_->getApplicationTypeNamespace();
+}
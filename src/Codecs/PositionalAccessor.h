@@ -0,0 +1,197 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef POSITIONALACCESSOR_H
+#define POSITIONALACCESSOR_H
+#include "PositionalAccessor_fwd.h"
+#include <Common/QuickFAST_Export.h>
+#include <Common/Types.h>
+#include <Common/Decimal.h>
+#include <Common/StringBuffer.h>
+#include <Codecs/SegmentBody_fwd.h>
+#include <Messages/MessageAccessor.h>
+
+namespace QuickFAST{
+  namespace Codecs{
+    /// @brief A MessageAccessor that holds values by position rather than by name.
+    ///
+    /// The accessor is bound to a template (or to the segment body of a group or
+    /// sequence) and has one slot for each field instruction in the segment.  The
+    /// application fills the slots by instruction index, typically found once at
+    /// startup with fieldIndex().
+    ///
+    /// When the Encoder asks for a field, the slot is found by comparing the
+    /// address of the instruction's identity, starting with the slot most
+    /// recently found.  Since the encoder visits the fields in template order
+    /// the field is normally in that slot or the next one, so the search ends
+    /// within two comparisons.  No strings are compared and no field objects
+    /// are created while encoding.
+    ///
+    /// Groups, sequence entries, and static template references are supplied as
+    /// nested accessors which may themselves be PositionalAccessors bound to the
+    /// nested segment body.  Nested accessors are not owned by this object.
+    class QuickFAST_Export PositionalAccessor : public Messages::MessageAccessor
+    {
+    public:
+      /// @brief Bind to a template or segment body.
+      /// @param segment defines the fields.  A TemplateCPtr may be used here.
+      explicit PositionalAccessor(const SegmentBodyCPtr & segment);
+
+      /// @brief a typical virtual destructor.
+      virtual ~PositionalAccessor();
+
+      /// @brief How many field instructions (and therefore slots) are in the segment?
+      size_t size()const
+      {
+        return slots_.size();
+      }
+
+      /// @brief Find the slot for a field.
+      /// @param name is the local or qualified name of the field.
+      /// @param[out] index will be set to the slot index if the field is found.
+      /// @returns true if the field is defined in the segment.
+      bool fieldIndex(const std::string & name, size_t & index)const;
+
+      /// @brief Find the segment body that defines a group or sequence entry.
+      ///
+      /// Use this to bind nested PositionalAccessors.
+      /// @param index identifies the group or sequence.
+      /// @param[out] segment receives the nested segment body.
+      /// @returns true if the field at index has a segment body.
+      bool getSegmentBody(size_t index, SegmentBodyPtr & segment)const;
+
+      /// @brief Mark every field absent so the accessor can be reused for the next message.
+      void clear();
+
+      /// @brief Mark a field absent.
+      /// @param index identifies the field.
+      void setAbsent(size_t index)
+      {
+        slot(index).present_ = false;
+      }
+
+      /// @brief Set an unsigned integer field.
+      /// @param index identifies the field.
+      /// @param value is the value to be encoded.
+      void setUnsignedInteger(size_t index, uint64 value)
+      {
+        Slot & target = slot(index);
+        target.present_ = true;
+        target.unsignedInteger_ = value;
+      }
+
+      /// @brief Set a signed integer field.
+      /// @param index identifies the field.
+      /// @param value is the value to be encoded.
+      void setSignedInteger(size_t index, int64 value)
+      {
+        Slot & target = slot(index);
+        target.present_ = true;
+        target.signedInteger_ = value;
+      }
+
+      /// @brief Set a decimal field.
+      /// @param index identifies the field.
+      /// @param value is the value to be encoded.
+      void setDecimal(size_t index, const Decimal & value)
+      {
+        Slot & target = slot(index);
+        target.present_ = true;
+        target.decimal_ = value;
+      }
+
+      /// @brief Set a string or byte vector field.
+      ///
+      /// The value is copied into storage that is reused from message to message.
+      /// @param index identifies the field.
+      /// @param value points to the bytes to be encoded.
+      /// @param length is the number of bytes.
+      void setString(size_t index, const uchar * value, size_t length)
+      {
+        Slot & target = slot(index);
+        target.present_ = true;
+        target.string_.assign(value, length);
+      }
+
+      /// @brief Set a string field.
+      /// @param index identifies the field.
+      /// @param value is the value to be encoded.
+      void setString(size_t index, const std::string & value)
+      {
+        setString(index, reinterpret_cast<const uchar *>(value.data()), value.size());
+      }
+
+      /// @brief Set a group or static template reference.
+      /// @param index identifies the field.
+      /// @param group provides the fields in the group.  It must outlive the encoding.
+      void setGroup(size_t index, const Messages::MessageAccessor & group)
+      {
+        Slot & target = slot(index);
+        target.present_ = true;
+        target.group_ = &group;
+      }
+
+      /// @brief Set a sequence.
+      /// @param index identifies the field.
+      /// @param entries points to an array of accessors, one per entry.  It must outlive the encoding.
+      /// @param length is the number of entries.
+      void setSequence(size_t index, const Messages::MessageAccessor * const * entries, size_t length)
+      {
+        Slot & target = slot(index);
+        target.present_ = true;
+        target.entries_ = entries;
+        target.length_ = length;
+      }
+
+      /////////////////////////////
+      // Implement MessageAccessor
+      virtual bool isPresent(const Messages::FieldIdentity & identity)const;
+      virtual bool getUnsignedInteger(const Messages::FieldIdentity & identity, ValueType::Type type, uint64 & value)const;
+      virtual bool getSignedInteger(const Messages::FieldIdentity & identity, ValueType::Type type, int64 & value)const;
+      virtual bool getDecimal(const Messages::FieldIdentity & identity, ValueType::Type type, Decimal & value)const;
+      virtual bool getString(const Messages::FieldIdentity & identity, ValueType::Type type, const StringBuffer *& value)const;
+      virtual bool getGroup(const Messages::FieldIdentity & identity, const Messages::MessageAccessor *& group)const;
+      virtual bool getSequenceLength(const Messages::FieldIdentity & identity, size_t & length)const;
+      virtual bool getSequenceEntry(const Messages::FieldIdentity & identity, size_t index, const Messages::MessageAccessor *& entry)const;
+      virtual const std::string & getApplicationType()const;
+      virtual const std::string & getApplicationTypeNs()const;
+
+    private:
+      struct Slot
+      {
+        Slot()
+          : identity_(0)
+          , present_(false)
+          , unsignedInteger_(0)
+          , signedInteger_(0)
+          , group_(0)
+          , entries_(0)
+          , length_(0)
+        {
+        }
+        const Messages::FieldIdentity * identity_;
+        bool present_;
+        uint64 unsignedInteger_;
+        int64 signedInteger_;
+        Decimal decimal_;
+        StringBuffer string_;
+        const Messages::MessageAccessor * group_;
+        const Messages::MessageAccessor * const * entries_;
+        size_t length_;
+      };
+
+      Slot & slot(size_t index);
+      const Slot * find(const Messages::FieldIdentity & identity)const;
+
+    private:
+      SegmentBodyCPtr segment_;
+      std::vector<Slot> slots_;
+      /// The slot most recently found.  The next search starts here.
+      mutable size_t cursor_;
+    };
+  }
+}
+#endif // POSITIONALACCESSOR_H
@@ -0,0 +1,20 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef POSITIONALACCESSOR_FWD_H
+#define POSITIONALACCESSOR_FWD_H
+#ifndef QUICKFAST_HEADERS
+#error Please include <Application/QuickFAST.h> preferably as a precompiled header file.
+#endif //QUICKFAST_HEADERS
+
+namespace QuickFAST{
+  namespace Codecs{
+    class PositionalAccessor;
+    /// @brief A smart pointer to a PositionalAccessor.
+    typedef boost::shared_ptr<PositionalAccessor> PositionalAccessorPtr;
+  }
+}
+#endif // POSITIONALACCESSOR_FWD_H
@@ -121,6 +121,17 @@ PresenceMap::encodeBytesNeeded()const
   return bpos + 1;
 }
 
+void
+PresenceMap::getEncoded(const uchar *& buffer, size_t & size)
+{
+  buffer = bits_;
+  size = encodeBytesNeeded();
+  if(size > 0)
+  {
+    bits_[size - 1] |= stopBit;
+  }
+}
+
 void
 PresenceMap::encode(DataDestination & destination)
 {
@@ -52,6 +52,13 @@ namespace QuickFAST{
       /// @param destination where the data is written
       void encode(DataDestination & destination);
 
+      /// @brief Prepare this presence map for output and expose the encoded bytes.
+      ///
+      /// The bytes remain valid until the presence map is changed.
+      /// @param[out] buffer will point to the encoded presence map.
+      /// @param[out] size will be set to the number of bytes to write.  Zero means no pmap bits were used.
+      void getEncoded(const uchar *& buffer, size_t & size);
+
       /// @brief Stuff a raw representation of the presence map into this object.
       ///
       /// Intended for testing/debugging.  Avoid using this in production code.
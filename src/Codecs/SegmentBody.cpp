@@ -167,6 +167,18 @@ SegmentBody::getInstruction(size_t index, FieldInstructionCPtr & value)const
   return bool(value);
 }
 
+bool
+SegmentBody::getMutableInstruction(const std::string & name, FieldInstructionPtr & value)
+{
+  size_t index = instructionIndex(name);
+  if(index >= mutableInstructions_.size())
+  {
+    return false;
+  }
+  value = mutableInstructions_[index];
+  return bool(value);
+}
+
 bool
 SegmentBody::getLengthInstruction(FieldInstructionCPtr & value)const
 {
@@ -58,6 +58,13 @@ namespace QuickFAST{
         return applicationNamespace_;
       }
 
+      /// @brief Retrieve the dictionary= attribute
+      /// @returns the dictionary name or an empty string if it was not set.
+      const std::string & getDictionaryName()const
+      {
+        return dictionaryName_;
+      }
+
       /// @brief Enable the addLengt+hInstruction() method.
       void allowLengthField()
       {
@@ -86,6 +93,14 @@ namespace QuickFAST{
         return fieldCount_;
       }
 
+      /// @brief Has finalize() completed for this segment?
+      ///
+      /// False while a recursive reference to this segment is being finalized.
+      bool isFinalized()const
+      {
+        return isFinalized_;
+      }
+
       /// @brief How many bits are needed in the presence map.
       /// @returns the maximum number of presence bits that might be used.
       size_t presenceMapBitCount()const
@@ -110,6 +125,14 @@ namespace QuickFAST{
       /// @returns true if the field instruction is found.  False if it is not defined in this segment.
       bool getInstruction(size_t index, FieldInstructionCPtr & value)const;
 
+      /// @brief Get the definition of a specific field by name (mutable version)
+      ///
+      /// Allows an application to adjust field instruction options after the template has been parsed.
+      /// @param[in] name identifies the desired field instruction.
+      /// @param[out] value is set to point to the field instruction if it is found.
+      /// @returns true if the field instruction is found.  False if it is not defined in this segment.
+      bool getMutableInstruction(const std::string & name, FieldInstructionPtr & value);
+
       /// @brief Access the instruction with the assumption that it exists.
       /// @param[in] index identifies the desired field.
       /// @returns a reference to the field instruction.
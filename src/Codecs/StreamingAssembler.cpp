@@ -72,6 +72,7 @@ StreamingAssembler::serviceQueue(
     if(more)
     {
       headerIsComplete_ = 0;
+      size_t messageSize = blockSize_;
       blockSize_ = 0;
       if(skipBlock_)
       {
@@ -86,9 +87,9 @@ StreamingAssembler::serviceQueue(
         {
           if(reset_)
           {
-            decoder_.reset();
+            decoder_.resetDecoder();
           }
-          decoder_.decodeMessage(*this, builder_);
+          decoder_.decodeMessage(*this, builder_, messageSize);
         }
         catch(std::exception & ex)
         {
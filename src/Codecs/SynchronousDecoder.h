@@ -51,7 +51,7 @@ namespace QuickFAST{
       /// @brief immediate reset
       void reset()
       {
-        decoder_.reset();
+        decoder_.resetDecoder();
       }
 
       /// @brief Enable some debugging/diagnostic information to be written to an ostream
@@ -123,7 +123,7 @@ namespace QuickFAST{
         {
           if(resetOnMessage_)
           {
-            decoder_.reset();
+            decoder_.resetDecoder();
           }
 //          if(headerBytes_ > 0)
 //          {
@@ -5,6 +5,8 @@
 #include "TemplateRegistry.h"
 #include <Codecs/Template.h>
 #include <Codecs/DictionaryIndexer.h>
+#include <Codecs/FieldInstructionTemplateRef.h>
+#include <Common/Exceptions.h>
 
 using namespace ::QuickFAST;
 using namespace ::QuickFAST::Codecs;
@@ -97,6 +99,83 @@ TemplateRegistry::addTemplate(TemplatePtr value)
   }
 }
 
+void
+TemplateRegistry::merge(TemplateRegistry & source)
+{
+  for(MutableTemplates::iterator mit = source.mutableTemplates_.begin();
+    mit != source.mutableTemplates_.end();
+    ++mit)
+  {
+    const TemplatePtr & value = *mit;
+    template_id_t id = value->getId();
+    if(id != 0 && templates_.find(id) != templates_.end())
+    {
+      std::stringstream msg;
+      msg << "[ERR D9] Template ID " << id << " is defined more than once.";
+      throw TemplateDefinitionError(msg.str());
+    }
+    std::string name;
+    value->qualifyName(name);
+    if(!name.empty() && namedTemplates_.find(name) != namedTemplates_.end())
+    {
+      std::stringstream msg;
+      msg << "[ERR D9] Template " << value->getTemplateName() << " is defined more than once.";
+      throw TemplateDefinitionError(msg.str());
+    }
+    if(value->getDictionaryName().empty() && !source.dictionaryName_.empty())
+    {
+      value->setDictionaryName(source.dictionaryName_);
+    }
+    addTemplate(value);
+  }
+}
+
+namespace
+{
+  bool referencesResolve(const TemplateRegistry & registry, const SegmentBody & segment)
+  {
+    for(size_t nField = 0; nField < segment.size(); ++nField)
+    {
+      const FieldInstructionCPtr & instruction = segment.getInstruction(nField);
+      SegmentBodyPtr body;
+      if(instruction->getSegmentBody(body))
+      {
+        if(!referencesResolve(registry, *body))
+        {
+          return false;
+        }
+      }
+      else if(instruction->fieldInstructionType() == ValueType::TEMPLATEREF)
+      {
+        const FieldInstructionStaticTemplateRef * reference =
+          dynamic_cast<const FieldInstructionStaticTemplateRef *>(instruction.get());
+        TemplateCPtr target;
+        if(reference != 0 && !registry.findNamedTemplate(
+          reference->getTemplateName(), reference->getTemplateNamespace(), target))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+}
+
+bool
+TemplateRegistry::isSelfContained() const
+{
+  for(MutableTemplates::const_iterator mit = mutableTemplates_.begin();
+    mit != mutableTemplates_.end();
+    ++mit)
+  {
+    if(!referencesResolve(*this, **mit))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 size_t
 TemplateRegistry::size()const
 {
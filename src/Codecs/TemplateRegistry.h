@@ -62,6 +62,21 @@ namespace QuickFAST{
       /// @brief do any final processing after parsing is complete.
       virtual void finalize();
 
+      /// @brief Add the templates from another registry.
+      ///
+      /// The templates are shared, not copied.  Templates that do not name a
+      /// dictionary use the dictionary named by the source's &lt;templates> element.
+      /// Dictionary indexes are assigned when finalize() is called, in the order
+      /// in which the templates were added, so merging the same registries in the
+      /// same order always produces the same indexes.
+      /// @param source supplies the templates.  It may already be finalized.
+      /// @throws TemplateDefinitionError if a template ID or name is already defined.
+      void merge(TemplateRegistry & source);
+
+      /// @brief Can this registry be finalized without templates from elsewhere?
+      /// @returns true if every static templateRef names a template in this registry.
+      bool isSelfContained() const;
+
       /// @brief How many templates are defined?
       /// @return the count of known templates.
       size_t size()const;
@@ -0,0 +1,75 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "TemplateRegistryPublisher.h"
+#include <Codecs/TemplateRegistry.h>
+#include <Common/Exceptions.h>
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Codecs;
+
+TemplateRegistryPublisher::TemplateRegistryPublisher(TemplateRegistryPtr registry)
+: current_(registry)
+{
+  if(!registry)
+  {
+    throw UsageError("Coding Error", "Template registry required.");
+  }
+}
+
+TemplateRegistryPublisher::~TemplateRegistryPublisher()
+{
+}
+
+void
+TemplateRegistryPublisher::publish(TemplateRegistryPtr registry)
+{
+  if(!registry)
+  {
+    throw UsageError("Coding Error", "Template registry required.");
+  }
+  boost::mutex::scoped_lock lock(lock_);
+  pruneRetired();
+  retired_.push_back(current_);
+  current_ = registry;
+  // readers compare generations without the lock, so update it last.
+  ++generation_;
+}
+
+TemplateRegistryPtr
+TemplateRegistryPublisher::current(long & generation) const
+{
+  boost::mutex::scoped_lock lock(lock_);
+  generation = generation_;
+  return current_;
+}
+
+TemplateRegistryPtr
+TemplateRegistryPublisher::current() const
+{
+  boost::mutex::scoped_lock lock(lock_);
+  return current_;
+}
+
+size_t
+TemplateRegistryPublisher::liveRegistries() const
+{
+  boost::mutex::scoped_lock lock(lock_);
+  pruneRetired();
+  return retired_.size() + 1;
+}
+
+void
+TemplateRegistryPublisher::pruneRetired() const
+{
+  Retired::iterator end = retired_.begin();
+  for(Retired::iterator it = retired_.begin(); it != retired_.end(); ++it)
+  {
+    if(!it->expired())
+    {
+      *end++ = *it;
+    }
+  }
+  retired_.erase(end, retired_.end());
+}
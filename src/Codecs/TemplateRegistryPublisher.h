@@ -0,0 +1,80 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef TEMPLATEREGISTRYPUBLISHER_H
+#define TEMPLATEREGISTRYPUBLISHER_H
+#include "TemplateRegistryPublisher_fwd.h"
+#include <Common/QuickFAST_Export.h>
+#include <Common/AtomicCounter.h>
+#include <Codecs/TemplateRegistry_fwd.h>
+
+namespace QuickFAST{
+  namespace Codecs{
+    /// @brief Hand a new set of templates to running decoders.
+    ///
+    /// The new TemplateRegistry is parsed and finalized by whatever thread
+    /// has the time to do it, then published here.  Each Decoder that follows
+    /// the publisher notices the change by comparing generation numbers, which
+    /// costs one read per message, and picks up the new registry at a point
+    /// where no message is partially decoded.
+    ///
+    /// Registries are never modified once published.  A decoder holds a
+    /// reference to the registry it is using, so the old registry is retired
+    /// when the publisher and the last decoder that used it have let go.
+    class QuickFAST_Export TemplateRegistryPublisher
+    {
+    public:
+      /// @brief Construct with the templates currently in use.
+      /// @param registry a finalized registry.
+      explicit TemplateRegistryPublisher(TemplateRegistryPtr registry);
+      ~TemplateRegistryPublisher();
+
+      /// @brief Replace the templates.
+      ///
+      /// May be called from any thread.
+      /// @param registry a finalized registry.  It must not change after it is published.
+      void publish(TemplateRegistryPtr registry);
+
+      /// @brief Which version of the templates is current.
+      ///
+      /// Cheap enough to call for every message.
+      /// @returns a number that changes each time a registry is published.
+      long generation() const
+      {
+        return generation_;
+      }
+
+      /// @brief Get the current registry.
+      /// @param[out] generation receives the generation of the registry returned.
+      /// @returns the most recently published registry.
+      TemplateRegistryPtr current(long & generation) const;
+
+      /// @brief Get the current registry.
+      TemplateRegistryPtr current() const;
+
+      /// @brief How many of the registries published here are still in use.
+      ///
+      /// Includes the current registry.  Registries that have been replaced
+      /// stay alive until every decoder that used them has moved on.
+      size_t liveRegistries() const;
+
+    private:
+      TemplateRegistryPublisher(const TemplateRegistryPublisher &);
+      TemplateRegistryPublisher & operator = (const TemplateRegistryPublisher &);
+      /// Forget retired registries that have been released.  Call with lock_ held.
+      void pruneRetired() const;
+
+    private:
+      mutable boost::mutex lock_;
+      TemplateRegistryPtr current_;
+      AtomicCounter generation_;
+      typedef std::vector<boost::weak_ptr<TemplateRegistry> > Retired;
+      /// Registries that have been replaced, kept to see when they are released.
+      mutable Retired retired_;
+    };
+  }
+}
+#endif // TEMPLATEREGISTRYPUBLISHER_H
@@ -0,0 +1,20 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef TEMPLATEREGISTRYPUBLISHER_FWD_H
+#define TEMPLATEREGISTRYPUBLISHER_FWD_H
+#ifndef QUICKFAST_HEADERS
+#error Please include <Application/QuickFAST.h> preferably as a precompiled header file.
+#endif //QUICKFAST_HEADERS
+
+namespace QuickFAST{
+  namespace Codecs{
+    class TemplateRegistryPublisher;
+    /// @brief A smart pointer to a TemplateRegistryPublisher.
+    typedef boost::shared_ptr<TemplateRegistryPublisher> TemplateRegistryPublisherPtr;
+  }
+}
+#endif // TEMPLATEREGISTRYPUBLISHER_FWD_H
@@ -0,0 +1,887 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "TemplateSchemaBuilder.h"
+#include <Codecs/XMLTemplateParser.h>
+#include <Codecs/BinaryTemplateWriter.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Template.h>
+#include <Codecs/FieldInstructionInt8.h>
+#include <Codecs/FieldInstructionUInt8.h>
+#include <Codecs/FieldInstructionInt16.h>
+#include <Codecs/FieldInstructionUInt16.h>
+#include <Codecs/FieldInstructionInt32.h>
+#include <Codecs/FieldInstructionUInt32.h>
+#include <Codecs/FieldInstructionInt64.h>
+#include <Codecs/FieldInstructionUInt64.h>
+#include <Codecs/FieldInstructionDecimal.h>
+#include <Codecs/FieldInstructionExponent.h>
+#include <Codecs/FieldInstructionMantissa.h>
+#include <Codecs/FieldInstructionAscii.h>
+#include <Codecs/FieldInstructionUtf8.h>
+#include <Codecs/FieldInstructionByteVector.h>
+#include <Codecs/FieldInstructionGroup.h>
+#include <Codecs/FieldInstructionSequence.h>
+#include <Codecs/FieldInstructionTemplateRef.h>
+
+#include <Codecs/FieldOpNop.h>
+#include <Codecs/FieldOpConstant.h>
+#include <Codecs/FieldOpDefault.h>
+#include <Codecs/FieldOpCopy.h>
+#include <Codecs/FieldOpDelta.h>
+#include <Codecs/FieldOpIncrement.h>
+#include <Codecs/FieldOpTail.h>
+
+#include <Common/Exceptions.h>
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Codecs;
+
+TemplateSchemaBuilder::TemplateSchemaBuilder(
+  TemplateRegistryPtr registry,
+  std::ostream * out,
+  unsigned long nonstandard
+  )
+  : registry_(registry)
+  , out_(out)
+  , nonstandard_(nonstandard)
+  , writer_(0)
+  , finalize_(true)
+{
+}
+
+TemplateSchemaBuilder::~TemplateSchemaBuilder()
+{
+}
+
+void
+TemplateSchemaBuilder::setImageWriter(BinaryTemplateWriter & writer)
+{
+  writer_ = &writer;
+}
+
+void
+TemplateSchemaBuilder::setFinalize(bool finalize)
+{
+  finalize_ = finalize;
+}
+
+void
+TemplateSchemaBuilder::endDocument()
+{
+  if(finalize_)
+  {
+    registry_->finalize();
+  }
+}
+
+void
+TemplateSchemaBuilder::startElement(
+  const std::string & tag,
+  const AttributeMap & attributeMap)
+{
+  if(writer_ != 0)
+  {
+    writer_->startElement(tag, attributeMap);
+  }
+  if(out_)
+  {
+    *out_ << std::string(2*schemaElements_.size(), ' ') << '<' << tag;
+    for(AttributeMap::const_iterator it = attributeMap.begin();
+      it != attributeMap.end();
+      ++it)
+    {
+      *out_ << ' ' << it->first << "=\"" << it->second << "\"";
+    }
+    *out_ << '>' << std::endl;
+  }
+  if (tag == "templates")
+  {
+    parseTemplateRegistry(tag, attributeMap);
+  }
+  else if (tag == "template")
+  {
+    parseTemplate(tag, attributeMap);
+  }
+  else if (tag == "typeRef")
+  {
+    parseTypeRef(tag, attributeMap);
+  }
+  else if (tag == "int8")
+  {
+    parseInt8(tag, attributeMap);
+  }
+  else if (tag == "uInt8")
+  {
+    parseUInt8(tag, attributeMap);
+  }
+  else if (tag == "int16")
+  {
+    parseInt16(tag, attributeMap);
+  }
+  else if (tag == "uInt16")
+  {
+    parseUInt16(tag, attributeMap);
+  }
+  else if (tag == "int32")
+  {
+    parseInt32(tag, attributeMap);
+  }
+  else if (tag == "uInt32")
+  {
+    parseUInt32(tag, attributeMap);
+  }
+  else if (tag == "int64")
+  {
+    parseInt64(tag, attributeMap);
+  }
+  else if (tag == "uInt64")
+  {
+    parseUInt64(tag, attributeMap);
+  }
+  else if (tag == "decimal")
+  {
+    parseDecimal(tag, attributeMap);
+  }
+  else if (tag == "string")
+  {
+    parseString(tag, attributeMap);
+  }
+  else if (tag == "byteVector")
+  {
+    parseByteVector(tag, attributeMap);
+  }
+  else if (tag == "group")
+  {
+    parseGroup(tag, attributeMap);
+  }
+  else if (tag == "sequence")
+  {
+    parseSequence(tag, attributeMap);
+  }
+  else if (tag == "nop")
+  {
+    parseNop(tag, attributeMap);
+  }
+  else if (tag == "constant")
+  {
+    parseConstant(tag, attributeMap);
+  }
+  else if (tag == "default")
+  {
+    parseDefault(tag, attributeMap);
+  }
+  else if (tag == "copy")
+  {
+    parseCopy(tag, attributeMap);
+  }
+  else if (tag == "delta")
+  {
+    parseDelta(tag, attributeMap);
+  }
+  else if (tag == "increment")
+  {
+    parseIncrement(tag, attributeMap);
+  }
+  else if (tag == "tail")
+  {
+    parseTail(tag, attributeMap);
+  }
+  else if (tag == "length")
+  {
+    parseLength(tag, attributeMap);
+  }
+  else if (tag == "exponent")
+  {
+    parseExponent(tag, attributeMap);
+  }
+  else if (tag == "mantissa")
+  {
+    parseMantissa(tag, attributeMap);
+  }
+  else if (tag == "templateRef")
+  {
+    parseTemplateRef(tag, attributeMap);
+  }
+  else
+  {
+    std::string errMsg("[ERR S1] Unknown XML tag: ");
+    errMsg += tag;
+    throw TemplateDefinitionError(errMsg);
+  }
+}
+
+void
+TemplateSchemaBuilder::endElement(const std::string & tag)
+{
+  if(writer_ != 0)
+  {
+    writer_->endElement(tag);
+  }
+  // Don't pop <templates>.  It's optional and has been forcibly pushed
+  if(tag != "templates")
+  {
+    if(schemaElements_.top().first == tag)
+    {
+      schemaElements_.pop();
+    }
+  }
+  if(out_)
+  {
+    *out_ << std::string(2*schemaElements_.size(), ' ') << "</" << tag << '>' << std::endl;;
+  }
+}
+
+bool
+TemplateSchemaBuilder::hasAttribute(
+  const AttributeMap& attributes,
+  const std::string& name)
+{
+  return attributes.find(name) != attributes.end();
+}
+
+
+const std::string &
+TemplateSchemaBuilder::getRequiredAttribute(
+  const AttributeMap& attributes,
+  const std::string& name
+  )
+{
+  AttributeMap::const_iterator it = attributes.find(name);
+  if(it == attributes.end())
+  {
+    std::string errMsg;
+    errMsg +=
+      "[ERR S1] Missing required attribute \"" + name + "\"";
+    throw TemplateDefinitionError(errMsg);
+  }
+  return it->second;
+}
+
+bool
+TemplateSchemaBuilder::getOptionalAttribute(
+  const AttributeMap& attributes,
+  const std::string& name,
+  std::string & result
+  )
+{
+  AttributeMap::const_iterator it = attributes.find(name);
+  if(it == attributes.end())
+  {
+    return false;
+  }
+  result = it->second;
+  return true;
+}
+
+bool
+TemplateSchemaBuilder::getRequiredBooleanAttribute(
+  const AttributeMap& attributes,
+  const std::string& name)
+{
+  AttributeMap::const_iterator it = attributes.find(name);
+  if(it == attributes.end())
+  {
+    std::string errMsg;
+    errMsg +=
+      "[ERR S1] Missing required attribute \"" + name + "\"";
+    throw TemplateDefinitionError(errMsg);
+  }
+  return getOptionalBooleanAttribute(attributes, name, false);
+}
+
+bool
+TemplateSchemaBuilder::getOptionalBooleanAttribute(
+  const AttributeMap& attributes,
+  const std::string& name,
+  bool defaultResult)
+{
+  bool result = defaultResult;
+  AttributeMap::const_iterator it = attributes.find(name);
+  if(it != attributes.end())
+  {
+    char yn = it->second[0];
+    yn = (char)toupper(yn);
+    if(yn != 'Y' && yn != 'N' && yn != 'T' && yn != 'F')
+    {
+      std::stringstream msg;
+      msg << "[ERR S1] Invalid boolean \"" << name << "=\"" << it->second;
+      throw TemplateDefinitionError(msg.str());
+    }
+    result = (yn == 'Y' || yn == 'T');
+  }
+  return result;
+}
+
+void
+TemplateSchemaBuilder::parseTemplateRegistry(const std::string & tag, const AttributeMap& attributes)
+{
+  // because <templates> is optional, we already have a registry.
+  std::string ns;
+  if(getOptionalAttribute(attributes, "ns", ns))
+  {
+    registry_->setNamespace(ns);
+  }
+  std::string templateNs;
+  if(getOptionalAttribute(attributes, "templateNs", templateNs))
+  {
+    registry_->setTemplateNamespace(templateNs);
+  }
+
+  std::string dictionary;
+  if (getOptionalAttribute(attributes, "dictionary", dictionary))
+  {
+    registry_->setDictionaryName(dictionary);
+  }
+//  schemaElements_.push(StackEntry(tag, registry_));
+}
+
+void
+TemplateSchemaBuilder::parseTemplate(const std::string & tag, const AttributeMap& attributes)
+{
+  TemplatePtr target(new Template);
+
+  target->setTemplateName(getRequiredAttribute(attributes, "name"));
+  std::string ns;
+  if(getOptionalAttribute(attributes, "ns", ns))
+  {
+    target->setNamespace(ns);
+  }
+
+  std::string templateNs;
+  if(getOptionalAttribute(attributes, "templateNs", templateNs))
+  {
+    target->setTemplateNamespace(templateNs);
+  }
+
+  std::string id;
+  if (getOptionalAttribute(attributes, "id", id))
+  {
+    target->setId(
+      boost::lexical_cast<template_id_t>(id)
+      );
+  }
+
+  std::string dictionary;
+  if (getOptionalAttribute(attributes, "dictionary", dictionary))
+  {
+    target->setDictionaryName(dictionary);
+  }
+
+  if(hasAttribute(attributes, "reset"))
+  {
+    target->setReset(getRequiredBooleanAttribute(attributes, "reset"));
+  }
+  else
+  {
+    target->setReset(getOptionalBooleanAttribute(attributes, "scp:reset", false));
+  }
+
+  bool ignore = getOptionalBooleanAttribute(attributes, "ignore", false);
+  target->setIgnore(ignore);
+  registry_->addTemplate(target);
+//  schemaElements_.top().second->addTemplate(target);
+  schemaElements_.push(StackEntry(tag, target));
+}
+
+void
+TemplateSchemaBuilder::parseTypeRef(const std::string & tag, const AttributeMap& attributes)
+{
+  std::string name = getRequiredAttribute(attributes, "name");
+  std::string ns;
+  getOptionalAttribute(attributes, "ns", ns);
+  schemaElements_.top().second->setApplicationType(name, ns);
+}
+void
+TemplateSchemaBuilder::parseInt8(const std::string & tag, const AttributeMap& attributes)
+{
+  std::string name = getRequiredAttribute(attributes, "name");
+  std::string ns;
+  getOptionalAttribute(attributes, "ns", ns);
+  FieldInstructionPtr field(new FieldInstructionInt8(name, ns));
+  std::string id;
+  if (getOptionalAttribute(attributes, "id", id))
+  {
+    field->setId(id);
+  }
+  std::string presence;
+  if(getOptionalAttribute(attributes, "presence", presence))
+  {
+    field->setPresence(presence == "mandatory");
+  }
+  schemaElements_.top().second->addInstruction(field);
+  schemaElements_.push(StackEntry(tag, field));
+}
+
+void
+TemplateSchemaBuilder::parseUInt8(const std::string & tag, const AttributeMap& attributes)
+{
+  std::string name = getRequiredAttribute(attributes, "name");
+  std::string ns;
+  getOptionalAttribute(attributes, "ns", ns);
+  FieldInstructionPtr field(new FieldInstructionUInt8(name, ns));
+  std::string id;
+  if (getOptionalAttribute(attributes, "id", id))
+  {
+    field->setId(id);
+  }
+  std::string presence;
+  if(getOptionalAttribute(attributes, "presence", presence))
+  {
+    field->setPresence(presence == "mandatory");
+  }
+  schemaElements_.top().second->addInstruction(field);
+  schemaElements_.push(StackEntry(tag, field));
+}
+
+void
+TemplateSchemaBuilder::parseInt16(const std::string & tag, const AttributeMap& attributes)
+{
+  std::string name = getRequiredAttribute(attributes, "name");
+  std::string ns;
+  getOptionalAttribute(attributes, "ns", ns);
+  FieldInstructionPtr field(new FieldInstructionInt16(name, ns));
+  std::string id;
+  if (getOptionalAttribute(attributes, "id", id))
+  {
+    field->setId(id);
+  }
+  std::string presence;
+  if(getOptionalAttribute(attributes, "presence", presence))
+  {
+    field->setPresence(presence == "mandatory");
+  }
+  schemaElements_.top().second->addInstruction(field);
+  schemaElements_.push(StackEntry(tag, field));
+}
+
+void
+TemplateSchemaBuilder::parseUInt16(const std::string & tag, const AttributeMap& attributes)
+{
+  std::string name = getRequiredAttribute(attributes, "name");
+  std::string ns;
+  getOptionalAttribute(attributes, "ns", ns);
+  FieldInstructionPtr field(new FieldInstructionUInt16(name, ns));
+  std::string id;
+  if (getOptionalAttribute(attributes, "id", id))
+  {
+    field->setId(id);
+  }
+  std::string presence;
+  if(getOptionalAttribute(attributes, "presence", presence))
+  {
+    field->setPresence(presence == "mandatory");
+  }
+  schemaElements_.top().second->addInstruction(field);
+  schemaElements_.push(StackEntry(tag, field));
+}
+
+void
+TemplateSchemaBuilder::parseInt32(const std::string & tag, const AttributeMap& attributes)
+{
+  std::string name = getRequiredAttribute(attributes, "name");
+  std::string ns;
+  getOptionalAttribute(attributes, "ns", ns);
+  FieldInstructionPtr field(new FieldInstructionInt32(name, ns));
+  std::string id;
+  if (getOptionalAttribute(attributes, "id", id))
+  {
+    field->setId(id);
+  }
+  std::string presence;
+  if(getOptionalAttribute(attributes, "presence", presence))
+  {
+    field->setPresence(presence == "mandatory");
+  }
+  std::string allowOverflow;
+  if(getOptionalAttribute(attributes, "ignore_overflows", allowOverflow))
+  {
+    field->setIgnoreOverflow(std::tolower(allowOverflow[0]) == 'y');
+  }
+  schemaElements_.top().second->addInstruction(field);
+  schemaElements_.push(StackEntry(tag, field));
+}
+
+void
+TemplateSchemaBuilder::parseUInt32(const std::string & tag, const AttributeMap& attributes)
+{
+  std::string name = getRequiredAttribute(attributes, "name");
+  std::string ns;
+  getOptionalAttribute(attributes, "ns", ns);
+  FieldInstructionPtr field(new FieldInstructionUInt32(name, ns));
+  std::string id;
+  if (getOptionalAttribute(attributes, "id", id))
+  {
+    field->setId(id);
+  }
+  std::string presence;
+  if(getOptionalAttribute(attributes, "presence", presence))
+  {
+    field->setPresence(presence == "mandatory");
+  }
+  schemaElements_.top().second->addInstruction(field);
+  schemaElements_.push(StackEntry(tag, field));
+}
+
+void
+TemplateSchemaBuilder::parseInt64(const std::string & tag, const AttributeMap& attributes)
+{
+  std::string name = getRequiredAttribute(attributes, "name");
+  std::string ns;
+  getOptionalAttribute(attributes, "ns", ns);
+  FieldInstructionPtr field(new FieldInstructionInt64(name, ns));
+  std::string id;
+  if (getOptionalAttribute(attributes, "id", id))
+  {
+    field->setId(id);
+  }
+  std::string presence;
+  if(getOptionalAttribute(attributes, "presence", presence))
+  {
+    field->setPresence(presence == "mandatory");
+  }
+  schemaElements_.top().second->addInstruction(field);
+  schemaElements_.push(StackEntry(tag, field));
+}
+
+void
+TemplateSchemaBuilder::parseUInt64(const std::string & tag, const AttributeMap& attributes)
+{
+  std::string name = getRequiredAttribute(attributes, "name");
+  std::string ns;
+  getOptionalAttribute(attributes, "ns", ns);
+  FieldInstructionPtr field(new FieldInstructionUInt64(name, ns));
+  std::string id;
+  if (getOptionalAttribute(attributes, "id", id))
+  {
+    field->setId(id);
+  }
+  std::string presence;
+  if(getOptionalAttribute(attributes, "presence", presence))
+  {
+    field->setPresence(presence == "mandatory");
+  }
+  schemaElements_.top().second->addInstruction(field);
+  schemaElements_.push(StackEntry(tag, field));
+}
+
+void
+TemplateSchemaBuilder::parseDecimal(const std::string & tag, const AttributeMap& attributes)
+{
+  std::string name = getRequiredAttribute(attributes, "name");
+  std::string ns;
+  getOptionalAttribute(attributes, "ns", ns);
+  FieldInstructionDecimal * decimal = new FieldInstructionDecimal(name, ns);
+  FieldInstructionPtr field(decimal);
+  std::string id;
+  if (getOptionalAttribute(attributes, "id", id))
+  {
+    field->setId(id);
+  }
+  std::string presence;
+  if(getOptionalAttribute(attributes, "presence", presence))
+  {
+    field->setPresence(presence == "mandatory");
+  }
+  std::string fixedPointExponent;
+  if(getOptionalAttribute(attributes, "fixed_point_exponent", fixedPointExponent))
+  {
+    int exponent = boost::lexical_cast<int>(fixedPointExponent);
+    if(exponent < -63 || exponent > 63)
+    {
+      throw TemplateDefinitionError("[ERR R1] fixed_point_exponent out of range.");
+    }
+    decimal->setFixedPointExponent(exponent_t(exponent));
+  }
+  schemaElements_.top().second->addInstruction(field);
+  schemaElements_.push(StackEntry(tag, field));
+}
+
+void
+TemplateSchemaBuilder::parseExponent(const std::string & tag, const AttributeMap& attributes)
+{
+  FieldInstructionExponentPtr field(new FieldInstructionExponent);
+  std::string presence;
+  if(getOptionalAttribute(attributes, "presence", presence))
+  {
+    field->setPresence(presence == "mandatory");
+  }
+  schemaElements_.top().second->setExponentInstruction(field);
+  schemaElements_.push(StackEntry(tag, field));
+}
+
+void
+TemplateSchemaBuilder::parseMantissa(const std::string & tag, const AttributeMap& attributes)
+{
+  FieldInstructionMantissaPtr field(new FieldInstructionMantissa);
+  std::string presence;
+  if(getOptionalAttribute(attributes, "presence", presence))
+  {
+    field->setPresence(presence == "mandatory");
+  }
+  schemaElements_.top().second->setMantissaInstruction(field);
+  schemaElements_.push(StackEntry(tag, field));
+}
+
+void
+TemplateSchemaBuilder::parseString(const std::string & tag, const AttributeMap& attributes)
+{
+  std::string name = getRequiredAttribute(attributes, "name");
+  std::string ns;
+  getOptionalAttribute(attributes, "ns", ns);
+
+  std::string charset = "ascii";
+  getOptionalAttribute(attributes, "charset", charset);
+  FieldInstructionPtr field;
+  if(charset == "unicode")
+  {
+    field.reset(new FieldInstructionUtf8(name, ns));
+  }
+  else
+  {
+    field.reset(new FieldInstructionAscii(name, ns));
+  }
+  std::string id;
+  if (getOptionalAttribute(attributes, "id", id))
+  {
+    field->setId(id);
+  }
+  std::string presence;
+  if(getOptionalAttribute(attributes, "presence", presence))
+  {
+    field->setPresence(presence == "mandatory");
+  }
+  schemaElements_.top().second->addInstruction(field);
+  schemaElements_.push(StackEntry(tag, field));
+}
+
+void
+TemplateSchemaBuilder::parseByteVector(const std::string & tag, const AttributeMap& attributes)
+{
+  std::string name = getRequiredAttribute(attributes, "name");
+  std::string ns;
+  getOptionalAttribute(attributes, "ns", ns);
+  FieldInstructionPtr field(new FieldInstructionByteVector(name, ns));
+  std::string id;
+  if (getOptionalAttribute(attributes, "id", id))
+  {
+    field->setId(id);
+  }
+  std::string presence;
+  if(getOptionalAttribute(attributes, "presence", presence))
+  {
+    field->setPresence(presence == "mandatory");
+  }
+  schemaElements_.top().second->addInstruction(field);
+  schemaElements_.push(StackEntry(tag, field));
+}
+
+
+void
+TemplateSchemaBuilder::parseGroup(const std::string & tag, const AttributeMap& attributes)
+{
+  std::string name = getRequiredAttribute(attributes, "name");
+  std::string ns;
+  getOptionalAttribute(attributes, "ns", ns);
+  FieldInstructionPtr field(new FieldInstructionGroup(name, ns));
+  std::string id;
+  if (getOptionalAttribute(attributes, "id", id))
+  {
+    field->setId(id);
+  }
+  std::string presence;
+  if(getOptionalAttribute(attributes, "presence", presence))
+  {
+    field->setPresence(presence == "mandatory");
+  }
+  std::string dictionary;
+  if(getOptionalAttribute(attributes, "dictionary", dictionary))
+  {
+    field->setDictionaryName(dictionary);
+  }
+  SegmentBodyPtr body(new SegmentBody);
+  field->setSegmentBody(body);
+
+  schemaElements_.top().second->addInstruction(field);
+  schemaElements_.push(StackEntry(tag, body));
+}
+
+void
+TemplateSchemaBuilder::parseSequence(const std::string & tag, const AttributeMap& attributes)
+{
+  std::string name = getRequiredAttribute(attributes, "name");
+  std::string ns;
+  getOptionalAttribute(attributes, "ns", ns);
+  FieldInstructionPtr field(new FieldInstructionSequence(name, ns));
+  std::string id;
+  if (getOptionalAttribute(attributes, "id", id))
+  {
+    field->setId(id);
+  }
+  std::string presence;
+  bool mandatory = true;
+  if(getOptionalAttribute(attributes, "presence", presence))
+  {
+    mandatory = presence == "mandatory";
+    field->setPresence(mandatory);
+  }
+  std::string dictionary;
+  if(getOptionalAttribute(attributes, "dictionary", dictionary))
+  {
+    field->setDictionaryName(dictionary);
+  }
+  SegmentBodyPtr body(new SegmentBody);
+  field->setSegmentBody(body);
+  body->allowLengthField();
+  body->setMandatoryLength(mandatory);
+
+  schemaElements_.top().second->addInstruction(field);
+  schemaElements_.push(StackEntry(tag, body));
+}
+
+void
+TemplateSchemaBuilder::parseLength(const std::string & tag, const AttributeMap& attributes)
+{
+  std::string name = getRequiredAttribute(attributes, "name");
+  std::string ns;
+  getOptionalAttribute(attributes, "ns", ns);
+  FieldInstructionPtr field(new FieldInstructionLength(name, ns));
+  std::string id;
+  if(getOptionalAttribute(attributes, "id", id))
+  {
+    field->setId(id);
+  }
+  if(nonstandard_ & XMLTemplateParser::NONSTANDARD_PresenceOnLengthInstruction)
+  {
+    std::string presence;
+    bool mandatory = true;
+    if(getOptionalAttribute(attributes, "presence", presence))
+    {
+      mandatory = presence == "mandatory";
+      field->setPresence(mandatory);
+    }
+  }
+  schemaElements_.top().second->addLengthInstruction(field);
+  // Is this push necessary?
+  schemaElements_.push(StackEntry(tag, field));
+}
+
+void
+TemplateSchemaBuilder::parseTemplateRef(const std::string & tag, const AttributeMap& attributes)
+{
+  FieldInstructionPtr field;
+  std::string name;
+  if(getOptionalAttribute(attributes, "name", name))
+  {
+    std::string ns;
+    getOptionalAttribute(attributes, "ns", ns);
+    field.reset(new FieldInstructionStaticTemplateRef(name, ns));
+  }
+  else
+  {
+    field.reset(new FieldInstructionDynamicTemplateRef);
+  }
+  schemaElements_.top().second->addInstruction(field);
+  // Is this push necessary?
+  schemaElements_.push(StackEntry(tag, field));
+}
+
+void
+TemplateSchemaBuilder::parseNop(const std::string & tag, const AttributeMap& attributes)
+{
+  FieldOpPtr op(new FieldOpNop);
+  parseOp(tag, attributes, op);
+
+}
+
+void
+TemplateSchemaBuilder::parseConstant(const std::string & tag, const AttributeMap& attributes)
+{
+  getRequiredAttribute(attributes, "value");
+  FieldOpPtr op(new FieldOpConstant);
+  parseInitialValue(tag, attributes, op);
+}
+
+void
+TemplateSchemaBuilder::parseDefault(const std::string & tag, const AttributeMap& attributes)
+{
+  FieldOpPtr op(new FieldOpDefault);
+  parseInitialValue(tag, attributes, op);
+}
+
+void
+TemplateSchemaBuilder::parseCopy(const std::string & tag, const AttributeMap& attributes)
+{
+  FieldOpPtr op(new FieldOpCopy);
+  parseOp(tag, attributes, op);
+}
+
+void
+TemplateSchemaBuilder::parseDelta(const std::string & tag, const AttributeMap& attributes)
+{
+  FieldOpPtr op(new FieldOpDelta);
+  parseOp(tag, attributes, op);
+}
+
+void
+TemplateSchemaBuilder::parseIncrement(const std::string & tag, const AttributeMap& attributes)
+{
+  FieldOpPtr op(new FieldOpIncrement);
+  parseOp(tag, attributes, op);
+}
+
+void
+TemplateSchemaBuilder::parseTail(const std::string & tag, const AttributeMap& attributes)
+{
+  FieldOpPtr op(new FieldOpTail);
+  parseOp(tag, attributes, op);
+}
+
+void
+TemplateSchemaBuilder::parseInitialValue(const std::string & tag, const AttributeMap& attributes, FieldOpPtr op)
+{
+  std::string value;
+  if(getOptionalAttribute(attributes, "value", value))
+  {
+    op->setValue(value);
+  }
+  schemaElements_.top().second->setFieldOp(op);
+  // is this push necessary?
+  schemaElements_.push(StackEntry(tag, op));
+}
+
+void
+TemplateSchemaBuilder::parseOp(const std::string & tag, const AttributeMap& attributes, FieldOpPtr op)
+{
+  std::string dictionary;
+  if(getOptionalAttribute(attributes, "dictionary", dictionary))
+  {
+    op->setDictionaryName(dictionary);
+  }
+  std::string key;
+  if(getOptionalAttribute(attributes, "key", key))
+  {
+    op->setKey(key);
+    std::string nsKey;
+    if(getOptionalAttribute(attributes, "nsKey", nsKey))
+    {
+      op->setKeyNamespace(nsKey);
+    }
+  }
+  std::string value;
+  if(getOptionalAttribute(attributes, "value", value))
+  {
+    op->setValue(value);
+  }
+
+  std::string pmapBitStr;
+  if(getOptionalAttribute(attributes, "pmap", pmapBitStr))
+  {
+    size_t pmapBit = atoi(pmapBitStr.c_str());
+    op->setPMapBit(pmapBit);
+  }
+  schemaElements_.top().second->setFieldOp(op);
+  // is this push necessary?
+  schemaElements_.push(StackEntry(tag, op));
+}
@@ -0,0 +1,141 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+
+#ifndef TEMPLATESCHEMABUILDER_H
+#define TEMPLATESCHEMABUILDER_H
+
+#include "TemplateSchemaBuilder_fwd.h"
+#include <Codecs/TemplateRegistry_fwd.h>
+#include <Codecs/SchemaElement_fwd.h>
+#include <Codecs/FieldOp_fwd.h>
+#include <Codecs/BinaryTemplateWriter_fwd.h>
+#include <Common/QuickFAST_Export.h>
+
+namespace QuickFAST
+{
+  namespace Codecs
+  {
+    /// @brief Build a TemplateRegistry from the elements of a template file.
+    ///
+    /// The elements and attributes are those of the XML template schema.
+    /// See XMLTemplateParser for the mapping from elements to objects.
+    ///
+    /// This class does not depend on an XML parser.  The XMLTemplateParser
+    /// feeds it the elements found by Xerces.  The BinaryTemplateParser
+    /// feeds it the elements recorded in a precompiled template image.
+    class QuickFAST_Export TemplateSchemaBuilder
+    {
+    public:
+      /// @brief The attributes of an element: name to value.
+      typedef std::map<std::string, std::string> AttributeMap;
+
+      /// @brief Construct
+      /// @param registry receives the templates
+      /// @param out if not null receives a trace of the elements.
+      /// @param nonstandard is a bitwise OR of XMLTemplateParser::NonstandardFeatures
+      TemplateSchemaBuilder(
+        TemplateRegistryPtr registry,
+        std::ostream * out,
+        unsigned long nonstandard);
+
+      ~TemplateSchemaBuilder();
+
+      /// @brief Also give every element to a writer.
+      /// @param writer records the elements to produce a template image.
+      void setImageWriter(BinaryTemplateWriter & writer);
+
+      /// @brief Should endDocument() finalize the registry?
+      /// @param finalize false to leave that to the caller.  The default is true.
+      void setFinalize(bool finalize);
+
+      /// @brief Handle the start of an element
+      /// @param tag is the element's local name
+      /// @param attributes are the element's attributes
+      void startElement(const std::string & tag, const AttributeMap & attributes);
+
+      /// @brief Handle the end of an element
+      /// @param tag is the element's local name
+      void endElement(const std::string & tag);
+
+      /// @brief All elements have been handled: finalize the registry unless told not to.
+      void endDocument();
+
+    private:
+      const std::string & getRequiredAttribute(
+      const AttributeMap& attributes,
+      const std::string& name);
+
+      bool getOptionalAttribute(
+      const AttributeMap& attributes,
+      const std::string& name,
+      std::string & result);
+
+      bool getRequiredBooleanAttribute(
+        const AttributeMap& attributes,
+        const std::string& name);
+
+      bool getOptionalBooleanAttribute(
+        const AttributeMap& attributes,
+        const std::string& name,
+        bool defaultResult
+        );
+
+      bool hasAttribute(
+        const AttributeMap& attributes,
+        const std::string& name);
+
+      void parseTemplateRegistry(const std::string & tag, const AttributeMap& attributes);
+      void parseTemplate(const std::string & tag, const AttributeMap& attributes);
+      void parseTypeRef(const std::string & tag, const AttributeMap& attributes);
+      void parseInt8(const std::string & tag, const AttributeMap& attributes);
+      void parseUInt8(const std::string & tag, const AttributeMap& attributes);
+      void parseInt16(const std::string & tag, const AttributeMap& attributes);
+      void parseUInt16(const std::string & tag, const AttributeMap& attributes);
+      void parseInt32(const std::string & tag, const AttributeMap& attributes);
+      void parseUInt32(const std::string & tag, const AttributeMap& attributes);
+      void parseInt64(const std::string & tag, const AttributeMap& attributes);
+      void parseUInt64(const std::string & tag, const AttributeMap& attributes);
+      void parseDecimal(const std::string & tag, const AttributeMap& attributes);
+      void parseExponent(const std::string & tag, const AttributeMap& attributes);
+      void parseMantissa(const std::string & tag, const AttributeMap& attributes);
+      void parseString(const std::string & tag, const AttributeMap& attributes);
+      void parseByteVector(const std::string & tag, const AttributeMap& attributes);
+      void parseGroup(const std::string & tag, const AttributeMap& attributes);
+      void parseSequence(const std::string & tag, const AttributeMap& attributes);
+      void parseLength(const std::string & tag, const AttributeMap& attributes);
+      void parseNop(const std::string & tag, const AttributeMap& attributes);
+      void parseConstant(const std::string & tag, const AttributeMap& attributes);
+      void parseDefault(const std::string & tag, const AttributeMap& attributes);
+      void parseCopy(const std::string & tag, const AttributeMap& attributes);
+      void parseDelta(const std::string & tag, const AttributeMap& attributes);
+      void parseIncrement(const std::string & tag, const AttributeMap& attributes);
+      void parseTail(const std::string & tag, const AttributeMap& attributes);
+      void parseTemplateRef(const std::string & tag, const AttributeMap& attributes);
+
+      void parseInitialValue(const std::string & tag, const AttributeMap& attributes, FieldOpPtr op);
+      void parseOp(const std::string & tag, const AttributeMap& attributes, FieldOpPtr op);
+
+    private:
+      // forbid copy constructor
+      TemplateSchemaBuilder(const TemplateSchemaBuilder &);
+      // forbid assignment
+      TemplateSchemaBuilder & operator = (const TemplateSchemaBuilder &);
+
+    private:
+      TemplateRegistryPtr registry_;
+      typedef std::pair<std::string, SchemaElementPtr> StackEntry;
+      typedef std::stack<StackEntry> SchemaStack ;
+      SchemaStack schemaElements_;
+      std::ostream * out_;
+      unsigned long nonstandard_;
+      BinaryTemplateWriter * writer_;
+      bool finalize_;
+    };
+  }
+}
+
+#endif /* TEMPLATESCHEMABUILDER_H */
@@ -4,32 +4,9 @@
 #include <Common/QuickFASTPch.h>
 #include "XMLTemplateParser.h"
 #include <Codecs/TemplateRegistry.h>
-#include <Codecs/Template.h>
-#include <Codecs/FieldInstructionInt8.h>
-#include <Codecs/FieldInstructionUInt8.h>
-#include <Codecs/FieldInstructionInt16.h>
-#include <Codecs/FieldInstructionUInt16.h>
-#include <Codecs/FieldInstructionInt32.h>
-#include <Codecs/FieldInstructionUInt32.h>
-#include <Codecs/FieldInstructionInt64.h>
-#include <Codecs/FieldInstructionUInt64.h>
-#include <Codecs/FieldInstructionDecimal.h>
-#include <Codecs/FieldInstructionExponent.h>
-#include <Codecs/FieldInstructionMantissa.h>
-#include <Codecs/FieldInstructionAscii.h>
-#include <Codecs/FieldInstructionUtf8.h>
-#include <Codecs/FieldInstructionByteVector.h>
-#include <Codecs/FieldInstructionGroup.h>
-#include <Codecs/FieldInstructionSequence.h>
-#include <Codecs/FieldInstructionTemplateRef.h>
-
-#include <Codecs/FieldOpNop.h>
-#include <Codecs/FieldOpConstant.h>
-#include <Codecs/FieldOpDefault.h>
-#include <Codecs/FieldOpCopy.h>
-#include <Codecs/FieldOpDelta.h>
-#include <Codecs/FieldOpIncrement.h>
-#include <Codecs/FieldOpTail.h>
+#include <Codecs/TemplateSchemaBuilder.h>
+#include <Codecs/BinaryTemplateWriter.h>
+#include <Codecs/BinaryTemplateParser.h>
 
 #include <Common/Exceptions.h>
 
@@ -54,7 +31,7 @@ namespace
   {
   public:
     /// @brief An easier-to-access version of the XML attributes
-    typedef std::map<std::string, std::string> AttributeMap;
+    typedef TemplateSchemaBuilder::AttributeMap AttributeMap;
 
     /// @brief Be sure the correct memory allocator is used to free Xerces allocated strings.
     ///
@@ -73,15 +50,8 @@ namespace
 
 
   public:
-    TemplateBuilder(
-      TemplateRegistryPtr registry,
-      std::ostream * out,
-      unsigned long nonstandard
-      )
-      : registry_(registry)
-      , out_(out)
-      , nonstandard_(nonstandard)
-
+    TemplateBuilder(TemplateSchemaBuilder & builder)
+      : builder_(builder)
     {
     }
 
@@ -108,7 +78,7 @@ namespace
 
     virtual void endDocument()
     {
-      registry_->finalize();
+      builder_.endDocument();
     }
 
     virtual void startElement(
@@ -122,135 +92,11 @@ namespace
       AttributeMap attributeMap;
       makeAttrs(attributes, attributeMap);
 
-      // then switch on element tag
+      // then hand it to the builder
       boost::shared_array<char> tagRaw(XMLString::transcode(localname),
           XMLStringReleaser());
       std::string tag(tagRaw.get());
-      if(out_)
-      {
-        *out_ << std::string(2*schemaElements_.size(), ' ') << '<' << tag;
-        for(AttributeMap::const_iterator it = attributeMap.begin();
-          it != attributeMap.end();
-          ++it)
-        {
-          *out_ << ' ' << it->first << "=\"" << it->second << "\"";
-        }
-        *out_ << '>' << std::endl;
-      }
-      if (tag == "templates")
-      {
-        parseTemplateRegistry(tag, attributeMap);
-      }
-      else if (tag == "template")
-      {
-        parseTemplate(tag, attributeMap);
-      }
-      else if (tag == "typeRef")
-      {
-        parseTypeRef(tag, attributeMap);
-      }
-      else if (tag == "int8")
-      {
-        parseInt8(tag, attributeMap);
-      }
-      else if (tag == "uInt8")
-      {
-        parseUInt8(tag, attributeMap);
-      }
-      else if (tag == "int16")
-      {
-        parseInt16(tag, attributeMap);
-      }
-      else if (tag == "uInt16")
-      {
-        parseUInt16(tag, attributeMap);
-      }
-      else if (tag == "int32")
-      {
-        parseInt32(tag, attributeMap);
-      }
-      else if (tag == "uInt32")
-      {
-        parseUInt32(tag, attributeMap);
-      }
-      else if (tag == "int64")
-      {
-        parseInt64(tag, attributeMap);
-      }
-      else if (tag == "uInt64")
-      {
-        parseUInt64(tag, attributeMap);
-      }
-      else if (tag == "decimal")
-      {
-        parseDecimal(tag, attributeMap);
-      }
-      else if (tag == "string")
-      {
-        parseString(tag, attributeMap);
-      }
-      else if (tag == "byteVector")
-      {
-        parseByteVector(tag, attributeMap);
-      }
-      else if (tag == "group")
-      {
-        parseGroup(tag, attributeMap);
-      }
-      else if (tag == "sequence")
-      {
-        parseSequence(tag, attributeMap);
-      }
-      else if (tag == "nop")
-      {
-        parseNop(tag, attributeMap);
-      }
-      else if (tag == "constant")
-      {
-        parseConstant(tag, attributeMap);
-      }
-      else if (tag == "default")
-      {
-        parseDefault(tag, attributeMap);
-      }
-      else if (tag == "copy")
-      {
-        parseCopy(tag, attributeMap);
-      }
-      else if (tag == "delta")
-      {
-        parseDelta(tag, attributeMap);
-      }
-      else if (tag == "increment")
-      {
-        parseIncrement(tag, attributeMap);
-      }
-      else if (tag == "tail")
-      {
-        parseTail(tag, attributeMap);
-      }
-      else if (tag == "length")
-      {
-        parseLength(tag, attributeMap);
-      }
-      else if (tag == "exponent")
-      {
-        parseExponent(tag, attributeMap);
-      }
-      else if (tag == "mantissa")
-      {
-        parseMantissa(tag, attributeMap);
-      }
-      else if (tag == "templateRef")
-      {
-        parseTemplateRef(tag, attributeMap);
-      }
-      else
-      {
-        std::string errMsg("[ERR S1] Unknown XML tag: ");
-        errMsg += tag;
-        throw TemplateDefinitionError(errMsg);
-      }
+      builder_.startElement(tag, attributeMap);
     }
 
     virtual void endElement(
@@ -262,19 +108,7 @@ namespace
       boost::shared_array<char> tagRaw(XMLString::transcode(localname),
           XMLStringReleaser());
       std::string tag(tagRaw.get());
-
-      // Don't pop <templates>.  It's optional and has been forcibly pushed
-      if(tag != "templates")
-      {
-        if(schemaElements_.top().first == tag)
-        {
-          schemaElements_.pop();
-        }
-      }
-      if(out_)
-      {
-        *out_ << std::string(2*schemaElements_.size(), ' ') << "</" << tag << '>' << std::endl;;
-      }
+      builder_.endElement(tag);
     }
 
     virtual void characters(
@@ -343,749 +177,92 @@ namespace
     }
 
   private:
-    TemplateRegistryPtr registry_;
-
-    const std::string & getRequiredAttribute(
-    const AttributeMap& attributes,
-    const std::string& name);
-
-    bool getOptionalAttribute(
-    const AttributeMap& attributes,
-    const std::string& name,
-    std::string & result);
-
-    bool getRequiredBooleanAttribute(
-      const AttributeMap& attributes,
-      const std::string& name);
-
-    bool getOptionalBooleanAttribute(
-      const AttributeMap& attributes,
-      const std::string& name,
-      bool defaultResult
-      );
-
-    bool hasAttribute(
-      const AttributeMap& attributes,
-      const std::string& name);
-
-
-
-    void parseTemplateRegistry(const std::string & tag, const AttributeMap& attributes);
-    void parseTemplate(const std::string & tag, const AttributeMap& attributes);
-    void parseTypeRef(const std::string & tag, const AttributeMap& attributes);
-    void parseInt8(const std::string & tag, const AttributeMap& attributes);
-    void parseUInt8(const std::string & tag, const AttributeMap& attributes);
-    void parseInt16(const std::string & tag, const AttributeMap& attributes);
-    void parseUInt16(const std::string & tag, const AttributeMap& attributes);
-    void parseInt32(const std::string & tag, const AttributeMap& attributes);
-    void parseUInt32(const std::string & tag, const AttributeMap& attributes);
-    void parseInt64(const std::string & tag, const AttributeMap& attributes);
-    void parseUInt64(const std::string & tag, const AttributeMap& attributes);
-    void parseDecimal(const std::string & tag, const AttributeMap& attributes);
-    void parseExponent(const std::string & tag, const AttributeMap& attributes);
-    void parseMantissa(const std::string & tag, const AttributeMap& attributes);
-    void parseString(const std::string & tag, const AttributeMap& attributes);
-    void parseByteVector(const std::string & tag, const AttributeMap& attributes);
-//    void parseBitMap(const std::string & tag, const AttributeMap& attributes);
-    void parseGroup(const std::string & tag, const AttributeMap& attributes);
-    void parseSequence(const std::string & tag, const AttributeMap& attributes);
-    void parseLength(const std::string & tag, const AttributeMap& attributes);
-    void parseNop(const std::string & tag, const AttributeMap& attributes);
-    void parseConstant(const std::string & tag, const AttributeMap& attributes);
-    void parseDefault(const std::string & tag, const AttributeMap& attributes);
-    void parseCopy(const std::string & tag, const AttributeMap& attributes);
-    void parseDelta(const std::string & tag, const AttributeMap& attributes);
-    void parseIncrement(const std::string & tag, const AttributeMap& attributes);
-    void parseTail(const std::string & tag, const AttributeMap& attributes);
-    void parseTemplateRef(const std::string & tag, const AttributeMap& attributes);
-
-    void parseInitialValue(const std::string & tag, const AttributeMap& attributes, FieldOpPtr op);
-    void parseOp(const std::string & tag, const AttributeMap& attributes, FieldOpPtr op);
-
-  private:
-    typedef std::pair<std::string, SchemaElementPtr> StackEntry;
-    typedef std::stack<StackEntry> SchemaStack ;
-    SchemaStack schemaElements_;
-    std::ostream * out_;
-    unsigned long nonstandard_;
+    TemplateSchemaBuilder & builder_;
   };
 }
 
+//////////////////////////////////////
+/// XML Template Parser Implementation
 
-bool
-TemplateBuilder::hasAttribute(
-  const AttributeMap& attributes,
-  const std::string& name)
-{
-  return attributes.find(name) != attributes.end();
-}
-
-
-const std::string &
-TemplateBuilder::getRequiredAttribute(
-  const AttributeMap& attributes,
-  const std::string& name
-  )
-{
-  AttributeMap::const_iterator it = attributes.find(name);
-  if(it == attributes.end())
-  {
-    std::string errMsg;
-    errMsg +=
-      "[ERR S1] Missing required attribute \"" + name + "\"";
-    throw TemplateDefinitionError(errMsg);
-  }
-  return it->second;
-}
-
-bool
-TemplateBuilder::getOptionalAttribute(
-  const AttributeMap& attributes,
-  const std::string& name,
-  std::string & result
-  )
-{
-  AttributeMap::const_iterator it = attributes.find(name);
-  if(it == attributes.end())
-  {
-    return false;
-  }
-  result = it->second;
-  return true;
-}
-
-bool
-TemplateBuilder::getRequiredBooleanAttribute(
-  const AttributeMap& attributes,
-  const std::string& name)
-{
-  AttributeMap::const_iterator it = attributes.find(name);
-  if(it == attributes.end())
-  {
-    std::string errMsg;
-    errMsg +=
-      "[ERR S1] Missing required attribute \"" + name + "\"";
-    throw TemplateDefinitionError(errMsg);
-  }
-  return getOptionalBooleanAttribute(attributes, name, false);
-}
-
-bool
-TemplateBuilder::getOptionalBooleanAttribute(
-  const AttributeMap& attributes,
-  const std::string& name,
-  bool defaultResult)
-{
-  bool result = defaultResult;
-  AttributeMap::const_iterator it = attributes.find(name);
-  if(it != attributes.end())
-  {
-    char yn = it->second[0];
-    yn = (char)toupper(yn);
-    if(yn != 'Y' && yn != 'N' && yn != 'T' && yn != 'F')
-    {
-      std::stringstream msg;
-      msg << "[ERR S1] Invalid boolean \"" << name << "=\"" << it->second;
-      throw TemplateDefinitionError(msg.str());
-    }
-    result = (yn == 'Y' || yn == 'T');
-  }
-  return result;
-}
-
-void
-TemplateBuilder::parseTemplateRegistry(const std::string & tag, const AttributeMap& attributes)
-{
-  // because <templates> is optional, we already have a registry.
-  std::string ns;
-  if(getOptionalAttribute(attributes, "ns", ns))
-  {
-    registry_->setNamespace(ns);
-  }
-  std::string templateNs;
-  if(getOptionalAttribute(attributes, "templateNs", templateNs))
-  {
-    registry_->setTemplateNamespace(templateNs);
-  }
-
-  std::string dictionary;
-  if (getOptionalAttribute(attributes, "dictionary", dictionary))
-  {
-    registry_->setDictionaryName(dictionary);
-  }
-//  schemaElements_.push(StackEntry(tag, registry_));
-}
-
-void
-TemplateBuilder::parseTemplate(const std::string & tag, const AttributeMap& attributes)
-{
-  TemplatePtr target(new Template);
-
-  target->setTemplateName(getRequiredAttribute(attributes, "name"));
-  std::string ns;
-  if(getOptionalAttribute(attributes, "ns", ns))
-  {
-    target->setNamespace(ns);
-  }
-
-  std::string templateNs;
-  if(getOptionalAttribute(attributes, "templateNs", templateNs))
-  {
-    target->setTemplateNamespace(templateNs);
-  }
-
-  std::string id;
-  if (getOptionalAttribute(attributes, "id", id))
-  {
-    target->setId(
-      boost::lexical_cast<template_id_t>(id)
-      );
-  }
-
-  std::string dictionary;
-  if (getOptionalAttribute(attributes, "dictionary", dictionary))
-  {
-    target->setDictionaryName(dictionary);
-  }
-
-  if(hasAttribute(attributes, "reset"))
-  {
-    target->setReset(getRequiredBooleanAttribute(attributes, "reset"));
-  }
-  else
-  {
-    target->setReset(getOptionalBooleanAttribute(attributes, "scp:reset", false));
-  }
-
-  bool ignore = getOptionalBooleanAttribute(attributes, "ignore", false);
-  target->setIgnore(ignore);
-  registry_->addTemplate(target);
-//  schemaElements_.top().second->addTemplate(target);
-  schemaElements_.push(StackEntry(tag, target));
-}
-
-void
-TemplateBuilder::parseTypeRef(const std::string & tag, const AttributeMap& attributes)
-{
-  std::string name = getRequiredAttribute(attributes, "name");
-  std::string ns;
-  getOptionalAttribute(attributes, "ns", ns);
-  schemaElements_.top().second->setApplicationType(name, ns);
-}
-void
-TemplateBuilder::parseInt8(const std::string & tag, const AttributeMap& attributes)
-{
-  std::string name = getRequiredAttribute(attributes, "name");
-  std::string ns;
-  getOptionalAttribute(attributes, "ns", ns);
-  FieldInstructionPtr field(new FieldInstructionInt8(name, ns));
-  std::string id;
-  if (getOptionalAttribute(attributes, "id", id))
-  {
-    field->setId(id);
-  }
-  std::string presence;
-  if(getOptionalAttribute(attributes, "presence", presence))
-  {
-    field->setPresence(presence == "mandatory");
-  }
-  schemaElements_.top().second->addInstruction(field);
-  schemaElements_.push(StackEntry(tag, field));
-}
-
-void
-TemplateBuilder::parseUInt8(const std::string & tag, const AttributeMap& attributes)
-{
-  std::string name = getRequiredAttribute(attributes, "name");
-  std::string ns;
-  getOptionalAttribute(attributes, "ns", ns);
-  FieldInstructionPtr field(new FieldInstructionUInt8(name, ns));
-  std::string id;
-  if (getOptionalAttribute(attributes, "id", id))
-  {
-    field->setId(id);
-  }
-  std::string presence;
-  if(getOptionalAttribute(attributes, "presence", presence))
-  {
-    field->setPresence(presence == "mandatory");
-  }
-  schemaElements_.top().second->addInstruction(field);
-  schemaElements_.push(StackEntry(tag, field));
-}
-
-void
-TemplateBuilder::parseInt16(const std::string & tag, const AttributeMap& attributes)
-{
-  std::string name = getRequiredAttribute(attributes, "name");
-  std::string ns;
-  getOptionalAttribute(attributes, "ns", ns);
-  FieldInstructionPtr field(new FieldInstructionInt16(name, ns));
-  std::string id;
-  if (getOptionalAttribute(attributes, "id", id))
-  {
-    field->setId(id);
-  }
-  std::string presence;
-  if(getOptionalAttribute(attributes, "presence", presence))
-  {
-    field->setPresence(presence == "mandatory");
-  }
-  schemaElements_.top().second->addInstruction(field);
-  schemaElements_.push(StackEntry(tag, field));
-}
-
-void
-TemplateBuilder::parseUInt16(const std::string & tag, const AttributeMap& attributes)
-{
-  std::string name = getRequiredAttribute(attributes, "name");
-  std::string ns;
-  getOptionalAttribute(attributes, "ns", ns);
-  FieldInstructionPtr field(new FieldInstructionUInt16(name, ns));
-  std::string id;
-  if (getOptionalAttribute(attributes, "id", id))
-  {
-    field->setId(id);
-  }
-  std::string presence;
-  if(getOptionalAttribute(attributes, "presence", presence))
-  {
-    field->setPresence(presence == "mandatory");
-  }
-  schemaElements_.top().second->addInstruction(field);
-  schemaElements_.push(StackEntry(tag, field));
-}
-
-void
-TemplateBuilder::parseInt32(const std::string & tag, const AttributeMap& attributes)
-{
-  std::string name = getRequiredAttribute(attributes, "name");
-  std::string ns;
-  getOptionalAttribute(attributes, "ns", ns);
-  FieldInstructionPtr field(new FieldInstructionInt32(name, ns));
-  std::string id;
-  if (getOptionalAttribute(attributes, "id", id))
-  {
-    field->setId(id);
-  }
-  std::string presence;
-  if(getOptionalAttribute(attributes, "presence", presence))
-  {
-    field->setPresence(presence == "mandatory");
-  }
-  std::string allowOverflow;
-  if(getOptionalAttribute(attributes, "ignore_overflows", allowOverflow))
-  {
-    field->setIgnoreOverflow(std::tolower(allowOverflow[0]) == 'y');
-  }
-  schemaElements_.top().second->addInstruction(field);
-  schemaElements_.push(StackEntry(tag, field));
-}
-
-void
-TemplateBuilder::parseUInt32(const std::string & tag, const AttributeMap& attributes)
-{
-  std::string name = getRequiredAttribute(attributes, "name");
-  std::string ns;
-  getOptionalAttribute(attributes, "ns", ns);
-  FieldInstructionPtr field(new FieldInstructionUInt32(name, ns));
-  std::string id;
-  if (getOptionalAttribute(attributes, "id", id))
-  {
-    field->setId(id);
-  }
-  std::string presence;
-  if(getOptionalAttribute(attributes, "presence", presence))
-  {
-    field->setPresence(presence == "mandatory");
-  }
-  schemaElements_.top().second->addInstruction(field);
-  schemaElements_.push(StackEntry(tag, field));
-}
-
-void
-TemplateBuilder::parseInt64(const std::string & tag, const AttributeMap& attributes)
-{
-  std::string name = getRequiredAttribute(attributes, "name");
-  std::string ns;
-  getOptionalAttribute(attributes, "ns", ns);
-  FieldInstructionPtr field(new FieldInstructionInt64(name, ns));
-  std::string id;
-  if (getOptionalAttribute(attributes, "id", id))
-  {
-    field->setId(id);
-  }
-  std::string presence;
-  if(getOptionalAttribute(attributes, "presence", presence))
-  {
-    field->setPresence(presence == "mandatory");
-  }
-  schemaElements_.top().second->addInstruction(field);
-  schemaElements_.push(StackEntry(tag, field));
-}
-
-void
-TemplateBuilder::parseUInt64(const std::string & tag, const AttributeMap& attributes)
-{
-  std::string name = getRequiredAttribute(attributes, "name");
-  std::string ns;
-  getOptionalAttribute(attributes, "ns", ns);
-  FieldInstructionPtr field(new FieldInstructionUInt64(name, ns));
-  std::string id;
-  if (getOptionalAttribute(attributes, "id", id))
-  {
-    field->setId(id);
-  }
-  std::string presence;
-  if(getOptionalAttribute(attributes, "presence", presence))
-  {
-    field->setPresence(presence == "mandatory");
-  }
-  schemaElements_.top().second->addInstruction(field);
-  schemaElements_.push(StackEntry(tag, field));
-}
-
-void
-TemplateBuilder::parseDecimal(const std::string & tag, const AttributeMap& attributes)
-{
-  std::string name = getRequiredAttribute(attributes, "name");
-  std::string ns;
-  getOptionalAttribute(attributes, "ns", ns);
-  FieldInstructionPtr field(new FieldInstructionDecimal(name, ns));
-  std::string id;
-  if (getOptionalAttribute(attributes, "id", id))
-  {
-    field->setId(id);
-  }
-  std::string presence;
-  if(getOptionalAttribute(attributes, "presence", presence))
-  {
-    field->setPresence(presence == "mandatory");
-  }
-  schemaElements_.top().second->addInstruction(field);
-  schemaElements_.push(StackEntry(tag, field));
-}
-
-void
-TemplateBuilder::parseExponent(const std::string & tag, const AttributeMap& attributes)
-{
-  FieldInstructionExponentPtr field(new FieldInstructionExponent);
-  std::string presence;
-  if(getOptionalAttribute(attributes, "presence", presence))
-  {
-    field->setPresence(presence == "mandatory");
-  }
-  schemaElements_.top().second->setExponentInstruction(field);
-  schemaElements_.push(StackEntry(tag, field));
-}
-
-void
-TemplateBuilder::parseMantissa(const std::string & tag, const AttributeMap& attributes)
-{
-  FieldInstructionMantissaPtr field(new FieldInstructionMantissa);
-  std::string presence;
-  if(getOptionalAttribute(attributes, "presence", presence))
-  {
-    field->setPresence(presence == "mandatory");
-  }
-  schemaElements_.top().second->setMantissaInstruction(field);
-  schemaElements_.push(StackEntry(tag, field));
-}
-
-void
-TemplateBuilder::parseString(const std::string & tag, const AttributeMap& attributes)
-{
-  std::string name = getRequiredAttribute(attributes, "name");
-  std::string ns;
-  getOptionalAttribute(attributes, "ns", ns);
-
-  std::string charset = "ascii";
-  getOptionalAttribute(attributes, "charset", charset);
-  FieldInstructionPtr field;
-  if(charset == "unicode")
-  {
-    field.reset(new FieldInstructionUtf8(name, ns));
-  }
-  else
-  {
-    field.reset(new FieldInstructionAscii(name, ns));
-  }
-  std::string id;
-  if (getOptionalAttribute(attributes, "id", id))
-  {
-    field->setId(id);
-  }
-  std::string presence;
-  if(getOptionalAttribute(attributes, "presence", presence))
-  {
-    field->setPresence(presence == "mandatory");
-  }
-  schemaElements_.top().second->addInstruction(field);
-  schemaElements_.push(StackEntry(tag, field));
-}
-
-void
-TemplateBuilder::parseByteVector(const std::string & tag, const AttributeMap& attributes)
-{
-  std::string name = getRequiredAttribute(attributes, "name");
-  std::string ns;
-  getOptionalAttribute(attributes, "ns", ns);
-  FieldInstructionPtr field(new FieldInstructionByteVector(name, ns));
-  std::string id;
-  if (getOptionalAttribute(attributes, "id", id))
-  {
-    field->setId(id);
-  }
-  std::string presence;
-  if(getOptionalAttribute(attributes, "presence", presence))
-  {
-    field->setPresence(presence == "mandatory");
-  }
-  schemaElements_.top().second->addInstruction(field);
-  schemaElements_.push(StackEntry(tag, field));
-}
-
-
-void
-TemplateBuilder::parseGroup(const std::string & tag, const AttributeMap& attributes)
-{
-  std::string name = getRequiredAttribute(attributes, "name");
-  std::string ns;
-  getOptionalAttribute(attributes, "ns", ns);
-  FieldInstructionPtr field(new FieldInstructionGroup(name, ns));
-  std::string id;
-  if (getOptionalAttribute(attributes, "id", id))
-  {
-    field->setId(id);
-  }
-  std::string presence;
-  if(getOptionalAttribute(attributes, "presence", presence))
-  {
-    field->setPresence(presence == "mandatory");
-  }
-  std::string dictionary;
-  if(getOptionalAttribute(attributes, "dictionary", dictionary))
-  {
-    field->setDictionaryName(dictionary);
-  }
-  SegmentBodyPtr body(new SegmentBody);
-  field->setSegmentBody(body);
-
-  schemaElements_.top().second->addInstruction(field);
-  schemaElements_.push(StackEntry(tag, body));
-}
-
-void
-TemplateBuilder::parseSequence(const std::string & tag, const AttributeMap& attributes)
-{
-  std::string name = getRequiredAttribute(attributes, "name");
-  std::string ns;
-  getOptionalAttribute(attributes, "ns", ns);
-  FieldInstructionPtr field(new FieldInstructionSequence(name, ns));
-  std::string id;
-  if (getOptionalAttribute(attributes, "id", id))
-  {
-    field->setId(id);
-  }
-  std::string presence;
-  bool mandatory = true;
-  if(getOptionalAttribute(attributes, "presence", presence))
-  {
-    mandatory = presence == "mandatory";
-    field->setPresence(mandatory);
-  }
-  std::string dictionary;
-  if(getOptionalAttribute(attributes, "dictionary", dictionary))
-  {
-    field->setDictionaryName(dictionary);
-  }
-  SegmentBodyPtr body(new SegmentBody);
-  field->setSegmentBody(body);
-  body->allowLengthField();
-  body->setMandatoryLength(mandatory);
-
-  schemaElements_.top().second->addInstruction(field);
-  schemaElements_.push(StackEntry(tag, body));
-}
-
-void
-TemplateBuilder::parseLength(const std::string & tag, const AttributeMap& attributes)
-{
-  std::string name = getRequiredAttribute(attributes, "name");
-  std::string ns;
-  getOptionalAttribute(attributes, "ns", ns);
-  FieldInstructionPtr field(new FieldInstructionLength(name, ns));
-  std::string id;
-  if(getOptionalAttribute(attributes, "id", id))
-  {
-    field->setId(id);
-  }
-  if(nonstandard_ & XMLTemplateParser::NONSTANDARD_PresenceOnLengthInstruction)
-  {
-    std::string presence;
-    bool mandatory = true;
-    if(getOptionalAttribute(attributes, "presence", presence))
-    {
-      mandatory = presence == "mandatory";
-      field->setPresence(mandatory);
-    }
-  }
-  schemaElements_.top().second->addLengthInstruction(field);
-  // Is this push necessary?
-  schemaElements_.push(StackEntry(tag, field));
-}
-
-void
-TemplateBuilder::parseTemplateRef(const std::string & tag, const AttributeMap& attributes)
-{
-  FieldInstructionPtr field;
-  std::string name;
-  if(getOptionalAttribute(attributes, "name", name))
-  {
-    std::string ns;
-    getOptionalAttribute(attributes, "ns", ns);
-    field.reset(new FieldInstructionStaticTemplateRef(name, ns));
-  }
-  else
-  {
-    field.reset(new FieldInstructionDynamicTemplateRef);
-  }
-  schemaElements_.top().second->addInstruction(field);
-  // Is this push necessary?
-  schemaElements_.push(StackEntry(tag, field));
-}
-
-void
-TemplateBuilder::parseNop(const std::string & tag, const AttributeMap& attributes)
-{
-  FieldOpPtr op(new FieldOpNop);
-  parseOp(tag, attributes, op);
-
-}
-
-void
-TemplateBuilder::parseConstant(const std::string & tag, const AttributeMap& attributes)
-{
-  getRequiredAttribute(attributes, "value");
-  FieldOpPtr op(new FieldOpConstant);
-  parseInitialValue(tag, attributes, op);
-}
-
-void
-TemplateBuilder::parseDefault(const std::string & tag, const AttributeMap& attributes)
-{
-  FieldOpPtr op(new FieldOpDefault);
-  parseInitialValue(tag, attributes, op);
-}
-
-void
-TemplateBuilder::parseCopy(const std::string & tag, const AttributeMap& attributes)
-{
-  FieldOpPtr op(new FieldOpCopy);
-  parseOp(tag, attributes, op);
-}
-
-void
-TemplateBuilder::parseDelta(const std::string & tag, const AttributeMap& attributes)
-{
-  FieldOpPtr op(new FieldOpDelta);
-  parseOp(tag, attributes, op);
-}
-
-void
-TemplateBuilder::parseIncrement(const std::string & tag, const AttributeMap& attributes)
-{
-  FieldOpPtr op(new FieldOpIncrement);
-  parseOp(tag, attributes, op);
-}
-
-void
-TemplateBuilder::parseTail(const std::string & tag, const AttributeMap& attributes)
+XMLTemplateParser::XMLTemplateParser()
+: out_(0)
+, nonstandard_(0)
+, finalize_(true)
 {
-  FieldOpPtr op(new FieldOpTail);
-  parseOp(tag, attributes, op);
+  // This can throw an XMLException
+  XMLPlatformUtils::Initialize();
 }
 
-void
-TemplateBuilder::parseInitialValue(const std::string & tag, const AttributeMap& attributes, FieldOpPtr op)
+XMLTemplateParser::~XMLTemplateParser()
 {
-  std::string value;
-  if(getOptionalAttribute(attributes, "value", value))
-  {
-    op->setValue(value);
-  }
-  schemaElements_.top().second->setFieldOp(op);
-  // is this push necessary?
-  schemaElements_.push(StackEntry(tag, op));
+  XMLPlatformUtils::Terminate();
 }
 
 void
-TemplateBuilder::parseOp(const std::string & tag, const AttributeMap& attributes, FieldOpPtr op)
+XMLTemplateParser::read(std::istream& xmlData, std::string & xml)
 {
-  std::string dictionary;
-  if(getOptionalAttribute(attributes, "dictionary", dictionary))
-  {
-    op->setDictionaryName(dictionary);
-  }
-  std::string key;
-  if(getOptionalAttribute(attributes, "key", key))
-  {
-    op->setKey(key);
-    std::string nsKey;
-    if(getOptionalAttribute(attributes, "nsKey", nsKey))
-    {
-      op->setKeyNamespace(nsKey);
-    }
-  }
-  std::string value;
-  if(getOptionalAttribute(attributes, "value", value))
+  if(!xmlData.good())
   {
-    op->setValue(value);
+    throw TemplateDefinitionError("[ERR S1] Can't read XML templates.");
   }
+  xmlData.seekg(0, std::ios::end);
+  int length = int(xmlData.tellg());
+  xmlData.seekg(0, std::ios::beg);
 
-  std::string pmapBitStr;
-  if(getOptionalAttribute(attributes, "pmap", pmapBitStr))
+  xml.resize(length);
+  if(length > 0)
   {
-    size_t pmapBit = atoi(pmapBitStr.c_str());
-    op->setPMapBit(pmapBit);
+    xmlData.read(&xml[0], length);
   }
-  schemaElements_.top().second->setFieldOp(op);
-  // is this push necessary?
-  schemaElements_.push(StackEntry(tag, op));
 }
 
-
-//////////////////////////////////////
-/// XML Template Parser Implementation
-
-XMLTemplateParser::XMLTemplateParser()
-: out_(0)
-, nonstandard_(0)
+TemplateRegistryPtr
+XMLTemplateParser::parse(
+  std::istream& xmlData
+  )
 {
-  // This can throw an XMLException
-  XMLPlatformUtils::Initialize();
+  std::string xml;
+  read(xmlData, xml);
+  return parse(xml.data(), xml.size(), 0);
 }
 
-XMLTemplateParser::~XMLTemplateParser()
+TemplateRegistryPtr
+XMLTemplateParser::compile(
+  std::istream& xmlData,
+  std::ostream& image
+  )
 {
-  XMLPlatformUtils::Terminate();
+  std::string xml;
+  read(xmlData, xml);
+  BinaryTemplateWriter writer;
+  TemplateRegistryPtr templateRegistry = parse(xml.data(), xml.size(), &writer);
+  writer.write(
+    image,
+    *templateRegistry,
+    BinaryTemplateParser::hash(reinterpret_cast<const unsigned char *>(xml.data()), xml.size()),
+    nonstandard_);
+  return templateRegistry;
 }
 
 TemplateRegistryPtr
 XMLTemplateParser::parse(
-  std::istream& xmlData
+  const char * xmlData,
+  size_t length,
+  BinaryTemplateWriter * writer
   )
 {
-  if(!xmlData.good())
-  {
-    throw TemplateDefinitionError("[ERR S1] Can't read XML templates.");
-  }
-
   TemplateRegistryPtr templateRegistry(
     new TemplateRegistry
     );
 
-  TemplateBuilder templateBuilder(templateRegistry, out_, nonstandard_);
+  TemplateSchemaBuilder schemaBuilder(templateRegistry, out_, nonstandard_);
+  if(writer != 0)
+  {
+    schemaBuilder.setImageWriter(*writer);
+  }
+  // The image records the finalized registry.
+  schemaBuilder.setFinalize(finalize_ || writer != 0);
+  TemplateBuilder templateBuilder(schemaBuilder);
   boost::shared_ptr<SAX2XMLReader> reader(XMLReaderFactory::createXMLReader());
   reader->setContentHandler(&templateBuilder);
   reader->setErrorHandler(&templateBuilder);
@@ -1097,16 +274,9 @@ XMLTemplateParser::parse(
   // enable validation
 //  reader->setFeature(xercesc::XMLUni::fgSAX2CoreValidation, true);
 
-  xmlData.seekg(0, std::ios::end);
-  int length = int(xmlData.tellg());
-  xmlData.seekg(0, std::ios::beg);
-
-  boost::scoped_array<char> data(new char[length]);
-  xmlData.read(data.get(), length);
-
-  // Adapt the stream to what Xerces wants to see
+  // Adapt the data to what Xerces wants to see
   MemBufInputSource dataAdapter(
-    reinterpret_cast<unsigned char*>(data.get()),
+    reinterpret_cast<const unsigned char*>(xmlData),
     length,
     "FAST"
     );
@@ -1128,3 +298,9 @@ XMLTemplateParser::setNonstandard(unsigned long nonstandard)
 {
   nonstandard_ = nonstandard;
 }
+
+void
+XMLTemplateParser::setFinalize(bool finalize)
+{
+  finalize_ = finalize;
+}
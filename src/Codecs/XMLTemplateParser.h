@@ -13,6 +13,7 @@
 
 #include <Codecs/TemplateRegistry_fwd.h>
 #include <Codecs/SchemaElement_fwd.h>
+#include <Codecs/BinaryTemplateWriter_fwd.h>
 #include <Common/QuickFAST_Export.h>
 #include <istream>
 
@@ -80,6 +81,10 @@ namespace QuickFAST
     ///   id=                       setId()
     ///   presence="mandatory"      setPresence(true)  (the default)
     ///   presence="optional"       setPresence(false)
+    ///
+    /// QuickFAST extensions
+    ///   ignore_overflows="yes"    setIgnoreOverflow(true) on &lt;int32>
+    ///   fixed_point_exponent=     setFixedPointExponent() on &lt;decimal>
     /// </pre>
     /// Notes:
     ///
@@ -114,6 +119,10 @@ namespace QuickFAST
     ///   No length instruction is specified, the Sequence will automatically handle
     ///   the default length.
     ///
+    /// Precompiled templates:
+    ///   compile() parses the XML and also writes a template image which can be
+    ///   loaded later by a BinaryTemplateParser without Xerces.  See BinaryTemplateParser.
+    ///
     /// Multithreading Note:
     ///   This class was designed under the assumption that it would be run once during
     ///   initialization.  There are no guarantees that template parsing is thread-safe.
@@ -134,6 +143,16 @@ namespace QuickFAST
         std::istream& xmlData
         );
 
+      /// @brief Parse XML data and write a precompiled template image
+      /// @param xmlData is the stream that supplies the data
+      /// @param image receives the image.  It should be opened in binary mode.
+      /// @returns a TemplateRegistry containing the parsed templates.
+      TemplateRegistryPtr
+      compile(
+        std::istream& xmlData,
+        std::ostream& image
+        );
+
       /// @brief enable verbosity and give it a destination
       /// @param out the stream to which diagnostic info should be written
       void setVerboseOutput(std::ostream & out);
@@ -149,6 +168,23 @@ namespace QuickFAST
       /// Some non-standard implementatons of FAST do not comply with the Specification
       /// @param nonstandard is a bitwise OR of the nonstandard featurse that should be allowed
       void setNonstandard(unsigned long nonstandard);
+
+      /// @brief Should parse() finalize the registry?
+      ///
+      /// Turn this off to merge the templates with templates from other files
+      /// before they are finalized.  See TemplateRegistry::merge().
+      /// compile() always finalizes the registry.
+      /// @param finalize false to leave finalizing to the caller. The default is true.
+      void setFinalize(bool finalize);
+    private:
+      TemplateRegistryPtr
+      parse(
+        const char * xmlData,
+        size_t length,
+        BinaryTemplateWriter * writer
+        );
+      void read(std::istream& xmlData, std::string & xml);
+
     private:
       // forbid copy constructor
       XMLTemplateParser(const XMLTemplateParser &);
@@ -157,6 +193,7 @@ namespace QuickFAST
     private:
       std::ostream * out_;
       unsigned long nonstandard_;
+      bool finalize_;
     };
   }
 }
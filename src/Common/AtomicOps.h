@@ -156,6 +156,28 @@ namespace QuickFAST
 #endif
   }
 
+  /// @brief Read a long integer with acquire semantics
+  ///
+  /// Reads and writes that follow in program order are not moved ahead of this read,
+  /// so data published before the value was stored is visible once the value is seen.
+  /// @param target points to the long to be read
+  inline
+  long atomic_read_long(const volatile long * target)
+  {
+#if defined(_WIN32)
+    // Exchanging zero for zero changes nothing but orders the read.
+    return _InterlockedCompareExchange(const_cast<volatile long *>(target), 0, 0);
+#elif defined(__GNUC__)
+# if defined(__ATOMIC_ACQUIRE)
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+# else
+    return __sync_val_compare_and_swap(const_cast<volatile long *>(target), long(0), long(0));
+# endif
+#else
+    return long(atomic_cas_ulong(const_cast<volatile long *>(target), 0, 0));
+#endif
+  }
+
   /// @brief compare and swap long longs
   ///
   /// @param target the long long to be updated
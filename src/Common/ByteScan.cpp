@@ -0,0 +1,70 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "ByteScan.h"
+
+using namespace QuickFAST;
+
+bool
+ByteScan::isValidUtf8(const uchar * data, size_t size)
+{
+  size_t pos = 0;
+  while(pos < size)
+  {
+    // Skip the ASCII run quickly.
+    pos += findStopBit(data + pos, size - pos);
+    if(pos >= size)
+    {
+      break;
+    }
+    uchar lead = data[pos];
+    size_t trailing = 0;
+    uint32 codePoint = 0;
+    uint32 smallest = 0;
+    if((lead & 0xE0) == 0xC0)
+    {
+      trailing = 1;
+      codePoint = lead & 0x1F;
+      smallest = 0x80;
+    }
+    else if((lead & 0xF0) == 0xE0)
+    {
+      trailing = 2;
+      codePoint = lead & 0x0F;
+      smallest = 0x800;
+    }
+    else if((lead & 0xF8) == 0xF0)
+    {
+      trailing = 3;
+      codePoint = lead & 0x07;
+      smallest = 0x10000;
+    }
+    else
+    {
+      // a continuation byte or an invalid lead byte
+      return false;
+    }
+    if(size - pos <= trailing)
+    {
+      return false;
+    }
+    for(size_t nByte = 1; nByte <= trailing; ++nByte)
+    {
+      uchar byte = data[pos + nByte];
+      if((byte & 0xC0) != 0x80)
+      {
+        return false;
+      }
+      codePoint = (codePoint << 6) | (byte & 0x3F);
+    }
+    if(codePoint < smallest
+      || codePoint > 0x10FFFF
+      || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+    {
+      return false;
+    }
+    pos += trailing + 1;
+  }
+  return true;
+}
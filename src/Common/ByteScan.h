@@ -0,0 +1,85 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef BYTESCAN_H
+#define BYTESCAN_H
+#include <Common/QuickFAST_Export.h>
+#include <Common/Types.h>
+
+// Scans use SSE2 where the compiler guarantees it is available: always on
+// x86-64, and on 32 bit x86 when enabled by -msse2 or /arch:SSE2.
+// Define QUICKFAST_NO_SIMD to use the portable versions everywhere.
+#if !defined(QUICKFAST_NO_SIMD)
+# if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define QUICKFAST_HAS_SSE2
+# endif
+#endif
+
+namespace QuickFAST{
+  /// @brief Examine runs of bytes many at a time.
+  ///
+  /// These help decode strings.  Every byte in a stop bit encoded ASCII
+  /// string has its high bit clear except the last one, so finding the end
+  /// of the string also checks that its content is 7 bit ASCII.
+  ///
+  /// Nothing is read outside the range that is passed in.
+  class QuickFAST_Export ByteScan
+  {
+  public:
+    /// @brief Find the first byte with the high (stop) bit set.
+    /// @param data points to the bytes to scan.
+    /// @param size is the number of bytes to scan.
+    /// @returns the index of the byte, or size if there is none.
+    static size_t findStopBit(const uchar * data, size_t size)
+    {
+      const uint64 highBits = 0x8080808080808080ULL;
+      size_t pos = 0;
+#if defined(QUICKFAST_HAS_SSE2)
+      while(pos + 16 <= size)
+      {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos));
+        if(_mm_movemask_epi8(chunk) != 0)
+        {
+          break;
+        }
+        pos += 16;
+      }
+#endif
+      while(pos + 8 <= size)
+      {
+        uint64 word;
+        std::memcpy(&word, data + pos, sizeof(word));
+        if((word & highBits) != 0)
+        {
+          break;
+        }
+        pos += 8;
+      }
+      while(pos < size && (data[pos] & 0x80) == 0)
+      {
+        ++pos;
+      }
+      return pos;
+    }
+
+    /// @brief Check that every byte is 7 bit ASCII.
+    /// @param data points to the bytes to check.
+    /// @param size is the number of bytes to check.
+    static bool isAscii(const uchar * data, size_t size)
+    {
+      return findStopBit(data, size) == size;
+    }
+
+    /// @brief Check for a well formed UTF-8 string.
+    ///
+    /// Overlong encodings, surrogates, and code points above U+10FFFF are rejected.
+    /// @param data points to the bytes to check.
+    /// @param size is the number of bytes to check.
+    static bool isValidUtf8(const uchar * data, size_t size);
+  };
+}
+#endif // BYTESCAN_H
@@ -4,11 +4,12 @@
 #include <Common/QuickFASTPch.h>
 #include "Decimal.h"
 #include <Common/Exceptions.h>
-#include <Common/WorkingBuffer.h>
-#include <boost/algorithm/string/trim.hpp>
+#include <cctype>
 
 using namespace ::QuickFAST;
 
+const size_t Decimal::maxStringLength;
+
 Decimal::Decimal(
     mantissa_t mantissa,
     exponent_t exponent,
@@ -33,42 +34,122 @@ Decimal::~Decimal()
 void
 Decimal::parse(const std::string & value)
 {
-  std::string str = value;
-  boost::algorithm::trim(str);
-  size_t dotPos = str.find(".");
-  std::string wholeString = str.substr(0,dotPos);
-  std::string fracString;
-  if(dotPos != std::string::npos)
+  parse(value.data(), value.size());
+}
+
+void
+Decimal::parse(const char * value, size_t length)
+{
+  const char * pos = value;
+  const char * end = value + length;
+  while(pos < end && std::isspace(static_cast<unsigned char>(*pos)))
   {
-    fracString = str.substr(dotPos+1);
+    ++pos;
+  }
+  while(end > pos && std::isspace(static_cast<unsigned char>(end[-1])))
+  {
+    --end;
   }
-  std::string mantissaString = wholeString+fracString;
-  exponent_ = -exponent_t(fracString.size());
 
-  bool overflow = false;
+  bool negative = false;
+  if(pos < end && (*pos == '-' || *pos == '+'))
+  {
+    negative = (*pos == '-');
+    ++pos;
+  }
 
-  // VC8 stringstream is truncating a large string instead of throwing
-  // the exception, so we'll always fall back on the overflow code.
-#if defined _MSC_VER && _MSC_VER < 1500
-  overflow = true;
-#else
-  try {
-    mantissa_ = boost::lexical_cast<mantissa_t>(mantissaString);
+  // Accumulate the digits as an unsigned magnitude.  Zeros are held back until
+  // a nonzero digit follows so trailing zeros never cause an overflow.
+  const uint64 limit = negative ? uint64(LLONG_MAX) + 1 : uint64(LLONG_MAX);
+  uint64 magnitude = 0;
+  int exponent = 0;
+  size_t pendingZeros = 0;
+  bool fraction = false;
+  bool digits = false;
+  for(; pos < end; ++pos)
+  {
+    char c = *pos;
+    if(c >= '0' && c <= '9')
+    {
+      digits = true;
+      if(fraction)
+      {
+        --exponent;
+      }
+      if(c == '0')
+      {
+        ++pendingZeros;
+        continue;
+      }
+      for(size_t nZero = 0; nZero <= pendingZeros; ++nZero)
+      {
+        if(magnitude > limit / 10)
+        {
+          throw OverflowError("[ERR R1]Decimal mantissa overflow.");
+        }
+        magnitude *= 10;
+      }
+      pendingZeros = 0;
+      uint64 digit = uint64(c - '0');
+      if(magnitude > limit - digit)
+      {
+        throw OverflowError("[ERR R1]Decimal mantissa overflow.");
+      }
+      magnitude += digit;
+    }
+    else if(c == '.' && !fraction)
+    {
+      fraction = true;
+    }
+    else
+    {
+      break;
+    }
   }
-  catch (std::exception &)
+
+  if(pos < end && (*pos == 'e' || *pos == 'E'))
   {
-    overflow = true;
+    ++pos;
+    bool negativeExponent = false;
+    if(pos < end && (*pos == '-' || *pos == '+'))
+    {
+      negativeExponent = (*pos == '-');
+      ++pos;
+    }
+    int explicitExponent = 0;
+    const char * exponentStart = pos;
+    while(pos < end && *pos >= '0' && *pos <= '9' && explicitExponent < 1000)
+    {
+      explicitExponent = explicitExponent * 10 + (*pos - '0');
+      ++pos;
+    }
+    if(pos == exponentStart)
+    {
+      digits = false;
+    }
+    exponent += negativeExponent ? -explicitExponent : explicitExponent;
   }
-#endif
 
-  if (overflow && autoNormalize_)
+  if(!digits || pos != end)
   {
-    size_t pos = mantissaString.find_last_not_of ("0");
-    exponent_ += exponent_t(mantissaString.length () - pos - 1);
-    mantissaString = mantissaString.substr (0, pos + 1);
-    mantissa_ = boost::lexical_cast<mantissa_t>(mantissaString);
+    throw UnsupportedConversion(std::string(value, length) + " cannot be converted to Decimal");
   }
 
+  // restore the held back zeros if possible; otherwise keep them in the exponent
+  while(pendingZeros > 0 && magnitude <= limit / 10)
+  {
+    magnitude *= 10;
+    --pendingZeros;
+  }
+  exponent += int(pendingZeros);
+
+  if(exponent > SCHAR_MAX || exponent < SCHAR_MIN)
+  {
+    throw OverflowError("[ERR R1]Decimal Exponent overflow.");
+  }
+  mantissa_ = negative ? mantissa_t(0 - magnitude) : mantissa_t(magnitude);
+  exponent_ = exponent_t(exponent);
+
   if(autoNormalize_)
   {
     normalize();
@@ -114,60 +195,89 @@ Decimal::getExponent() const
 void
 Decimal::toString(std::string & value)const
 {
-#if 0
-  value = boost::lexical_cast<std::string>(double(*this));
-#elif 1
-  std::stringstream str;
-  str << double(*this);
-  value = str.str();
-#else
-  WorkingBuffer buffer;
-  buffer.clear(true, 20);
-  bool negative = false;
-  int64 m = mantissa_;
-  if(m < 0)
+  char buffer[maxStringLength];
+  value.assign(buffer, toString(buffer, sizeof(buffer)));
+}
+
+size_t
+Decimal::toString(char * buffer, size_t capacity)const
+{
+  // Generate the digits of the mantissa, least significant first.
+  char digits[20];
+  size_t digitCount = 0;
+  uint64 magnitude = mantissa_ < 0 ? 0 - uint64(mantissa_) : uint64(mantissa_);
+  do
+  {
+    digits[digitCount++] = char('0' + magnitude % 10);
+    magnitude /= 10;
+  } while(magnitude != 0);
+
+  int exponent = exponent_;
+  size_t length = (mantissa_ < 0) ? 1 : 0;
+  if(mantissa_ == 0 && exponent > 0)
+  {
+    exponent = 0;
+  }
+  if(exponent >= 0)
   {
-    negative = true;
-    m = -m;
+    length += digitCount + size_t(exponent);
   }
-  short e = exponent_;
-  if(e >= 0)
+  else if(int(digitCount) > -exponent)
   {
-    // No trailing decimal point
-    // buffer.push((unsigned char)'.');
-    while(e > 0)
+    length += digitCount + 1;
+  }
+  else
+  {
+    // "0." plus leading zeros plus digits
+    length += 2 + size_t(-exponent);
+  }
+  if(length > capacity)
+  {
+    throw UsageError("Coding Error", "Decimal::toString: buffer too small.");
+  }
+
+  char * pos = buffer;
+  if(mantissa_ < 0)
+  {
+    *pos++ = '-';
+  }
+  if(exponent >= 0)
+  {
+    while(digitCount > 0)
     {
-      buffer.push((unsigned char)'0');
-      e -= 1;
+      *pos++ = digits[--digitCount];
+    }
+    for(int nZero = 0; nZero < exponent; ++nZero)
+    {
+      *pos++ = '0';
     }
   }
-  bool none = true;
-  while(m != 0 || e < 0 || none)
+  else
   {
-    none = false;
-    char c = (m % 10) + '0';
-    m /= 10;
-    buffer.push((unsigned char)c);
-    if(e < 0)
+    size_t fractionDigits = size_t(-exponent);
+    if(digitCount > fractionDigits)
     {
-      e += 1;
-      if(e == 0)
+      while(digitCount > fractionDigits)
       {
-        buffer.push((unsigned char)'.');
-        // insure at least one character to the left of the decimal point
-        if(m == 0)
-        {
-          buffer.push((unsigned char)'0');
-        }
+        *pos++ = digits[--digitCount];
       }
+      *pos++ = '.';
+    }
+    else
+    {
+      *pos++ = '0';
+      *pos++ = '.';
+      for(size_t nZero = digitCount; nZero < fractionDigits; ++nZero)
+      {
+        *pos++ = '0';
+      }
+    }
+    while(digitCount > 0)
+    {
+      *pos++ = digits[--digitCount];
     }
   }
-  if(negative)
-  {
-    buffer.push((unsigned char)'-');
-  }
-  value.assign((const char *)buffer.begin(), buffer.end()-buffer.begin());
-#endif
+  return size_t(pos - buffer);
 }
 
 Decimal &
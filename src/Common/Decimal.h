@@ -31,10 +31,22 @@ namespace QuickFAST{
     Decimal(const Decimal & rhs);
     /// @brief Destruct a decimal
     ~Decimal();
+    /// @brief The largest number of characters produced by toString(char *, size_t)
+    static const size_t maxStringLength = 150;
+
     /// @brief Parse a decimal value from a string
     ///
-    /// Supports only www.fff format. [no explicit exponent]
+    /// Supports [-]www.fff format with an optional exponent: [-]www.fffE[-]xx
+    /// The value is converted exactly: "12.30" has mantissa 1230 and exponent -2
+    /// unless autonormalize is set.
+    /// @param value is the string to be parsed.
     void parse(const std::string & value);
+
+    /// @brief Parse a decimal value from a character buffer without allocating memory.
+    /// @see parse(const std::string &)
+    /// @param value points to the characters to be parsed.
+    /// @param length is the number of characters to parse.
+    void parse(const char * value, size_t length);
     /// @brief Set the autonormalize flag.
     void setAutoNormalize(bool autoNormalize);
     /// @brief Set the mantissa directly
@@ -50,8 +62,19 @@ namespace QuickFAST{
     operator double()const;
 
     /// @brief Convert the value to an www.ffff formatted string
+    ///
+    /// The conversion is exact: no floating point arithmetic is used.
     void toString(std::string & value)const;
 
+    /// @brief Format the value as www.ffff into a caller supplied buffer.
+    ///
+    /// The conversion is exact and does not allocate memory.  The result is not null terminated.
+    /// A buffer of maxStringLength characters is always large enough.
+    /// @param buffer receives the formatted value.
+    /// @param capacity is the size of the buffer.
+    /// @returns the number of characters written.
+    size_t toString(char * buffer, size_t capacity)const;
+
     /// @brief Assignment
     Decimal & operator=(const Decimal & rhs);
 
@@ -3,98 +3,337 @@
 // See the file license.txt for licensing information.
 #include <Common/QuickFASTPch.h>
 #include "Profiler.h"
+#include <Common/AtomicOps.h>
 #include <math.h>
 
+#if defined(_MSC_VER)
+# define PROFILER_THREAD_LOCAL __declspec(thread)
+#else
+# define PROFILER_THREAD_LOCAL __thread
+#endif
+
 using namespace QuickFAST;
 
-ProfileAccumulator * ProfileAccumulator::root_ = 0;
+namespace
+{
+  /// The profile points measured by one thread.
+  /// Never deleted so the results survive the thread.
+  struct ProfileThread
+  {
+    ProfileThread()
+      : next_(0)
+    {
+      std::fill(statistics_, statistics_ + ProfileAccumulator::maxPoints, (ProfileStatistics *)0);
+    }
+    ProfileThread * next_;
+    ProfileStatistics * volatile statistics_[ProfileAccumulator::maxPoints];
+  };
 
-ProfileAccumulator::ProfileAccumulator(const char * name, const char * file, size_t line)
-  : name_(name)
-  , file_(file)
-  , line_(line)
-  , entries_(0)
+  PROFILER_THREAD_LOCAL ProfileThread * currentThread = 0;
+  void * volatile threads = 0;
+  volatile long pointCount = 0;
+
+  // The starting point for calibrating the clock.
+  uint64 calibrationTicks = ProfileClock::ticks();
+  boost::posix_time::ptime calibrationTime = boost::posix_time::microsec_clock::universal_time();
+}
+
+///////////////
+// ProfileClock
+
+double ProfileClock::ticksPerNanosecond_ = 0.0;
+
+uint64
+ProfileClock::microseconds()
+{
+  static const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+  return uint64((boost::posix_time::microsec_clock::universal_time() - epoch).total_microseconds());
+}
+
+double
+ProfileClock::ticksPerNanosecond()
+{
+  if(ticksPerNanosecond_ == 0.0)
+  {
+    calibrate();
+  }
+  return ticksPerNanosecond_;
+}
+
+void
+ProfileClock::calibrate(unsigned long milliseconds)
+{
+  boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+  while((now - calibrationTime).total_milliseconds() < long(milliseconds))
+  {
+    now = boost::posix_time::microsec_clock::universal_time();
+  }
+  uint64 ticks = ProfileClock::ticks();
+  double nanoseconds = double((now - calibrationTime).total_microseconds()) * 1000.0;
+  ticksPerNanosecond_ = double(ticks - calibrationTicks) / nanoseconds;
+  calibrationTicks = ticks;
+  calibrationTime = now;
+}
+
+///////////////////
+// ProfileHistogram
+
+ProfileHistogram::ProfileHistogram()
+{
+  clear();
+}
+
+void
+ProfileHistogram::clear()
+{
+  count_ = 0;
+  sum_ = 0;
+  sumOfSquares_ = 0.0;
+  min_ = ~uint64(0);
+  max_ = 0;
+  std::fill(counts_, counts_ + bucketCount, uint64(0));
+}
+
+void
+ProfileHistogram::merge(const ProfileHistogram & rhs)
+{
+  for(size_t nBucket = 0; nBucket < bucketCount; ++nBucket)
+  {
+    counts_[nBucket] += rhs.counts_[nBucket];
+  }
+  count_ += rhs.count_;
+  sum_ += rhs.sum_;
+  sumOfSquares_ += rhs.sumOfSquares_;
+  if(rhs.min_ < min_)
+  {
+    min_ = rhs.min_;
+  }
+  if(rhs.max_ > max_)
+  {
+    max_ = rhs.max_;
+  }
+}
+
+uint64
+ProfileHistogram::bucketHighValue(size_t index)
+{
+  if(index < 2 * subBucketCount)
+  {
+    return index;
+  }
+  size_t shift = index / subBucketCount - 1;
+  uint64 low = uint64(index % subBucketCount + subBucketCount) << shift;
+  return low + (uint64(1) << shift) - 1;
+}
+
+uint64
+ProfileHistogram::percentile(double percent)const
+{
+  if(count_ == 0)
+  {
+    return 0;
+  }
+  uint64 target = uint64(ceil(double(count_) * percent / 100.0));
+  if(target == 0)
+  {
+    target = 1;
+  }
+  uint64 seen = 0;
+  for(size_t nBucket = 0; nBucket < bucketCount; ++nBucket)
+  {
+    seen += counts_[nBucket];
+    if(seen >= target)
+    {
+      uint64 high = bucketHighValue(nBucket);
+      return high < max_ ? high : max_;
+    }
+  }
+  return max_;
+}
+
+////////////////////
+// ProfileStatistics
+
+ProfileStatistics::ProfileStatistics()
+  : entries_(0)
   , exits_(0)
   , pauses_(0)
   , resumes_(0)
-  , sum_(0.0)
-  , sumOfSquares_(0.0)
+  , depth_(0)
   , recursions_(0)
-  , recursiveSum_(0.0)
+  , recursiveSum_(0)
   , recursiveSumOfSquares_(0.0)
+{
+}
+
+void
+ProfileStatistics::merge(const ProfileStatistics & rhs)
+{
+  entries_ += rhs.entries_;
+  exits_ += rhs.exits_;
+  pauses_ += rhs.pauses_;
+  resumes_ += rhs.resumes_;
+  depth_ += rhs.depth_;
+  recursions_ += rhs.recursions_;
+  recursiveSum_ += rhs.recursiveSum_;
+  recursiveSumOfSquares_ += rhs.recursiveSumOfSquares_;
+  histogram_.merge(rhs.histogram_);
+}
+
+/////////////////////
+// ProfileAccumulator
+
+ProfileAccumulator * ProfileAccumulator::root_ = 0;
+bool ProfileAccumulator::enabled_ = true;
+
+ProfileAccumulator::ProfileAccumulator(const char * name, const char * file, size_t line)
+  : next_(0)
+  , name_(name)
+  , file_(file)
+  , line_(line)
+  , index_(size_t(atomic_increment_long(&pointCount) - 1))
+{
+  do
+  {
+    next_ = root_;
+  } while(!CASPtr((void * volatile *)&root_, next_, this));
+}
+
+ProfileStatistics *
+ProfileAccumulator::statistics()
+{
+  if(index_ >= maxPoints)
+  {
+    return 0;
+  }
+  ProfileThread * thread = currentThread;
+  if(thread == 0)
+  {
+    thread = new ProfileThread;
+    do
+    {
+      thread->next_ = static_cast<ProfileThread *>(threads);
+    } while(!CASPtr(&threads, thread->next_, thread));
+    currentThread = thread;
+  }
+  ProfileStatistics * statistics = thread->statistics_[index_];
+  if(statistics == 0)
+  {
+    statistics = new ProfileStatistics;
+    // only this thread stores here. CAS for the memory barrier.
+    CASPtr((void * volatile *)&thread->statistics_[index_], 0, statistics);
+  }
+  return statistics;
+}
 
+void
+ProfileAccumulator::collect(ProfileStatistics & total)const
 {
-  next_ = root_;
-  root_ = this;
+  if(index_ >= maxPoints)
+  {
+    return;
+  }
+  for(const ProfileThread * thread = static_cast<const ProfileThread *>(threads);
+    thread != 0;
+    thread = thread->next_)
+  {
+    const ProfileStatistics * statistics = thread->statistics_[index_];
+    if(statistics != 0)
+    {
+      total.merge(*statistics);
+    }
+  }
+}
+
+namespace
+{
+  double standardDeviation(double count, double sum, double sumOfSquares)
+  {
+    if(count < 2.0)
+    {
+      return 0.0;
+    }
+    double mean = sum / count;
+    double variance = (sumOfSquares - sum * mean) / (count - 1.0);
+    return variance > 0.0 ? sqrt(variance) : 0.0;
+  }
+
+  double nanoseconds(double ticks)
+  {
+    return ProfileClock::toNanoseconds(ticks);
+  }
 }
 
 void
 ProfileAccumulator::write(std::ostream & out)
 {
-  const ProfileAccumulator * ac = root_;
-  out << "name\tfile\tline\tentries\texits\tsum\tsum_of_squares"
-    << "\trecursions\trecursive_sum\trecursive_sum_of_squares"
-    // helpers
-    << "\tnonRsum"
-    << "\tnonRmean"
+  out << "name\tfile\tline\tentries\texits\tcount\tsum\tmean\tstd_dev"
+    << "\tmin\tp50\tp99\tp99.9\tmax"
+    << "\trecursions\trecursive_sum\trecursive_mean"
     << std::endl;
-  while(ac != 0)
+  for(const ProfileAccumulator * ac = root_; ac != 0; ac = ac->next_)
   {
+    ProfileStatistics total;
+    ac->collect(total);
+    const ProfileHistogram & histogram = total.histogram_;
+    double count = double(histogram.count());
+    double sum = double(histogram.sum());
+    double recursions = double(total.recursions_);
+    double recursiveSum = double(total.recursiveSum_);
     out << ac->name_
       << '\t' << ac->file_
       << '\t' << ac->line_
-      << '\t' << ac->entries_
-      << '\t' << ac->exits_
-      << '\t' << ac->sum_
-      << '\t' << ac->sumOfSquares_
-      << '\t' << ac->recursions_
-      << '\t' << ac->recursiveSum_
-      << '\t' << ac->recursiveSumOfSquares_
-      // helpers
-      << '\t' << ac->sum_ - ac->recursiveSum_
-      << '\t' << (ac->sum_ - ac->recursiveSum_) /double(ac->exits_ - ac->recursions_)
+      << '\t' << total.entries_
+      << '\t' << total.exits_
+      << '\t' << histogram.count()
+      << '\t' << nanoseconds(sum)
+      << '\t' << (count > 0 ? nanoseconds(sum / count) : 0.0)
+      << '\t' << nanoseconds(standardDeviation(count, sum, histogram.sumOfSquares()))
+      << '\t' << nanoseconds(double(histogram.minimum()))
+      << '\t' << nanoseconds(double(histogram.percentile(50.0)))
+      << '\t' << nanoseconds(double(histogram.percentile(99.0)))
+      << '\t' << nanoseconds(double(histogram.percentile(99.9)))
+      << '\t' << nanoseconds(double(histogram.maximum()))
+      << '\t' << total.recursions_
+      << '\t' << nanoseconds(recursiveSum)
+      << '\t' << (recursions > 0 ? nanoseconds(recursiveSum / recursions) : 0.0)
       << std::endl;
-    ac = ac->next_;
   }
 }
 
 void
 ProfileAccumulator::print(std::ostream & out)
 {
-  const ProfileAccumulator * ac = root_;
-  out << "name\tcount\tsum\tmean\tstd_dev\trecursions\trsum\trmean\trstd_dev" << std::endl;
-  while(ac != 0)
+  out << "name\tcount\tmean\tstd_dev\tp50\tp99\tp99.9\tmax\trecursions\trmean\trstd_dev" << std::endl;
+  for(const ProfileAccumulator * ac = root_; ac != 0; ac = ac->next_)
   {
-    double count = double(ac->exits_ - ac->recursions_);
-    double sum = ac->sum_ - ac->recursiveSum_;
-    double sumsq = ac->sumOfSquares_ - ac->recursiveSumOfSquares_;
-
+    ProfileStatistics total;
+    ac->collect(total);
+    const ProfileHistogram & histogram = total.histogram_;
+    double count = double(histogram.count());
     out << ac->name_
-      << '\t' << std::fixed << std::setprecision(0) << count
-      << '\t' << std::fixed << std::setprecision(0) << sum;
-    if(count > 1)
+      << '\t' << std::fixed << std::setprecision(0) << count;
+    if(count > 0)
     {
-      double mean = sum/ count;
-      double stdDev = std::sqrt((sumsq - sum * mean) / (count - 1.0));
+      double sum = double(histogram.sum());
+      double toNs = nanoseconds(1.0);
       out
-        << '\t' << std::fixed << std::setprecision(3) << mean
-        << '\t' << std::fixed << std::setprecision(3) << stdDev
-        << '\t' << ac->recursions_;
-      if(ac->recursions_ > 0)
+        << '\t' << std::fixed << std::setprecision(1) << toNs * sum / count
+        << '\t' << std::fixed << std::setprecision(1) << toNs * standardDeviation(count, sum, histogram.sumOfSquares())
+        << '\t' << std::fixed << std::setprecision(1) << toNs * double(histogram.percentile(50.0))
+        << '\t' << std::fixed << std::setprecision(1) << toNs * double(histogram.percentile(99.0))
+        << '\t' << std::fixed << std::setprecision(1) << toNs * double(histogram.percentile(99.9))
+        << '\t' << std::fixed << std::setprecision(1) << toNs * double(histogram.maximum())
+        << '\t' << total.recursions_;
+      if(total.recursions_ > 0)
       {
-        double count = double(ac->recursions_);
-        double sum = ac->recursiveSum_;
-        double sumsq = ac->recursiveSumOfSquares_;
-        double mean = sum/ count;
-        double stdDev = std::sqrt((sumsq - sum * mean) / (count - 1.0));
-        out << '\t' << std::fixed << std::setprecision(0) << sum
-          << '\t' << std::fixed << std::setprecision(3) << mean
-          << '\t' << std::fixed << std::setprecision(3) << stdDev;
+        double count = double(total.recursions_);
+        double sum = double(total.recursiveSum_);
+        out << '\t' << std::fixed << std::setprecision(1) << toNs * sum / count
+          << '\t' << std::fixed << std::setprecision(1)
+          << toNs * standardDeviation(count, sum, total.recursiveSumOfSquares_);
       }
     }
     out << std::endl;
-    ac = ac->next_;
   }
 }
-
-
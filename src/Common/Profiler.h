@@ -7,71 +7,298 @@
 #ifndef PROFILER_H
 #define PROFILER_H
 #include <Common/QuickFAST_Export.h>
+#include <Common/Types.h>
 
 /// enable or disable generation of profiler code.
 #define PROFILER_ENABLEx
 
-
-// Note: boost's microsecond_clock was slow enough to skew the results
-// hence the win32 GetTickCount stuff.
-#ifdef _WIN32
-# ifndef _WINBASE_ // if we didn't #include <windows.h>
-// this is the ultimate expansion of the declaration for GetTickCount
-// after the macros have been resolved on a 16 bit windows build
-// With luck, it won't conflict with the windows declaration in case
-// the included occur in the wrong order
-typedef unsigned long DWORD;
-__declspec(dllimport) DWORD GetTickCount(void);
-# endif // _WINBASE_
-# define PROFILER_GET_TIME ::GetTickCount()
-# define PROFILER_TIME_TYPE DWORD
-# define PROFILER_DIFF_MSEC(a, b) (a - b)
-#else // _WIN32
-# include <boost/date_time/posix_time/posix_time.hpp>
-# define PROFILER_GET_TIME boost::posix_time::microsec_clock::universal_time()
-# define PROFILER_TIME_TYPE boost::posix_time::ptime
-# define PROFILER_DIFF_MSEC(a,b) ((a - b).total_milliseconds())
-#endif // _WIN32
+// Time stamps come from the CPU's time stamp counter where it is available.
+// It costs a few nanoseconds to read, unlike the system clocks which were slow
+// enough to skew the results.  The counter is assumed to be invariant (constant
+// rate and synchronized across cores) which is true of any recent x86 processor.
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+# include <intrin.h>
+# pragma intrinsic(__rdtsc)
+# define PROFILER_HAS_TSC
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+# define PROFILER_HAS_TSC
+#endif
 
 namespace QuickFAST{
+  /// @brief A fast clock for profiling.
+  ///
+  /// ticks() reads the time stamp counter.  Platforms without one fall back
+  /// to boost's microsecond clock.  Ticks are converted to nanoseconds
+  /// using a rate measured against the system clock.
+  class QuickFAST_Export ProfileClock
+  {
+  public:
+    /// @brief Read the clock.
+    static uint64 ticks()
+    {
+#if defined(PROFILER_HAS_TSC) && defined(_MSC_VER)
+      return __rdtsc();
+#elif defined(PROFILER_HAS_TSC)
+      return __builtin_ia32_rdtsc();
+#else
+      return microseconds();
+#endif
+    }
+
+    /// @brief How many ticks occur in a nanosecond.
+    ///
+    /// Calibrates the clock the first time it is called.
+    static double ticksPerNanosecond();
+
+    /// @brief Measure the tick rate against the system clock.
+    ///
+    /// The measurement covers the time since the program started (or since the
+    /// previous calibration) but at least the given interval.
+    /// @param milliseconds is the shortest interval to measure.
+    static void calibrate(unsigned long milliseconds = 10);
+
+    /// @brief Convert a number of ticks to nanoseconds.
+    static double toNanoseconds(double ticks)
+    {
+      return ticks / ticksPerNanosecond();
+    }
+
+  private:
+    static uint64 microseconds();
+    static double ticksPerNanosecond_;
+  };
+
+  /// @brief A histogram of profiled intervals.
+  ///
+  /// Buckets are exact for values below 64 and then cover ranges of increasing
+  /// width so that any recorded value is within 1/32 (about 3%) of its bucket's
+  /// upper bound.  This gives useful percentiles from a few nanoseconds to days
+  /// in a fixed amount of memory with no arithmetic beyond a bit scan.
+  class QuickFAST_Export ProfileHistogram
+  {
+  public:
+    /// Significant bits kept for each value.
+    static const size_t subBucketBits = 5;
+    /// Buckets for each power of two.
+    static const size_t subBucketCount = 1 << subBucketBits;
+    /// Enough buckets for any 64 bit value.
+    static const size_t bucketCount = (64 - subBucketBits + 1) * subBucketCount;
+
+    ProfileHistogram();
+
+    /// @brief Count one occurrence of a value.
+    void record(uint64 value)
+    {
+      ++counts_[bucketIndex(value)];
+      ++count_;
+      sum_ += value;
+      sumOfSquares_ += double(value) * double(value);
+      if(value < min_)
+      {
+        min_ = value;
+      }
+      if(value > max_)
+      {
+        max_ = value;
+      }
+    }
+
+    /// @brief Add the contents of another histogram to this one.
+    void merge(const ProfileHistogram & rhs);
+
+    /// @brief Forget everything that has been recorded.
+    void clear();
+
+    /// @brief How many values have been recorded.
+    uint64 count()const
+    {
+      return count_;
+    }
+
+    /// @brief The total of the recorded values.
+    uint64 sum()const
+    {
+      return sum_;
+    }
+
+    /// @brief The total of the squares of the recorded values.
+    double sumOfSquares()const
+    {
+      return sumOfSquares_;
+    }
+
+    /// @brief The smallest value recorded (zero if nothing has been recorded)
+    uint64 minimum()const
+    {
+      return count_ == 0 ? 0 : min_;
+    }
+
+    /// @brief The largest value recorded.
+    uint64 maximum()const
+    {
+      return max_;
+    }
+
+    /// @brief Find the value at or below which a given percentage of the values fall.
+    ///
+    /// The result is the upper bound of the bucket, but no higher than maximum().
+    /// @param percent is from 0.0 to 100.0
+    uint64 percentile(double percent)const;
+
+    /// @brief Find the bucket for a value.
+    static size_t bucketIndex(uint64 value)
+    {
+      if(value < subBucketCount)
+      {
+        return size_t(value);
+      }
+      size_t msb = highestBit(value);
+      size_t shift = msb - subBucketBits;
+      return (msb - subBucketBits + 1) * subBucketCount + size_t(value >> shift) - subBucketCount;
+    }
+
+    /// @brief The largest value that belongs in a bucket.
+    static uint64 bucketHighValue(size_t index);
+
+  private:
+    static size_t highestBit(uint64 value)
+    {
+#if defined(__GNUC__)
+      return 63 - __builtin_clzll(value);
+#else
+      size_t bit = 0;
+      while(value >>= 1)
+      {
+        ++bit;
+      }
+      return bit;
+#endif
+    }
+
+  private:
+    uint64 count_;
+    uint64 sum_;
+    double sumOfSquares_;
+    uint64 min_;
+    uint64 max_;
+    uint64 counts_[bucketCount];
+  };
+
+  /// @brief The measurements for one profile point.
+  ///
+  /// Each thread has its own ProfileStatistics for each profile point
+  /// so measuring never needs a lock or an atomic operation.
+  /// Times are in ProfileClock ticks.
+  struct QuickFAST_Export ProfileStatistics
+  {
+    ProfileStatistics();
+
+    /// @brief Add another thread's results into this one.
+    void merge(const ProfileStatistics & rhs);
+
+    /// Times the profile point was entered.
+    size_t entries_;
+    /// Times it was exited.
+    size_t exits_;
+    /// Times it was paused.
+    size_t pauses_;
+    /// Times it was resumed.
+    size_t resumes_;
+    /// How many instances are currently active (in the owning thread)
+    size_t depth_;
+    /// Intervals measured while an outer instance was active.
+    size_t recursions_;
+    /// The total of those intervals.
+    uint64 recursiveSum_;
+    /// The total of their squares.
+    double recursiveSumOfSquares_;
+    /// Intervals measured by the outermost instances.
+    ProfileHistogram histogram_;
+  };
+
   /// @brief Accumulate profiler statistics.
   ///
   /// A ProfileAccumulater is statically created for each Profile Point.
   /// The ProfileInstances created to do the actual timing store their results
-  /// into the corresponding ProfileAccumulator.
+  /// into a ProfileStatistics that belongs to the accumulator and the current thread.
   /// These accumulators link themselves together in a list starting at root_.
   /// Walking this list lets you find all profile points in the system.
   /// The static write(...) method writes a tab-delimited file of the statistics.
   /// Hint: try importing this file into a spreadsheet for analysis.
+  ///
+  /// Reporting combines the statistics from every thread without stopping
+  /// them, so a report taken while threads are still being profiled may be
+  /// slightly inconsistent.
   class QuickFAST_Export ProfileAccumulator
   {
   public:
+    /// The most profile points that can be measured.  Any more are ignored.
+    static const size_t maxPoints = 512;
+
     /// @brief Create the ProfileAccumulator
     /// @param name identifies the profile point.
     /// @param file should be generated by the __FILE__ predefined macro.
     /// @param line should be generated by the __LINE__ predefined macro.
     ProfileAccumulator(const char * name, const char * file, size_t line);
+
     /// @brief write in machine-readable form (tab delimited columns)
+    ///
+    /// Times are in nanoseconds.
     static void write(std::ostream & out);
+
     /// @brief write in somewhat human readable format
+    ///
+    /// Times are in nanoseconds.
     static void print(std::ostream & out);
 
+    /// @brief Turn measurement on or off at run time.
+    ///
+    /// When profiling is disabled a profile point costs one test of a flag.
+    static void enable(bool enabled = true)
+    {
+      enabled_ = enabled;
+    }
+
+    /// @brief Is measurement turned on?
+    static bool isEnabled()
+    {
+      return enabled_;
+    }
+
+    /// @brief Access the first accumulator in the list.
+    static const ProfileAccumulator * first()
+    {
+      return root_;
+    }
+
+    /// @brief Access the next accumulator in the list.
+    const ProfileAccumulator * next()const
+    {
+      return next_;
+    }
+
+    /// @brief The name of the profile point.
+    const char * name()const
+    {
+      return name_;
+    }
+
+    /// @brief Combine the statistics from all threads.
+    /// @param[out] total receives the results.  It should be empty.
+    void collect(ProfileStatistics & total)const;
+
   private:
     friend class ProfileInstance;
+    ProfileStatistics * statistics();
+
+  private:
     static ProfileAccumulator * root_;
+    static bool enabled_;
     ProfileAccumulator * next_;
     const char * name_;
     const char * file_;
     size_t line_;
-    size_t entries_;
-    size_t exits_;
-    size_t pauses_;
-    size_t resumes_;
-    double sum_;
-    double sumOfSquares_;
-    size_t recursions_;
-    double recursiveSum_;
-    double recursiveSumOfSquares_;
+    size_t index_;
   };
 
   /// @brief an auto variable to measure the time in a section of code
@@ -85,18 +312,28 @@ namespace QuickFAST{
     /// @brief Construct and link to an accumulator
     /// @param accumulator to receive the measured results.
     ProfileInstance(ProfileAccumulator & accumulator)
-      : accumulator_(accumulator)
-      , start_(PROFILER_GET_TIME)
-      , running_(true)
+      : statistics_(ProfileAccumulator::enabled_ ? accumulator.statistics() : 0)
+      , start_(0)
+      , running_(false)
     {
-      accumulator_.entries_ += 1;
+      if(statistics_ != 0)
+      {
+        statistics_->entries_ += 1;
+        statistics_->depth_ += 1;
+        running_ = true;
+        start_ = ProfileClock::ticks();
+      }
     }
 
     /// @brief Stop timing and accumulate results.
     ~ProfileInstance()
     {
-      stop();
-      accumulator_.exits_ += 1;
+      if(statistics_ != 0)
+      {
+        stop();
+        statistics_->exits_ += 1;
+        statistics_->depth_ -= 1;
+      }
     }
 
     /// @brief Stop timing -- may be resumable
@@ -104,8 +341,11 @@ namespace QuickFAST{
     bool pause()
     {
       bool result = running_;
-      stop();
-      accumulator_.pauses_ += 1;
+      if(statistics_ != 0)
+      {
+        stop();
+        statistics_->pauses_ += 1;
+      }
       return result;
     }
 
@@ -113,11 +353,14 @@ namespace QuickFAST{
     /// @param pauseState is the return value from a pause
     void resume(bool pauseState)
     {
-      accumulator_.resumes_ += 1;
-      if(!running_ && pauseState)
+      if(statistics_ != 0)
       {
-        start_ = PROFILER_GET_TIME;
-        running_ = true;
+        statistics_->resumes_ += 1;
+        if(!running_ && pauseState)
+        {
+          running_ = true;
+          start_ = ProfileClock::ticks();
+        }
       }
     }
 
@@ -126,16 +369,17 @@ namespace QuickFAST{
     {
       if(running_)
       {
-        PROFILER_TIME_TYPE now = PROFILER_GET_TIME;
-        double lapse = double(PROFILER_DIFF_MSEC(now, start_));
-        accumulator_.sum_ += lapse;
-        accumulator_.sumOfSquares_ += lapse * lapse;
-        assert(accumulator_.entries_ > accumulator_.exits_);
-        if(accumulator_.entries_ != accumulator_.exits_ + 1)
+        uint64 lapse = ProfileClock::ticks() - start_;
+        assert(statistics_->depth_ > 0);
+        if(statistics_->depth_ > 1)
+        {
+          statistics_->recursions_ += 1;
+          statistics_->recursiveSum_ += lapse;
+          statistics_->recursiveSumOfSquares_ += double(lapse) * double(lapse);
+        }
+        else
         {
-          accumulator_.recursions_ += 1;
-          accumulator_.recursiveSum_ += lapse;
-          accumulator_.recursiveSumOfSquares_ += lapse * lapse;
+          statistics_->histogram_.record(lapse);
         }
         running_ = false;
       }
@@ -146,8 +390,8 @@ namespace QuickFAST{
     ProfileInstance(const ProfileInstance &);
 
   private:
-    ProfileAccumulator & accumulator_;
-    PROFILER_TIME_TYPE start_;
+    ProfileStatistics * statistics_;
+    uint64 start_;
     bool running_;
   };
 }
@@ -164,7 +408,7 @@ namespace QuickFAST{
 
 /// Resume after pause
 # define PROFILE_RESUME \
-    PROFILE_instance.pause(PROFILE_pauseState)
+    PROFILE_instance.resume(PROFILE_pauseState)
 
 /// Define the start point of a block of code to be profiled.
 /// Allows more than one profiler in the same scope.
@@ -178,12 +422,13 @@ namespace QuickFAST{
 
 /// Resume after pause
 # define NESTED_PROFILE_RESUME(id) \
-  PROFILE_instance##id.pause(PROFILE_pauseState##id)
+  PROFILE_instance##id.resume(PROFILE_pauseState##id)
 
 #else // PROFILER_ENABLE
 
 # define PROFILE_POINT(name)  void(0)
 # define PROFILE_PAUSE  void(0)
+# define PROFILE_RESUME  void(0)
 # define NESTED_PROFILE_POINT(id, name)  void(0)
 # define NESTED_PROFILE_PAUSE(id) void(0)
 # define NESTED_PROFILE_RESUME(id) void(0)
@@ -542,6 +542,47 @@ namespace QuickFAST
       size_ = length;
     }
 
+    /// @brief replace part of the current contents in place.
+    ///
+    /// Like std::string::replace: count bytes starting at pos are replaced
+    /// by length bytes from source.  The buffer grows only if the result
+    /// does not fit in the current capacity.
+    /// source must not point into this StringBufferT.
+    /// @param pos is the first byte to replace (at most size())
+    /// @param count is the number of bytes to replace (clipped to the end of the string)
+    /// @param source points to the replacement bytes
+    /// @param length is the number of replacement bytes
+    void replace(
+      size_t pos,
+      size_t count,
+      const unsigned char * source,
+      size_t length
+      )
+    {
+      size_t oldSize = size();
+      if(pos > oldSize)
+      {
+        throw std::range_error("StringBufferT::replace position out of range.");
+      }
+      if(count > oldSize - pos)
+      {
+        count = oldSize - pos;
+      }
+      size_t newSize = oldSize - count + length;
+      reserve(newSize);
+      unsigned char * buffer = getBuffer();
+      if(length != count)
+      {
+        std::memmove(buffer + pos + length, buffer + pos + count, oldSize - pos - count);
+      }
+      if(length > 0)
+      {
+        std::memcpy(buffer + pos, source, length);
+      }
+      buffer[newSize] = 0;
+      size_ = newSize;
+    }
+
     /// @brief cast to a standard string.
     operator std::string() const
     {
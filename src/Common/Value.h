@@ -191,6 +191,26 @@ namespace QuickFAST{
       setValue(reinterpret_cast<const unsigned char*>(value.c_str()), value.length());
     }
 
+    /// @brief Replace part of a string value in place.
+    ///
+    /// Used by the delta and tail operators so the dictionary entry is
+    /// edited in its own buffer rather than rebuilt.  A value that is not
+    /// a string is treated as an empty string.
+    /// @param pos is the first byte to replace
+    /// @param count is the number of bytes to replace
+    /// @param value points to the replacement bytes
+    /// @param length is the number of replacement bytes
+    void replaceString(size_t pos, size_t count, const unsigned char * value, size_t length)
+    {
+      if(class_ != STRING)
+      {
+        class_ = STRING;
+        string_.erase();
+      }
+      cachedString_ = true;
+      string_.replace(pos, count, value, length);
+    }
+
     /// @brief check for class and value equality
     bool operator == (const Value & rhs) const
     {
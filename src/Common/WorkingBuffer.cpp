@@ -42,7 +42,7 @@ WorkingBuffer::operator =(const WorkingBuffer & rhs)
 namespace
 {
   template<typename TYPE>
-  void swap_i(TYPE lhs, TYPE rhs)
+  void swap_i(TYPE & lhs, TYPE & rhs)
   {
     TYPE temp = lhs;
     lhs = rhs;
@@ -149,27 +149,69 @@ WorkingBuffer::grow(size_t newCapacity)
 void
 WorkingBuffer::append(const WorkingBuffer & rhs)
 {
-  size_t bytesToAppend = rhs.size();
+  append(rhs.buffer_.get() + rhs.startPos_, rhs.size());
+}
+
+void
+WorkingBuffer::append(const uchar * data, size_t bytesToAppend)
+{
+  if(bytesToAppend == 0)
+  {
+    return;
+  }
+  // Growing moves the contents, so data that came from this buffer
+  // must be found again afterwards.
+  bool self = data >= buffer_.get() && data < buffer_.get() + capacity_;
+  size_t selfOffset = self ? size_t(data - (buffer_.get() + startPos_)) : 0;
   if(reverse_)
   {
     if(startPos_ < bytesToAppend)
     {
       grow(size() + bytesToAppend);
+      if(self)
+      {
+        data = buffer_.get() + startPos_ + selfOffset;
+      }
     }
-    std::memcpy(buffer_.get() + startPos_ - bytesToAppend, rhs.buffer_.get() + rhs.startPos_, bytesToAppend);
+    std::memcpy(buffer_.get() + startPos_ - bytesToAppend, data, bytesToAppend);
     startPos_ -= bytesToAppend;
   }
   else
   {
     if(endPos_ + bytesToAppend > capacity_)
     {
-      grow(size() + bytesToAppend);
+      grow(endPos_ + bytesToAppend);
+      if(self)
+      {
+        data = buffer_.get() + startPos_ + selfOffset;
+      }
     }
-    std::memcpy(buffer_.get() + endPos_, rhs.buffer_.get() + rhs.startPos_, bytesToAppend);
+    std::memcpy(buffer_.get() + endPos_, data, bytesToAppend);
     endPos_ += bytesToAppend;
   }
 }
 
+void
+WorkingBuffer::replace(size_t pos, size_t count, const uchar * data, size_t size)
+{
+  if(reverse_ || pos + count > this->size())
+  {
+    throw UsageError("Coding error", "WorkingBuffer: invalid replace.");
+  }
+  if(size > count && endPos_ + size - count > capacity_)
+  {
+    grow(capacity_ + size - count);
+  }
+  uchar * target = buffer_.get() + startPos_ + pos;
+  std::memmove(target + size, target + count, endPos_ - (startPos_ + pos + count));
+  if(size != 0)
+  {
+    // data may be null when the range is only being erased.
+    std::memcpy(target, data, size);
+  }
+  endPos_ = endPos_ + size - count;
+}
+
 void
 WorkingBuffer::toString(std::string & result) const
 {
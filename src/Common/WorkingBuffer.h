@@ -105,6 +105,23 @@ namespace QuickFAST{
     /// @param rhs the buffer to be appended
     void append(const WorkingBuffer & rhs);
 
+    ///@brief Append a run of bytes
+    ///
+    /// if reverse append to the front of this buffer else append to the back
+    /// @param data points to the bytes to be appended
+    /// @param size is the number of bytes to append
+    void append(const uchar * data, size_t size);
+
+    ///@brief Overwrite a range of bytes, moving the following bytes to fit.
+    ///
+    /// Used to fill in space that was set aside before the size of its
+    /// contents was known.  Only valid for forward (fifo) buffers.
+    /// @param pos is the offset of the first byte to replace.
+    /// @param count is the number of bytes being replaced.
+    /// @param data points to the replacement bytes.  May be null if size is zero.
+    /// @param size is the number of replacement bytes.
+    void replace(size_t pos, size_t count, const uchar * data, size_t size);
+
     /// @brief A convenience method: copy contents to a std::string
     void toString(std::string & result) const;
 
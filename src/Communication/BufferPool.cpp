@@ -0,0 +1,498 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+//
+#include <Common/QuickFASTPch.h>
+#include "BufferPool.h"
+#include <Common/Exceptions.h>
+
+#if defined(_WIN32)
+# include <windows.h>
+#elif defined(__linux__)
+# include <sys/mman.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+
+using namespace QuickFAST;
+using namespace Communication;
+
+namespace
+{
+  const size_t hugePageSize = 2 * 1024 * 1024;
+
+  size_t roundUp(size_t size, size_t boundary)
+  {
+    return ((size + boundary - 1) / boundary) * boundary;
+  }
+
+#if defined(__linux__)
+  // From <numaif.h>.  Using the system call directly avoids a dependency on libnuma.
+  const int mpolBind = 2;
+
+  bool bindToNode(void * memory, size_t size, int numaNode)
+  {
+#if defined(SYS_mbind)
+    const size_t bitsPerLong = sizeof(unsigned long) * 8;
+    unsigned long mask[4] = {0, 0, 0, 0};
+    if(numaNode < 0 || size_t(numaNode) >= sizeof(mask) * 8)
+    {
+      return false;
+    }
+    mask[numaNode / bitsPerLong] = 1UL << (numaNode % bitsPerLong);
+    return syscall(SYS_mbind, memory, size, mpolBind, mask, sizeof(mask) * 8, 0) == 0;
+#else
+    return false;
+#endif
+  }
+#endif
+}
+
+const size_t BufferPool::cacheLineSize;
+
+BufferPool::BufferPool()
+  : hugePages_(false)
+  , numaNode_(-1)
+  , bufferSize_(0)
+  , stride_(0)
+  , hugeSlabs_(0)
+  , boundSlabs_(0)
+  , lowWater_(0)
+  , growBy_(0)
+  , maxBytes_(0)
+  , shrinkTicks_(0)
+  , unneededSince_(0)
+  , bufferCount_(0)
+  , slabBytes_(0)
+  , inUse_(0)
+  , highWaterMark_(0)
+  , exhausted_(0)
+  , exhaustedSince_(0)
+  , exhaustedTicks_(0)
+  , growths_(0)
+  , capped_(0)
+  , cappedEpisode_(false)
+  , shrinks_(0)
+  , refillsRequested_(0)
+  , refillsInstalled_(0)
+  , stopRefill_(false)
+  , refillBytes_(0)
+{
+}
+
+BufferPool::~BufferPool()
+{
+  stopRefill();
+  stagedIdle_.popList();
+  for(size_t nSlab = 0; nSlab < staged_.size(); ++nSlab)
+  {
+    freeSlab(staged_[nSlab]);
+  }
+  idle_.popList();
+  for(size_t nSlab = 0; nSlab < slabs_.size(); ++nSlab)
+  {
+    freeSlab(slabs_[nSlab]);
+  }
+}
+
+void
+BufferPool::setHugePages(bool hugePages)
+{
+  hugePages_ = hugePages;
+}
+
+void
+BufferPool::setNumaNode(int numaNode)
+{
+  numaNode_ = numaNode;
+}
+
+void
+BufferPool::setGrowth(size_t lowWater, size_t growBy, size_t maxBytes)
+{
+  lowWater_ = lowWater;
+  growBy_ = growBy;
+  maxBytes_ = maxBytes;
+  if(lowWater_ != 0 && growBy_ != 0 && !refillThread_)
+  {
+    refillThread_.reset(new boost::thread(boost::bind(&BufferPool::refill, this)));
+  }
+}
+
+void
+BufferPool::setShrink(size_t idleMilliseconds)
+{
+  shrinkTicks_ = uint64(ProfileClock::ticksPerNanosecond() * 1000000.0 * double(idleMilliseconds));
+  unneededSince_ = 0;
+}
+
+double
+BufferPool::exhaustedNanoseconds() const
+{
+  uint64 ticks = exhaustedTicks_;
+  if(exhaustedSince_ != 0)
+  {
+    ticks += ProfileClock::ticks() - exhaustedSince_;
+  }
+  return ProfileClock::toNanoseconds(double(ticks));
+}
+
+void
+BufferPool::allocate(size_t bufferSize, size_t bufferCount)
+{
+  if(bufferSize == 0)
+  {
+    throw UsageError("Coding Error", "BufferPool: Buffer size must not be zero.");
+  }
+  if(bufferSize_ != 0 && bufferSize != bufferSize_)
+  {
+    throw UsageError("Coding Error", "BufferPool: All buffers in a pool must be the same size.");
+  }
+  if(bufferCount == 0)
+  {
+    return;
+  }
+  bufferSize_ = bufferSize;
+  stride_ = roundUp(bufferSize, cacheLineSize);
+  addSlab(bufferCount, false);
+}
+
+void
+BufferPool::addSlab(size_t bufferCount, bool grown)
+{
+  Slab slab;
+  BufferQueue buffers;
+  prepareSlab(slab, stride_ * bufferCount, buffers);
+  slab.grown_ = grown;
+  installSlab(slab);
+  idle_.push(buffers);
+}
+
+void
+BufferPool::prepareSlab(Slab & slab, size_t size, BufferQueue & buffers)
+{
+  allocateSlab(slab, size);
+  slab.grown_ = true;
+
+  // A huge page slab may have room for more buffers than were requested.  Use them.
+  slab.bufferCount_ = slab.size_ / stride_;
+  try
+  {
+    slab.buffers_ = new LinkedBuffer[slab.bufferCount_];
+  }
+  catch(...)
+  {
+    freeSlab(slab);
+    throw;
+  }
+  for(size_t nBuffer = 0; nBuffer < slab.bufferCount_; ++nBuffer)
+  {
+    LinkedBuffer & buffer = slab.buffers_[nBuffer];
+    buffer.setStorage(slab.memory_ + nBuffer * stride_, bufferSize_);
+    buffers.push(&buffer);
+  }
+}
+
+void
+BufferPool::installSlab(const Slab & slab)
+{
+  slabs_.push_back(slab);
+  bufferCount_ += slab.bufferCount_;
+  slabBytes_ += slab.size_;
+  if(slab.huge_)
+  {
+    ++hugeSlabs_;
+  }
+  if(slab.bound_)
+  {
+    ++boundSlabs_;
+  }
+}
+
+void
+BufferPool::requestRefill()
+{
+  // Only one refill at a time.
+  if(refillsRequested_ != refillsInstalled_ || !refillThread_ || stride_ == 0)
+  {
+    return;
+  }
+  size_t size = stride_ * growBy_;
+  if(hugePages_)
+  {
+    size = roundUp(size, hugePageSize);
+  }
+  if(maxBytes_ != 0 && slabBytes_ + size > maxBytes_)
+  {
+    if(!cappedEpisode_)
+    {
+      ++capped_;
+      cappedEpisode_ = true;
+    }
+    return;
+  }
+  boost::mutex::scoped_lock lock(refillMutex_);
+  refillBytes_ = size;
+  ++refillsRequested_;
+  refillWanted_.notify_one();
+}
+
+void
+BufferPool::installRefills()
+{
+  boost::mutex::scoped_lock lock(refillMutex_);
+  for(size_t nSlab = 0; nSlab < staged_.size(); ++nSlab)
+  {
+    installSlab(staged_[nSlab]);
+    ++growths_;
+  }
+  staged_.clear();
+  idle_.push(stagedIdle_);
+  refillsInstalled_ = refillsDone_;
+  unneededSince_ = 0;
+}
+
+void
+BufferPool::refill()
+{
+  boost::mutex::scoped_lock lock(refillMutex_);
+  while(!stopRefill_)
+  {
+    if(refillBytes_ == 0)
+    {
+      refillWanted_.wait(lock);
+      continue;
+    }
+    size_t size = refillBytes_;
+    refillBytes_ = 0;
+
+    // The slow part: get the memory from the operating system and touch it.
+    lock.unlock();
+    Slab slab;
+    BufferQueue buffers;
+    bool prepared = false;
+    try
+    {
+      prepareSlab(slab, size, buffers);
+      prepared = true;
+    }
+    catch(const std::bad_alloc &)
+    {
+      // Nothing to stage.  pop() will ask again while the pool is low.
+    }
+    lock.lock();
+
+    if(prepared)
+    {
+      staged_.push_back(slab);
+      stagedIdle_.push(buffers);
+    }
+    ++refillsDone_;
+  }
+}
+
+void
+BufferPool::stopRefill()
+{
+  if(refillThread_)
+  {
+    {
+      boost::mutex::scoped_lock lock(refillMutex_);
+      stopRefill_ = true;
+      refillWanted_.notify_all();
+    }
+    refillThread_->join();
+    refillThread_.reset();
+  }
+}
+
+void
+BufferPool::checkShrink()
+{
+  // Would we still be above the low water mark without the last slab?
+  const Slab & slab = slabs_.back();
+  if(inUse_ + lowWater_ + slab.bufferCount_ > bufferCount_)
+  {
+    unneededSince_ = 0;
+    return;
+  }
+  uint64 now = ProfileClock::ticks();
+  if(unneededSince_ == 0)
+  {
+    unneededSince_ = now;
+  }
+  else if(now - unneededSince_ >= shrinkTicks_)
+  {
+    if(releaseLastSlab())
+    {
+      ++shrinks_;
+    }
+    // Either way, start timing again.
+    unneededSince_ = 0;
+  }
+}
+
+bool
+BufferPool::releaseLastSlab()
+{
+  Slab & slab = slabs_.back();
+  const LinkedBuffer * first = slab.buffers_;
+  const LinkedBuffer * last = slab.buffers_ + slab.bufferCount_;
+
+  // The slab can be released only if all of its buffers are idle.
+  size_t idleInSlab = 0;
+  for(const LinkedBuffer * buffer = idle_.peek(); buffer != 0; buffer = buffer->link())
+  {
+    if(buffer >= first && buffer < last)
+    {
+      ++idleInSlab;
+    }
+  }
+  if(idleInSlab != slab.bufferCount_)
+  {
+    return false;
+  }
+
+  BufferQueue keep;
+  LinkedBuffer * buffer = idle_.pop();
+  while(buffer != 0)
+  {
+    if(buffer < first || buffer >= last)
+    {
+      keep.push(buffer);
+    }
+    buffer = idle_.pop();
+  }
+  idle_.push(keep);
+
+  bufferCount_ -= slab.bufferCount_;
+  slabBytes_ -= slab.size_;
+  if(slab.huge_)
+  {
+    --hugeSlabs_;
+  }
+  if(slab.bound_)
+  {
+    --boundSlabs_;
+  }
+  freeSlab(slab);
+  slabs_.pop_back();
+  return true;
+}
+
+void
+BufferPool::allocateSlab(Slab & slab, size_t size)
+{
+  slab.memory_ = 0;
+  slab.allocation_ = 0;
+  slab.size_ = size;
+  slab.mapped_ = false;
+  slab.buffers_ = 0;
+  slab.bufferCount_ = 0;
+  bool huge = false;
+  bool bound = false;
+
+#if defined(_WIN32)
+  DWORD protect = PAGE_READWRITE;
+  if(hugePages_)
+  {
+    SIZE_T largePage = GetLargePageMinimum();
+    if(largePage != 0)
+    {
+      size_t hugeSize = roundUp(size, largePage);
+      DWORD type = MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES;
+      void * memory = (numaNode_ >= 0)
+        ? VirtualAllocExNuma(GetCurrentProcess(), 0, hugeSize, type, protect, DWORD(numaNode_))
+        : VirtualAlloc(0, hugeSize, type, protect);
+      if(memory != 0)
+      {
+        slab.allocation_ = static_cast<unsigned char *>(memory);
+        slab.size_ = hugeSize;
+        huge = true;
+        bound = numaNode_ >= 0;
+      }
+    }
+  }
+  if(slab.allocation_ == 0)
+  {
+    DWORD type = MEM_RESERVE | MEM_COMMIT;
+    void * memory = (numaNode_ >= 0)
+      ? VirtualAllocExNuma(GetCurrentProcess(), 0, size, type, protect, DWORD(numaNode_))
+      : VirtualAlloc(0, size, type, protect);
+    if(memory == 0)
+    {
+      throw std::bad_alloc();
+    }
+    slab.allocation_ = static_cast<unsigned char *>(memory);
+    bound = numaNode_ >= 0;
+  }
+  slab.mapped_ = true;
+  slab.memory_ = slab.allocation_;
+#elif defined(__linux__)
+  const int protect = PROT_READ | PROT_WRITE;
+  const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+  void * memory = MAP_FAILED;
+  if(hugePages_)
+  {
+    slab.size_ = roundUp(size, hugePageSize);
+#if defined(MAP_HUGETLB)
+    // Explicit huge pages come from the pool reserved via /proc/sys/vm/nr_hugepages
+    memory = mmap(0, slab.size_, protect, flags | MAP_HUGETLB, -1, 0);
+    huge = memory != MAP_FAILED;
+#endif
+  }
+  if(memory == MAP_FAILED)
+  {
+    memory = mmap(0, slab.size_, protect, flags, -1, 0);
+    if(memory == MAP_FAILED)
+    {
+      throw std::bad_alloc();
+    }
+#if defined(MADV_HUGEPAGE)
+    if(hugePages_)
+    {
+      // Fall back to transparent huge pages if the kernel will give them to us.
+      madvise(memory, slab.size_, MADV_HUGEPAGE);
+    }
+#endif
+  }
+  if(numaNode_ >= 0)
+  {
+    // The pages have not been touched yet so they will be placed on the node.
+    bound = bindToNode(memory, slab.size_, numaNode_);
+  }
+  slab.allocation_ = static_cast<unsigned char *>(memory);
+  slab.memory_ = slab.allocation_;
+  slab.mapped_ = true;
+#else
+  slab.allocation_ = new unsigned char[size + cacheLineSize];
+  size_t misalignment = reinterpret_cast<size_t>(slab.allocation_) % cacheLineSize;
+  slab.memory_ = slab.allocation_ + (misalignment == 0 ? 0 : cacheLineSize - misalignment);
+#endif
+
+  // Touch every page now rather than taking page faults while receiving.
+  std::memset(slab.memory_, 0, slab.size_);
+  slab.huge_ = huge;
+  slab.bound_ = bound;
+}
+
+void
+BufferPool::freeSlab(Slab & slab)
+{
+  delete[] slab.buffers_;
+  slab.buffers_ = 0;
+  if(slab.mapped_)
+  {
+#if defined(_WIN32)
+    VirtualFree(slab.allocation_, 0, MEM_RELEASE);
+#elif defined(__linux__)
+    munmap(slab.allocation_, slab.size_);
+#endif
+  }
+  else
+  {
+    delete[] slab.allocation_;
+  }
+  slab.allocation_ = 0;
+  slab.memory_ = 0;
+}
@@ -0,0 +1,319 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+//
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef BUFFERPOOL_H
+#define BUFFERPOOL_H
+#include <Common/QuickFAST_Export.h>
+#include "BufferPool_fwd.h"
+#include <Communication/LinkedBuffer.h>
+#include <Common/AtomicCounter.h>
+#include <Common/Profiler.h>
+
+namespace QuickFAST
+{
+  namespace Communication
+  {
+    /// @brief A pool of equally sized LinkedBuffers carved from contiguous slabs of memory.
+    ///
+    /// Rather than allocating each receive buffer separately, the pool allocates
+    /// one slab big enough for all of the buffers requested by a call to
+    /// allocate() and points each LinkedBuffer into it.  Every buffer starts
+    /// on a cache line boundary so two buffers never share a cache line.
+    ///
+    /// Optionally the slab can be backed by huge pages (2MB on x86) to reduce
+    /// TLB misses and can be bound to a NUMA node so the memory is local to the
+    /// CPU that services the socket.  If the operating system refuses either
+    /// request the pool quietly falls back to ordinary pages; usingHugePages()
+    /// and boundToNumaNode() report what actually happened.  The slab is touched
+    /// when it is allocated so no page faults happen on the receive path.
+    ///
+    /// The pool is also the free list of idle buffers.  It keeps track of how
+    /// many buffers are in use, the most that have ever been in use at once,
+    /// how many times a buffer was requested when none was available, and how
+    /// long the pool spent with no idle buffers.
+    ///
+    /// The pool can adapt to bursts of traffic.  When setGrowth() has been
+    /// called the pool adds a slab whenever the number of idle buffers falls
+    /// below a low water mark, up to a limit on the total memory used.
+    /// The slab is allocated and touched by a refill thread that belongs to
+    /// the pool, so pop() never waits for the operating system.  The new
+    /// buffers become available to pop() once the refill thread has
+    /// finished with them.
+    /// When setShrink() has been called a slab that was added this way is
+    /// released once it has been unnecessary for a while and all of its
+    /// buffers are idle.  Slabs allocated by allocate() are never released.
+    ///
+    /// No internal synchronization: one thread at a time may use the pool.
+    /// The pool and its refill thread synchronize with each other.
+    class QuickFAST_Export BufferPool
+    {
+    public:
+      /// @brief Buffers start on boundaries of this many bytes.
+      static const size_t cacheLineSize = 64;
+
+      BufferPool();
+      ~BufferPool();
+
+      /// @brief Ask for huge page backed memory for slabs allocated after this call.
+      /// @param hugePages true to try for huge pages.
+      void setHugePages(bool hugePages);
+
+      /// @brief Bind slabs allocated after this call to a NUMA node.
+      /// @param numaNode is the node number; -1 (the default) means no binding.
+      void setNumaNode(int numaNode);
+
+      /// @brief Allocate buffers and make them available via pop()
+      ///
+      /// All buffers in the pool must have the same size.  Additional
+      /// calls add another slab to the pool.
+      /// @param bufferSize is the capacity of each buffer
+      /// @param bufferCount is how many buffers to allocate.
+      void allocate(size_t bufferSize, size_t bufferCount);
+
+      /// @brief Grow the pool when it runs low on idle buffers.
+      ///
+      /// Starts the refill thread the first time growth is enabled.
+      /// Call setHugePages() and setNumaNode() before this.
+      /// @param lowWater: pop() asks for a slab when fewer than this many buffers are idle.
+      ///        Zero disables growth.
+      /// @param growBy is the number of buffers in each added slab.
+      /// @param maxBytes limits the total size of all slabs.  Zero means no limit.
+      void setGrowth(size_t lowWater, size_t growBy, size_t maxBytes = 0);
+
+      /// @brief Release added slabs that are no longer needed.
+      ///
+      /// A slab is unnecessary when the pool would still be above its low
+      /// water mark without it.
+      /// @param idleMilliseconds is how long the slab must be unnecessary before
+      ///        it is released.  Zero disables shrinking.
+      void setShrink(size_t idleMilliseconds);
+
+      /// @brief Return a buffer to the pool.
+      /// @param buffer is the buffer to be returned.
+      void push(LinkedBuffer * buffer)
+      {
+        idle_.push(buffer);
+        if(inUse_ > 0)
+        {
+          --inUse_;
+        }
+        if(exhaustedSince_ != 0)
+        {
+          exhaustedTicks_ += ProfileClock::ticks() - exhaustedSince_;
+          exhaustedSince_ = 0;
+        }
+        if(shrinkTicks_ != 0 && !slabs_.empty() && slabs_.back().grown_)
+        {
+          checkShrink();
+        }
+      }
+
+      /// @brief Return all the buffers from a queue to the pool.
+      ///
+      /// The source queue is empty after this call.
+      /// @param queue the source queue.
+      void push(BufferQueue & queue)
+      {
+        LinkedBuffer * buffer = queue.pop();
+        while(buffer != 0)
+        {
+          push(buffer);
+          buffer = queue.pop();
+        }
+      }
+
+      /// @brief Take a buffer from the pool.
+      ///
+      /// Never allocates memory.  Buffers prepared by the refill thread are
+      /// added to the idle list here.
+      /// @returns the buffer or 0 if the pool is exhausted
+      LinkedBuffer * pop()
+      {
+        if(refillsRequested_ != refillsInstalled_ && long(refillsDone_) != refillsInstalled_)
+        {
+          installRefills();
+        }
+        LinkedBuffer * buffer = idle_.pop();
+        if(buffer != 0)
+        {
+          if(++inUse_ > highWaterMark_)
+          {
+            highWaterMark_ = inUse_;
+          }
+          if(bufferCount_ - inUse_ < lowWater_)
+          {
+            requestRefill();
+          }
+          else if(cappedEpisode_)
+          {
+            cappedEpisode_ = false;
+          }
+        }
+        else
+        {
+          ++exhausted_;
+          if(exhaustedSince_ == 0)
+          {
+            exhaustedSince_ = ProfileClock::ticks();
+          }
+          requestRefill();
+        }
+        return buffer;
+      }
+
+      /// @brief The capacity of each buffer.
+      size_t bufferSize() const
+      {
+        return bufferSize_;
+      }
+
+      /// @brief The distance between the start of adjacent buffers in a slab.
+      size_t stride() const
+      {
+        return stride_;
+      }
+
+      /// @brief Statistic: How many buffers belong to the pool.
+      size_t bufferCount() const
+      {
+        return bufferCount_;
+      }
+
+      /// @brief Statistic: How many bytes of memory have been allocated for slabs.
+      size_t slabBytes() const
+      {
+        return slabBytes_;
+      }
+
+      /// @brief Statistic: How many buffers are currently popped.
+      size_t inUse() const
+      {
+        return inUse_;
+      }
+
+      /// @brief Statistic: The largest number of buffers in use at once.
+      size_t highWaterMark() const
+      {
+        return highWaterMark_;
+      }
+
+      /// @brief Statistic: How many times pop() found the pool empty.
+      size_t exhausted() const
+      {
+        return exhausted_;
+      }
+
+      /// @brief Statistic: How long has the pool spent with no idle buffers.
+      ///
+      /// Includes the current interval if the pool is exhausted now.
+      /// @returns the time in nanoseconds.
+      double exhaustedNanoseconds() const;
+
+      /// @brief Statistic: How many slabs have been added because the pool ran low.
+      size_t growths() const
+      {
+        return growths_;
+      }
+
+      /// @brief Statistic: How many times the pool ran low and could not grow because of maxBytes.
+      ///
+      /// Counts once each time the pool falls below its low water mark, not once per pop().
+      size_t capped() const
+      {
+        return capped_;
+      }
+
+      /// @brief Statistic: How many added slabs have been released.
+      size_t shrinks() const
+      {
+        return shrinks_;
+      }
+
+      /// @brief Was every slab allocated from huge pages?
+      bool usingHugePages() const
+      {
+        return !slabs_.empty() && hugeSlabs_ == slabs_.size();
+      }
+
+      /// @brief Was every slab bound to the requested NUMA node?
+      bool boundToNumaNode() const
+      {
+        return !slabs_.empty() && boundSlabs_ == slabs_.size();
+      }
+
+    private:
+      BufferPool(const BufferPool &);
+      BufferPool & operator=(const BufferPool &);
+
+      struct Slab
+      {
+        unsigned char * memory_;
+        unsigned char * allocation_;
+        size_t size_;
+        bool mapped_;
+        bool huge_;
+        bool bound_;
+        bool grown_;
+        LinkedBuffer * buffers_;
+        size_t bufferCount_;
+      };
+      void addSlab(size_t bufferCount, bool grown);
+      void prepareSlab(Slab & slab, size_t size, BufferQueue & buffers);
+      void installSlab(const Slab & slab);
+      void allocateSlab(Slab & slab, size_t size);
+      void freeSlab(Slab & slab);
+      void requestRefill();
+      void installRefills();
+      void refill();
+      void stopRefill();
+      void checkShrink();
+      bool releaseLastSlab();
+
+    private:
+      bool hugePages_;
+      int numaNode_;
+      size_t bufferSize_;
+      size_t stride_;
+      std::vector<Slab> slabs_;
+      size_t hugeSlabs_;
+      size_t boundSlabs_;
+      size_t lowWater_;
+      size_t growBy_;
+      size_t maxBytes_;
+      uint64 shrinkTicks_;
+      uint64 unneededSince_;
+      BufferQueue idle_;
+      size_t bufferCount_;
+      size_t slabBytes_;
+      size_t inUse_;
+      size_t highWaterMark_;
+      size_t exhausted_;
+      uint64 exhaustedSince_;
+      uint64 exhaustedTicks_;
+      size_t growths_;
+      size_t capped_;
+      bool cappedEpisode_;
+      size_t shrinks_;
+
+      // Owned by the thread using the pool.
+      long refillsRequested_;
+      long refillsInstalled_;
+
+      // Shared with the refill thread; protected by refillMutex_.
+      boost::mutex refillMutex_;
+      boost::condition_variable refillWanted_;
+      boost::scoped_ptr<boost::thread> refillThread_;
+      bool stopRefill_;
+      size_t refillBytes_;
+      std::vector<Slab> staged_;
+      BufferQueue stagedIdle_;
+      /// Counts refills finished by the refill thread, whether or not they succeeded.
+      AtomicCounter refillsDone_;
+    };
+  }
+}
+#endif // BUFFERPOOL_H
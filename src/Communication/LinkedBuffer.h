@@ -22,6 +22,9 @@ namespace QuickFAST
     /// it can live in an external buffer which implies that this LinkedBuffer
     /// is not concerned with the lifetime of the memory space.
     ///
+    /// A third choice is storage: memory that someone else owns (a BufferPool
+    /// for example) that this LinkedBuffer may fill up to its capacity.
+    ///
     /// An "extra" void *field in each LinkedBuffer can be used by the external application
     /// to remember information about the external buffer (or for other purposes as needed.)
     ///
@@ -39,6 +42,7 @@ namespace QuickFAST
         , used_(0)
         , extra_(0)
         , flags_(0)
+        , owned_(true)
       {
       }
 
@@ -52,6 +56,8 @@ namespace QuickFAST
         , capacity_(0)
         , used_(0)
         , extra_(0)
+        , flags_(0)
+        , owned_(false)
       {
       }
 
@@ -65,12 +71,14 @@ namespace QuickFAST
         , capacity_(0)
         , used_(used)
         , extra_(extra)
+        , flags_(0)
+        , owned_(false)
       {
       }
 
       ~LinkedBuffer()
       {
-        if(capacity_ != 0)
+        if(owned_)
         {
           delete[] buffer_;
         }
@@ -121,16 +129,27 @@ namespace QuickFAST
       ///
       void setExternal(const unsigned char * externalBuffer, size_t used, void * extra = 0)
       {
-        if(capacity_ != 0)
-        {
-          delete[] buffer_;
-          capacity_ = 0;
-        }
+        release();
         buffer_ = const_cast<unsigned char *>(externalBuffer);
         used_ = used;
         extra_ = extra;
       }
 
+      /// @brief Use storage that belongs to someone else.
+      ///
+      /// Unlike an external buffer, storage can be filled up to its capacity.
+      /// The storage must outlive this LinkedBuffer (or the next call to
+      /// setStorage or setExternal.)
+      /// @param storage is where data will be stored
+      /// @param capacity is the number of bytes available at storage
+      void setStorage(unsigned char * storage, size_t capacity)
+      {
+        release();
+        buffer_ = storage;
+        capacity_ = capacity;
+        used_ = 0;
+      }
+
       /// @brief Set the number of bytes used in this buffer
       /// @param used byte count
       void setUsed(size_t used)
@@ -209,6 +228,17 @@ namespace QuickFAST
         return flags_;
       }
 
+    private:
+      void release()
+      {
+        if(owned_)
+        {
+          delete[] buffer_;
+          owned_ = false;
+        }
+        capacity_ = 0;
+      }
+
     private:
       LinkedBuffer * link_;
       unsigned char * buffer_;
@@ -216,6 +246,7 @@ namespace QuickFAST
       size_t used_;
       void * extra_;
       uint32 flags_;
+      bool owned_;
     };
 
   }
@@ -0,0 +1,195 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+//
+#include <Common/QuickFASTPch.h>
+#include "PCapWriter.h"
+#include <Common/Exceptions.h>
+
+using namespace QuickFAST;
+using namespace Communication;
+
+namespace
+{
+#pragma pack(push)
+#pragma pack(1)
+  // libpcap file header: written in native byte order.
+  struct pcap_file_header {
+    uint32 magic;
+    uint16 version_major;
+    uint16 version_minor;
+    uint32 thiszone;
+    uint32 sigfigs;
+    uint32 snaplen;
+    uint32 linktype;
+  };
+
+  // libpcap record header with 32 bit time stamps.
+  struct pcap_pkthdr32 {
+    uint32 tv_sec;
+    uint32 tv_usec;
+    uint32 caplen;
+    uint32 len;
+  };
+#pragma pack(pop)
+
+  const uint32 nativeMagic = 0xa1b2c3d4;
+  const uint32 linkTypeEthernet = 1;
+  const size_t ethernetHeaderSize = 14;
+  const size_t ipHeaderSize = 20;
+  const size_t udpHeaderSize = 8;
+  const size_t headerSize = ethernetHeaderSize + ipHeaderSize + udpHeaderSize;
+  const size_t maximumPayload = 65535 - ipHeaderSize - udpHeaderSize;
+
+  // Headers on the wire are in network byte order.
+  void put16(unsigned char * buffer, uint32 value)
+  {
+    buffer[0] = static_cast<unsigned char>(value >> 8);
+    buffer[1] = static_cast<unsigned char>(value);
+  }
+
+  void put32(unsigned char * buffer, uint32 value)
+  {
+    put16(buffer, value >> 16);
+    put16(buffer + 2, value);
+  }
+}
+
+PCapWriter::PCapWriter()
+: file_(0)
+, source_(0x0A000001)         // 10.0.0.1
+, sourcePort_(30000)
+, destination_(0xE0010101)    // 224.1.1.1
+, destinationPort_(30001)
+, identification_(0)
+, bytesWritten_(0)
+{
+}
+
+PCapWriter::~PCapWriter()
+{
+  close();
+}
+
+bool
+PCapWriter::open(const char * filename)
+{
+  close();
+  file_ = fopen(filename, "wb");
+  if(file_ != 0)
+  {
+    pcap_file_header header;
+    header.magic = nativeMagic;
+    header.version_major = 2;
+    header.version_minor = 4;
+    header.thiszone = 0;
+    header.sigfigs = 0;
+    header.snaplen = 65535;
+    header.linktype = linkTypeEthernet;
+    if(fwrite(&header, sizeof(header), 1, file_) != 1)
+    {
+      close();
+    }
+    else
+    {
+      bytesWritten_ = sizeof(header);
+    }
+  }
+  return good();
+}
+
+void
+PCapWriter::setAddresses(
+  uint32 source,
+  unsigned short sourcePort,
+  uint32 destination,
+  unsigned short destinationPort)
+{
+  source_ = source;
+  sourcePort_ = sourcePort;
+  destination_ = destination;
+  destinationPort_ = destinationPort;
+}
+
+void
+PCapWriter::write(const unsigned char * data, size_t size, uint32 seconds, uint32 microseconds)
+{
+  if(file_ == 0)
+  {
+    throw CommunicationError("PCapWriter: file is not open.");
+  }
+  if(size > maximumPayload)
+  {
+    throw CommunicationError("PCapWriter: packet too large for UDP.");
+  }
+  pcap_pkthdr32 record;
+  record.tv_sec = seconds;
+  record.tv_usec = microseconds;
+  record.caplen = uint32(headerSize + size);
+  record.len = record.caplen;
+
+  unsigned char headers[headerSize];
+  // Ethernet II: multicast destinations map to 01:00:5e + the low 23 bits of the address.
+  unsigned char * ethernet = headers;
+  ethernet[0] = 0x01;
+  ethernet[1] = 0x00;
+  ethernet[2] = 0x5e;
+  ethernet[3] = static_cast<unsigned char>((destination_ >> 16) & 0x7F);
+  ethernet[4] = static_cast<unsigned char>(destination_ >> 8);
+  ethernet[5] = static_cast<unsigned char>(destination_);
+  ethernet[6] = 0x02; // locally administered
+  ethernet[7] = 0x00;
+  put32(ethernet + 8, source_);
+  put16(ethernet + 12, 0x0800); // IPv4
+
+  unsigned char * ip = headers + ethernetHeaderSize;
+  ip[0] = 0x45; // version 4, 5 words
+  ip[1] = 0;
+  put16(ip + 2, uint32(ipHeaderSize + udpHeaderSize + size));
+  put16(ip + 4, identification_++);
+  put16(ip + 6, 0x4000); // don't fragment
+  ip[8] = 16; // time to live
+  ip[9] = 17; // UDP
+  put16(ip + 10, 0);
+  put32(ip + 12, source_);
+  put32(ip + 16, destination_);
+  uint32 checksum = 0;
+  for(size_t pos = 0; pos < ipHeaderSize; pos += 2)
+  {
+    checksum += (uint32(ip[pos]) << 8) | ip[pos + 1];
+  }
+  checksum = (checksum & 0xFFFF) + (checksum >> 16);
+  checksum = (checksum & 0xFFFF) + (checksum >> 16);
+  put16(ip + 10, ~checksum & 0xFFFF);
+
+  unsigned char * udp = ip + ipHeaderSize;
+  put16(udp, sourcePort_);
+  put16(udp + 2, destinationPort_);
+  put16(udp + 4, uint32(udpHeaderSize + size));
+  put16(udp + 6, 0); // no checksum
+
+  if(fwrite(&record, sizeof(record), 1, file_) != 1
+    || fwrite(headers, headerSize, 1, file_) != 1
+    || (size > 0 && fwrite(data, size, 1, file_) != 1))
+  {
+    close();
+    throw CommunicationError("PCapWriter: write failed.");
+  }
+  bytesWritten_ += sizeof(record) + headerSize + size;
+}
+
+bool
+PCapWriter::good()const
+{
+  return file_ != 0 && ferror(file_) == 0;
+}
+
+void
+PCapWriter::close()
+{
+  if(file_ != 0)
+  {
+    fclose(file_);
+    file_ = 0;
+  }
+}
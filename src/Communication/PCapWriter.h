@@ -0,0 +1,81 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef PCAPWRITER_H
+#define PCAPWRITER_H
+#ifndef QUICKFAST_HEADERS
+#error Please include <Application/QuickFAST.h> preferably as a precompiled header file.
+#endif //QUICKFAST_HEADERS
+
+#include <Common/QuickFAST_Export.h>
+#include <Common/Types.h>
+
+namespace QuickFAST
+{
+  namespace Communication
+  {
+    /// @brief Write UDP packets to a PCap file.
+    ///
+    /// Each packet is wrapped in Ethernet, IPv4 and UDP headers so the file can be
+    /// read by PCapReader, Wireshark, tcpdump, and tcpreplay.
+    ///
+    /// The file uses the standard libpcap format with 32 bit time stamps,
+    /// so when reading it with PCapReader on a 64 bit system call set32bit().
+    class QuickFAST_Export PCapWriter
+    {
+    public:
+      PCapWriter();
+      ~PCapWriter();
+
+      /// @brief Create the file and write the file header.
+      /// @param filename names the file
+      /// @returns true if the file was created.
+      bool open(const char * filename);
+
+      /// @brief Set the addresses written in the packet headers.
+      /// @param source is the source IPv4 address in host byte order.
+      /// @param sourcePort is the source UDP port.
+      /// @param destination is the destination IPv4 address (usually multicast) in host byte order.
+      /// @param destinationPort is the destination UDP port.
+      void setAddresses(
+        uint32 source,
+        unsigned short sourcePort,
+        uint32 destination,
+        unsigned short destinationPort);
+
+      /// @brief Write one packet.
+      /// @param data is the UDP payload
+      /// @param size is the number of bytes in the payload (at most 65507)
+      /// @param seconds is the time stamp (seconds since 1970)
+      /// @param microseconds is the fractional part of the time stamp.
+      /// @throws CommunicationError if the packet is too large or the write fails.
+      void write(const unsigned char * data, size_t size, uint32 seconds, uint32 microseconds);
+
+      /// @brief Check the state of the file.
+      /// @returns true if the file is open and no errors have occurred.
+      bool good()const;
+
+      /// @brief Flush and close the file.
+      void close();
+
+      /// @brief How many bytes (including headers) have been written?
+      uint64 bytesWritten()const
+      {
+        return bytesWritten_;
+      }
+
+    private:
+      FILE * file_;
+      uint32 source_;
+      unsigned short sourcePort_;
+      uint32 destination_;
+      unsigned short destinationPort_;
+      unsigned short identification_;
+      uint64 bytesWritten_;
+    };
+  }
+}
+#endif // PCAPWRITER_H
@@ -12,6 +12,7 @@
 #include "Receiver_fwd.h"
 #include <Communication/Assembler.h>
 #include <Communication/SingleServerBufferQueue.h>
+#include <Communication/BufferPool.h>
 #include <Common/Exceptions.h>
 
 namespace QuickFAST
@@ -64,14 +65,7 @@ namespace QuickFAST
 
           // Allocate initial set of buffers
           boost::mutex::scoped_lock lock(bufferMutex_);
-
-          for(size_t nBuffer = 0; nBuffer < bufferCount; ++nBuffer)
-          {
-            BufferLifetime buffer(new LinkedBuffer(bufferSize));
-            /// bufferLifetimes_ is used only to clean up on object destruction
-            bufferLifetimes_.push_back(buffer);
-            idleBufferPool_.push(buffer.get());
-          }
+          idleBufferPool_.allocate(bufferSize, bufferCount);
           startReceive(lock);
           result = true;
         }
@@ -85,14 +79,40 @@ namespace QuickFAST
         size_t bufferCount = 1)
       {
         boost::mutex::scoped_lock lock(bufferMutex_);
+        idleBufferPool_.allocate(bufferSize_, bufferCount);
+      }
 
-        for(size_t nBuffer = 0; nBuffer < bufferCount; ++nBuffer)
-        {
-          BufferLifetime buffer(new LinkedBuffer(bufferSize_));
-          /// bufferLifetimes_ is used only to clean up on object destruction
-          bufferLifetimes_.push_back(buffer);
-          idleBufferPool_.push(buffer.get());
-        }
+      /// @brief Let the number of buffers follow the load.
+      ///
+      /// When fewer than lowWater buffers are idle, another growBy buffers are
+      /// allocated as long as the total buffer memory stays within maxBytes.
+      /// The pool allocates them in its own thread, not in the receiving thread.
+      /// Buffers added this way are released after they have been unnecessary
+      /// for shrinkMilliseconds.  See BufferPool::setGrowth and BufferPool::setShrink.
+      /// @param lowWater is the minimum number of idle buffers. Zero disables growth.
+      /// @param growBy is how many buffers to add at a time.
+      /// @param maxBytes limits the memory used for buffers.  Zero means no limit.
+      /// @param shrinkMilliseconds is how long to wait before releasing buffers. Zero means never.
+      void setAdaptiveBuffers(
+        size_t lowWater,
+        size_t growBy,
+        size_t maxBytes = 0,
+        size_t shrinkMilliseconds = 0)
+      {
+        boost::mutex::scoped_lock lock(bufferMutex_);
+        idleBufferPool_.setGrowth(lowWater, growBy, maxBytes);
+        idleBufferPool_.setShrink(shrinkMilliseconds);
+      }
+
+      /// @brief Access the pool that provides the receive buffers.
+      ///
+      /// Configure the pool (huge pages, NUMA node) before calling start().
+      /// The pool's statistics may be read at any time, but they are
+      /// updated by the receiving threads without synchronization.
+      /// @returns the buffer pool
+      BufferPool & bufferPool()
+      {
+        return idleBufferPool_;
       }
 
       ////////////////////////////////////////////////////////////////////
@@ -345,6 +365,13 @@ namespace QuickFAST
         return noBufferAvailable_;
       }
 
+      /// @brief Statistic: How long were all buffers busy?
+      /// @returns the time in nanoseconds during which no buffer was available to receive packets.
+      double noBufferNanoseconds() const
+      {
+        return idleBufferPool_.exhaustedNanoseconds();
+      }
+
       /// @brief Statistic: How many packets have been received
       /// @returns the number of packets that have been received
       size_t packetsReceived() const
@@ -463,8 +490,6 @@ namespace QuickFAST
     protected:
       /// The assembler to receive full buffers
       Assembler * assembler_;
-      /// Manage the buffers' lifetimes
-      BufferLifetimeManager bufferLifetimes_;
 
       /// Protect access to the SingleServerBufferQueue
       boost::mutex bufferMutex_;
@@ -481,8 +506,8 @@ namespace QuickFAST
       /// incoming communication stream (which of course is ignored for multicast)
       BufferCollection idleBuffers_;
 
-      /// @brief Buffers waiting to be filled
-      BufferCollection idleBufferPool_;
+      /// @brief Buffers waiting to be filled.  Also owns all of the buffers.
+      BufferPool idleBufferPool_;
 
       /// @brief All buffers have the same size
       size_t bufferSize_;
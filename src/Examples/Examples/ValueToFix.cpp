@@ -117,9 +117,11 @@ ValueToFix::addValue(const Messages::FieldIdentity & identity, ValueType::Type t
 void
 ValueToFix::addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const Decimal& value)
 {
-  std::string v;
-  value.toString(v);
-  out_ << identity.id() << '=' << v << '\x01';
+  char v[Decimal::maxStringLength];
+  size_t length = value.toString(v, sizeof(v));
+  out_ << identity.id() << '=';
+  out_.write(v, std::streamsize(length));
+  out_ << '\x01';
 }
 
 void
@@ -0,0 +1,399 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+//
+#include <Examples/ExamplesPch.h>
+#include "GenerateFAST.h"
+#include <GenerateFAST/MessageSynthesizer.h>
+#include <Codecs/XMLTemplateParser.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/DataDestination.h>
+#include <Messages/Message.h>
+#include <Examples/StopWatch.h>
+
+using namespace QuickFAST;
+using namespace Examples;
+
+namespace
+{
+  /// Interpret a byte count with an optional K, M, or G suffix.
+  uint64 parseSize(const std::string & text)
+  {
+    std::string digits(text);
+    uint64 multiplier = 1;
+    if(!digits.empty())
+    {
+      switch(digits[digits.size() - 1])
+      {
+      case 'k': case 'K':
+        multiplier = 1024;
+        break;
+      case 'm': case 'M':
+        multiplier = 1024 * 1024;
+        break;
+      case 'g': case 'G':
+        multiplier = 1024 * 1024 * 1024;
+        break;
+      }
+      if(multiplier != 1)
+      {
+        digits.resize(digits.size() - 1);
+      }
+    }
+    return boost::lexical_cast<uint64>(digits) * multiplier;
+  }
+
+  /// Interpret a dotted IPv4 address.
+  uint32 parseAddress(const std::string & text)
+  {
+    uint32 address = 0;
+    std::stringstream in(text);
+    for(size_t nByte = 0; nByte < 4; ++nByte)
+    {
+      unsigned int byte = 256;
+      char dot = '.';
+      if(nByte != 0)
+      {
+        in >> dot;
+      }
+      in >> byte;
+      if(!in || dot != '.' || byte > 255)
+      {
+        throw std::invalid_argument("Invalid IPv4 address " + text);
+      }
+      address = (address << 8) | byte;
+    }
+    return address;
+  }
+}
+
+GenerateFAST::GenerateFAST()
+: messageLimit_(100000)
+, byteLimit_(0)
+, seedSet_(false)
+, seed_(0)
+, resetOnPacket_(false)
+, destinationAddress_(0xE0010101)  // 224.1.1.1
+, destinationPort_(30001)
+, packetsPerSecond_(10000.0)
+, verbose_(false)
+, rawFile_(0)
+{
+}
+
+GenerateFAST::~GenerateFAST()
+{
+}
+
+bool
+GenerateFAST::init(int argc, char * argv[])
+{
+  commandArgParser_.addHandler(this);
+  return commandArgParser_.parse(argc, argv);
+}
+
+int
+GenerateFAST::parseSingleArg(int argc, char * argv[])
+{
+  int consumed = 0;
+  std::string opt(argv[0]);
+  try
+  {
+    if(opt == "-t" && argc > 1)
+    {
+      templateFileName_ = argv[1];
+      consumed = 2;
+    }
+    else if(opt == "-p" && argc > 1)
+    {
+      profileFileName_ = argv[1];
+      consumed = 2;
+    }
+    else if(opt == "-o" && argc > 1)
+    {
+      rawFileName_ = argv[1];
+      consumed = 2;
+    }
+    else if(opt == "-pcap" && argc > 1)
+    {
+      pcapFileName_ = argv[1];
+      consumed = 2;
+    }
+    else if(opt == "-n" && argc > 1)
+    {
+      messageLimit_ = boost::lexical_cast<size_t>(argv[1]);
+      consumed = 2;
+    }
+    else if(opt == "-size" && argc > 1)
+    {
+      byteLimit_ = parseSize(argv[1]);
+      consumed = 2;
+    }
+    else if(opt == "-seed" && argc > 1)
+    {
+      seed_ = boost::lexical_cast<uint32>(argv[1]);
+      seedSet_ = true;
+      consumed = 2;
+    }
+    else if(opt == "-r")
+    {
+      resetOnPacket_ = true;
+      consumed = 1;
+    }
+    else if(opt == "-addr" && argc > 1)
+    {
+      destinationAddress_ = parseAddress(argv[1]);
+      consumed = 2;
+    }
+    else if(opt == "-port" && argc > 1)
+    {
+      destinationPort_ = boost::lexical_cast<unsigned short>(argv[1]);
+      consumed = 2;
+    }
+    else if(opt == "-rate" && argc > 1)
+    {
+      packetsPerSecond_ = boost::lexical_cast<double>(argv[1]);
+      consumed = 2;
+    }
+    else if(opt == "-v")
+    {
+      verbose_ = !verbose_;
+      consumed = 1;
+    }
+  }
+  catch (std::exception & ex)
+  {
+    std::cerr << ex.what() << " while interpreting " << opt << std::endl;
+    consumed = 0;
+  }
+  return consumed;
+}
+
+void
+GenerateFAST::usage(std::ostream & out) const
+{
+  out << "  -t file     : Template file (required)" << std::endl;
+  out << "  -p file     : Profile describing the stream (default: built-in defaults)" << std::endl;
+  out << "  -o file     : Write a raw FAST file (messages back to back)" << std::endl;
+  out << "  -pcap file  : Write a PCap file with one UDP packet per packet of messages" << std::endl;
+  out << "                (At least one of -o and -pcap is required.)" << std::endl;
+  out << "  -n count    : Number of messages to generate (default 100000; 0 means no limit)" << std::endl;
+  out << "  -size bytes : Stop after this much FAST data.  Suffix K, M, or G allowed." << std::endl;
+  out << "  -seed n     : Seed for the random number generator (overrides the profile)" << std::endl;
+  out << "  -r          : Reset the encoder at the start of each packet." << std::endl;
+  out << "  -addr a.b.c.d : Destination address in PCap headers (default 224.1.1.1)" << std::endl;
+  out << "  -port n     : Destination port in PCap headers (default 30001)" << std::endl;
+  out << "  -rate n     : Packets per second for PCap time stamps (default 10000)" << std::endl;
+  out << "  -v          : Noisy output" << std::endl;
+  out << std::endl;
+  out << "PCap files use 32 bit time stamps.  Use PCapToMulticast -32 on 64 bit systems." << std::endl;
+  out << std::endl;
+  out << "Profile lines (# starts a comment):" << std::endl;
+  out << "  seed n" << std::endl;
+  out << "  template name-or-id weight" << std::endl;
+  out << "  messages_per_packet min max" << std::endl;
+  out << "  sequence name min max            (name * applies to all sequences)" << std::endl;
+  out << "  field name distribution args [repeat p] [absent p] [scale n]" << std::endl;
+  out << "                                   (name * applies to all fields)" << std::endl;
+  out << "    distributions: uniform low high | normal mean deviation | walk start step" << std::endl;
+  out << "                   increment start step | choice v1 v2 ... | text minlen maxlen" << std::endl;
+  out << "    repeat p: probability the previous value is repeated (copy/default hit rate)" << std::endl;
+  out << "    absent p: probability an optional field is omitted" << std::endl;
+  out << "    scale n: digits after the decimal point for decimal fields" << std::endl;
+}
+
+bool
+GenerateFAST::applyArgs()
+{
+  bool ok = true;
+  try
+  {
+    if(templateFileName_.empty())
+    {
+      ok = false;
+      std::cerr << "ERROR: -t [templatefile] option is required." << std::endl;
+    }
+    if(rawFileName_.empty() && pcapFileName_.empty())
+    {
+      ok = false;
+      std::cerr << "ERROR: -o [file] or -pcap [file] option is required." << std::endl;
+    }
+    if(messageLimit_ == 0 && byteLimit_ == 0)
+    {
+      ok = false;
+      std::cerr << "ERROR: -n 0 needs a -size limit." << std::endl;
+    }
+    if(packetsPerSecond_ <= 0.0)
+    {
+      ok = false;
+      std::cerr << "ERROR: -rate must be positive." << std::endl;
+    }
+    if(ok)
+    {
+      std::ifstream templateFile(templateFileName_.c_str(), std::ios::in
+#ifdef _WIN32
+        | std::ios::binary
+#endif
+        );
+      if(!templateFile.good())
+      {
+        ok = false;
+        std::cerr << "ERROR: Can't open template file: "
+          << templateFileName_
+          << std::endl;
+      }
+      else
+      {
+        Codecs::XMLTemplateParser parser;
+        templateRegistry_ = parser.parse(templateFile);
+      }
+    }
+    if(ok && !profileFileName_.empty())
+    {
+      std::ifstream profileFile(profileFileName_.c_str());
+      if(!profileFile.good())
+      {
+        ok = false;
+        std::cerr << "ERROR: Can't open profile: "
+          << profileFileName_
+          << std::endl;
+      }
+      else
+      {
+        profile_.read(profileFile);
+      }
+    }
+    if(ok && seedSet_)
+    {
+      profile_.setSeed(seed_);
+    }
+    if(ok && !rawFileName_.empty())
+    {
+      rawFile_ = fopen(rawFileName_.c_str(), "wb");
+      if(rawFile_ == 0)
+      {
+        ok = false;
+        std::cerr << "ERROR: Can't open output file: "
+          << rawFileName_
+          << std::endl;
+      }
+    }
+    if(ok && !pcapFileName_.empty())
+    {
+      if(!pcapWriter_.open(pcapFileName_.c_str()))
+      {
+        ok = false;
+        std::cerr << "ERROR: Can't open PCap output file: "
+          << pcapFileName_
+          << std::endl;
+      }
+      pcapWriter_.setAddresses(0x0A000001, 30000, destinationAddress_, destinationPort_);
+    }
+  }
+  catch (std::exception & ex)
+  {
+    std::cerr << ex.what() << std::endl;
+    ok = false;
+  }
+  if(!ok)
+  {
+    commandArgParser_.usage(std::cerr);
+  }
+  return ok;
+}
+
+int
+GenerateFAST::run()
+{
+  int result = 0;
+  try
+  {
+    MessageSynthesizer synthesizer(templateRegistry_, profile_);
+    RandomSource packetRandom(profile_.seed() + 1);
+    Codecs::Encoder encoder(templateRegistry_);
+    Codecs::DataDestination destination;
+    std::string packet;
+
+    size_t messageCount = 0;
+    size_t packetCount = 0;
+    uint64 byteCount = 0;
+    // time stamps start at a fixed time so the output is reproducible.
+    const double startTime = 1262304000.0; // 2010-01-01 00:00:00 UTC
+    const size_t minimumPerPacket = profile_.minimumMessagesPerPacket();
+    const size_t perPacketRange = profile_.maximumMessagesPerPacket() - minimumPerPacket + 1;
+
+    StopWatch lapse;
+    while((messageLimit_ == 0 || messageCount < messageLimit_)
+      && (byteLimit_ == 0 || byteCount < byteLimit_))
+    {
+      size_t messagesInPacket = minimumPerPacket + packetRandom.below(perPacketRange);
+      if(messageLimit_ != 0 && messagesInPacket > messageLimit_ - messageCount)
+      {
+        messagesInPacket = messageLimit_ - messageCount;
+      }
+      if(resetOnPacket_)
+      {
+        encoder.reset();
+      }
+      destination.clear();
+      for(size_t nMessage = 0; nMessage < messagesInPacket; ++nMessage)
+      {
+        template_id_t templateId = 0;
+        Messages::MessagePtr message = synthesizer.next(templateId);
+        encoder.encodeMessage(destination, templateId, *message);
+      }
+      destination.toString(packet);
+
+      if(rawFile_ != 0 && fwrite(packet.data(), 1, packet.size(), rawFile_) != packet.size())
+      {
+        std::cerr << "ERROR: Write failed: " << rawFileName_ << std::endl;
+        return -1;
+      }
+      if(pcapWriter_.good())
+      {
+        double timestamp = startTime + double(packetCount) / packetsPerSecond_;
+        uint32 seconds = uint32(timestamp);
+        uint32 microseconds = uint32((timestamp - double(seconds)) * 1.0e6);
+        pcapWriter_.write(
+          reinterpret_cast<const unsigned char *>(packet.data()),
+          packet.size(),
+          seconds,
+          microseconds);
+      }
+      messageCount += messagesInPacket;
+      packetCount += 1;
+      byteCount += packet.size();
+      if(verbose_ && packetCount % 10000 == 0)
+      {
+        std::cout << messageCount << " messages " << byteCount << " bytes" << std::endl;
+      }
+    }
+    unsigned long msec = lapse.freeze();
+    std::cout << "Generated " << messageCount << " messages in "
+      << packetCount << " packets; " << byteCount << " bytes of FAST data in "
+      << msec << " msec." << std::endl;
+    if(msec > 0)
+    {
+      std::cout << std::fixed << std::setprecision(1)
+        << double(byteCount) / double(msec) / 1000.0 << " MB/second." << std::endl;
+    }
+  }
+  catch (std::exception & ex)
+  {
+    std::cerr << "Generator failed: " << ex.what() << std::endl;
+    result = -1;
+  }
+  return result;
+}
+
+void
+GenerateFAST::fini()
+{
+  if(rawFile_ != 0)
+  {
+    fclose(rawFile_);
+    rawFile_ = 0;
+  }
+  pcapWriter_.close();
+}
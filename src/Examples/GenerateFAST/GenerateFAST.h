@@ -0,0 +1,74 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+//
+#ifndef GENERATEFAST_H
+#define GENERATEFAST_H
+
+#include <Application/CommandArgParser.h>
+#include <Codecs/TemplateRegistry_fwd.h>
+#include <Communication/PCapWriter.h>
+#include <GenerateFAST/StreamProfile.h>
+
+namespace QuickFAST{
+  namespace Examples{
+    /// @brief Generate a synthetic stream of FAST encoded messages for load testing.
+    ///
+    /// Messages are built from a template file and a statistical profile that describes
+    /// field values, sequence lengths, how often values repeat (the hit rate of copy
+    /// and default operators), and how many messages go into each packet.
+    /// See StreamProfile for the profile format.
+    ///
+    /// The output is a raw FAST file (messages back to back, as read by PerformanceTest
+    /// and InterpretApplication) and/or a PCap file containing one UDP packet per
+    /// packet of messages (as read by PCapToMulticast.)
+    ///
+    /// The same templates, profile, and seed always produce the same output.
+    ///
+    /// Run the program with a -? command line option for detailed usage information.
+    class GenerateFAST : public Application::CommandArgHandler
+    {
+    public:
+      GenerateFAST();
+      ~GenerateFAST();
+
+      /// @brief parse command line arguments, and initialize.
+      /// @param argc from main
+      /// @param argv from main
+      /// @returns true if everything is ok.
+      bool init(int argc, char * argv[]);
+      /// @brief run the program
+      /// @returns a value to be used as an exit code of the program (0 means all is well)
+      int run();
+      /// @brief do final cleanup after a run.
+      void fini();
+
+    private:
+      virtual int parseSingleArg(int argc, char * argv[]);
+      virtual void usage(std::ostream & out) const;
+      virtual bool applyArgs();
+
+    private:
+      std::string templateFileName_;
+      std::string profileFileName_;
+      std::string rawFileName_;
+      std::string pcapFileName_;
+      size_t messageLimit_;
+      uint64 byteLimit_;
+      bool seedSet_;
+      uint32 seed_;
+      bool resetOnPacket_;
+      uint32 destinationAddress_;
+      unsigned short destinationPort_;
+      double packetsPerSecond_;
+      bool verbose_;
+
+      Codecs::TemplateRegistryPtr templateRegistry_;
+      StreamProfile profile_;
+      FILE * rawFile_;
+      Communication::PCapWriter pcapWriter_;
+      Application::CommandArgParser commandArgParser_;
+    };
+  }
+}
+#endif // GENERATEFAST_H
@@ -0,0 +1,368 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Examples/ExamplesPch.h>
+#include "MessageSynthesizer.h"
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Template.h>
+#include <Codecs/FieldInstruction.h>
+#include <Codecs/FieldOp.h>
+#include <Messages/Message.h>
+#include <Messages/Sequence.h>
+#include <Messages/FieldInt8.h>
+#include <Messages/FieldUInt8.h>
+#include <Messages/FieldInt16.h>
+#include <Messages/FieldUInt16.h>
+#include <Messages/FieldInt32.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldInt64.h>
+#include <Messages/FieldUInt64.h>
+#include <Messages/FieldDecimal.h>
+#include <Messages/FieldAscii.h>
+#include <Messages/FieldUtf8.h>
+#include <Messages/FieldByteVector.h>
+#include <Messages/FieldSequence.h>
+#include <Messages/FieldGroup.h>
+#include <Common/Exceptions.h>
+
+using namespace QuickFAST;
+using namespace Examples;
+
+namespace
+{
+  /// Round and clamp a generated value to the range of an integer type.
+  template<typename INTEGER>
+  INTEGER toInteger(double value)
+  {
+    double low = double(std::numeric_limits<INTEGER>::min());
+    double high = double(std::numeric_limits<INTEGER>::max());
+    value = floor(value + 0.5);
+    if(value <= low)
+    {
+      return std::numeric_limits<INTEGER>::min();
+    }
+    if(value >= high)
+    {
+      return std::numeric_limits<INTEGER>::max();
+    }
+    return INTEGER(value);
+  }
+
+  bool isText(ValueType::Type type)
+  {
+    return type == ValueType::ASCII || type == ValueType::UTF8 || type == ValueType::BYTEVECTOR;
+  }
+}
+
+MessageSynthesizer::MessageSynthesizer(Codecs::TemplateRegistryPtr registry, const StreamProfile & profile)
+  : registry_(registry)
+  , profile_(profile)
+  , random_(profile.seed())
+  , totalWeight_(0.0)
+{
+  const StreamProfile::TemplateWeights & weights = profile_.templateWeights();
+  if(weights.empty())
+  {
+    for(Codecs::TemplateRegistry::const_iterator it = registry_->begin(); it != registry_->end(); ++it)
+    {
+      totalWeight_ += 1.0;
+      templates_.push_back(std::make_pair(totalWeight_, it->second));
+    }
+  }
+  for(StreamProfile::TemplateWeights::const_iterator it = weights.begin(); it != weights.end(); ++it)
+  {
+    Codecs::TemplateCPtr templ;
+    if(!registry_->findNamedTemplate(it->first, "", templ))
+    {
+      try
+      {
+        registry_->getTemplate(boost::lexical_cast<template_id_t>(it->first), templ);
+      }
+      catch(const boost::bad_lexical_cast &)
+      {
+      }
+    }
+    if(!templ)
+    {
+      throw UsageError("Profile", ("Unknown template " + it->first).c_str());
+    }
+    if(it->second > 0.0)
+    {
+      totalWeight_ += it->second;
+      templates_.push_back(std::make_pair(totalWeight_, templ));
+    }
+  }
+  if(templates_.empty())
+  {
+    throw UsageError("Profile", "No templates to generate.");
+  }
+}
+
+MessageSynthesizer::~MessageSynthesizer()
+{
+}
+
+const Codecs::Template &
+MessageSynthesizer::chooseTemplate()
+{
+  double choice = random_.uniform() * totalWeight_;
+  for(WeightedTemplates::const_iterator it = templates_.begin(); it != templates_.end(); ++it)
+  {
+    if(choice < it->first)
+    {
+      return *it->second;
+    }
+  }
+  return *templates_.back().second;
+}
+
+Messages::MessagePtr
+MessageSynthesizer::next(template_id_t & templateId)
+{
+  const Codecs::Template & templ = chooseTemplate();
+  templateId = templ.getId();
+  Messages::MessagePtr message(new Messages::Message(registry_->maxFieldCount()));
+  fillSegment(templ, *message);
+  return message;
+}
+
+void
+MessageSynthesizer::fillSegment(const Codecs::SegmentBody & segment, Messages::FieldSet & fields)
+{
+  for(size_t nField = 0; nField < segment.size(); ++nField)
+  {
+    const Codecs::FieldInstruction & instruction = *segment.getInstruction(nField);
+    switch(instruction.fieldInstructionType())
+    {
+    case ValueType::SEQUENCE:
+      addSequence(instruction, fields);
+      break;
+    case ValueType::GROUP:
+      addGroup(instruction, fields);
+      break;
+    case ValueType::TEMPLATEREF:
+      addTemplateRef(instruction, fields);
+      break;
+    default:
+      addField(instruction, fields);
+      break;
+    }
+  }
+}
+
+bool
+MessageSynthesizer::isAbsent(const Codecs::FieldInstruction & instruction, bool isText)
+{
+  if(instruction.isMandatory())
+  {
+    return false;
+  }
+  const FieldProfile & profile = profile_.field(instruction.getIdentity().getLocalName(), isText);
+  return random_.chance(profile.absent_);
+}
+
+void
+MessageSynthesizer::addField(const Codecs::FieldInstruction & instruction, Messages::FieldSet & fields)
+{
+  if(instruction.getFieldOp()->opType() == Codecs::FieldOp::CONSTANT)
+  {
+    // The encoder supplies mandatory constants; leave optional constants absent.
+    return;
+  }
+  if(isAbsent(instruction, isText(instruction.fieldInstructionType())))
+  {
+    return;
+  }
+  Messages::FieldCPtr field = scalarField(instruction);
+  if(field)
+  {
+    fields.addField(instruction.getIdentity(), field);
+  }
+}
+
+void
+MessageSynthesizer::addSequence(const Codecs::FieldInstruction & instruction, Messages::FieldSet & fields)
+{
+  if(isAbsent(instruction, false))
+  {
+    return;
+  }
+  Codecs::SegmentBodyPtr segment;
+  instruction.getSegmentBody(segment);
+  size_t minimum = 0;
+  size_t maximum = 0;
+  profile_.sequenceLength(instruction.getIdentity().getLocalName(), minimum, maximum);
+  size_t length = minimum + random_.below(maximum - minimum + 1);
+
+  Messages::FieldIdentity lengthIdentity;
+  Codecs::FieldInstructionCPtr lengthInstruction;
+  if(segment->getLengthInstruction(lengthInstruction))
+  {
+    lengthIdentity = lengthInstruction->getIdentity();
+  }
+  Messages::SequencePtr sequence(new Messages::Sequence(lengthIdentity, length));
+  for(size_t nEntry = 0; nEntry < length; ++nEntry)
+  {
+    Messages::FieldSetPtr entry(new Messages::FieldSet(segment->size()));
+    fillSegment(*segment, *entry);
+    sequence->addEntry(entry);
+  }
+  fields.addField(instruction.getIdentity(), Messages::FieldSequence::create(sequence));
+}
+
+void
+MessageSynthesizer::addGroup(const Codecs::FieldInstruction & instruction, Messages::FieldSet & fields)
+{
+  if(isAbsent(instruction, false))
+  {
+    return;
+  }
+  Codecs::SegmentBodyPtr segment;
+  instruction.getSegmentBody(segment);
+  Messages::GroupPtr group(new Messages::Group(segment->size()));
+  fillSegment(*segment, *group);
+  fields.addField(instruction.getIdentity(), Messages::FieldGroup::create(group));
+}
+
+void
+MessageSynthesizer::addTemplateRef(const Codecs::FieldInstruction & instruction, Messages::FieldSet & fields)
+{
+  const Messages::FieldIdentity & identity = instruction.getIdentity();
+  Codecs::TemplateCPtr target;
+  if(identity.getLocalName().empty() ||
+    !registry_->findNamedTemplate(identity.getLocalName(), identity.getNamespace(), target))
+  {
+    throw UsageError("Template", "Only static templateRefs to known templates can be generated.");
+  }
+  // The encoder takes the referenced template's fields from the same field set.
+  fillSegment(*target, fields);
+}
+
+double
+MessageSynthesizer::nextNumber(const std::string & name, const FieldProfile & profile)
+{
+  FieldState & state = states_[name];
+  if(state.valid_ && random_.chance(profile.repeat_))
+  {
+    return state.number_;
+  }
+  double value = 0.0;
+  switch(profile.distribution_)
+  {
+  case FieldProfile::UNIFORM:
+  case FieldProfile::TEXT:
+    value = random_.uniform(profile.first_, profile.second_);
+    break;
+  case FieldProfile::NORMAL:
+    value = random_.normal(profile.first_, profile.second_);
+    break;
+  case FieldProfile::WALK:
+    value = state.valid_
+      ? state.number_ + random_.uniform(-profile.second_, profile.second_)
+      : profile.first_;
+    break;
+  case FieldProfile::INCREMENT:
+    value = state.valid_ ? state.number_ + profile.second_ : profile.first_;
+    break;
+  case FieldProfile::CHOICE:
+    {
+      const std::string & choice = profile.choices_[random_.below(profile.choices_.size())];
+      try
+      {
+        value = boost::lexical_cast<double>(choice);
+      }
+      catch(const boost::bad_lexical_cast &)
+      {
+        throw UsageError("Profile", ("Field " + name + " needs numeric choices, not " + choice).c_str());
+      }
+      break;
+    }
+  }
+  // store the value as it will be encoded so repeats are exact
+  double scale = pow(10.0, profile.scale_);
+  value = floor(value * scale + 0.5) / scale;
+  state.valid_ = true;
+  state.number_ = value;
+  return value;
+}
+
+const std::string &
+MessageSynthesizer::nextText(const std::string & name, const FieldProfile & profile)
+{
+  FieldState & state = states_[name];
+  if(state.valid_ && random_.chance(profile.repeat_))
+  {
+    return state.text_;
+  }
+  switch(profile.distribution_)
+  {
+  case FieldProfile::TEXT:
+    {
+      size_t minimum = size_t(profile.first_);
+      size_t length = minimum + random_.below(size_t(profile.second_) - minimum + 1);
+      state.text_.resize(length);
+      for(size_t pos = 0; pos < length; ++pos)
+      {
+        state.text_[pos] = char('A' + random_.below(26));
+      }
+      break;
+    }
+  case FieldProfile::CHOICE:
+    state.text_ = profile.choices_[random_.below(profile.choices_.size())];
+    break;
+  default:
+    {
+      // numeric distributions produce digits.
+      FieldProfile integer(profile);
+      integer.repeat_ = 0.0;
+      integer.scale_ = 0;
+      std::string key(name);
+      key += '#';
+      state.text_ = boost::lexical_cast<std::string>(toInteger<int64>(nextNumber(key, integer)));
+      break;
+    }
+  }
+  state.valid_ = true;
+  return state.text_;
+}
+
+Messages::FieldCPtr
+MessageSynthesizer::scalarField(const Codecs::FieldInstruction & instruction)
+{
+  const std::string & name = instruction.getIdentity().getLocalName();
+  ValueType::Type type = instruction.fieldInstructionType();
+  const FieldProfile & profile = profile_.field(name, isText(type));
+  switch(type)
+  {
+  case ValueType::INT8:
+    return Messages::FieldInt8::create(toInteger<int8>(nextNumber(name, profile)));
+  case ValueType::UINT8:
+    return Messages::FieldUInt8::create(toInteger<uchar>(nextNumber(name, profile)));
+  case ValueType::INT16:
+    return Messages::FieldInt16::create(toInteger<int16>(nextNumber(name, profile)));
+  case ValueType::UINT16:
+    return Messages::FieldUInt16::create(toInteger<uint16>(nextNumber(name, profile)));
+  case ValueType::INT32:
+    return Messages::FieldInt32::create(toInteger<int32>(nextNumber(name, profile)));
+  case ValueType::UINT32:
+    return Messages::FieldUInt32::create(toInteger<uint32>(nextNumber(name, profile)));
+  case ValueType::INT64:
+    return Messages::FieldInt64::create(toInteger<int64>(nextNumber(name, profile)));
+  case ValueType::UINT64:
+    return Messages::FieldUInt64::create(toInteger<uint64>(nextNumber(name, profile)));
+  case ValueType::DECIMAL:
+    {
+      double value = nextNumber(name, profile);
+      mantissa_t mantissa = toInteger<mantissa_t>(value * pow(10.0, profile.scale_));
+      return Messages::FieldDecimal::create(mantissa, exponent_t(-profile.scale_));
+    }
+  case ValueType::ASCII:
+    return Messages::FieldAscii::create(nextText(name, profile));
+  case ValueType::UTF8:
+    return Messages::FieldUtf8::create(nextText(name, profile));
+  case ValueType::BYTEVECTOR:
+    return Messages::FieldByteVector::create(nextText(name, profile));
+  default:
+    return Messages::FieldCPtr();
+  }
+}
@@ -0,0 +1,81 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef MESSAGESYNTHESIZER_H
+#define MESSAGESYNTHESIZER_H
+#include "StreamProfile.h"
+#include <Codecs/TemplateRegistry_fwd.h>
+#include <Codecs/Template_fwd.h>
+#include <Codecs/SegmentBody_fwd.h>
+#include <Codecs/FieldInstruction_fwd.h>
+#include <Messages/Message_fwd.h>
+#include <Messages/FieldSet_fwd.h>
+#include <Messages/Field_fwd.h>
+
+namespace QuickFAST{
+  namespace Examples{
+    /// @brief Create messages whose field values follow a StreamProfile.
+    ///
+    /// Every message is valid for its template: mandatory fields are always present,
+    /// constants are left to the encoder, and groups, sequences and static template
+    /// references are filled in recursively.
+    ///
+    /// The sequence of messages depends only on the templates, the profile, and the seed.
+    class MessageSynthesizer
+    {
+    public:
+      /// @brief Construct
+      /// @param registry contains the templates.
+      /// @param profile describes the values.  Must outlive the synthesizer.
+      /// @throws UsageError if the profile names a template that is not in the registry.
+      MessageSynthesizer(Codecs::TemplateRegistryPtr registry, const StreamProfile & profile);
+      ~MessageSynthesizer();
+
+      /// @brief Create the next message.
+      /// @param[out] templateId is the template to be used to encode the message.
+      /// @returns the message.
+      Messages::MessagePtr next(template_id_t & templateId);
+
+    private:
+      const Codecs::Template & chooseTemplate();
+      void fillSegment(const Codecs::SegmentBody & segment, Messages::FieldSet & fields);
+      void addField(const Codecs::FieldInstruction & instruction, Messages::FieldSet & fields);
+      void addSequence(const Codecs::FieldInstruction & instruction, Messages::FieldSet & fields);
+      void addGroup(const Codecs::FieldInstruction & instruction, Messages::FieldSet & fields);
+      void addTemplateRef(const Codecs::FieldInstruction & instruction, Messages::FieldSet & fields);
+      bool isAbsent(const Codecs::FieldInstruction & instruction, bool isText);
+      double nextNumber(const std::string & name, const FieldProfile & profile);
+      const std::string & nextText(const std::string & name, const FieldProfile & profile);
+      Messages::FieldCPtr scalarField(const Codecs::FieldInstruction & instruction);
+
+    private:
+      Codecs::TemplateRegistryPtr registry_;
+      const StreamProfile & profile_;
+      RandomSource random_;
+
+      /// Templates with cumulative weights for choosing a template
+      typedef std::vector<std::pair<double, Codecs::TemplateCPtr> > WeightedTemplates;
+      WeightedTemplates templates_;
+      double totalWeight_;
+
+      /// The most recent value of a field: used for repeats, walks and increments.
+      struct FieldState
+      {
+        FieldState()
+          : valid_(false)
+          , number_(0.0)
+        {
+        }
+        bool valid_;
+        double number_;
+        std::string text_;
+      };
+      typedef std::map<std::string, FieldState> FieldStates;
+      FieldStates states_;
+    };
+  }
+}
+#endif // MESSAGESYNTHESIZER_H
@@ -0,0 +1,279 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Examples/ExamplesPch.h>
+#include "StreamProfile.h"
+#include <Common/Exceptions.h>
+
+using namespace QuickFAST;
+using namespace Examples;
+
+namespace
+{
+  void profileError(size_t lineNumber, const std::string & message)
+  {
+    std::stringstream msg;
+    msg << "Profile line " << lineNumber << ": " << message;
+    throw UsageError("Profile", msg.str().c_str());
+  }
+
+  template<typename VALUE>
+  VALUE readValue(std::istream & in, size_t lineNumber, const char * what)
+  {
+    std::string token;
+    if(!(in >> token))
+    {
+      profileError(lineNumber, std::string("Missing ") + what);
+    }
+    try
+    {
+      return boost::lexical_cast<VALUE>(token);
+    }
+    catch(const boost::bad_lexical_cast &)
+    {
+      profileError(lineNumber, std::string("Invalid ") + what + ": " + token);
+    }
+    return VALUE();
+  }
+
+  double readProbability(std::istream & in, size_t lineNumber)
+  {
+    double probability = readValue<double>(in, lineNumber, "probability");
+    if(probability < 0.0 || probability > 1.0)
+    {
+      profileError(lineNumber, "Probability must be between 0 and 1");
+    }
+    return probability;
+  }
+}
+
+double
+RandomSource::normal(double mean, double deviation)
+{
+  double u1 = uniform();
+  double u2 = uniform();
+  if(u1 <= 0.0)
+  {
+    u1 = 1.0 / 4294967296.0;
+  }
+  return mean + deviation * sqrt(-2.0 * log(u1)) * cos(2.0 * 3.14159265358979323846 * u2);
+}
+
+FieldProfile::FieldProfile()
+  : distribution_(UNIFORM)
+  , first_(0.0)
+  , second_(1000.0)
+  , repeat_(0.5)
+  , absent_(0.1)
+  , scale_(2)
+{
+}
+
+StreamProfile::StreamProfile()
+  : seed_(5489)
+  , minimumMessagesPerPacket_(1)
+  , maximumMessagesPerPacket_(1)
+  , hasDefaultField_(false)
+  , defaultSequence_(1, 4)
+{
+  defaultText_.distribution_ = FieldProfile::TEXT;
+  defaultText_.first_ = 4.0;
+  defaultText_.second_ = 8.0;
+}
+
+void
+StreamProfile::read(std::istream & in)
+{
+  std::string line;
+  size_t lineNumber = 0;
+  while(std::getline(in, line))
+  {
+    ++lineNumber;
+    std::string::size_type comment = line.find('#');
+    if(comment != std::string::npos)
+    {
+      line.resize(comment);
+    }
+    std::stringstream words(line);
+    std::string keyword;
+    if(!(words >> keyword))
+    {
+      continue;
+    }
+    if(keyword == "seed")
+    {
+      seed_ = readValue<uint32>(words, lineNumber, "seed");
+    }
+    else if(keyword == "template")
+    {
+      std::string name = readValue<std::string>(words, lineNumber, "template");
+      double weight = readValue<double>(words, lineNumber, "weight");
+      if(weight < 0.0)
+      {
+        profileError(lineNumber, "Template weight must not be negative");
+      }
+      templateWeights_.push_back(std::make_pair(name, weight));
+    }
+    else if(keyword == "messages_per_packet")
+    {
+      minimumMessagesPerPacket_ = readValue<size_t>(words, lineNumber, "minimum");
+      maximumMessagesPerPacket_ = readValue<size_t>(words, lineNumber, "maximum");
+      if(minimumMessagesPerPacket_ == 0 || minimumMessagesPerPacket_ > maximumMessagesPerPacket_)
+      {
+        profileError(lineNumber, "messages_per_packet needs 0 < min <= max");
+      }
+    }
+    else if(keyword == "sequence")
+    {
+      std::string name = readValue<std::string>(words, lineNumber, "sequence");
+      std::pair<size_t, size_t> length;
+      length.first = readValue<size_t>(words, lineNumber, "minimum");
+      length.second = readValue<size_t>(words, lineNumber, "maximum");
+      if(length.first > length.second)
+      {
+        profileError(lineNumber, "sequence needs min <= max");
+      }
+      if(name == "*")
+      {
+        defaultSequence_ = length;
+      }
+      else
+      {
+        sequences_[name] = length;
+      }
+    }
+    else if(keyword == "field")
+    {
+      std::string name = readValue<std::string>(words, lineNumber, "field");
+      readField(name, words, lineNumber);
+    }
+    else
+    {
+      profileError(lineNumber, "Unknown keyword " + keyword);
+    }
+  }
+}
+
+void
+StreamProfile::readField(const std::string & name, std::istream & in, size_t lineNumber)
+{
+  FieldProfile field;
+  std::string distribution = readValue<std::string>(in, lineNumber, "distribution");
+  if(distribution == "uniform")
+  {
+    field.distribution_ = FieldProfile::UNIFORM;
+  }
+  else if(distribution == "normal")
+  {
+    field.distribution_ = FieldProfile::NORMAL;
+  }
+  else if(distribution == "walk")
+  {
+    field.distribution_ = FieldProfile::WALK;
+  }
+  else if(distribution == "increment")
+  {
+    field.distribution_ = FieldProfile::INCREMENT;
+  }
+  else if(distribution == "text")
+  {
+    field.distribution_ = FieldProfile::TEXT;
+  }
+  else if(distribution == "choice")
+  {
+    field.distribution_ = FieldProfile::CHOICE;
+  }
+  else
+  {
+    profileError(lineNumber, "Unknown distribution " + distribution);
+  }
+
+  std::string word;
+  if(field.distribution_ == FieldProfile::CHOICE)
+  {
+    while(in >> word && word != "repeat" && word != "absent" && word != "scale")
+    {
+      field.choices_.push_back(word);
+    }
+    if(field.choices_.empty())
+    {
+      profileError(lineNumber, "choice needs at least one value");
+    }
+  }
+  else
+  {
+    field.first_ = readValue<double>(in, lineNumber, "distribution argument");
+    field.second_ = readValue<double>(in, lineNumber, "distribution argument");
+    if(field.distribution_ == FieldProfile::TEXT && (field.first_ < 0 || field.first_ > field.second_))
+    {
+      profileError(lineNumber, "text needs 0 <= min <= max");
+    }
+    if(!(in >> word))
+    {
+      word.clear();
+    }
+  }
+
+  // word holds the first modifier (if any)
+  while(!word.empty())
+  {
+    if(word == "repeat")
+    {
+      field.repeat_ = readProbability(in, lineNumber);
+    }
+    else if(word == "absent")
+    {
+      field.absent_ = readProbability(in, lineNumber);
+    }
+    else if(word == "scale")
+    {
+      field.scale_ = readValue<int>(in, lineNumber, "scale");
+      if(field.scale_ < 0 || field.scale_ > 18)
+      {
+        profileError(lineNumber, "scale must be between 0 and 18");
+      }
+    }
+    else
+    {
+      profileError(lineNumber, "Unknown modifier " + word);
+    }
+    if(!(in >> word))
+    {
+      word.clear();
+    }
+  }
+
+  if(name == "*")
+  {
+    hasDefaultField_ = true;
+    defaultField_ = field;
+  }
+  else
+  {
+    fields_[name] = field;
+  }
+}
+
+const FieldProfile &
+StreamProfile::field(const std::string & name, bool isText)const
+{
+  FieldProfiles::const_iterator it = fields_.find(name);
+  if(it != fields_.end())
+  {
+    return it->second;
+  }
+  if(hasDefaultField_)
+  {
+    return defaultField_;
+  }
+  return isText ? defaultText_ : defaultNumber_;
+}
+
+void
+StreamProfile::sequenceLength(const std::string & name, size_t & minimum, size_t & maximum)const
+{
+  SequenceLengths::const_iterator it = sequences_.find(name);
+  const std::pair<size_t, size_t> & length = (it != sequences_.end()) ? it->second : defaultSequence_;
+  minimum = length.first;
+  maximum = length.second;
+}
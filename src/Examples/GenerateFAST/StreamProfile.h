@@ -0,0 +1,193 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef STREAMPROFILE_H
+#define STREAMPROFILE_H
+#include <Common/Types.h>
+#include <boost/random/mersenne_twister.hpp>
+
+namespace QuickFAST{
+  namespace Examples{
+    /// @brief A deterministic source of random numbers.
+    ///
+    /// The same seed always produces the same stream.
+    class RandomSource
+    {
+    public:
+      /// @brief Construct
+      /// @param seed starts the sequence
+      explicit RandomSource(uint32 seed = 5489)
+        : engine_(seed)
+      {
+      }
+
+      /// @brief A value uniformly distributed in [0, 1)
+      double uniform()
+      {
+        return double(engine_()) / 4294967296.0;
+      }
+
+      /// @brief A value uniformly distributed in [low, high]
+      double uniform(double low, double high)
+      {
+        return low + (high - low) * uniform();
+      }
+
+      /// @brief An integer uniformly distributed in [0, limit)
+      size_t below(size_t limit)
+      {
+        size_t result = size_t(uniform() * double(limit));
+        return result < limit ? result : limit - 1;
+      }
+
+      /// @brief A normally distributed value (Box-Muller)
+      double normal(double mean, double deviation);
+
+      /// @brief True with the given probability.
+      bool chance(double probability)
+      {
+        return probability > 0.0 && uniform() < probability;
+      }
+
+    private:
+      boost::mt19937 engine_;
+    };
+
+    /// @brief How to generate the values of one field.
+    ///
+    /// A profile line has the form:
+    /// <pre>
+    ///   field name distribution arguments... [repeat p] [absent p] [scale n]
+    /// </pre>
+    /// Distributions:
+    /// - uniform low high: uniformly distributed.
+    /// - normal mean deviation: normally distributed.
+    /// - walk start step: a random walk starting at start moving at most step each time.
+    /// - increment start step: start, start+step, start+2*step...
+    /// - choice a b c...: one of the listed values (numbers or text.)
+    /// - text min max: random upper case letters; length uniformly distributed in [min,max]
+    ///
+    /// Modifiers:
+    /// - repeat p: with probability p the previous value is used again.
+    ///   This sets the hit rate for copy and default operators.
+    /// - absent p: with probability p an optional field is omitted.
+    /// - scale n: decimal values have n digits after the decimal point.
+    struct FieldProfile
+    {
+      /// @brief The supported distributions.
+      enum Distribution
+      {
+        UNIFORM,
+        NORMAL,
+        WALK,
+        INCREMENT,
+        CHOICE,
+        TEXT
+      };
+
+      FieldProfile();
+
+      /// The distribution from which values are drawn.
+      Distribution distribution_;
+      /// First parameter of the distribution (low, mean, start, or minimum length)
+      double first_;
+      /// Second parameter of the distribution (high, deviation, step, or maximum length)
+      double second_;
+      /// The values for a CHOICE distribution.
+      std::vector<std::string> choices_;
+      /// Probability that the previous value is used again.
+      double repeat_;
+      /// Probability that an optional field is omitted.
+      double absent_;
+      /// Digits after the decimal point for decimal fields.
+      int scale_;
+    };
+
+    /// @brief A statistical description of a FAST stream.
+    ///
+    /// Read from a text file with one setting per line.  '#' starts a comment.
+    /// <pre>
+    ///   seed n                       # seed for the random number generator
+    ///   template name-or-id weight   # relative frequency of a template
+    ///   messages_per_packet min max  # messages in each packet (uniform)
+    ///   sequence name min max        # entries in a sequence (uniform; name * for all sequences)
+    ///   field name ...               # see FieldProfile (name * for all fields)
+    /// </pre>
+    /// If no template lines appear, all templates are used equally often.
+    /// Fields and sequences are identified by their local name.
+    /// Fields without a field line use the "field *" settings or, if there are none,
+    /// uniform 0 1000 (numbers) or text 4 8 (strings) with repeat 0.5 and absent 0.1.
+    class StreamProfile
+    {
+    public:
+      StreamProfile();
+
+      /// @brief Read the profile from a stream.
+      /// @throws UsageError if the profile contains an error.
+      void read(std::istream & in);
+
+      /// @brief Seed for the random number generator.
+      uint32 seed()const
+      {
+        return seed_;
+      }
+
+      /// @brief Set the seed (overrides the profile)
+      void setSeed(uint32 seed)
+      {
+        seed_ = seed;
+      }
+
+      /// @brief Smallest number of messages per packet.
+      size_t minimumMessagesPerPacket()const
+      {
+        return minimumMessagesPerPacket_;
+      }
+
+      /// @brief Largest number of messages per packet.
+      size_t maximumMessagesPerPacket()const
+      {
+        return maximumMessagesPerPacket_;
+      }
+
+      /// @brief Template weights by template name or id as given in the profile.
+      typedef std::vector<std::pair<std::string, double> > TemplateWeights;
+
+      /// @brief The relative frequency of templates.
+      const TemplateWeights & templateWeights()const
+      {
+        return templateWeights_;
+      }
+
+      /// @brief Find the profile for a field.
+      /// @param name is the local name of the field.
+      /// @param isText selects the built-in default for strings and byte vectors.
+      const FieldProfile & field(const std::string & name, bool isText)const;
+
+      /// @brief Find the range of sequence lengths for a sequence.
+      void sequenceLength(const std::string & name, size_t & minimum, size_t & maximum)const;
+
+    private:
+      void readField(const std::string & name, std::istream & in, size_t lineNumber);
+
+    private:
+      uint32 seed_;
+      size_t minimumMessagesPerPacket_;
+      size_t maximumMessagesPerPacket_;
+      TemplateWeights templateWeights_;
+      typedef std::map<std::string, FieldProfile> FieldProfiles;
+      FieldProfiles fields_;
+      bool hasDefaultField_;
+      FieldProfile defaultField_;
+      FieldProfile defaultNumber_;
+      FieldProfile defaultText_;
+      typedef std::map<std::string, std::pair<size_t, size_t> > SequenceLengths;
+      SequenceLengths sequences_;
+      std::pair<size_t, size_t> defaultSequence_;
+    };
+  }
+}
+#endif // STREAMPROFILE_H
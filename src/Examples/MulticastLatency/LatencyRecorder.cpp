@@ -0,0 +1,71 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+//
+
+#include <Examples/ExamplesPch.h>
+#include "LatencyRecorder.h"
+
+using namespace QuickFAST;
+using namespace Examples;
+
+LatencyRecorder::LatencyRecorder(const StampHeaderAnalyzer & stamps)
+  : stamps_(stamps)
+  , expected_(0)
+{
+}
+
+LatencyRecorder::~LatencyRecorder()
+{
+}
+
+uint64
+LatencyRecorder::received()const
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  return results_.received_;
+}
+
+void
+LatencyRecorder::collect(Results & results, uint64 nextSequence)
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  results = results_;
+  // Anything that was sent but never arrived is missing, too.
+  if(nextSequence > expected_)
+  {
+    results.missing_ += nextSequence - expected_;
+  }
+  results_.latency_.clear();
+  results_.received_ = 0;
+  results_.missing_ = 0;
+  results_.outOfOrder_ = 0;
+  expected_ = nextSequence;
+}
+
+bool
+LatencyRecorder::endMessage(Messages::ValueMessageBuilder & messageBuilder)
+{
+  uint64 lapse = ProfileClock::ticks() - stamps_.sendTicks();
+  uint64 sequence = stamps_.sequence();
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    results_.latency_.record(lapse);
+    results_.received_ += 1;
+    if(sequence >= expected_)
+    {
+      results_.missing_ += sequence - expected_;
+      expected_ = sequence + 1;
+    }
+    else
+    {
+      // it was counted as missing when a later packet arrived.
+      results_.outOfOrder_ += 1;
+      if(results_.missing_ > 0)
+      {
+        results_.missing_ -= 1;
+      }
+    }
+  }
+  return PerformanceBuilder::endMessage(messageBuilder);
+}
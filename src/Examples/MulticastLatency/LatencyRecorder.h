@@ -0,0 +1,70 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef LATENCYRECORDER_H
+#define LATENCYRECORDER_H
+#include <Examples/MessagePerformance.h>
+#include <Common/Profiler.h>
+#include <MulticastLatency/StampHeaderAnalyzer.h>
+
+namespace QuickFAST{
+  namespace Examples{
+    /// @brief A PerformanceBuilder that measures the time from send to the end of decoding.
+    ///
+    /// When the decoder finishes a message the time since the packet was sent,
+    /// as found by the StampHeaderAnalyzer, is recorded in ProfileClock ticks.
+    /// Sequence numbers are checked to count packets that never arrived.
+    ///
+    /// The recorder is used by the receiver's thread.  Call collect() from any
+    /// thread to take the results gathered so far and start over.
+    class LatencyRecorder : public PerformanceBuilder
+    {
+    public:
+      /// @brief What happened since the previous call to collect()
+      struct Results
+      {
+        Results()
+          : received_(0)
+          , missing_(0)
+          , outOfOrder_(0)
+        {
+        }
+        /// Latencies of the messages received in ticks.
+        ProfileHistogram latency_;
+        /// Messages decoded.
+        uint64 received_;
+        /// Sequence numbers skipped.
+        uint64 missing_;
+        /// Messages that arrived after a later one.
+        uint64 outOfOrder_;
+      };
+
+      /// @brief Construct
+      /// @param stamps provides the send time of the packet being decoded.
+      explicit LatencyRecorder(const StampHeaderAnalyzer & stamps);
+      virtual ~LatencyRecorder();
+
+      /// @brief How many messages have been decoded since the last collect()
+      uint64 received()const;
+
+      /// @brief Take the results and start over.
+      /// @param[out] results receives everything recorded since the previous call.
+      /// @param nextSequence is the sequence number that the next packet will carry.
+      void collect(Results & results, uint64 nextSequence);
+
+      ///////////////////////////////////////////
+      // Override ValueMessageBuilder methods
+      virtual bool endMessage(Messages::ValueMessageBuilder & messageBuilder);
+
+    private:
+      const StampHeaderAnalyzer & stamps_;
+      mutable boost::mutex mutex_;
+      Results results_;
+      uint64 expected_;
+    };
+  }
+}
+#endif // LATENCYRECORDER_H
@@ -0,0 +1,507 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+//
+#include <Examples/ExamplesPch.h>
+#include "MulticastLatency.h"
+#include <Codecs/XMLTemplateParser.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Template.h>
+#include <Codecs/FieldInstruction.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/NoHeaderAnalyzer.h>
+#include <Codecs/MessagePerPacketAssembler.h>
+#include <Communication/MulticastSender.h>
+#include <Communication/MulticastReceiver.h>
+#include <Messages/Message.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldUInt64.h>
+#include <Messages/FieldAscii.h>
+#include <Messages/FieldDecimal.h>
+#include <boost/array.hpp>
+
+using namespace QuickFAST;
+using namespace Examples;
+
+namespace
+{
+  /// A quote much like those in a typical market data feed.
+  /// The optional Text field pads the message to the requested size.
+  const char * quoteTemplate =
+    "<templates xmlns=\"http://www.fixprotocol.org/ns/fast/td/1.1\">"
+    "  <template name=\"Quote\" id=\"1\">"
+    "    <uInt32 name=\"MsgSeqNum\" id=\"34\"><increment/></uInt32>"
+    "    <uInt64 name=\"SendingTime\" id=\"52\"><delta/></uInt64>"
+    "    <string name=\"Symbol\" id=\"55\"><copy/></string>"
+    "    <decimal name=\"BidPx\" id=\"132\"><delta/></decimal>"
+    "    <uInt32 name=\"BidSize\" id=\"134\"><copy/></uInt32>"
+    "    <decimal name=\"OfferPx\" id=\"133\"><delta/></decimal>"
+    "    <uInt32 name=\"OfferSize\" id=\"135\"><copy/></uInt32>"
+    "    <string name=\"Text\" id=\"58\" presence=\"optional\"/>"
+    "  </template>"
+    "</templates>";
+
+  const template_id_t quoteId = 1;
+
+  /// How many different messages to cycle through.
+  const size_t distinctMessages = 1024;
+
+  /// Receive buffers must hold the largest packet.
+  const size_t receiveBufferSize = 65536;
+
+  double microseconds(uint64 ticks)
+  {
+    return ProfileClock::toNanoseconds(double(ticks)) / 1000.0;
+  }
+}
+
+MulticastLatency::MulticastLatency()
+: multicastGroupIP_("239.255.0.1")
+, listenInterfaceIP_("127.0.0.1")
+, bindIP_("0.0.0.0")
+, portNumber_(30001)
+, messageCount_(100000)
+, warmupCount_(1000)
+, padding_(0)
+, bufferCount_(100)
+, drainMilliseconds_(200)
+, sequence_(0)
+{
+}
+
+MulticastLatency::~MulticastLatency()
+{
+}
+
+bool
+MulticastLatency::init(int argc, char * argv[])
+{
+  commandArgParser_.addHandler(this);
+  return commandArgParser_.parse(argc, argv);
+}
+
+int
+MulticastLatency::parseSingleArg(int argc, char * argv[])
+{
+  int consumed = 0;
+  std::string opt(argv[0]);
+  try
+  {
+    if(opt == "-a" && argc > 1)
+    {
+      multicastGroupIP_ = argv[1];
+      consumed = 2;
+    }
+    else if(opt == "-i" && argc > 1)
+    {
+      listenInterfaceIP_ = argv[1];
+      consumed = 2;
+    }
+    else if(opt == "-b" && argc > 1)
+    {
+      bindIP_ = argv[1];
+      consumed = 2;
+    }
+    else if(opt == "-p" && argc > 1)
+    {
+      portNumber_ = boost::lexical_cast<unsigned short>(argv[1]);
+      consumed = 2;
+    }
+    else if(opt == "-r" && argc > 1)
+    {
+      rates_.clear();
+      std::string list(argv[1]);
+      size_t pos = 0;
+      while(pos <= list.size())
+      {
+        size_t comma = list.find(',', pos);
+        if(comma == std::string::npos)
+        {
+          comma = list.size();
+        }
+        rates_.push_back(boost::lexical_cast<double>(list.substr(pos, comma - pos)));
+        pos = comma + 1;
+      }
+      consumed = 2;
+    }
+    else if(opt == "-n" && argc > 1)
+    {
+      messageCount_ = boost::lexical_cast<size_t>(argv[1]);
+      consumed = 2;
+    }
+    else if(opt == "-w" && argc > 1)
+    {
+      warmupCount_ = boost::lexical_cast<size_t>(argv[1]);
+      consumed = 2;
+    }
+    else if(opt == "-s" && argc > 1)
+    {
+      padding_ = boost::lexical_cast<size_t>(argv[1]);
+      consumed = 2;
+    }
+    else if(opt == "-c" && argc > 1)
+    {
+      bufferCount_ = boost::lexical_cast<size_t>(argv[1]);
+      consumed = 2;
+    }
+    else if(opt == "-d" && argc > 1)
+    {
+      drainMilliseconds_ = boost::lexical_cast<size_t>(argv[1]);
+      consumed = 2;
+    }
+    else if(opt == "-csv" && argc > 1)
+    {
+      csvFileName_ = argv[1];
+      consumed = 2;
+    }
+  }
+  catch (std::exception & ex)
+  {
+    std::cerr << ex.what() << " while interpreting " << opt << std::endl;
+    consumed = 0;
+  }
+  return consumed;
+}
+
+void
+MulticastLatency::usage(std::ostream & out) const
+{
+  out << "  -a dotted_ip  : Multicast group (default 239.255.0.1)" << std::endl;
+  out << "  -i dotted_ip  : Interface used to send and receive (default 127.0.0.1)" << std::endl;
+  out << "  -b dotted_ip  : Address the receiver binds to (default 0.0.0.0)" << std::endl;
+  out << "  -p port       : Port number (default 30001)" << std::endl;
+  out << "  -r r1,r2,...  : Offered loads in messages per second." << std::endl;
+  out << "                  0 means as fast as possible. (default 1000,10000,50000,100000,0)" << std::endl;
+  out << "  -n count      : Messages to send at each rate (default 100000)" << std::endl;
+  out << "  -w count      : Messages to send before measuring (default 1000)" << std::endl;
+  out << "  -s bytes      : Extra text added to each message (default 0)" << std::endl;
+  out << "  -c count      : Receive buffers (default 100)" << std::endl;
+  out << "  -d msec       : How long to wait for stragglers after each rate (default 200)" << std::endl;
+  out << "  -csv file     : Also write the results to a comma separated file." << std::endl;
+  out << std::endl;
+  out << "Latency is measured from just before a packet is sent until" << std::endl;
+  out << "the decoder delivers the end of the message in it." << std::endl;
+  out << "Each packet carries one message after a 16 byte time stamp." << std::endl;
+}
+
+bool
+MulticastLatency::applyArgs()
+{
+  bool ok = true;
+  try
+  {
+    if(rates_.empty())
+    {
+      rates_.push_back(1000.0);
+      rates_.push_back(10000.0);
+      rates_.push_back(50000.0);
+      rates_.push_back(100000.0);
+      rates_.push_back(0.0);
+    }
+    for(size_t nRate = 0; nRate < rates_.size(); ++nRate)
+    {
+      if(rates_[nRate] < 0.0)
+      {
+        ok = false;
+        std::cerr << "ERROR: -r rates may not be negative." << std::endl;
+      }
+    }
+    if(messageCount_ == 0)
+    {
+      ok = false;
+      std::cerr << "ERROR: -n count must be positive." << std::endl;
+    }
+    if(bufferCount_ == 0)
+    {
+      ok = false;
+      std::cerr << "ERROR: -c count must be positive." << std::endl;
+    }
+    if(ok)
+    {
+      std::stringstream templateText(quoteTemplate);
+      Codecs::XMLTemplateParser parser;
+      templateRegistry_ = parser.parse(templateText);
+      encodeMessages();
+    }
+  }
+  catch (std::exception & ex)
+  {
+    std::cerr << ex.what() << std::endl;
+    ok = false;
+  }
+  if(!ok)
+  {
+    commandArgParser_.usage(std::cerr);
+  }
+  return ok;
+}
+
+void
+MulticastLatency::encodeMessages()
+{
+  Codecs::TemplateCPtr templ;
+  if(!templateRegistry_->getTemplate(quoteId, templ))
+  {
+    throw std::logic_error("Quote template is missing.");
+  }
+  // The template declares a namespace, so use the identities it created.
+  std::vector<const Messages::FieldIdentity *> identities;
+  for(size_t nField = 0; nField < templ->size(); ++nField)
+  {
+    identities.push_back(&templ->getInstruction(nField)->getIdentity());
+  }
+
+  const char * symbols[] = {"IBM", "MSFT", "GOOG", "ORCL", "AAPL", "CSCO", "INTC", "AMZN"};
+  const size_t symbolCount = sizeof(symbols) / sizeof(symbols[0]);
+
+  Codecs::Encoder encoder(templateRegistry_);
+  Codecs::DataDestination destination;
+  packets_.resize(distinctMessages);
+  for(size_t nMessage = 0; nMessage < distinctMessages; ++nMessage)
+  {
+    Messages::Message message(templateRegistry_->maxFieldCount());
+    mantissa_t bid = mantissa_t(1234500 + (nMessage % 7) * 25 - (nMessage % 5) * 20);
+    size_t field = 0;
+    message.addField(*identities[field++], Messages::FieldUInt32::create(uint32(nMessage + 1)));
+    message.addField(*identities[field++], Messages::FieldUInt64::create(uint64(1262304000000ULL + nMessage * 3)));
+    message.addField(*identities[field++], Messages::FieldAscii::create(symbols[nMessage % symbolCount]));
+    message.addField(*identities[field++], Messages::FieldDecimal::create(bid, -4));
+    message.addField(*identities[field++], Messages::FieldUInt32::create(uint32(100 * (1 + nMessage % 9))));
+    message.addField(*identities[field++], Messages::FieldDecimal::create(bid + 100, -4));
+    message.addField(*identities[field++], Messages::FieldUInt32::create(uint32(100 * (1 + nMessage % 11))));
+    if(padding_ > 0)
+    {
+      message.addField(*identities[field++], Messages::FieldAscii::create(std::string(padding_, 'x')));
+    }
+
+    // Each packet is decoded by itself, so start from a clean dictionary.
+    encoder.reset();
+    destination.clear();
+    encoder.encodeMessage(destination, quoteId, message);
+    destination.toString(packets_[nMessage]);
+  }
+}
+
+int
+MulticastLatency::run()
+{
+  int result = 0;
+  try
+  {
+    ProfileClock::calibrate(100);
+
+    std::ofstream csv;
+    if(!csvFileName_.empty())
+    {
+      csv.open(csvFileName_.c_str());
+      if(!csv.good())
+      {
+        std::cerr << "ERROR: Can't open " << csvFileName_ << std::endl;
+        return -1;
+      }
+      csv << "offered,achieved,sent,received,lost,out_of_order,no_buffer,"
+        "min_us,p50_us,p90_us,p99_us,p999_us,max_us" << std::endl;
+    }
+
+    StampHeaderAnalyzer stampAnalyzer;
+    Codecs::NoHeaderAnalyzer messageHeaderAnalyzer;
+    LatencyRecorder recorder(stampAnalyzer);
+    Codecs::MessagePerPacketAssembler assembler(
+      templateRegistry_,
+      stampAnalyzer,
+      messageHeaderAnalyzer,
+      recorder);
+    assembler.setReset(true);
+
+    Communication::MulticastReceiver receiver(
+      multicastGroupIP_,
+      listenInterfaceIP_,
+      bindIP_,
+      portNumber_);
+    if(!receiver.start(assembler, receiveBufferSize, bufferCount_))
+    {
+      std::cerr << "ERROR: Can't start the receiver." << std::endl;
+      return -1;
+    }
+    receiver.runThreads(1, false);
+
+    sender_.reset(new Communication::MulticastSender(*this, multicastGroupIP_, portNumber_));
+    sender_->initializeSender();
+    boost::asio::ip::address_v4 sendInterface =
+      boost::asio::ip::address_v4::from_string(listenInterfaceIP_);
+    sender_->socket().set_option(boost::asio::ip::multicast::outbound_interface(sendInterface));
+    sender_->socket().set_option(boost::asio::ip::multicast::enable_loopback(true));
+
+    std::cout << "Sending " << messageCount_ << " messages at each rate; "
+      << packets_[0].size() + LatencyStamp::size << " bytes per packet." << std::endl;
+    std::cout << "Latency from send to decoded, in microseconds." << std::endl;
+    std::cout
+      << std::setw(10) << "offered" << std::setw(10) << "achieved"
+      << std::setw(9) << "received" << std::setw(8) << "lost"
+      << std::setw(8) << "min" << std::setw(8) << "p50"
+      << std::setw(8) << "p90" << std::setw(8) << "p99"
+      << std::setw(9) << "p99.9" << std::setw(10) << "max"
+      << std::endl;
+
+    LatencyRecorder::Results results;
+    if(warmupCount_ > 0)
+    {
+      sendAt(rates_[0], warmupCount_);
+      drain();
+      recorder.collect(results, sequence_);
+    }
+
+    for(size_t nRate = 0; nRate < rates_.size(); ++nRate)
+    {
+      size_t noBuffer = receiver.noBufferAvailable();
+      double achieved = sendAt(rates_[nRate], messageCount_);
+
+      // Wait until everything arrived or nothing has arrived for a while.
+      uint64 received = recorder.received();
+      while(received < messageCount_)
+      {
+        drain();
+        uint64 now = recorder.received();
+        if(now == received)
+        {
+          break;
+        }
+        received = now;
+      }
+      recorder.collect(results, sequence_);
+      noBuffer = receiver.noBufferAvailable() - noBuffer;
+      report(std::cout, rates_[nRate], achieved, messageCount_, results, noBuffer);
+      if(csv.is_open())
+      {
+        report(csv, rates_[nRate], achieved, messageCount_, results, noBuffer);
+      }
+    }
+
+    sender_->stop();
+    receiver.stop();
+    receiver.joinThreads();
+  }
+  catch (std::exception & ex)
+  {
+    std::cerr << "Latency test failed: " << ex.what() << std::endl;
+    result = -1;
+  }
+  return result;
+}
+
+double
+MulticastLatency::sendAt(double messagesPerSecond, size_t count)
+{
+  double ticksPerMessage = 0.0;
+  if(messagesPerSecond > 0.0)
+  {
+    ticksPerMessage = ProfileClock::ticksPerNanosecond() * 1.0e9 / messagesPerSecond;
+  }
+  uchar stamp[LatencyStamp::size];
+  boost::array<boost::asio::const_buffer, 2> buffers;
+
+  uint64 start = ProfileClock::ticks();
+  for(size_t nMessage = 0; nMessage < count; ++nMessage)
+  {
+    if(ticksPerMessage > 0.0)
+    {
+      // Busy wait: sleeping is far too coarse for the rates being tested.
+      uint64 due = start + uint64(ticksPerMessage * double(nMessage));
+      while(ProfileClock::ticks() < due)
+      {
+      }
+    }
+    const std::string & packet = packets_[sequence_ % packets_.size()];
+    LatencyStamp::put(stamp, sequence_, ProfileClock::ticks());
+    buffers[0] = boost::asio::buffer(stamp, sizeof(stamp));
+    buffers[1] = boost::asio::buffer(packet.data(), packet.size());
+    sender_->send(buffers);
+    ++sequence_;
+  }
+  double seconds = ProfileClock::toNanoseconds(double(ProfileClock::ticks() - start)) / 1.0e9;
+  if(seconds <= 0.0)
+  {
+    return 0.0;
+  }
+  return double(count) / seconds;
+}
+
+void
+MulticastLatency::drain()
+{
+  boost::this_thread::sleep(boost::posix_time::milliseconds(drainMilliseconds_));
+}
+
+void
+MulticastLatency::report(
+  std::ostream & out,
+  double offered,
+  double achieved,
+  size_t sent,
+  const LatencyRecorder::Results & results,
+  size_t noBuffer)
+{
+  const ProfileHistogram & latency = results.latency_;
+  bool csv = (&out != &std::cout);
+  const char * separator = csv ? "," : "";
+  out << std::fixed << std::setprecision(0);
+  if(csv)
+  {
+    out << offered << separator << achieved << separator << sent << separator
+      << results.received_ << separator << results.missing_ << separator
+      << results.outOfOrder_ << separator << noBuffer;
+  }
+  else
+  {
+    if(offered > 0.0)
+    {
+      out << std::setw(10) << offered;
+    }
+    else
+    {
+      out << std::setw(10) << "max";
+    }
+    out << std::setw(10) << achieved
+      << std::setw(9) << results.received_
+      << std::setw(8) << results.missing_;
+  }
+  out << std::setprecision(1);
+  double values[] = {
+    microseconds(latency.minimum()),
+    microseconds(latency.percentile(50.0)),
+    microseconds(latency.percentile(90.0)),
+    microseconds(latency.percentile(99.0)),
+    microseconds(latency.percentile(99.9)),
+    microseconds(latency.maximum())};
+  const int widths[] = {8, 8, 8, 8, 9, 10};
+  for(size_t nValue = 0; nValue < sizeof(values) / sizeof(values[0]); ++nValue)
+  {
+    if(csv)
+    {
+      out << separator << values[nValue];
+    }
+    else
+    {
+      out << std::setw(widths[nValue]) << values[nValue];
+    }
+  }
+  out << std::endl;
+  if(!csv && (results.outOfOrder_ != 0 || noBuffer != 0))
+  {
+    out << "          " << results.outOfOrder_ << " out of order; receiver ran out of buffers "
+      << noBuffer << " times." << std::endl;
+  }
+}
+
+void
+MulticastLatency::recycle(Communication::LinkedBuffer * /*emptyBuffer*/)
+{
+  // Packets are sent synchronously from our own buffers.
+}
+
+void
+MulticastLatency::fini()
+{
+  sender_.reset();
+}
@@ -0,0 +1,90 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+//
+#ifndef MULTICASTLATENCY_H
+#define MULTICASTLATENCY_H
+
+#include <Application/CommandArgParser.h>
+#include <Codecs/TemplateRegistry_fwd.h>
+#include <Communication/BufferRecycler.h>
+#include <Communication/MulticastSender_fwd.h>
+#include <MulticastLatency/LatencyRecorder.h>
+
+namespace QuickFAST{
+  namespace Examples{
+    /// @brief Measure end-to-end latency through the multicast receive path.
+    ///
+    /// FAST encoded messages are sent over loopback multicast with a
+    /// MulticastSender at a series of controlled rates.  They are received
+    /// by a MulticastReceiver, assembled by a MessagePerPacketAssembler, and
+    /// decoded by a Decoder into a ValueMessageBuilder.  The time from just
+    /// before the packet is sent to the end of the decoded message is recorded.
+    ///
+    /// For each offered rate the program reports the latency distribution and
+    /// how many packets were lost.  The messages are encoded before the clock
+    /// starts so the encoder does not limit the rate.
+    ///
+    /// Run the program with a -? command line option for detailed usage information.
+    class MulticastLatency
+      : public Application::CommandArgHandler
+      , public Communication::BufferRecycler
+    {
+    public:
+      MulticastLatency();
+      ~MulticastLatency();
+
+      /// @brief parse command line arguments, and initialize.
+      /// @param argc from main
+      /// @param argv from main
+      /// @returns true if everything is ok.
+      bool init(int argc, char * argv[]);
+      /// @brief run the program
+      /// @returns a value to be used as an exit code of the program (0 means all is well)
+      int run();
+      /// @brief do final cleanup after a run.
+      void fini();
+
+    private:
+      virtual int parseSingleArg(int argc, char * argv[]);
+      virtual void usage(std::ostream & out) const;
+      virtual bool applyArgs();
+      virtual void recycle(Communication::LinkedBuffer * emptyBuffer);
+
+    private:
+      void encodeMessages();
+      /// @brief Send a burst of messages at an even pace.
+      /// @returns the achieved rate in messages per second.
+      double sendAt(double messagesPerSecond, size_t count);
+      void drain();
+      void report(
+        std::ostream & out,
+        double offered,
+        double achieved,
+        size_t sent,
+        const LatencyRecorder::Results & results,
+        size_t noBuffer);
+
+    private:
+      std::string multicastGroupIP_;
+      std::string listenInterfaceIP_;
+      std::string bindIP_;
+      unsigned short portNumber_;
+      std::vector<double> rates_;
+      size_t messageCount_;
+      size_t warmupCount_;
+      size_t padding_;
+      size_t bufferCount_;
+      size_t drainMilliseconds_;
+      std::string csvFileName_;
+
+      Codecs::TemplateRegistryPtr templateRegistry_;
+      /// Encoded messages: each one can be decoded by itself.
+      std::vector<std::string> packets_;
+      uint64 sequence_;
+      Communication::MulticastSenderPtr sender_;
+      Application::CommandArgParser commandArgParser_;
+    };
+  }
+}
+#endif // MULTICASTLATENCY_H
@@ -0,0 +1,97 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef STAMPHEADERANALYZER_H
+#define STAMPHEADERANALYZER_H
+#include <Codecs/HeaderAnalyzer.h>
+#include <Codecs/DataSource.h>
+
+namespace QuickFAST{
+  namespace Examples{
+    /// @brief Packet header written by MulticastLatency in front of each FAST message.
+    ///
+    /// The header holds a sequence number and the ProfileClock tick count read
+    /// just before the packet was handed to the socket.  Both are in native byte
+    /// order, which is fine because the sender and receiver are the same process.
+    struct LatencyStamp
+    {
+      /// @brief The number of bytes the stamp occupies at the start of a packet.
+      static const size_t size = 16;
+
+      /// @brief Store a stamp into a buffer of at least size bytes.
+      static void put(uchar * buffer, uint64 sequence, uint64 ticks)
+      {
+        memcpy(buffer, &sequence, sizeof(sequence));
+        memcpy(buffer + sizeof(sequence), &ticks, sizeof(ticks));
+      }
+    };
+
+    /// @brief Reads the LatencyStamp at the start of each packet.
+    ///
+    /// The sequence number and send time of the most recent packet are
+    /// available until the next header is analyzed, i.e. for the whole time
+    /// the message in the packet is being decoded.
+    class StampHeaderAnalyzer : public Codecs::HeaderAnalyzer
+    {
+    public:
+      StampHeaderAnalyzer()
+        : position_(0)
+        , sequence_(0)
+        , sendTicks_(0)
+      {
+      }
+
+      virtual ~StampHeaderAnalyzer()
+      {
+      }
+
+      virtual bool analyzeHeader(
+        Codecs::DataSource & source,
+        size_t & blockSize,
+        bool & skip)
+      {
+        blockSize = 0;
+        skip = false;
+        while(position_ < LatencyStamp::size)
+        {
+          if(!source.getByte(stamp_[position_]))
+          {
+            return false;
+          }
+          ++position_;
+        }
+        position_ = 0;
+        memcpy(&sequence_, stamp_, sizeof(sequence_));
+        memcpy(&sendTicks_, stamp_ + sizeof(sequence_), sizeof(sendTicks_));
+        return true;
+      }
+
+      virtual void reset()
+      {
+        position_ = 0;
+      }
+
+      /// @brief The sequence number from the most recent header.
+      uint64 sequence()const
+      {
+        return sequence_;
+      }
+
+      /// @brief The ProfileClock ticks at which the most recent packet was sent.
+      uint64 sendTicks()const
+      {
+        return sendTicks_;
+      }
+
+    private:
+      uchar stamp_[LatencyStamp::size];
+      size_t position_;
+      uint64 sequence_;
+      uint64 sendTicks_;
+    };
+  }
+}
+#endif // STAMPHEADERANALYZER_H
@@ -0,0 +1,22 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+//
+
+#include <Examples/ExamplesPch.h>
+#include <MulticastLatency/MulticastLatency.h>
+
+using namespace QuickFAST;
+using namespace Examples;
+
+int main(int argc, char* argv[])
+{
+  int result = -1;
+  MulticastLatency application;
+  if(application.init(argc, argv))
+  {
+    result = application.run();
+    application.fini();
+  }
+  return result;
+}
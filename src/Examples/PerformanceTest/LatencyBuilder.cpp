@@ -0,0 +1,88 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+//
+
+#include <Examples/ExamplesPch.h>
+#include "LatencyBuilder.h"
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Template.h>
+
+using namespace QuickFAST;
+using namespace Examples;
+
+LatencyBuilder::LatencyBuilder()
+  : lastTicks_(ProfileClock::ticks())
+  , current_(0)
+{
+}
+
+LatencyBuilder::~LatencyBuilder()
+{
+}
+
+Messages::ValueMessageBuilder &
+LatencyBuilder::startMessage(
+  const std::string & applicationType,
+  const std::string & applicationTypeNamespace,
+  size_t size)
+{
+  HistogramPtr & histogram = templates_[&applicationType];
+  if(!histogram)
+  {
+    histogram.reset(new ProfileHistogram);
+  }
+  current_ = histogram.get();
+  return PerformanceBuilder::startMessage(applicationType, applicationTypeNamespace, size);
+}
+
+bool
+LatencyBuilder::endMessage(Messages::ValueMessageBuilder & messageBuilder)
+{
+  uint64 lapse = ProfileClock::ticks() - lastTicks_;
+  latency_.record(lapse);
+  if(current_ != 0)
+  {
+    current_->record(lapse);
+    current_ = 0;
+  }
+  bool result = PerformanceBuilder::endMessage(messageBuilder);
+  lastTicks_ = ProfileClock::ticks();
+  return result;
+}
+
+bool
+LatencyBuilder::ignoreMessage(Messages::ValueMessageBuilder & messageBuilder)
+{
+  // filtered messages are not measured
+  current_ = 0;
+  bool result = PerformanceBuilder::ignoreMessage(messageBuilder);
+  lastTicks_ = ProfileClock::ticks();
+  return result;
+}
+
+void
+LatencyBuilder::templateLatencies(
+  const Codecs::TemplateRegistry & registry,
+  TemplateHistograms & histograms)const
+{
+  for(Codecs::TemplateRegistry::const_iterator it = registry.begin(); it != registry.end(); ++it)
+  {
+    const Codecs::TemplateCPtr & tmpl = it->second;
+    HistogramMap::const_iterator found = templates_.find(&tmpl->getApplicationType());
+    if(found != templates_.end())
+    {
+      std::string name = tmpl->getTemplateName();
+      if(name.empty())
+      {
+        name = boost::lexical_cast<std::string>(tmpl->getId());
+      }
+      HistogramPtr & histogram = histograms[name];
+      if(!histogram)
+      {
+        histogram.reset(new ProfileHistogram);
+      }
+      histogram->merge(*found->second);
+    }
+  }
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef LATENCYBUILDER_H
+#define LATENCYBUILDER_H
+#include <Examples/MessagePerformance.h>
+#include <Common/Profiler.h>
+#include <Codecs/TemplateRegistry_fwd.h>
+namespace QuickFAST{
+  namespace Examples{
+    /// @brief A PerformanceBuilder that also measures how long each message takes to decode.
+    ///
+    /// The time for a message runs from the end of the previous message (or from
+    /// start()) to the end of this one, so it includes the template id and the
+    /// presence map.  The time spent recording a result is not charged to
+    /// the next message.
+    ///
+    /// Times are recorded in ProfileClock ticks.  Use ProfileClock::toNanoseconds()
+    /// to convert them.
+    class LatencyBuilder : public PerformanceBuilder
+    {
+    public:
+      /// Latencies for the messages decoded using one template
+      typedef boost::shared_ptr<ProfileHistogram> HistogramPtr;
+      /// Latencies by template name
+      typedef std::map<std::string, HistogramPtr> TemplateHistograms;
+
+      LatencyBuilder();
+      virtual ~LatencyBuilder();
+
+      /// @brief Start the clock for the first message.
+      void start()
+      {
+        lastTicks_ = ProfileClock::ticks();
+      }
+
+      /// @brief The latencies of all messages.
+      const ProfileHistogram & latency()const
+      {
+        return latency_;
+      }
+
+      /// @brief Collect the latencies for each template.
+      /// @param registry contains the templates used to decode the messages.
+      /// @param[out] histograms receives the results.  Existing entries are added to.
+      void templateLatencies(
+        const Codecs::TemplateRegistry & registry,
+        TemplateHistograms & histograms)const;
+
+      ///////////////////////////////////////////
+      // Override ValueMessageBuilder methods
+      virtual ValueMessageBuilder & startMessage(
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t size);
+      virtual bool endMessage(Messages::ValueMessageBuilder & messageBuilder);
+      virtual bool ignoreMessage(Messages::ValueMessageBuilder & messageBuilder);
+
+    private:
+      /// Keyed by address: the decoder passes the same string each time a template is used.
+      typedef std::map<const std::string *, HistogramPtr> HistogramMap;
+      uint64 lastTicks_;
+      ProfileHistogram latency_;
+      HistogramMap templates_;
+      ProfileHistogram * current_;
+    };
+  }
+}
+#endif /* LATENCYBUILDER_H */
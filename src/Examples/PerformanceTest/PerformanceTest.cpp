@@ -13,13 +13,75 @@
 
 #include <Examples/MessagePerformance.h>
 #include <PerformanceTest/NullMessage.h>
+#include <PerformanceTest/LatencyBuilder.h>
 
 #include <Examples/StopWatch.h>
 #include <Common/Profiler.h>
+#if defined(__linux__)
+# include <pthread.h>
+# include <sched.h>
+#endif
 
 using namespace QuickFAST;
 using namespace Examples;
 
+namespace
+{
+  const double percentiles[] = {50.0, 90.0, 99.0, 99.9, 99.99};
+  const char * percentileNames[] = {"p50", "p90", "p99", "p99.9", "p99.99"};
+  const size_t percentileCount = sizeof(percentiles) / sizeof(percentiles[0]);
+
+  void writeLatency(std::ostream & out, const ProfileHistogram & histogram)
+  {
+    out << "min " << std::fixed << std::setprecision(0)
+      << ProfileClock::toNanoseconds(double(histogram.minimum()));
+    for(size_t nPercentile = 0; nPercentile < percentileCount; ++nPercentile)
+    {
+      out << ' ' << percentileNames[nPercentile] << ' '
+        << ProfileClock::toNanoseconds(double(histogram.percentile(percentiles[nPercentile])));
+    }
+    out << " max " << ProfileClock::toNanoseconds(double(histogram.maximum()));
+  }
+
+  void writeJsonString(std::ostream & out, const std::string & value)
+  {
+    out << '"';
+    for(std::string::const_iterator it = value.begin(); it != value.end(); ++it)
+    {
+      unsigned char ch = static_cast<unsigned char>(*it);
+      if(ch == '"' || ch == '\\')
+      {
+        out << '\\' << ch;
+      }
+      else if(ch < ' ')
+      {
+        out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << unsigned(ch)
+          << std::dec << std::setfill(' ');
+      }
+      else
+      {
+        out << ch;
+      }
+    }
+    out << '"';
+  }
+
+  void writeJsonLatency(std::ostream & out, const ProfileHistogram & histogram)
+  {
+    double count = double(histogram.count());
+    out << "{\"count\": " << histogram.count()
+      << std::fixed << std::setprecision(1)
+      << ", \"mean\": " << (count > 0 ? ProfileClock::toNanoseconds(double(histogram.sum()) / count) : 0.0)
+      << ", \"min\": " << ProfileClock::toNanoseconds(double(histogram.minimum()));
+    for(size_t nPercentile = 0; nPercentile < percentileCount; ++nPercentile)
+    {
+      out << ", \"" << percentileNames[nPercentile] << "\": "
+        << ProfileClock::toNanoseconds(double(histogram.percentile(percentiles[nPercentile])));
+    }
+    out << ", \"max\": " << ProfileClock::toNanoseconds(double(histogram.maximum())) << "}";
+  }
+}
+
 PerformanceTest::PerformanceTest()
   : resetOnMessage_(false)
   , strict_(true)
@@ -31,6 +93,9 @@ PerformanceTest::PerformanceTest()
   , interpret_(false)
   , headerBytes_(0)
   , echo_(false)
+  , warmup_(0)
+  , cpu_(-1)
+  , jsonFile_(0)
 {
 }
 
@@ -112,6 +177,21 @@ PerformanceTest::parseSingleArg(int argc, char * argv[])
       echo_ = true;
       consumed = 1;
     }
+    else if(opt == "-w" && argc > 1)
+    {
+      warmup_ = boost::lexical_cast<size_t>(argv[1]);
+      consumed = 2;
+    }
+    else if(opt == "-cpu" && argc > 1)
+    {
+      cpu_ = boost::lexical_cast<int>(argv[1]);
+      consumed = 2;
+    }
+    else if(opt == "-json" && argc > 1)
+    {
+      jsonFileName_ = argv[1];
+      consumed = 2;
+    }
   }
   catch (std::exception & ex)
   {
@@ -130,6 +210,9 @@ PerformanceTest::usage(std::ostream & out) const
   out << "  -profiler file : File to which profiler statistics are written (very optional)" << std::endl;
   out << "  -head n     : process only the first 'n' messages" << std::endl;
   out << "  -c count    : repeat the test 'count' times" << std::endl;
+  out << "  -w count    : decode the file 'count' times before measuring (default 0)" << std::endl;
+  out << "  -cpu n      : run on CPU number n" << std::endl;
+  out << "  -json file  : File to which the results are written in JSON" << std::endl;
   out << "  -i count    : retrieve (interprete) field values count times." << std::endl;
   out << "  -r          : Toggle 'reset decoder on every message' (default false)." << std::endl;
   out << "  -null       : Use null message to receive fields." << std::endl;
@@ -214,6 +297,18 @@ PerformanceTest::applyArgs()
           << std::endl;
       }
     }
+
+    if(ok && !jsonFileName_.empty())
+    {
+      jsonFile_ = new std::ofstream(jsonFileName_.c_str());
+      if(!jsonFile_->good())
+      {
+        ok = false;
+        std::cerr << "ERROR: Can't open JSON output file: "
+          << jsonFileName_
+          << std::endl;
+      }
+    }
   }
   catch (std::exception & ex)
   {
@@ -231,6 +326,10 @@ PerformanceTest::applyArgs()
 int
 PerformanceTest::run()
 {
+  if(cpu_ >= 0 && !pinToCpu())
+  {
+    std::cerr << "WARNING: Can't run on CPU " << cpu_ << std::endl;
+  }
   try
   {
     std::cout << "Parsing templates" << std::endl;
@@ -250,11 +349,22 @@ PerformanceTest::run()
       << std::fixed << std::setprecision(0)
       << 1000. * double(templateCount)/double(parseLapse) << " template/second.]"
       << std::endl;
-    for(size_t nPass = 0; nPass < count_; ++nPass)
+
+    size_t totalMessages = 0;
+    uint64 totalBytes = 0;
+    uint64 totalTicks = 0;
+    ProfileHistogram totalLatency;
+    LatencyBuilder::TemplateHistograms templateLatency;
+    for(size_t nPass = 0; nPass < warmup_ + count_; ++nPass)
     {
-      if(count_ > 1)
+      bool warmup = nPass < warmup_;
+      if(warmup)
       {
-        std::cout << "Decoding input; pass " << nPass + 1 << " of " << count_ << std::endl;
+        std::cout << "Warming up; pass " << nPass + 1 << " of " << warmup_ << std::endl;
+      }
+      else if(count_ > 1)
+      {
+        std::cout << "Decoding input; pass " << nPass - warmup_ + 1 << " of " << count_ << std::endl;
       }
       fastFile_.seekg(0, std::ios::beg);
       Codecs::DataSourceBufferedStream source(fastFile_);
@@ -263,23 +373,31 @@ PerformanceTest::run()
         source.setEcho(std::cout, Codecs::DataSource::HEX, true, true);
       }
 
-      PerformanceBuilder builder;
+      LatencyBuilder builder;
       Codecs::SynchronousDecoder decoder(templateRegistry);
       decoder.setResetOnMessage(resetOnMessage_);
       decoder.setStrict(strict_);
       decoder.setLimit(head_);
       decoder.setHeaderBytes(headerBytes_);
       StopWatch decodeTimer;
+      uint64 startTicks = ProfileClock::ticks();
       {
         PROFILE_POINT("Main");
+        builder.start();
         decoder.decode(source, builder);
       }//PROFILE_POINT
+      uint64 lapseTicks = ProfileClock::ticks() - startTicks;
       unsigned long decodeLapse = decodeTimer.freeze();
+      if(warmup)
+      {
+        continue;
+      }
       size_t messageCount = builder.msgCount();//handler.getMessageCount();
 //      size_t groupCount = builder.groupCount();
       size_t fieldCount = builder.fieldCount();
 //      size_t sequenceCount = builder.sequenceCount();
       size_t sequenceEntryCount = builder.sequenceEntryCount();
+      size_t byteCount = source.bytesConsumed();
       (*performanceFile_)
 #ifdef _DEBUG
         << "[debug] "
@@ -317,6 +435,76 @@ PerformanceTest::run()
             << std::endl;
         }
       }
+      else
+      {
+        (*performanceFile_) << "]" << std::endl;
+      }
+      double seconds = ProfileClock::toNanoseconds(double(lapseTicks)) / 1.0e9;
+      if(seconds > 0.0)
+      {
+        (*performanceFile_)
+          << "      Throughput: "
+          << std::fixed << std::setprecision(0) << double(messageCount) / seconds << " messages/second; "
+          << std::fixed << std::setprecision(3) << double(byteCount) / seconds / 1.0e6 << " MB/second"
+          << std::endl;
+      }
+      if(messageCount != 0)
+      {
+        (*performanceFile_) << "      Latency (nsec/message): ";
+        writeLatency(*performanceFile_, builder.latency());
+        (*performanceFile_) << std::endl;
+        LatencyBuilder::TemplateHistograms passLatency;
+        builder.templateLatencies(*templateRegistry, passLatency);
+        for(LatencyBuilder::TemplateHistograms::const_iterator it = passLatency.begin();
+          it != passLatency.end();
+          ++it)
+        {
+          (*performanceFile_) << "        " << it->first << " (" << it->second->count() << "): ";
+          writeLatency(*performanceFile_, *it->second);
+          (*performanceFile_) << std::endl;
+        }
+      }
+      totalMessages += messageCount;
+      totalBytes += byteCount;
+      totalTicks += lapseTicks;
+      totalLatency.merge(builder.latency());
+      builder.templateLatencies(*templateRegistry, templateLatency);
+    }
+
+    if(jsonFile_ != 0)
+    {
+      double seconds = ProfileClock::toNanoseconds(double(totalTicks)) / 1.0e9;
+      std::ostream & json = *jsonFile_;
+      json << "{" << std::endl
+        << "  \"templates\": " << templateCount << "," << std::endl
+        << "  \"parse_msec\": " << parseLapse << "," << std::endl
+        << "  \"warmup_passes\": " << warmup_ << "," << std::endl
+        << "  \"passes\": " << count_ << "," << std::endl
+        << "  \"messages\": " << totalMessages << "," << std::endl
+        << "  \"bytes\": " << totalBytes << "," << std::endl
+        << std::fixed << std::setprecision(6)
+        << "  \"seconds\": " << seconds << "," << std::endl
+        << std::fixed << std::setprecision(1)
+        << "  \"messages_per_second\": " << (seconds > 0.0 ? double(totalMessages) / seconds : 0.0) << "," << std::endl
+        << std::fixed << std::setprecision(3)
+        << "  \"mb_per_second\": " << (seconds > 0.0 ? double(totalBytes) / seconds / 1.0e6 : 0.0) << "," << std::endl
+        << "  \"latency_nsec\": ";
+      writeJsonLatency(json, totalLatency);
+      json << "," << std::endl
+        << "  \"template_latency_nsec\": {";
+      const char * separator = "";
+      for(LatencyBuilder::TemplateHistograms::const_iterator it = templateLatency.begin();
+        it != templateLatency.end();
+        ++it)
+      {
+        json << separator << std::endl << "    ";
+        writeJsonString(json, it->first);
+        json << ": ";
+        writeJsonLatency(json, *it->second);
+        separator = ",";
+      }
+      json << std::endl << "  }" << std::endl
+        << "}" << std::endl;
     }
   }
   catch (std::exception & e)
@@ -333,4 +521,24 @@ PerformanceTest::run()
 void
 PerformanceTest::fini()
 {
+  if(jsonFile_ != 0)
+  {
+    delete jsonFile_;
+    jsonFile_ = 0;
+  }
+}
+
+bool
+PerformanceTest::pinToCpu()
+{
+#if defined(_WIN32)
+  return 0 != SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu_);
+#elif defined(__linux__)
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu_, &cpus);
+  return 0 == pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+#else
+  return false;
+#endif
 }
@@ -15,6 +15,10 @@ namespace QuickFAST{
     ///
     /// This is also a good program to run when profiling.
     ///
+    /// Besides the total time it reports the distribution of the time taken to
+    /// decode each message, overall and for each template, and can write the
+    /// results as JSON so they can be compared from one build to the next.
+    ///
     /// Run the program with a -? command line option for detailed usage information.
     class PerformanceTest : public Application::CommandArgHandler
     {
@@ -37,6 +41,7 @@ namespace QuickFAST{
       virtual int parseSingleArg(int argc, char * argv[]);
       virtual void usage(std::ostream & out) const;
       virtual bool applyArgs();
+      bool pinToCpu();
     private:
       bool resetOnMessage_;
       bool strict_;
@@ -54,6 +59,10 @@ namespace QuickFAST{
       size_t interpret_;
       size_t headerBytes_;
       bool echo_;
+      size_t warmup_;
+      int cpu_;
+      std::string jsonFileName_;
+      std::ostream * jsonFile_;
 
       Codecs::XMLTemplateParser parser_;
       Application::CommandArgParser commandArgParser_;
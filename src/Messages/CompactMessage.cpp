@@ -0,0 +1,214 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "CompactMessage.h"
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Messages;
+
+namespace
+{
+  const std::string noType;
+
+  bool refersToSlots(const CompactField & field)
+  {
+    switch(field.getType())
+    {
+    case ValueType::GROUP:
+    case ValueType::SEQUENCE:
+      return true;
+    case ValueType::ASCII:
+    case ValueType::UTF8:
+    case ValueType::BYTEVECTOR:
+    case ValueType::BITMAP:
+      return field.stringLength() > CompactField::inlineStringLength;
+    default:
+      return false;
+    }
+  }
+}
+
+bool
+CompactField::findField(const std::string & name, const CompactField *& result)const
+{
+  for(size_t index = 0; index < size_; ++index)
+  {
+    const CompactField & candidate = field(index);
+    if(candidate.identity_ != 0 && candidate.name() == name)
+    {
+      result = &candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+CompactMessage::CompactMessage()
+: first_(0)
+, size_(0)
+, applicationType_(&noType)
+, applicationTypeNs_(&noType)
+{
+}
+
+CompactMessage::~CompactMessage()
+{
+}
+
+void
+CompactMessage::clear()
+{
+  block_.clear();
+  first_ = 0;
+  size_ = 0;
+  applicationType_ = &noType;
+  applicationTypeNs_ = &noType;
+}
+
+void
+CompactMessage::swap(CompactMessage & rhs)
+{
+  block_.swap(rhs.block_);
+  std::swap(first_, rhs.first_);
+  std::swap(size_, rhs.size_);
+  std::swap(applicationType_, rhs.applicationType_);
+  std::swap(applicationTypeNs_, rhs.applicationTypeNs_);
+}
+
+bool
+CompactMessage::findField(const std::string & name, const CompactField *& result)const
+{
+  for(size_t index = 0; index < size_; ++index)
+  {
+    const CompactField & candidate = block_[first_ + index];
+    if(candidate.identity_ != 0 && candidate.name() == name)
+    {
+      result = &candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+CompactMessage::start(
+  const std::string & applicationType,
+  const std::string & applicationTypeNs,
+  size_t fieldCount)
+{
+  clear();
+  applicationType_ = &applicationType;
+  applicationTypeNs_ = &applicationTypeNs;
+  first_ = allocate(fieldCount);
+}
+
+void
+CompactMessage::setSigned(size_t slot, const FieldIdentity & identity, ValueType::Type type, int64 value)
+{
+  CompactField & field = block_[slot];
+  field.identity_ = &identity;
+  field.type_ = uchar(type);
+  field.size_ = 0;
+  field.value_.signed_ = value;
+}
+
+void
+CompactMessage::setUnsigned(size_t slot, const FieldIdentity & identity, ValueType::Type type, uint64 value)
+{
+  CompactField & field = block_[slot];
+  field.identity_ = &identity;
+  field.type_ = uchar(type);
+  field.size_ = 0;
+  field.value_.unsigned_ = value;
+}
+
+void
+CompactMessage::setDecimal(size_t slot, const FieldIdentity & identity, ValueType::Type type, const Decimal & value)
+{
+  CompactField & field = block_[slot];
+  field.identity_ = &identity;
+  field.type_ = uchar(type);
+  field.size_ = 0;
+  field.value_.signed_ = value.getMantissa();
+  field.exponent_ = value.getExponent();
+}
+
+void
+CompactMessage::setString(
+  size_t slot,
+  const FieldIdentity & identity,
+  ValueType::Type type,
+  const unsigned char * value,
+  size_t length)
+{
+  if(length <= CompactField::inlineStringLength)
+  {
+    CompactField & field = block_[slot];
+    field.identity_ = &identity;
+    field.type_ = uchar(type);
+    field.size_ = uint32(length);
+    std::memcpy(field.value_.chars_, value, length);
+    return;
+  }
+  size_t chars = allocate((length + sizeof(CompactField) - 1) / sizeof(CompactField));
+  std::memcpy(&block_[chars], value, length);
+  CompactField & field = block_[slot];
+  field.identity_ = &identity;
+  field.type_ = uchar(type);
+  field.size_ = uint32(length);
+  field.value_.offset_ = int32(chars - slot);
+}
+
+void
+CompactMessage::setNested(
+  size_t slot,
+  const FieldIdentity & identity,
+  ValueType::Type type,
+  size_t first,
+  size_t size)
+{
+  CompactField & field = block_[slot];
+  field.identity_ = &identity;
+  field.type_ = uchar(type);
+  field.size_ = uint32(size);
+  field.value_.offset_ = int32(first - slot);
+}
+
+void
+CompactMessage::setNestedSize(size_t slot, size_t size, bool topLevel)
+{
+  if(topLevel)
+  {
+    size_ = size;
+  }
+  else
+  {
+    block_[slot].size_ = uint32(size);
+  }
+}
+
+size_t
+CompactMessage::relocate(size_t first, size_t used, size_t capacity, size_t owner, bool topLevel)
+{
+  size_t moved = allocate(capacity);
+  for(size_t index = 0; index < used; ++index)
+  {
+    CompactField & field = block_[moved + index];
+    field = block_[first + index];
+    if(refersToSlots(field))
+    {
+      // keep pointing at the same slots from the new position
+      field.value_.offset_ -= int32(moved - first);
+    }
+  }
+  if(topLevel)
+  {
+    first_ = moved;
+  }
+  else
+  {
+    block_[owner].value_.offset_ = int32(moved - owner);
+  }
+  return moved;
+}
@@ -0,0 +1,284 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef COMPACTMESSAGE_H
+#define COMPACTMESSAGE_H
+#include "CompactMessage_fwd.h"
+#include <Common/QuickFAST_Export.h>
+#include <Common/Types.h>
+#include <Common/Decimal.h>
+#include <Messages/FieldIdentity.h>
+
+namespace QuickFAST{
+  namespace Messages{
+    /// @brief One field of a CompactMessage.
+    ///
+    /// Every field occupies one 32 byte slot, two to a cache line.  Integers,
+    /// decimals and strings of up to inlineStringLength bytes are stored in
+    /// the slot.  Longer strings, the fields of a group and the entries of a
+    /// sequence are stored in other slots of the same message.  The slot records
+    /// where they are relative to itself, so a field can be navigated without
+    /// the message.
+    ///
+    /// Each entry of a sequence is a GROUP field named by the sequence.
+    ///
+    /// The identity refers to the template that decoded the field.  The
+    /// TemplateRegistry must outlive the message.
+    class QuickFAST_Export CompactField
+    {
+    public:
+      /// @brief The longest string that is stored in the slot.
+      static const size_t inlineStringLength = 16;
+
+      /// @brief Identify the field.
+      const FieldIdentity & getIdentity()const
+      {
+        return *identity_;
+      }
+
+      /// @brief The name of the field
+      const std::string & name()const
+      {
+        return identity_->name();
+      }
+
+      /// @brief The type of the field
+      ValueType::Type getType()const
+      {
+        return ValueType::Type(type_);
+      }
+
+      /// @brief The value of a signed integer field
+      int64 toInt64()const
+      {
+        return value_.signed_;
+      }
+
+      /// @brief The value of an unsigned integer field
+      uint64 toUInt64()const
+      {
+        return value_.unsigned_;
+      }
+
+      /// @brief The value of a decimal field
+      Decimal toDecimal()const
+      {
+        return Decimal(value_.signed_, exponent_, false);
+      }
+
+      /// @brief The bytes of an ASCII, UTF8 or byte vector field
+      const unsigned char * stringData()const
+      {
+        if(size_ <= inlineStringLength)
+        {
+          return value_.chars_;
+        }
+        return reinterpret_cast<const unsigned char *>(this + value_.offset_);
+      }
+
+      /// @brief The length of an ASCII, UTF8 or byte vector field
+      size_t stringLength()const
+      {
+        return size_;
+      }
+
+      /// @brief The value of an ASCII, UTF8 or byte vector field
+      std::string toString()const
+      {
+        return std::string(reinterpret_cast<const char *>(stringData()), size_);
+      }
+
+      /// @brief How many fields are in a group.
+      size_t fieldCount()const
+      {
+        return size_;
+      }
+
+      /// @brief Access one of the fields in a group.
+      /// @param index 0 <= index < fieldCount()
+      const CompactField & field(size_t index)const
+      {
+        return this[value_.offset_ + ptrdiff_t(index)];
+      }
+
+      /// @brief Find a field in a group by name.
+      /// @param name of the field
+      /// @param[out] result points to the field if it is found.
+      /// @returns true if the field was found.
+      bool findField(const std::string & name, const CompactField *& result)const;
+
+      /// @brief How many entries are in a sequence.
+      size_t length()const
+      {
+        return size_;
+      }
+
+      /// @brief Access one of the entries in a sequence.
+      /// @param index 0 <= index < length()
+      /// @returns a GROUP field that holds the entry's fields.
+      const CompactField & entry(size_t index)const
+      {
+        return this[value_.offset_ + ptrdiff_t(index)];
+      }
+
+    private:
+      friend class CompactMessage;
+      const FieldIdentity * identity_;
+      /// string length, group field count, or sequence length.
+      uint32 size_;
+      uchar type_;
+      exponent_t exponent_;
+      uchar reserved_[2];
+      union
+      {
+        int64 signed_;
+        uint64 unsigned_;
+        /// Slots from this one to the string, the fields or the entries.
+        int32 offset_;
+        uchar chars_[inlineStringLength];
+      } value_;
+    };
+
+    /// @brief A decoded message stored in a single contiguous block.
+    ///
+    /// The first size() slots hold the fields of the message in the order they
+    /// were decoded.  Groups, sequences and long strings are allocated from the
+    /// same block as they are decoded, so a message that holds only scalars and
+    /// short strings is read from one or two cache lines per four fields.
+    ///
+    /// The block is kept when the message is cleared, and swap() moves a message
+    /// without copying, so messages can be passed through queues and reused.
+    /// The message is filled by a Codecs::CompactMessageBuilder.
+    class QuickFAST_Export CompactMessage
+    {
+    public:
+      /// @brief Construct an empty message
+      CompactMessage();
+      ~CompactMessage();
+
+      /// @brief Forget the contents but keep the storage.
+      void clear();
+
+      /// @brief Exchange contents with another message.
+      void swap(CompactMessage & rhs);
+
+      /// @brief get the application type associated with this message via typeref.
+      const std::string & getApplicationType()const
+      {
+        return *applicationType_;
+      }
+
+      /// @brief get the namespace for the application type
+      const std::string & getApplicationTypeNs()const
+      {
+        return *applicationTypeNs_;
+      }
+
+      /// @brief How many fields are in the message.
+      ///
+      /// A group or a sequence counts as one field.
+      size_t size()const
+      {
+        return size_;
+      }
+
+      /// @brief Access a field
+      /// @param index 0 <= index < size()
+      const CompactField & operator[](size_t index)const
+      {
+        return block_[first_ + index];
+      }
+
+      /// @brief Find a field by name.
+      /// @param name of the field
+      /// @param[out] result points to the field if it is found.
+      /// @returns true if the field was found.
+      bool findField(const std::string & name, const CompactField *& result)const;
+
+      /// @brief How many bytes of the block are in use.
+      size_t bytesUsed()const
+      {
+        return block_.size() * sizeof(CompactField);
+      }
+
+      ////////////////////////////////////////////////
+      // Used by Codecs::CompactMessageBuilder to fill in the message.
+
+      /// @brief Start a new message.
+      /// @param applicationType from the template.  It must outlive the message.
+      /// @param applicationTypeNs from the template.  It must outlive the message.
+      /// @param fieldCount the maximum number of fields in the message.
+      void start(
+        const std::string & applicationType,
+        const std::string & applicationTypeNs,
+        size_t fieldCount);
+
+      /// @brief Allocate a run of slots.
+      /// @param count how many slots
+      /// @returns the index of the first slot.
+      size_t allocate(size_t count)
+      {
+        size_t first = block_.size();
+        block_.resize(first + count);
+        return first;
+      }
+
+      /// @brief Set a signed integer field.
+      void setSigned(size_t slot, const FieldIdentity & identity, ValueType::Type type, int64 value);
+      /// @brief Set an unsigned integer field.
+      void setUnsigned(size_t slot, const FieldIdentity & identity, ValueType::Type type, uint64 value);
+      /// @brief Set a decimal field.
+      void setDecimal(size_t slot, const FieldIdentity & identity, ValueType::Type type, const Decimal & value);
+      /// @brief Set a string or byte vector field.
+      void setString(
+        size_t slot,
+        const FieldIdentity & identity,
+        ValueType::Type type,
+        const unsigned char * value,
+        size_t length);
+      /// @brief Make a slot refer to a run of slots.
+      /// @param slot the group, sequence or sequence entry.
+      /// @param identity names the group or sequence
+      /// @param type is GROUP or SEQUENCE
+      /// @param first the first slot of the run.
+      /// @param size the number of slots in use.
+      void setNested(
+        size_t slot,
+        const FieldIdentity & identity,
+        ValueType::Type type,
+        size_t first,
+        size_t size);
+      /// @brief Update the number of slots in use by a group, sequence or the message.
+      /// @param slot the group or sequence.  Ignored for the message.
+      /// @param size the number of slots in use.
+      /// @param topLevel true if the run belongs to the message itself.
+      void setNestedSize(size_t slot, size_t size, bool topLevel);
+
+      /// @brief Move a run of slots to the end of the block with more room.
+      ///
+      /// Used when a run needs more slots than were allocated for it.
+      /// @param first the first slot of the run.
+      /// @param used the number of slots in use.
+      /// @param capacity the number of slots needed.
+      /// @param owner the slot that refers to the run.
+      /// @param topLevel true if the run belongs to the message itself.
+      /// @returns the new first slot.
+      size_t relocate(size_t first, size_t used, size_t capacity, size_t owner, bool topLevel);
+
+    private:
+      CompactMessage(const CompactMessage &);
+      CompactMessage & operator = (const CompactMessage &);
+
+    private:
+      std::vector<CompactField> block_;
+      size_t first_;
+      size_t size_;
+      const std::string * applicationType_;
+      const std::string * applicationTypeNs_;
+    };
+  }
+}
+#endif // COMPACTMESSAGE_H
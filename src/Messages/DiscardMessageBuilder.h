@@ -0,0 +1,165 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef DISCARDMESSAGEBUILDER_H
+#define DISCARDMESSAGEBUILDER_H
+#include <Messages/ValueMessageBuilder.h>
+
+namespace QuickFAST
+{
+  namespace Messages
+  {
+    ///@brief a MessageBuilder that throws away everything it is given.
+    ///
+    /// Used by the decoder when a field must be parsed to keep the presence map
+    /// and the dictionary in step with the encoder, but the application has
+    /// no interest in its value.
+    /// The builder returns itself for every nested group, sequence, or entry,
+    /// so a single instance can absorb an arbitrarily complex field.
+    class DiscardMessageBuilder : public ValueMessageBuilder
+    {
+    public:
+      DiscardMessageBuilder()
+      {
+      }
+
+      virtual ~DiscardMessageBuilder()
+      {
+      }
+
+      ///////////////////////////
+      // Implement ValueMessageBuilder
+      virtual const std::string & getApplicationType() const
+      {
+        static const std::string name("discard");
+        return name;
+      }
+
+      virtual const std::string & getApplicationTypeNs() const
+      {
+        static const std::string result("");
+        return result;
+      }
+
+      virtual void addValue(const FieldIdentity & /*identity*/, ValueType::Type /*type*/, const int64 /*value*/)
+      {
+      }
+      virtual void addValue(const FieldIdentity & /*identity*/, ValueType::Type /*type*/, const uint64 /*value*/)
+      {
+      }
+      virtual void addValue(const FieldIdentity & /*identity*/, ValueType::Type /*type*/, const int32 /*value*/)
+      {
+      }
+      virtual void addValue(const FieldIdentity & /*identity*/, ValueType::Type /*type*/, const uint32 /*value*/)
+      {
+      }
+      virtual void addValue(const FieldIdentity & /*identity*/, ValueType::Type /*type*/, const int16 /*value*/)
+      {
+      }
+      virtual void addValue(const FieldIdentity & /*identity*/, ValueType::Type /*type*/, const uint16 /*value*/)
+      {
+      }
+      virtual void addValue(const FieldIdentity & /*identity*/, ValueType::Type /*type*/, const int8 /*value*/)
+      {
+      }
+      virtual void addValue(const FieldIdentity & /*identity*/, ValueType::Type /*type*/, const uchar /*value*/)
+      {
+      }
+      virtual void addValue(const FieldIdentity & /*identity*/, ValueType::Type /*type*/, const Decimal& /*value*/)
+      {
+      }
+      virtual void addValue(const FieldIdentity & /*identity*/, ValueType::Type /*type*/, const unsigned char * /*value*/, size_t /*length*/)
+      {
+      }
+
+      virtual ValueMessageBuilder & startMessage(
+        const std::string & /*applicationType*/,
+        const std::string & /*applicationTypeNamespace*/,
+        size_t /*size*/)
+      {
+        return *this;
+      }
+
+      virtual bool endMessage(ValueMessageBuilder & /*messageBuilder*/)
+      {
+        return true;
+      }
+
+      virtual bool ignoreMessage(ValueMessageBuilder & /*messageBuilder*/)
+      {
+        return true;
+      }
+
+      virtual ValueMessageBuilder & startSequence(
+        const FieldIdentity & /*identity*/,
+        const std::string & /*applicationType*/,
+        const std::string & /*applicationTypeNamespace*/,
+        size_t /*fieldCount*/,
+        const FieldIdentity & /*lengthIdentity*/,
+        size_t /*length*/)
+      {
+        return *this;
+      }
+
+      virtual void endSequence(
+        const FieldIdentity & /*identity*/,
+        ValueMessageBuilder & /*sequenceBuilder*/)
+      {
+      }
+
+      virtual ValueMessageBuilder & startSequenceEntry(
+        const std::string & /*applicationType*/,
+        const std::string & /*applicationTypeNamespace*/,
+        size_t /*size*/)
+      {
+        return *this;
+      }
+
+      virtual void endSequenceEntry(ValueMessageBuilder & /*entry*/)
+      {
+      }
+
+      virtual ValueMessageBuilder & startGroup(
+        const FieldIdentity & /*identity*/,
+        const std::string & /*applicationType*/,
+        const std::string & /*applicationTypeNamespace*/,
+        size_t /*size*/)
+      {
+        return *this;
+      }
+
+      virtual void endGroup(
+        const FieldIdentity & /*identity*/,
+        ValueMessageBuilder & /*groupBuilder*/)
+      {
+      }
+
+      ///////////////////
+      // Implement Logger
+      virtual bool wantLog(unsigned short /*level*/)
+      {
+        return false;
+      }
+
+      virtual bool logMessage(unsigned short /*level*/, const std::string & /*logMessage*/)
+      {
+        return true;
+      }
+
+      virtual bool reportDecodingError(const std::string & /*errorMessage*/)
+      {
+        return true;
+      }
+
+      virtual bool reportCommunicationError(const std::string & /*errorMessage*/)
+      {
+        return true;
+      }
+    };
+  }
+}
+
+#endif // DISCARDMESSAGEBUILDER_H
@@ -179,9 +179,8 @@ MessageFormatter::displayFieldValue(const Messages::FieldCPtr & field)
     break;
   case ValueType::DECIMAL:
     {
-      std::string value;
-      field->toDecimal().toString(value);
-      out_ << value;
+      char value[Decimal::maxStringLength];
+      out_.write(value, std::streamsize(field->toDecimal().toString(value, sizeof(value))));
       break;
     }
   case ValueType::ASCII:
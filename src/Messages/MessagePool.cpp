@@ -0,0 +1,295 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "MessagePool.h"
+#include <Messages/Message.h>
+#include <Messages/Sequence.h>
+
+using namespace QuickFAST;
+using namespace Messages;
+
+namespace
+{
+  /// Reference counts for the smart pointers are carved from blocks this size.
+  /// A larger request goes to the heap.
+  const size_t blockSize = 128;
+}
+
+/// @brief Deleter that returns an object to the pool.
+template<typename Object>
+struct MessagePool::Recycler
+{
+  explicit Recycler(const MessagePoolPtr & pool)
+    : pool_(pool)
+  {
+  }
+
+  void operator()(Object * object) const
+  {
+    pool_->recycle(object);
+  }
+
+  MessagePoolPtr pool_;
+};
+
+/// @brief Allocator that takes the smart pointers' reference counts from the pool.
+template<typename Value>
+class MessagePool::Allocator
+{
+public:
+  typedef Value value_type;
+  typedef Value * pointer;
+  typedef const Value * const_pointer;
+  typedef Value & reference;
+  typedef const Value & const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+  template<typename Other>
+  struct rebind
+  {
+    typedef Allocator<Other> other;
+  };
+
+  explicit Allocator(const MessagePoolPtr & pool)
+    : pool_(pool)
+  {
+  }
+
+  template<typename Other>
+  Allocator(const Allocator<Other> & rhs)
+    : pool_(rhs.pool_)
+  {
+  }
+
+  pointer allocate(size_type count, const void * = 0)
+  {
+    return static_cast<pointer>(pool_->allocateBlock(count * sizeof(Value)));
+  }
+
+  void deallocate(pointer block, size_type count)
+  {
+    pool_->freeBlock(block, count * sizeof(Value));
+  }
+
+  void construct(pointer where, const Value & value)
+  {
+    new(where) Value(value);
+  }
+
+  void destroy(pointer where)
+  {
+    where->~Value();
+  }
+
+  size_type max_size() const
+  {
+    return size_type(-1) / sizeof(Value);
+  }
+
+  template<typename Other>
+  bool operator ==(const Allocator<Other> & rhs) const
+  {
+    return pool_ == rhs.pool_;
+  }
+
+  template<typename Other>
+  bool operator !=(const Allocator<Other> & rhs) const
+  {
+    return pool_ != rhs.pool_;
+  }
+
+  MessagePoolPtr pool_;
+};
+
+MessagePool::MessagePool(size_t limit)
+  : limit_(limit)
+  , created_(0)
+  , reused_(0)
+{
+}
+
+MessagePool::~MessagePool()
+{
+  // Everything that was handed out has come back, or the pool would still be referenced.
+  for(size_t pos = 0; pos < messages_.size(); ++pos)
+  {
+    delete messages_[pos];
+  }
+  for(size_t pos = 0; pos < fieldSets_.size(); ++pos)
+  {
+    delete fieldSets_[pos];
+  }
+  for(size_t pos = 0; pos < sequences_.size(); ++pos)
+  {
+    delete sequences_[pos];
+  }
+  for(size_t pos = 0; pos < blocks_.size(); ++pos)
+  {
+    ::operator delete(blocks_[pos]);
+  }
+}
+
+MessagePtr
+MessagePool::message(size_t fieldCount)
+{
+  MessagePoolPtr self(shared_from_this());
+  Message * message = take(messages_);
+  if(message == 0)
+  {
+    message = new Message(fieldCount);
+  }
+  else
+  {
+    message->clear(fieldCount);
+  }
+  return MessagePtr(message, Recycler<Message>(self), Allocator<Message>(self));
+}
+
+FieldSetPtr
+MessagePool::fieldSet(size_t fieldCount)
+{
+  MessagePoolPtr self(shared_from_this());
+  FieldSet * fieldSet = take(fieldSets_);
+  if(fieldSet == 0)
+  {
+    fieldSet = new FieldSet(fieldCount);
+  }
+  else
+  {
+    fieldSet->clear(fieldCount);
+  }
+  return FieldSetPtr(fieldSet, Recycler<FieldSet>(self), Allocator<FieldSet>(self));
+}
+
+SequencePtr
+MessagePool::sequence(const FieldIdentity & lengthIdentity, size_t length)
+{
+  MessagePoolPtr self(shared_from_this());
+  Sequence * sequence = take(sequences_);
+  if(sequence == 0)
+  {
+    sequence = new Sequence(lengthIdentity, length);
+  }
+  else
+  {
+    sequence->clear(lengthIdentity, length);
+  }
+  return SequencePtr(sequence, Recycler<Sequence>(self), Allocator<Sequence>(self));
+}
+
+void
+MessagePool::setLimit(size_t limit)
+{
+  boost::mutex::scoped_lock lock(lock_);
+  limit_ = limit;
+}
+
+size_t
+MessagePool::created()const
+{
+  boost::mutex::scoped_lock lock(lock_);
+  return created_;
+}
+
+size_t
+MessagePool::reused()const
+{
+  boost::mutex::scoped_lock lock(lock_);
+  return reused_;
+}
+
+size_t
+MessagePool::idle()const
+{
+  boost::mutex::scoped_lock lock(lock_);
+  return messages_.size() + fieldSets_.size() + sequences_.size();
+}
+
+template<typename Object>
+Object *
+MessagePool::take(std::vector<Object *> & free)
+{
+  boost::mutex::scoped_lock lock(lock_);
+  if(free.empty())
+  {
+    ++created_;
+    return 0;
+  }
+  ++reused_;
+  Object * object = free.back();
+  free.pop_back();
+  return object;
+}
+
+template<typename Object>
+void
+MessagePool::keep(Object * object, std::vector<Object *> & free)
+{
+  {
+    boost::mutex::scoped_lock lock(lock_);
+    if(free.size() < limit_)
+    {
+      free.push_back(object);
+      return;
+    }
+  }
+  delete object;
+}
+
+void
+MessagePool::recycle(Message * message)
+{
+  // Clearing releases nested groups and sequences which come back
+  // here in turn, so it must happen before the lock is taken.
+  message->clear();
+  keep(message, messages_);
+}
+
+void
+MessagePool::recycle(FieldSet * fieldSet)
+{
+  fieldSet->clear();
+  keep(fieldSet, fieldSets_);
+}
+
+void
+MessagePool::recycle(Sequence * sequence)
+{
+  sequence->clear(sequence->getLengthIdentity(), 0);
+  keep(sequence, sequences_);
+}
+
+void *
+MessagePool::allocateBlock(size_t size)
+{
+  if(size <= blockSize)
+  {
+    boost::mutex::scoped_lock lock(lock_);
+    if(!blocks_.empty())
+    {
+      void * block = blocks_.back();
+      blocks_.pop_back();
+      return block;
+    }
+    return ::operator new(blockSize);
+  }
+  return ::operator new(size);
+}
+
+void
+MessagePool::freeBlock(void * block, size_t size)
+{
+  if(size <= blockSize)
+  {
+    boost::mutex::scoped_lock lock(lock_);
+    // Every object that is out holds one block.
+    if(blocks_.size() < 3 * limit_)
+    {
+      blocks_.push_back(block);
+      return;
+    }
+  }
+  ::operator delete(block);
+}
@@ -0,0 +1,98 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef MESSAGEPOOL_H
+#define MESSAGEPOOL_H
+#include "MessagePool_fwd.h"
+#include <Common/QuickFAST_Export.h>
+#include <Messages/Message_fwd.h>
+#include <Messages/FieldSet_fwd.h>
+#include <Messages/Sequence_fwd.h>
+#include <Messages/FieldIdentity_fwd.h>
+
+namespace QuickFAST{
+  namespace Messages{
+    /// @brief Recycle the Messages, groups and sequences built by a GenericMessageBuilder.
+    ///
+    /// Objects handed out by the pool come back to it when the last smart
+    /// pointer to them is released, by whatever thread releases it.  They are
+    /// cleared but keep their storage, so once the pool has warmed up a
+    /// message with the same shape as an earlier one is built without
+    /// allocating a Message, its field array, its groups, or its sequences.
+    /// The reference counts for the smart pointers come from the pool, too.
+    ///
+    /// The pool must be owned by a MessagePoolPtr.  Every object that is out
+    /// holds a reference to the pool, so the pool lives until the last one
+    /// comes back no matter which is released first.
+    class QuickFAST_Export MessagePool
+      : public boost::enable_shared_from_this<MessagePool>
+    {
+    public:
+      /// @brief Construct an empty pool.
+      /// @param limit is the most idle objects of each kind to keep.
+      explicit MessagePool(size_t limit = 1000);
+      ~MessagePool();
+
+      /// @brief Get an empty Message.
+      /// @param fieldCount is the number of fields to expect.
+      MessagePtr message(size_t fieldCount);
+
+      /// @brief Get an empty FieldSet to hold a group or a sequence entry.
+      /// @param fieldCount is the number of fields to expect.
+      FieldSetPtr fieldSet(size_t fieldCount);
+
+      /// @brief Get an empty Sequence.
+      /// @param lengthIdentity identifies the length field of the sequence.
+      /// @param length is the number of entries to expect.
+      SequencePtr sequence(const FieldIdentity & lengthIdentity, size_t length);
+
+      /// @brief Change the most idle objects of each kind to keep.
+      ///
+      /// Objects that come back when the pool is full are deleted.
+      void setLimit(size_t limit);
+
+      /// @brief How many objects the pool had to create.
+      size_t created()const;
+
+      /// @brief How many requests were satisfied with a recycled object.
+      size_t reused()const;
+
+      /// @brief How many objects are waiting to be reused.
+      size_t idle()const;
+
+    private:
+      template<typename Object> struct Recycler;
+      template<typename Value> class Allocator;
+      template<typename Object> friend struct Recycler;
+      template<typename Value> friend class Allocator;
+
+      template<typename Object>
+      Object * take(std::vector<Object *> & free);
+      template<typename Object>
+      void keep(Object * object, std::vector<Object *> & free);
+      void recycle(Message * message);
+      void recycle(FieldSet * fieldSet);
+      void recycle(Sequence * sequence);
+      void * allocateBlock(size_t size);
+      void freeBlock(void * block, size_t size);
+
+    private:
+      MessagePool(const MessagePool &);
+      MessagePool & operator=(const MessagePool &);
+
+    private:
+      mutable boost::mutex lock_;
+      size_t limit_;
+      size_t created_;
+      size_t reused_;
+      std::vector<Message *> messages_;
+      std::vector<FieldSet *> fieldSets_;
+      std::vector<Sequence *> sequences_;
+      std::vector<void *> blocks_;
+    };
+  }
+}
+#endif // MESSAGEPOOL_H
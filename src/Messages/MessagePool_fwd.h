@@ -0,0 +1,20 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef MESSAGEPOOL_FWD_H
+#define MESSAGEPOOL_FWD_H
+#ifndef QUICKFAST_HEADERS
+#error Please include <Application/QuickFAST.h> preferably as a precompiled header file.
+#endif //QUICKFAST_HEADERS
+
+namespace QuickFAST{
+  namespace Messages{
+    class MessagePool;
+    /// @brief A smart pointer to a MessagePool.
+    typedef boost::shared_ptr<MessagePool> MessagePoolPtr;
+  }
+}
+#endif // MESSAGEPOOL_FWD_H
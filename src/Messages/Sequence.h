@@ -28,7 +28,7 @@ namespace QuickFAST{
       Sequence(
         const Messages::FieldIdentity & lengthFieldIdentity,
         size_t sequenceLength)
-        : lengthIdentity_(lengthFieldIdentity)
+        : lengthIdentity_(&lengthFieldIdentity)
       {
         this->entries_.reserve(sequenceLength);
       }
@@ -40,7 +40,22 @@ namespace QuickFAST{
       /// @brief get the identity of the sequence's length field
       const Messages::FieldIdentity & getLengthIdentity() const
       {
-        return lengthIdentity_;
+        return *lengthIdentity_;
+      }
+
+      /// @brief Release the entries and prepare to be reused for a new sequence.
+      ///
+      /// The entry storage is kept so a recycled sequence does not reallocate.
+      /// @param lengthFieldIdentity identifies the new sequence's length field
+      /// @param sequenceLength is the number of entries to expect
+      void clear(
+        const Messages::FieldIdentity & lengthFieldIdentity,
+        size_t sequenceLength)
+      {
+        entries_.clear();
+        applicationType_.clear();
+        lengthIdentity_ = &lengthFieldIdentity;
+        entries_.reserve(sequenceLength);
       }
 
       /// @brief Set the application data type associated with this sequence.
@@ -97,7 +112,7 @@ namespace QuickFAST{
       Sequence& operator=(const Sequence&);
     private:
       std::string applicationType_;
-      const Messages::FieldIdentity & lengthIdentity_;
+      const Messages::FieldIdentity * lengthIdentity_;
       Entries entries_;
     };
   }
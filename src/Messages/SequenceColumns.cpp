@@ -0,0 +1,338 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "SequenceColumns.h"
+#include <Common/Exceptions.h>
+
+using namespace QuickFAST;
+using namespace QuickFAST::Messages;
+
+namespace
+{
+  const std::string noApplicationType;
+}
+
+SequenceColumns::SequenceColumns()
+: applicationType_(&noApplicationType)
+, applicationTypeNamespace_(&noApplicationType)
+, lengthIdentity_(0)
+, length_(0)
+, row_(0)
+, columnCount_(0)
+, cursor_(0)
+{
+}
+
+SequenceColumns::~SequenceColumns()
+{
+}
+
+void
+SequenceColumns::reset(
+  const std::string & applicationType,
+  const std::string & applicationTypeNamespace,
+  const FieldIdentity & lengthIdentity,
+  size_t length)
+{
+  applicationType_ = &applicationType;
+  applicationTypeNamespace_ = &applicationTypeNamespace;
+  lengthIdentity_ = &lengthIdentity;
+  length_ = length;
+  row_ = 0;
+  columnCount_ = 0;
+  cursor_ = 0;
+}
+
+void
+SequenceColumns::defineColumn(const FieldIdentity & identity)
+{
+  if(columnCount_ == columns_.size())
+  {
+    columns_.push_back(Column());
+  }
+  Column & column = columns_[columnCount_++];
+  column.identity_ = &identity;
+  column.type_ = ValueType::UNDEFINED;
+  // resize does not release capacity so the storage is reused by later sequences
+  column.values_.resize(length_);
+  column.exponents_.resize(length_);
+  column.present_.assign(length_, 0);
+}
+
+bool
+SequenceColumns::columnIndex(const std::string & name, size_t & column)const
+{
+  for(size_t pos = 0; pos < columnCount_; ++pos)
+  {
+    const FieldIdentity & identity = *columns_[pos].identity_;
+    if(identity.getLocalName() == name || identity.name() == name)
+    {
+      column = pos;
+      return true;
+    }
+  }
+  return false;
+}
+
+SequenceColumns::Column &
+SequenceColumns::find(const FieldIdentity & identity)
+{
+  // Fields normally arrive in column order, so start looking after the previous one.
+  for(size_t count = 0; count < columnCount_; ++count)
+  {
+    size_t pos = cursor_ + count;
+    if(pos >= columnCount_)
+    {
+      pos -= columnCount_;
+    }
+    if(columns_[pos].identity_ == &identity)
+    {
+      cursor_ = pos + 1 < columnCount_ ? pos + 1 : 0;
+      return columns_[pos];
+    }
+  }
+  throw UsageError("Coding Error", "SequenceColumns: field is not a column.");
+}
+
+void
+SequenceColumns::setInteger(const FieldIdentity & identity, ValueType::Type type, int64 value)
+{
+  Column & column = find(identity);
+  column.type_ = type;
+  column.values_[row_] = value;
+  column.present_[row_] = 1;
+}
+
+void
+SequenceColumns::replay(ValueMessageBuilder & builder, const FieldIdentity & identity)const
+{
+  ValueMessageBuilder & sequenceBuilder = builder.startSequence(
+    identity,
+    *applicationType_,
+    *applicationTypeNamespace_,
+    columnCount_,
+    *lengthIdentity_,
+    length_);
+  for(size_t row = 0; row < length_; ++row)
+  {
+    ValueMessageBuilder & entry = sequenceBuilder.startSequenceEntry(
+      *applicationType_,
+      *applicationTypeNamespace_,
+      columnCount_);
+    for(size_t pos = 0; pos < columnCount_; ++pos)
+    {
+      const Column & column = columns_[pos];
+      if(!column.present_[row])
+      {
+        continue;
+      }
+      switch(column.type_)
+      {
+      case ValueType::INT8:
+        entry.addValue(*column.identity_, column.type_, int8(column.values_[row]));
+        break;
+      case ValueType::UINT8:
+        entry.addValue(*column.identity_, column.type_, uchar(column.values_[row]));
+        break;
+      case ValueType::INT16:
+        entry.addValue(*column.identity_, column.type_, int16(column.values_[row]));
+        break;
+      case ValueType::UINT16:
+        entry.addValue(*column.identity_, column.type_, uint16(column.values_[row]));
+        break;
+      case ValueType::INT32:
+        entry.addValue(*column.identity_, column.type_, int32(column.values_[row]));
+        break;
+      case ValueType::UINT32:
+        entry.addValue(*column.identity_, column.type_, uint32(column.values_[row]));
+        break;
+      case ValueType::UINT64:
+        entry.addValue(*column.identity_, column.type_, uint64(column.values_[row]));
+        break;
+      case ValueType::DECIMAL:
+        entry.addValue(*column.identity_, column.type_, getDecimal(pos, row));
+        break;
+      default:
+        entry.addValue(*column.identity_, column.type_, column.values_[row]);
+        break;
+      }
+    }
+    sequenceBuilder.endSequenceEntry(entry);
+  }
+  builder.endSequence(identity, sequenceBuilder);
+}
+
+const std::string &
+SequenceColumns::getApplicationType() const
+{
+  return *applicationType_;
+}
+
+const std::string &
+SequenceColumns::getApplicationTypeNs() const
+{
+  return *applicationTypeNamespace_;
+}
+
+void
+SequenceColumns::addValue(const FieldIdentity & identity, ValueType::Type type, const int64 value)
+{
+  setInteger(identity, type, value);
+}
+
+void
+SequenceColumns::addValue(const FieldIdentity & identity, ValueType::Type type, const uint64 value)
+{
+  setInteger(identity, type, int64(value));
+}
+
+void
+SequenceColumns::addValue(const FieldIdentity & identity, ValueType::Type type, const int32 value)
+{
+  setInteger(identity, type, value);
+}
+
+void
+SequenceColumns::addValue(const FieldIdentity & identity, ValueType::Type type, const uint32 value)
+{
+  setInteger(identity, type, value);
+}
+
+void
+SequenceColumns::addValue(const FieldIdentity & identity, ValueType::Type type, const int16 value)
+{
+  setInteger(identity, type, value);
+}
+
+void
+SequenceColumns::addValue(const FieldIdentity & identity, ValueType::Type type, const uint16 value)
+{
+  setInteger(identity, type, value);
+}
+
+void
+SequenceColumns::addValue(const FieldIdentity & identity, ValueType::Type type, const int8 value)
+{
+  setInteger(identity, type, value);
+}
+
+void
+SequenceColumns::addValue(const FieldIdentity & identity, ValueType::Type type, const uchar value)
+{
+  setInteger(identity, type, value);
+}
+
+void
+SequenceColumns::addValue(const FieldIdentity & identity, ValueType::Type type, const Decimal& value)
+{
+  Column & column = find(identity);
+  column.type_ = type;
+  column.values_[row_] = value.getMantissa();
+  column.exponents_[row_] = value.getExponent();
+  column.present_[row_] = 1;
+}
+
+void
+SequenceColumns::addValue(const FieldIdentity & /*identity*/, ValueType::Type /*type*/, const unsigned char * /*value*/, size_t /*length*/)
+{
+  throw UsageError("Coding Error", "SequenceColumns: strings are not supported.");
+}
+
+ValueMessageBuilder &
+SequenceColumns::startMessage(
+  const std::string & /*applicationType*/,
+  const std::string & /*applicationTypeNamespace*/,
+  size_t /*size*/)
+{
+  throw UsageError("Coding Error", "SequenceColumns: unexpected message.");
+}
+
+bool
+SequenceColumns::endMessage(ValueMessageBuilder & /*messageBuilder*/)
+{
+  throw UsageError("Coding Error", "SequenceColumns: unexpected message.");
+}
+
+bool
+SequenceColumns::ignoreMessage(ValueMessageBuilder & /*messageBuilder*/)
+{
+  throw UsageError("Coding Error", "SequenceColumns: unexpected message.");
+}
+
+ValueMessageBuilder &
+SequenceColumns::startSequence(
+  const FieldIdentity & /*identity*/,
+  const std::string & /*applicationType*/,
+  const std::string & /*applicationTypeNamespace*/,
+  size_t /*fieldCount*/,
+  const FieldIdentity & /*lengthIdentity*/,
+  size_t /*length*/)
+{
+  throw UsageError("Coding Error", "SequenceColumns: nested sequences are not supported.");
+}
+
+void
+SequenceColumns::endSequence(
+  const FieldIdentity & /*identity*/,
+  ValueMessageBuilder & /*sequenceBuilder*/)
+{
+  throw UsageError("Coding Error", "SequenceColumns: nested sequences are not supported.");
+}
+
+ValueMessageBuilder &
+SequenceColumns::startSequenceEntry(
+  const std::string & /*applicationType*/,
+  const std::string & /*applicationTypeNamespace*/,
+  size_t /*size*/)
+{
+  throw UsageError("Coding Error", "SequenceColumns: nested sequences are not supported.");
+}
+
+void
+SequenceColumns::endSequenceEntry(ValueMessageBuilder & /*entry*/)
+{
+  throw UsageError("Coding Error", "SequenceColumns: nested sequences are not supported.");
+}
+
+ValueMessageBuilder &
+SequenceColumns::startGroup(
+  const FieldIdentity & /*identity*/,
+  const std::string & /*applicationType*/,
+  const std::string & /*applicationTypeNamespace*/,
+  size_t /*size*/)
+{
+  throw UsageError("Coding Error", "SequenceColumns: groups are not supported.");
+}
+
+void
+SequenceColumns::endGroup(
+  const FieldIdentity & /*identity*/,
+  ValueMessageBuilder & /*groupBuilder*/)
+{
+  throw UsageError("Coding Error", "SequenceColumns: groups are not supported.");
+}
+
+bool
+SequenceColumns::wantLog(unsigned short /*level*/)
+{
+  return false;
+}
+
+bool
+SequenceColumns::logMessage(unsigned short /*level*/, const std::string & /*logMessage*/)
+{
+  return true;
+}
+
+bool
+SequenceColumns::reportDecodingError(const std::string & /*errorMessage*/)
+{
+  return false;
+}
+
+bool
+SequenceColumns::reportCommunicationError(const std::string & /*errorMessage*/)
+{
+  return false;
+}
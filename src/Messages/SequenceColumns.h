@@ -0,0 +1,235 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef SEQUENCECOLUMNS_H
+#define SEQUENCECOLUMNS_H
+#include "SequenceColumns_fwd.h"
+#include <Common/QuickFAST_Export.h>
+#include <Common/Types.h>
+#include <Common/Decimal.h>
+#include <Messages/ValueMessageBuilder.h>
+#include <Messages/FieldIdentity.h>
+
+namespace QuickFAST
+{
+  namespace Messages
+  {
+    /// @brief A decoded sequence stored as one array per field.
+    ///
+    /// When a ValueMessageBuilder returns true from wantSequenceColumns(), the decoder
+    /// decodes a sequence whose entries contain only integer and decimal fields into
+    /// a SequenceColumns object and delivers it with a single call to addSequenceColumns().
+    /// This replaces the startSequence(), startSequenceEntry(), endSequenceEntry(),
+    /// and endSequence() calls and the per-entry builders.
+    ///
+    /// Column n corresponds to the nth field instruction in the sequence entry.
+    /// Each column holds one cell per entry.  Integers are stored as int64 (unsigned
+    /// values are stored bit-for-bit); decimals are stored as a mantissa in the same
+    /// array plus a separate exponent array.  A cell is present if the field was present
+    /// in that entry.
+    ///
+    /// The decoder reuses the same object for every sequence, so the contents are
+    /// only valid during the call to addSequenceColumns().
+    class QuickFAST_Export SequenceColumns : public ValueMessageBuilder
+    {
+    public:
+      SequenceColumns();
+      virtual ~SequenceColumns();
+
+      /// @brief Prepare to receive a new sequence.
+      ///
+      /// Called by the decoder.  Follow with a call to defineColumn() for each field.
+      /// @param applicationType is the data type for a sequence entry
+      /// @param applicationTypeNamespace qualifies applicationType
+      /// @param lengthIdentity is the identity of the length field
+      /// @param length is the number of entries in the sequence
+      void reset(
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        const FieldIdentity & lengthIdentity,
+        size_t length);
+
+      /// @brief Add a column to receive values for a field.
+      /// @param identity identifies the field.
+      void defineColumn(const FieldIdentity & identity);
+
+      /// @brief Direct subsequent values to the given entry.
+      /// @param row is the index of the sequence entry being decoded.
+      void setRow(size_t row)
+      {
+        row_ = row;
+      }
+
+      /// @brief How many entries are in the sequence?
+      size_t length()const
+      {
+        return length_;
+      }
+
+      /// @brief How many fields are in each entry?
+      size_t columnCount()const
+      {
+        return columnCount_;
+      }
+
+      /// @brief The identity of the length field.
+      const FieldIdentity & lengthIdentity()const
+      {
+        return *lengthIdentity_;
+      }
+
+      /// @brief Find a column by field name.
+      /// @param name is the local name of the field
+      /// @param[out] column is set to the index of the column if found
+      /// @returns true if the column was found
+      bool columnIndex(const std::string & name, size_t & column)const;
+
+      /// @brief The identity of the field stored in a column.
+      const FieldIdentity & identity(size_t column)const
+      {
+        return *columns_[column].identity_;
+      }
+
+      /// @brief The type of the values stored in a column.
+      ///
+      /// This is ValueType::UNDEFINED if no entry contains the field.
+      ValueType::Type type(size_t column)const
+      {
+        return columns_[column].type_;
+      }
+
+      /// @brief Is the field present in a particular entry?
+      bool isPresent(size_t column, size_t row)const
+      {
+        return columns_[column].present_[row] != 0;
+      }
+
+      /// @brief The value of a signed integer field, or the mantissa of a decimal field.
+      int64 getInt64(size_t column, size_t row)const
+      {
+        return columns_[column].values_[row];
+      }
+
+      /// @brief The value of an unsigned integer field.
+      uint64 getUInt64(size_t column, size_t row)const
+      {
+        return uint64(columns_[column].values_[row]);
+      }
+
+      /// @brief The value of a decimal field.
+      Decimal getDecimal(size_t column, size_t row)const
+      {
+        const Column & col = columns_[column];
+        return Decimal(col.values_[row], col.exponents_[row], false);
+      }
+
+      /// @brief Direct access to the values (or mantissas) in a column.
+      /// @returns an array of length() values.
+      const int64 * values(size_t column)const
+      {
+        return length_ == 0 ? 0 : &columns_[column].values_[0];
+      }
+
+      /// @brief Direct access to the exponents in a decimal column.
+      /// @returns an array of length() exponents.
+      const exponent_t * exponents(size_t column)const
+      {
+        return length_ == 0 ? 0 : &columns_[column].exponents_[0];
+      }
+
+      /// @brief Direct access to the presence flags in a column.
+      /// @returns an array of length() flags.  Nonzero means present.
+      const uchar * presence(size_t column)const
+      {
+        return length_ == 0 ? 0 : &columns_[column].present_[0];
+      }
+
+      /// @brief Deliver the sequence to a builder one entry at a time.
+      ///
+      /// Makes the calls the decoder would have made had columnar delivery not been used.
+      /// @param builder receives the sequence
+      /// @param identity identifies the sequence
+      void replay(ValueMessageBuilder & builder, const FieldIdentity & identity)const;
+
+      ///////////////////////////
+      // Implement ValueMessageBuilder
+      virtual const std::string & getApplicationType() const;
+      virtual const std::string & getApplicationTypeNs() const;
+      virtual void addValue(const FieldIdentity & identity, ValueType::Type type, const int64 value);
+      virtual void addValue(const FieldIdentity & identity, ValueType::Type type, const uint64 value);
+      virtual void addValue(const FieldIdentity & identity, ValueType::Type type, const int32 value);
+      virtual void addValue(const FieldIdentity & identity, ValueType::Type type, const uint32 value);
+      virtual void addValue(const FieldIdentity & identity, ValueType::Type type, const int16 value);
+      virtual void addValue(const FieldIdentity & identity, ValueType::Type type, const uint16 value);
+      virtual void addValue(const FieldIdentity & identity, ValueType::Type type, const int8 value);
+      virtual void addValue(const FieldIdentity & identity, ValueType::Type type, const uchar value);
+      virtual void addValue(const FieldIdentity & identity, ValueType::Type type, const Decimal& value);
+      virtual void addValue(const FieldIdentity & identity, ValueType::Type type, const unsigned char * value, size_t length);
+      virtual ValueMessageBuilder & startMessage(
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t size);
+      virtual bool endMessage(ValueMessageBuilder & messageBuilder);
+      virtual bool ignoreMessage(ValueMessageBuilder & messageBuilder);
+      virtual ValueMessageBuilder & startSequence(
+        const FieldIdentity & identity,
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t fieldCount,
+        const FieldIdentity & lengthIdentity,
+        size_t length);
+      virtual void endSequence(
+        const FieldIdentity & identity,
+        ValueMessageBuilder & sequenceBuilder);
+      virtual ValueMessageBuilder & startSequenceEntry(
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t size);
+      virtual void endSequenceEntry(ValueMessageBuilder & entry);
+      virtual ValueMessageBuilder & startGroup(
+        const FieldIdentity & identity,
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t size);
+      virtual void endGroup(
+        const FieldIdentity & identity,
+        ValueMessageBuilder & groupBuilder);
+
+      ///////////////////
+      // Implement Logger
+      virtual bool wantLog(unsigned short level);
+      virtual bool logMessage(unsigned short level, const std::string & logMessage);
+      virtual bool reportDecodingError(const std::string & errorMessage);
+      virtual bool reportCommunicationError(const std::string & errorMessage);
+
+    private:
+      struct Column
+      {
+        const FieldIdentity * identity_;
+        ValueType::Type type_;
+        std::vector<int64> values_;
+        std::vector<exponent_t> exponents_;
+        std::vector<uchar> present_;
+      };
+
+      Column & find(const FieldIdentity & identity);
+      void setInteger(const FieldIdentity & identity, ValueType::Type type, int64 value);
+
+    private:
+      const std::string * applicationType_;
+      const std::string * applicationTypeNamespace_;
+      const FieldIdentity * lengthIdentity_;
+      size_t length_;
+      size_t row_;
+      /// The columns in use.  Columns beyond this are kept to avoid reallocation.
+      size_t columnCount_;
+      /// The column that received the most recent value
+      size_t cursor_;
+      std::vector<Column> columns_;
+    };
+  }
+}
+#endif // SEQUENCECOLUMNS_H
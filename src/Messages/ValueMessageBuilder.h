@@ -11,6 +11,7 @@
 #include <Common/QuickFAST_Export.h>
 #include <Common/Types.h>
 #include <Messages/FieldIdentity_fwd.h>
+#include <Messages/SequenceColumns_fwd.h>
 #include <Common/Logger.h>
 namespace QuickFAST{
   namespace Messages{
@@ -184,6 +185,31 @@ namespace QuickFAST{
         const FieldIdentity & identity,
         ValueMessageBuilder & groupBuilder) = 0;
 
+      /// @brief Does this builder accept sequences in columnar form?
+      ///
+      /// If so, a sequence whose entries contain only integer and decimal fields
+      /// is delivered by a single call to addSequenceColumns() rather than by
+      /// startSequence(), startSequenceEntry(), endSequenceEntry() and endSequence().
+      ///
+      /// New method added to the interface.  It's not pure virtual to avoid
+      /// breaking existing implementations.
+      /// @returns true to receive columnar sequences.
+      virtual bool wantSequenceColumns()const
+      {
+        return false;
+      }
+
+      /// @brief Accept an entire sequence in columnar form.
+      ///
+      /// Called only if wantSequenceColumns() returns true.
+      /// @param identity identifies the sequence
+      /// @param columns contains the decoded entries.  It is only valid during this call.
+      virtual void addSequenceColumns(
+        const FieldIdentity & /*identity*/,
+        const SequenceColumns & /*columns*/)
+      {
+      }
+
       /// @brief Notify builder that packets are missing
       ///
       /// Called when packet sequence numbers are being used for arbitrage.
@@ -0,0 +1,127 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+
+#include <Codecs/XMLTemplateParser.h>
+#include <Codecs/BinaryTemplateParser.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Common/Exceptions.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  std::string readTemplates(const char * name)
+  {
+    std::string fileName(std::getenv("QUICKFAST_ROOT"));
+    fileName += "/src/Tests/resources/";
+    fileName += name;
+    std::ifstream xml(fileName.c_str(), std::ios::in | std::ios::binary);
+    BOOST_REQUIRE(xml.good());
+    std::stringstream result;
+    result << xml.rdbuf();
+    return result.str();
+  }
+
+  std::string display(const Codecs::TemplateRegistry & registry)
+  {
+    std::stringstream result;
+    registry.display(result);
+    return result.str();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestBinaryTemplateRoundTrip)
+{
+  const char * files[] = {"unittest_mandatory.xml", "unittest_optional.xml", "biggest_value.xml"};
+  for(size_t nFile = 0; nFile < sizeof(files)/sizeof(files[0]); ++nFile)
+  {
+    std::string xml = readTemplates(files[nFile]);
+    std::stringstream xmlStream(xml);
+    std::stringstream image;
+    Codecs::XMLTemplateParser xmlParser;
+    Codecs::TemplateRegistryPtr expected = xmlParser.compile(xmlStream, image);
+    BOOST_REQUIRE(expected);
+
+    Codecs::BinaryTemplateParser parser;
+    std::stringstream source(xml);
+    parser.requireSource(source);
+    Codecs::TemplateRegistryPtr loaded = parser.parse(image);
+    BOOST_REQUIRE(loaded);
+    BOOST_CHECK_EQUAL(loaded->size(), expected->size());
+    BOOST_CHECK_EQUAL(loaded->presenceMapBits(), expected->presenceMapBits());
+    BOOST_CHECK_EQUAL(loaded->dictionarySize(), expected->dictionarySize());
+    BOOST_CHECK_EQUAL(loaded->maxFieldCount(), expected->maxFieldCount());
+    BOOST_CHECK_EQUAL(display(*loaded), display(*expected));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestBinaryTemplateFile)
+{
+  std::string root(std::getenv("QUICKFAST_ROOT"));
+  std::string fileName = root + "/src/Tests/resources/templateImageTest.out";
+  boost::filesystem::remove(fileName);
+
+  std::string xml = readTemplates("unittest_mandatory.xml");
+  Codecs::TemplateRegistryPtr expected;
+  {
+    std::stringstream xmlStream(xml);
+    std::ofstream image(fileName.c_str(), std::ios::out | std::ios::binary);
+    Codecs::XMLTemplateParser xmlParser;
+    expected = xmlParser.compile(xmlStream, image);
+  }
+  Codecs::BinaryTemplateParser parser;
+  Codecs::TemplateRegistryPtr loaded = parser.parseFile(fileName);
+  BOOST_REQUIRE(loaded);
+  BOOST_CHECK_EQUAL(display(*loaded), display(*expected));
+
+  boost::filesystem::remove(fileName);
+  BOOST_CHECK_THROW(parser.parseFile(fileName), TemplateDefinitionError);
+}
+
+BOOST_AUTO_TEST_CASE(TestBinaryTemplateRejects)
+{
+  std::string xml = readTemplates("unittest_optional.xml");
+  std::string image;
+  {
+    std::stringstream xmlStream(xml);
+    std::stringstream imageStream;
+    Codecs::XMLTemplateParser xmlParser;
+    xmlParser.compile(xmlStream, imageStream);
+    image = imageStream.str();
+  }
+  const unsigned char * data = reinterpret_cast<const unsigned char *>(image.data());
+
+  // The image must come from the same XML.
+  {
+    Codecs::BinaryTemplateParser parser;
+    std::stringstream changed(xml + " ");
+    parser.requireSource(changed);
+    BOOST_CHECK_THROW(parser.parse(data, image.size()), TemplateDefinitionError);
+  }
+  // ...and the same nonstandard features.
+  {
+    Codecs::BinaryTemplateParser parser;
+    parser.setNonstandard(Codecs::XMLTemplateParser::NONSTANDARD_PresenceOnLengthInstruction);
+    BOOST_CHECK_THROW(parser.parse(data, image.size()), TemplateDefinitionError);
+  }
+
+  Codecs::BinaryTemplateParser parser;
+  BOOST_CHECK(parser.parse(data, image.size()));
+
+  // Damage is detected
+  std::string damaged(image);
+  damaged[damaged.size() / 2] ^= 0x20;
+  BOOST_CHECK_THROW(
+    parser.parse(reinterpret_cast<const unsigned char *>(damaged.data()), damaged.size()),
+    TemplateDefinitionError);
+  BOOST_CHECK_THROW(parser.parse(data, image.size() - 1), TemplateDefinitionError);
+  BOOST_CHECK_THROW(parser.parse(data, 3), TemplateDefinitionError);
+  std::stringstream notAnImage(xml);
+  BOOST_CHECK_THROW(parser.parse(notAnImage), TemplateDefinitionError);
+}
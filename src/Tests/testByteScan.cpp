@@ -0,0 +1,226 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Common/ByteScan.h>
+#include <Common/StringBuffer.h>
+#include <Common/WorkingBuffer.h>
+#include <Codecs/FieldInstruction.h>
+#include <Codecs/XMLTemplateParser.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/DataSource.h>
+#include <Codecs/DataSourceString.h>
+#include <Codecs/SingleMessageConsumer.h>
+#include <Codecs/GenericMessageBuilder.h>
+
+#include <Messages/Message.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldUtf8.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  /// Deliver the data a few bytes at a time so strings cross buffer boundaries.
+  class DataSourceChunks : public Codecs::DataSource
+  {
+  public:
+    DataSourceChunks(const std::string & data, size_t chunkSize)
+      : data_(data)
+      , chunkSize_(chunkSize)
+      , position_(0)
+    {
+    }
+
+    virtual bool getBuffer(const uchar *& buffer, size_t & size)
+    {
+      if(position_ >= data_.size())
+      {
+        return false;
+      }
+      buffer = reinterpret_cast<const uchar *>(data_.data()) + position_;
+      size = std::min(chunkSize_, data_.size() - position_);
+      position_ += size;
+      return true;
+    }
+
+  private:
+    std::string data_;
+    size_t chunkSize_;
+    size_t position_;
+  };
+
+  std::string makeString(size_t length)
+  {
+    std::string result;
+    for(size_t pos = 0; pos < length; ++pos)
+    {
+      result += char('a' + pos % 26);
+    }
+    return result;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testByteScanFindStopBit)
+{
+  std::vector<uchar> data(70, 'x');
+  for(size_t size = 0; size < data.size(); ++size)
+  {
+    BOOST_CHECK_EQUAL(ByteScan::findStopBit(&data[0], size), size);
+    BOOST_CHECK(ByteScan::isAscii(&data[0], size));
+    for(size_t stop = 0; stop < size; ++stop)
+    {
+      data[stop] = uchar('x' | 0x80);
+      BOOST_CHECK_EQUAL(ByteScan::findStopBit(&data[0], size), stop);
+      BOOST_CHECK(!ByteScan::isAscii(&data[0], size));
+      // only the first one counts
+      if(stop + 1 < size)
+      {
+        data[size - 1] = uchar(0xFF);
+        BOOST_CHECK_EQUAL(ByteScan::findStopBit(&data[0], size), stop);
+        data[size - 1] = 'x';
+      }
+      data[stop] = 'x';
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testByteScanUtf8)
+{
+  const char * valid[] = {
+    "",
+    "plain ASCII text that is longer than sixteen bytes",
+    "caf\xC3\xA9",                        // U+00E9
+    "\xE2\x82\xAC 100",                   // U+20AC
+    "\xF0\x9F\x98\x80",                   // U+1F600
+    "\xED\x9F\xBF",                       // U+D7FF, just below the surrogates
+    "\xF4\x8F\xBF\xBF",                   // U+10FFFF
+  };
+  for(size_t n = 0; n < sizeof(valid)/sizeof(valid[0]); ++n)
+  {
+    std::string text(valid[n]);
+    BOOST_CHECK_MESSAGE(
+      ByteScan::isValidUtf8(reinterpret_cast<const uchar *>(text.data()), text.size()),
+      "valid string " << n);
+  }
+
+  const char * invalid[] = {
+    "\x80",                               // continuation without a lead byte
+    "caf\xC3",                            // truncated
+    "\xC3\x28",                           // bad continuation
+    "\xC0\xAF",                           // overlong '/'
+    "\xE0\x80\xAF",                       // overlong '/'
+    "\xED\xA0\x80",                       // U+D800 surrogate
+    "\xF4\x90\x80\x80",                   // above U+10FFFF
+    "\xF8\x88\x80\x80\x80",               // five byte form
+    "0123456789abcdef\xFF",               // bad byte after a fast ASCII run
+  };
+  for(size_t n = 0; n < sizeof(invalid)/sizeof(invalid[0]); ++n)
+  {
+    std::string text(invalid[n]);
+    BOOST_CHECK_MESSAGE(
+      !ByteScan::isValidUtf8(reinterpret_cast<const uchar *>(text.data()), text.size()),
+      "invalid string " << n);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testByteScanDecodeStrings)
+{
+  // Stop bit encoded ASCII strings of every length up to a few SSE registers.
+  const size_t longest = 50;
+  std::string encoded;
+  {
+    Codecs::DataDestination destination;
+    for(size_t length = 1; length <= longest; ++length)
+    {
+      Codecs::FieldInstruction::encodeAscii(destination, StringBuffer(makeString(length)));
+    }
+    destination.toString(encoded);
+  }
+  // followed by a length prefixed byte vector
+  std::string bytes = makeString(40);
+  bytes[7] = char(0xFF);
+  encoded += bytes;
+
+  const size_t chunkSizes[] = {1, 3, 16, 1000};
+  for(size_t nChunk = 0; nChunk < sizeof(chunkSizes)/sizeof(chunkSizes[0]); ++nChunk)
+  {
+    DataSourceChunks source(encoded, chunkSizes[nChunk]);
+    WorkingBuffer buffer;
+    for(size_t length = 1; length <= longest; ++length)
+    {
+      BOOST_REQUIRE(Codecs::FieldInstruction::decodeAscii(source, buffer));
+      std::string decoded;
+      buffer.toString(decoded);
+      BOOST_CHECK_EQUAL(decoded, makeString(length));
+    }
+
+    Codecs::Context context(Codecs::TemplateRegistryPtr(new Codecs::TemplateRegistry));
+    Codecs::FieldInstruction::decodeByteVector(context, source, "bytes", buffer, bytes.size());
+    std::string decoded;
+    buffer.toString(decoded);
+    BOOST_CHECK(decoded == bytes);
+    BOOST_CHECK_EQUAL(source.bytesConsumed(), encoded.size());
+
+    // Nothing left: no string to decode.
+    BOOST_CHECK(!Codecs::FieldInstruction::decodeAscii(source, buffer));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testByteScanValidateUtf8)
+{
+  const char templates[] =
+    "<templates>"
+    "  <template name=\"News\" id=\"1\">"
+    "    <string name=\"Headline\" charset=\"unicode\"/>"
+    "  </template>"
+    "</templates>";
+  Codecs::XMLTemplateParser parser;
+  std::stringstream templateStream(templates);
+  Codecs::TemplateRegistryPtr templateRegistry = parser.parse(templateStream);
+  BOOST_REQUIRE(templateRegistry);
+
+  Messages::FieldIdentity identity_Headline("Headline");
+  std::string fast;
+  {
+    Codecs::Encoder encoder(templateRegistry);
+    const std::string headlines[] = {"caf\xC3\xA9", "caf\xC3"};
+    for(size_t n = 0; n < 2; ++n)
+    {
+      Messages::FieldSet msg(1);
+      msg.addField(identity_Headline, Messages::FieldUtf8::create(headlines[n]));
+      Codecs::DataDestination destination;
+      encoder.encodeMessage(destination, 1, msg);
+      std::string encoded;
+      destination.toString(encoded);
+      fast += encoded;
+    }
+  }
+
+  {
+    // Not checked unless asked for.
+    Codecs::Decoder decoder(templateRegistry);
+    Codecs::DataSourceString source(fast);
+    Codecs::SingleMessageConsumer consumer;
+    Codecs::GenericMessageBuilder builder(consumer);
+    BOOST_CHECK(!decoder.getValidateUtf8());
+    decoder.decodeMessage(source, builder);
+    decoder.decodeMessage(source, builder);
+  }
+  {
+    Codecs::Decoder decoder(templateRegistry);
+    decoder.setValidateUtf8(true);
+    Codecs::DataSourceString source(fast);
+    Codecs::SingleMessageConsumer consumer;
+    Codecs::GenericMessageBuilder builder(consumer);
+    decoder.decodeMessage(source, builder);
+    BOOST_CHECK_THROW(decoder.decodeMessage(source, builder), EncodingError);
+  }
+}
@@ -8,10 +8,12 @@
 #include <boost/filesystem.hpp>
 
 #include <Communication/SingleServerBufferQueue.h>
+#include <Communication/BufferPool.h>
 #include <Common/StringBuffer.h>
 #include <Common/WorkingBuffer.h>
 #include <Common/Exceptions.h>
 #include <Common/Decimal.h>
+#include <Common/Profiler.h>
 
 using namespace QuickFAST;
 BOOST_AUTO_TEST_CASE(TestLinkedBuffer)
@@ -336,6 +338,164 @@ BOOST_AUTO_TEST_CASE(TestSingleServerBufferQueue)
   }
 }
 
+BOOST_AUTO_TEST_CASE(TestBufferPool)
+{
+  Communication::BufferPool pool;
+  BOOST_CHECK_EQUAL(pool.bufferCount(), 0u);
+  BOOST_CHECK(pool.pop() == 0);
+  BOOST_CHECK_EQUAL(pool.exhausted(), 1u);
+
+  const size_t bufferSize = 1500;
+  pool.allocate(bufferSize, 4);
+  BOOST_CHECK_EQUAL(pool.bufferCount(), 4u);
+  BOOST_CHECK_EQUAL(pool.stride() % Communication::BufferPool::cacheLineSize, 0u);
+  BOOST_CHECK(pool.stride() >= bufferSize);
+  BOOST_CHECK(pool.slabBytes() >= 4 * pool.stride());
+
+  std::vector<Communication::LinkedBuffer *> buffers;
+  for(size_t nBuffer = 0; nBuffer < 4; ++nBuffer)
+  {
+    Communication::LinkedBuffer * buffer = pool.pop();
+    BOOST_REQUIRE(buffer != 0);
+    BOOST_CHECK_EQUAL(buffer->capacity(), bufferSize);
+    BOOST_CHECK_EQUAL(reinterpret_cast<size_t>(buffer->get()) % Communication::BufferPool::cacheLineSize, 0u);
+    // the buffers are carved from one slab.
+    if(!buffers.empty())
+    {
+      BOOST_CHECK(buffer->get() == buffers.back()->get() + pool.stride());
+    }
+    buffer->get()[bufferSize - 1] = static_cast<unsigned char>(nBuffer);
+    buffer->setUsed(bufferSize);
+    buffers.push_back(buffer);
+  }
+  BOOST_CHECK(pool.pop() == 0);
+  BOOST_CHECK_EQUAL(pool.exhausted(), 2u);
+  BOOST_CHECK_EQUAL(pool.inUse(), 4u);
+  BOOST_CHECK_EQUAL(pool.highWaterMark(), 4u);
+
+  pool.push(buffers[0]);
+  Communication::BufferQueue queue;
+  queue.push(buffers[1]);
+  queue.push(buffers[2]);
+  pool.push(queue);
+  BOOST_CHECK(queue.isEmpty());
+  BOOST_CHECK_EQUAL(pool.inUse(), 1u);
+  BOOST_CHECK_EQUAL(pool.highWaterMark(), 4u);
+
+  // All buffers in a pool must be the same size.
+  BOOST_CHECK_THROW(pool.allocate(bufferSize + 1, 1), UsageError);
+
+  // Additional buffers come from another slab.
+  pool.allocate(bufferSize, 2);
+  BOOST_CHECK_EQUAL(pool.bufferCount(), 6u);
+  BOOST_CHECK_EQUAL(pool.inUse(), 1u);
+  for(size_t nBuffer = 0; nBuffer < 5; ++nBuffer)
+  {
+    BOOST_CHECK(pool.pop() != 0);
+  }
+  BOOST_CHECK(pool.pop() == 0);
+  BOOST_CHECK_EQUAL(pool.highWaterMark(), 6u);
+  BOOST_CHECK_EQUAL(buffers[3]->get()[bufferSize - 1], 3);
+
+  // Huge pages may not be available, but the pool must work either way.
+  Communication::BufferPool hugePool;
+  hugePool.setHugePages(true);
+  hugePool.setNumaNode(0);
+  hugePool.allocate(bufferSize, 10);
+  BOOST_CHECK(hugePool.bufferCount() >= 10u);
+  if(hugePool.usingHugePages())
+  {
+    BOOST_CHECK_EQUAL(hugePool.slabBytes() % (2 * 1024 * 1024), 0u);
+  }
+  Communication::LinkedBuffer * buffer = hugePool.pop();
+  BOOST_REQUIRE(buffer != 0);
+  BOOST_CHECK_EQUAL(reinterpret_cast<size_t>(buffer->get()) % Communication::BufferPool::cacheLineSize, 0u);
+}
+
+namespace
+{
+  // The pool grows in the background, so give the refill thread a chance to catch up.
+  Communication::LinkedBuffer * popWaiting(Communication::BufferPool & pool)
+  {
+    Communication::LinkedBuffer * buffer = pool.pop();
+    for(size_t nTry = 0; buffer == 0 && nTry < 1000; ++nTry)
+    {
+      boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+      buffer = pool.pop();
+    }
+    return buffer;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestBufferPoolGrowth)
+{
+  Communication::BufferPool pool;
+  const size_t stride = Communication::BufferPool::cacheLineSize * 2;
+  // Room for the initial four buffers and two more slabs of four.
+  pool.setGrowth(2, 4, stride * 12);
+  pool.allocate(stride - 10, 4);
+  BOOST_CHECK_EQUAL(pool.stride(), stride);
+
+  std::vector<Communication::LinkedBuffer *> buffers;
+  for(size_t nBuffer = 0; nBuffer < 12; ++nBuffer)
+  {
+    Communication::LinkedBuffer * buffer = popWaiting(pool);
+    BOOST_REQUIRE(buffer != 0);
+    buffers.push_back(buffer);
+  }
+  BOOST_CHECK_EQUAL(pool.growths(), 2u);
+  BOOST_CHECK_EQUAL(pool.bufferCount(), 12u);
+  BOOST_CHECK_EQUAL(pool.slabBytes(), stride * 12);
+  // Several pops happened below the low water mark, but it was one episode.
+  BOOST_CHECK_EQUAL(pool.capped(), 1u);
+  size_t exhausted = pool.exhausted();
+  BOOST_CHECK(pool.pop() == 0);
+  BOOST_CHECK_EQUAL(pool.exhausted(), exhausted + 1);
+  BOOST_CHECK_EQUAL(pool.capped(), 1u);
+
+  boost::this_thread::sleep(boost::posix_time::milliseconds(2));
+  pool.push(buffers.back());
+  buffers.pop_back();
+  double exhaustedTime = pool.exhaustedNanoseconds();
+  BOOST_CHECK(exhaustedTime > 0.0);
+  BOOST_CHECK_EQUAL(pool.exhaustedNanoseconds(), exhaustedTime);
+
+  // Shrinking releases the added slabs once they have not been needed for a while.
+  pool.setShrink(1);
+  while(!buffers.empty())
+  {
+    pool.push(buffers.back());
+    buffers.pop_back();
+  }
+  for(size_t nTry = 0; nTry < 100 && pool.shrinks() < 2; ++nTry)
+  {
+    boost::this_thread::sleep(boost::posix_time::milliseconds(2));
+    pool.push(pool.pop());
+  }
+  BOOST_CHECK_EQUAL(pool.shrinks(), 2u);
+  BOOST_CHECK_EQUAL(pool.bufferCount(), 4u);
+  BOOST_CHECK_EQUAL(pool.slabBytes(), stride * 4);
+  BOOST_CHECK_EQUAL(pool.inUse(), 0u);
+
+  // The original slab is never released.
+  for(size_t nTry = 0; nTry < 3; ++nTry)
+  {
+    boost::this_thread::sleep(boost::posix_time::milliseconds(2));
+    pool.push(pool.pop());
+  }
+  BOOST_CHECK_EQUAL(pool.bufferCount(), 4u);
+
+  // Popping below the low water mark grows the pool again.
+  for(size_t nBuffer = 0; nBuffer < 12; ++nBuffer)
+  {
+    BOOST_REQUIRE(popWaiting(pool) != 0);
+  }
+  BOOST_CHECK_EQUAL(pool.growths(), 4u);
+  BOOST_CHECK(pool.pop() == 0);
+  // A new episode.
+  BOOST_CHECK_EQUAL(pool.capped(), 2u);
+}
+
 BOOST_AUTO_TEST_CASE(TestStringBuffer)
 {
   typedef StringBufferT<10> String10;
@@ -377,6 +537,29 @@ BOOST_AUTO_TEST_CASE(TestStringBuffer)
   BOOST_CHECK(s2.growCount() == 2);
 }
 
+BOOST_AUTO_TEST_CASE(TestStringBufferReplace)
+{
+  typedef StringBufferT<10> String10;
+  const unsigned char * abc(reinterpret_cast<const unsigned char *>("abc"));
+  String10 s1("12345");
+  s1.replace(5, 0, abc, 3);  // append
+  BOOST_CHECK(s1 == "12345abc");
+  s1.replace(0, 2, abc, 1);  // shrink at the front
+  BOOST_CHECK(s1 == "a345abc");
+  s1.replace(1, 100, abc, 2); // count is clipped
+  BOOST_CHECK(s1 == "aab");
+  s1.replace(0, 0, abc, 3);  // prepend
+  BOOST_CHECK(s1 == "abcaab");
+  BOOST_CHECK_EQUAL(s1.growCount(), 0u);
+  s1.replace(3, 0, abc, 3);
+  s1.replace(3, 0, abc, 3);  // beyond the internal buffer
+  BOOST_CHECK(s1 == "abcabcabcaab");
+  BOOST_CHECK_EQUAL(s1.growCount(), 1u);
+  s1.replace(0, s1.size(), abc, 0);
+  BOOST_CHECK(s1.empty());
+  BOOST_CHECK_THROW(s1.replace(1, 0, abc, 1), std::range_error);
+}
+
 BOOST_AUTO_TEST_CASE(TestWorkingBuffer)
 {
   WorkingBuffer a;
@@ -428,6 +611,10 @@ BOOST_AUTO_TEST_CASE(TestWorkingBuffer)
   BOOST_CHECK(abc.capacity() > abcCap); // now we should have grown
   BOOST_CHECK(0 == std::strncmp(abcStr.data(), reinterpret_cast<const char *>(abc.begin()), abcHalf * 4));
 
+  // replacing a range with nothing erases it; no data pointer is needed
+  abc.replace(abcHalf, abcHalf * 3, 0, 0);
+  BOOST_CHECK(abc.size() == abcHalf);
+  BOOST_CHECK(0 == std::strncmp(abcStr.data(), reinterpret_cast<const char *>(abc.begin()), abcHalf));
 
   // TODO: This is a start, but we could use a lot more testing here.
 }
@@ -504,3 +691,148 @@ BOOST_AUTO_TEST_CASE(TestDecimal)
   BOOST_CHECK_GT(f, g);
 
 }
+
+BOOST_AUTO_TEST_CASE(TestDecimalFormatAndParse)
+{
+  struct Case
+  {
+    mantissa_t mantissa;
+    exponent_t exponent;
+    const char * text;
+  };
+  const Case cases[] = {
+    {12345, -2, "123.45"},
+    {1230, -2, "12.30"},
+    {-5, -3, "-0.005"},
+    {5, -1, "0.5"},
+    {42, 3, "42000"},
+    {0, 0, "0"},
+    {0, -2, "0.00"},
+    {LLONG_MAX, -4, "922337203685477.5807"},
+    {LLONG_MIN, 0, "-9223372036854775808"}
+  };
+  for(size_t nCase = 0; nCase < sizeof(cases) / sizeof(cases[0]); ++nCase)
+  {
+    const Case & test = cases[nCase];
+    Decimal value(test.mantissa, test.exponent, false);
+    char buffer[Decimal::maxStringLength];
+    size_t length = value.toString(buffer, sizeof(buffer));
+    BOOST_CHECK_EQUAL(std::string(buffer, length), test.text);
+    std::string text;
+    value.toString(text);
+    BOOST_CHECK_EQUAL(text, test.text);
+
+    // parsing is exact
+    Decimal parsed(0, 0, false);
+    parsed.parse(test.text, std::strlen(test.text));
+    if(test.mantissa != 0 && test.exponent <= 0)
+    {
+      BOOST_CHECK_EQUAL(parsed.getMantissa(), test.mantissa);
+      BOOST_CHECK_EQUAL(int(parsed.getExponent()), int(test.exponent));
+    }
+    BOOST_CHECK_EQUAL(parsed, value);
+  }
+
+  // worst case fits in maxStringLength
+  char buffer[Decimal::maxStringLength];
+  Decimal big(LLONG_MIN, SCHAR_MAX, false);
+  BOOST_CHECK_EQUAL(big.toString(buffer, sizeof(buffer)), 20 + SCHAR_MAX);
+  Decimal small(LLONG_MIN, SCHAR_MIN, false);
+  BOOST_CHECK_EQUAL(small.toString(buffer, sizeof(buffer)), 3 - SCHAR_MIN);
+  BOOST_CHECK_THROW(big.toString(buffer, 10), UsageError);
+
+  Decimal parsed;
+  parsed.parse(" 12.500 ");
+  BOOST_CHECK_EQUAL(parsed.getMantissa(), 125);
+  BOOST_CHECK_EQUAL(int(parsed.getExponent()), -1);
+  parsed.parse("-1.5e3");
+  BOOST_CHECK_EQUAL(parsed, Decimal(-1500, 0));
+  parsed.parse("25E-4");
+  BOOST_CHECK_EQUAL(parsed, Decimal(25, -4));
+  // trailing zeros do not overflow the mantissa
+  parsed.parse("12300000000000000000000000");
+  BOOST_CHECK_EQUAL(parsed, Decimal(123, 23));
+  BOOST_CHECK_THROW(parsed.parse("123456789012345678901"), OverflowError);
+  BOOST_CHECK_THROW(parsed.parse("12x"), UnsupportedConversion);
+  BOOST_CHECK_THROW(parsed.parse(""), UnsupportedConversion);
+}
+
+BOOST_AUTO_TEST_CASE(TestProfileHistogram)
+{
+  // every value maps into a bucket whose upper bound is within about 3%
+  uint64 values[] = {0, 1, 31, 32, 63, 64, 65, 1000, 123456789, ~uint64(0)};
+  size_t previous = 0;
+  for(size_t nValue = 0; nValue < sizeof(values)/sizeof(values[0]); ++nValue)
+  {
+    uint64 value = values[nValue];
+    size_t index = ProfileHistogram::bucketIndex(value);
+    BOOST_CHECK(index < ProfileHistogram::bucketCount);
+    BOOST_CHECK(index >= previous);
+    previous = index;
+    uint64 high = ProfileHistogram::bucketHighValue(index);
+    BOOST_CHECK(high >= value);
+    BOOST_CHECK(double(high - value) <= double(value) / 32.0);
+    if(index > 0)
+    {
+      BOOST_CHECK(ProfileHistogram::bucketHighValue(index - 1) < value);
+    }
+  }
+  BOOST_CHECK_EQUAL(ProfileHistogram::bucketIndex(~uint64(0)), ProfileHistogram::bucketCount - 1);
+
+  ProfileHistogram histogram;
+  BOOST_CHECK_EQUAL(histogram.percentile(50.0), 0);
+  for(uint64 value = 1; value <= 1000; ++value)
+  {
+    histogram.record(value);
+  }
+  BOOST_CHECK_EQUAL(histogram.count(), 1000);
+  BOOST_CHECK_EQUAL(histogram.sum(), 500500);
+  BOOST_CHECK_EQUAL(histogram.minimum(), 1);
+  BOOST_CHECK_EQUAL(histogram.maximum(), 1000);
+  uint64 median = histogram.percentile(50.0);
+  BOOST_CHECK(median >= 500 && median <= 516);
+  uint64 p99 = histogram.percentile(99.0);
+  BOOST_CHECK(p99 >= 990 && p99 <= 1000);
+  BOOST_CHECK_EQUAL(histogram.percentile(100.0), 1000);
+
+  ProfileHistogram other;
+  other.record(5000);
+  histogram.merge(other);
+  BOOST_CHECK_EQUAL(histogram.count(), 1001);
+  BOOST_CHECK_EQUAL(histogram.maximum(), 5000);
+  BOOST_CHECK_EQUAL(histogram.percentile(100.0), 5000);
+}
+
+BOOST_AUTO_TEST_CASE(TestProfileAccumulator)
+{
+  static ProfileAccumulator accumulator("TestProfileAccumulator", __FILE__, __LINE__);
+  for(size_t nLoop = 0; nLoop < 10; ++nLoop)
+  {
+    ProfileInstance outer(accumulator);
+    ProfileInstance inner(accumulator);
+  }
+  ProfileAccumulator::enable(false);
+  {
+    ProfileInstance ignored(accumulator);
+  }
+  ProfileAccumulator::enable(true);
+
+  ProfileStatistics total;
+  accumulator.collect(total);
+  BOOST_CHECK_EQUAL(total.entries_, 20);
+  BOOST_CHECK_EQUAL(total.exits_, 20);
+  BOOST_CHECK_EQUAL(total.depth_, 0);
+  BOOST_CHECK_EQUAL(total.recursions_, 10);
+  BOOST_CHECK_EQUAL(total.histogram_.count(), 10);
+  BOOST_CHECK(ProfileClock::ticksPerNanosecond() > 0.0);
+
+  bool found = false;
+  for(const ProfileAccumulator * ac = ProfileAccumulator::first(); ac != 0; ac = ac->next())
+  {
+    found = found || ac == &accumulator;
+  }
+  BOOST_CHECK(found);
+  std::stringstream report;
+  ProfileAccumulator::write(report);
+  BOOST_CHECK(report.str().find("TestProfileAccumulator") != std::string::npos);
+}
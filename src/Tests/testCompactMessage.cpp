@@ -0,0 +1,217 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/XMLTemplateParser.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/DataSourceString.h>
+#include <Codecs/CompactMessageBuilder.h>
+
+#include <Messages/CompactMessage.h>
+#include <Messages/FieldSet.h>
+#include <Messages/Group.h>
+#include <Messages/Sequence.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldInt64.h>
+#include <Messages/FieldAscii.h>
+#include <Messages/FieldDecimal.h>
+#include <Messages/FieldGroup.h>
+#include <Messages/FieldSequence.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  const char compactTemplates[] =
+    "<templates>"
+    "  <template name=\"Trade\" id=\"1\">"
+    "    <uInt32 name=\"SeqNum\"/>"
+    "    <string name=\"Symbol\"/>"
+    "    <string name=\"Text\"/>"
+    "    <decimal name=\"Price\"/>"
+    "    <int64 name=\"Change\"/>"
+    "    <group name=\"Header\">"
+    "      <typeRef name=\"Header\"/>"
+    "      <uInt32 name=\"Sender\"/>"
+    "      <string name=\"Venue\"/>"
+    "    </group>"
+    "    <sequence name=\"Legs\">"
+    "      <length name=\"NoLegs\"/>"
+    "      <string name=\"LegSymbol\"/>"
+    "      <uInt32 name=\"LegQty\"/>"
+    "    </sequence>"
+    "  </template>"
+    "</templates>";
+
+  Messages::FieldIdentity identity_SeqNum("SeqNum");
+  Messages::FieldIdentity identity_Symbol("Symbol");
+  Messages::FieldIdentity identity_Text("Text");
+  Messages::FieldIdentity identity_Price("Price");
+  Messages::FieldIdentity identity_Change("Change");
+  Messages::FieldIdentity identity_Header("Header");
+  Messages::FieldIdentity identity_Sender("Sender");
+  Messages::FieldIdentity identity_Venue("Venue");
+  Messages::FieldIdentity identity_Legs("Legs");
+  Messages::FieldIdentity identity_NoLegs("NoLegs");
+  Messages::FieldIdentity identity_LegSymbol("LegSymbol");
+  Messages::FieldIdentity identity_LegQty("LegQty");
+
+  const std::string longText("This text is too long to fit in a slot.");
+
+  void encodeTrade(Codecs::Encoder & encoder, std::string & fast, uint32 seqNum, size_t legs)
+  {
+    Messages::FieldSet msg(7);
+    msg.addField(identity_SeqNum, Messages::FieldUInt32::create(seqNum));
+    msg.addField(identity_Symbol, Messages::FieldAscii::create("IBM"));
+    msg.addField(identity_Text, Messages::FieldAscii::create(longText));
+    msg.addField(identity_Price, Messages::FieldDecimal::create(Decimal(12345, -2)));
+    msg.addField(identity_Change, Messages::FieldInt64::create(-42));
+
+    Messages::GroupPtr header(new Messages::Group(2));
+    header->addField(identity_Sender, Messages::FieldUInt32::create(7));
+    header->addField(identity_Venue, Messages::FieldAscii::create("XNYS"));
+    msg.addField(identity_Header, Messages::FieldGroup::create(header));
+
+    Messages::SequencePtr sequence(new Messages::Sequence(identity_NoLegs, legs));
+    for(size_t nLeg = 0; nLeg < legs; ++nLeg)
+    {
+      Messages::FieldSetPtr leg(new Messages::FieldSet(2));
+      leg->addField(identity_LegSymbol, Messages::FieldAscii::create(nLeg % 2 == 0 ? "IBM" : longText));
+      leg->addField(identity_LegQty, Messages::FieldUInt32::create(uint32(100 * (nLeg + 1))));
+      sequence->addEntry(leg);
+    }
+    msg.addField(identity_Legs, Messages::FieldSequence::create(sequence));
+
+    Codecs::DataDestination destination;
+    encoder.encodeMessage(destination, 1, msg);
+    std::string encoded;
+    destination.toString(encoded);
+    fast += encoded;
+  }
+
+  /// Keeps every message it receives.
+  class KeepingConsumer : public Codecs::CompactMessageConsumer
+  {
+  public:
+    virtual bool consumeMessage(Messages::CompactMessage & message)
+    {
+      messages_.push_back(Messages::CompactMessagePtr(new Messages::CompactMessage));
+      messages_.back()->swap(message);
+      return true;
+    }
+    virtual void decodingStarted(){}
+    virtual void decodingStopped(){}
+    virtual bool wantLog(unsigned short /*level*/){return false;}
+    virtual bool logMessage(unsigned short /*level*/, const std::string & /*logMessage*/){return true;}
+    virtual bool reportDecodingError(const std::string & /*errorMessage*/){return false;}
+    virtual bool reportCommunicationError(const std::string & /*errorMessage*/){return false;}
+
+    std::vector<Messages::CompactMessagePtr> messages_;
+  };
+
+  void checkTrade(const Messages::CompactMessage & message, uint32 seqNum, size_t legs)
+  {
+    BOOST_REQUIRE_EQUAL(message.size(), 7);
+    BOOST_CHECK_EQUAL(message[0].name(), "SeqNum");
+    BOOST_CHECK_EQUAL(message[0].toUInt64(), seqNum);
+    BOOST_CHECK_EQUAL(message[1].toString(), "IBM");
+    BOOST_CHECK_EQUAL(message[2].toString(), longText);
+    BOOST_CHECK(message[3].toDecimal() == Decimal(12345, -2));
+    BOOST_CHECK_EQUAL(message[4].toInt64(), -42);
+
+    const Messages::CompactField * header = 0;
+    BOOST_REQUIRE(message.findField("Header", header));
+    BOOST_CHECK_EQUAL(header->getType(), ValueType::GROUP);
+    BOOST_REQUIRE_EQUAL(header->fieldCount(), 2);
+    BOOST_CHECK_EQUAL(header->field(0).toUInt64(), 7);
+    const Messages::CompactField * venue = 0;
+    BOOST_REQUIRE(header->findField("Venue", venue));
+    BOOST_CHECK_EQUAL(venue->toString(), "XNYS");
+
+    const Messages::CompactField & sequence = message[6];
+    BOOST_CHECK_EQUAL(sequence.getType(), ValueType::SEQUENCE);
+    BOOST_REQUIRE_EQUAL(sequence.length(), legs);
+    for(size_t nLeg = 0; nLeg < legs; ++nLeg)
+    {
+      const Messages::CompactField & entry = sequence.entry(nLeg);
+      BOOST_CHECK_EQUAL(entry.name(), "Legs");
+      BOOST_REQUIRE_EQUAL(entry.fieldCount(), 2);
+      BOOST_CHECK_EQUAL(entry.field(0).toString(), nLeg % 2 == 0 ? std::string("IBM") : longText);
+      BOOST_CHECK_EQUAL(entry.field(1).toUInt64(), 100 * (nLeg + 1));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testCompactMessage)
+{
+  BOOST_CHECK_EQUAL(sizeof(Messages::CompactField), 32);
+
+  Codecs::XMLTemplateParser parser;
+  std::stringstream templateStream(compactTemplates);
+  Codecs::TemplateRegistryPtr templateRegistry = parser.parse(templateStream);
+  BOOST_REQUIRE(templateRegistry);
+
+  std::string fast;
+  {
+    Codecs::Encoder encoder(templateRegistry);
+    encodeTrade(encoder, fast, 1, 3);
+    encodeTrade(encoder, fast, 2, 0);
+    encodeTrade(encoder, fast, 3, 5);
+  }
+
+  Codecs::Decoder decoder(templateRegistry);
+  Codecs::DataSourceString source(fast);
+  KeepingConsumer consumer;
+  Codecs::CompactMessageBuilder builder(consumer);
+  decoder.decodeMessage(source, builder);
+  decoder.decodeMessage(source, builder);
+  decoder.decodeMessage(source, builder);
+  BOOST_CHECK_EQUAL(source.bytesAvailable(), 0);
+
+  // Messages that were kept are not disturbed by later decoding.
+  BOOST_REQUIRE_EQUAL(consumer.messages_.size(), 3);
+  checkTrade(*consumer.messages_[0], 1, 3);
+  checkTrade(*consumer.messages_[1], 2, 0);
+  checkTrade(*consumer.messages_[2], 3, 5);
+}
+
+BOOST_AUTO_TEST_CASE(testCompactMessageOverflow)
+{
+  // More fields than the builder was told to expect.
+  KeepingConsumer consumer;
+  Codecs::CompactMessageBuilder builder(consumer);
+  std::string type("type");
+  Messages::ValueMessageBuilder & body = builder.startMessage(type, "", 1);
+  body.addValue(identity_SeqNum, ValueType::UINT32, uint32(1));
+  body.addValue(identity_Text, ValueType::ASCII,
+    reinterpret_cast<const unsigned char *>(longText.data()), longText.size());
+  Messages::ValueMessageBuilder & group = body.startGroup(identity_Header, type, "", 1);
+  for(uint32 sender = 0; sender < 10; ++sender)
+  {
+    group.addValue(identity_Sender, ValueType::UINT32, sender);
+  }
+  body.endGroup(identity_Header, group);
+  body.addValue(identity_Change, ValueType::INT64, int64(-1));
+  BOOST_CHECK(builder.endMessage(body));
+
+  BOOST_REQUIRE_EQUAL(consumer.messages_.size(), 1);
+  const Messages::CompactMessage & message = *consumer.messages_[0];
+  BOOST_CHECK_EQUAL(message.getApplicationType(), "type");
+  BOOST_REQUIRE_EQUAL(message.size(), 4);
+  BOOST_CHECK_EQUAL(message[0].toUInt64(), 1);
+  BOOST_CHECK_EQUAL(message[1].toString(), longText);
+  BOOST_REQUIRE_EQUAL(message[2].fieldCount(), 10);
+  for(uint32 sender = 0; sender < 10; ++sender)
+  {
+    BOOST_CHECK_EQUAL(message[2].field(sender).toUInt64(), sender);
+  }
+  BOOST_CHECK_EQUAL(message[3].toInt64(), -1);
+}
@@ -0,0 +1,257 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/XMLTemplateParser.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Template.h>
+#include <Codecs/FieldInstructionDecimal.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/DataSourceString.h>
+#include <Codecs/SingleMessageConsumer.h>
+#include <Codecs/GenericMessageBuilder.h>
+
+#include <Messages/Message.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldDecimal.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  const char decimalTemplates[] =
+    "<templates>"
+    "  <template name=\"Quote\" id=\"1\">"
+    "    <decimal name=\"Price\">"
+    "      <exponent><copy/></exponent>"
+    "      <mantissa><delta/></mantissa>"
+    "    </decimal>"
+    "    <decimal name=\"Yield\" presence=\"optional\">"
+    "      <exponent><default value=\"-2\"/></exponent>"
+    "      <mantissa><copy/></mantissa>"
+    "    </decimal>"
+    "    <decimal name=\"Size\"><copy/></decimal>"
+    "  </template>"
+    "</templates>";
+
+  Messages::FieldIdentity identity_Price("Price");
+  Messages::FieldIdentity identity_Yield("Yield");
+  Messages::FieldIdentity identity_Size("Size");
+
+  struct Quote
+  {
+    mantissa_t price;
+    exponent_t priceExponent;
+    bool hasYield;
+    mantissa_t yield;
+    mantissa_t size;
+  };
+
+  const Quote quotes[] = {
+    {12345, -2, true, 475, 100},
+    {12350, -2, true, 475, 100},
+    {1234, -1, false, 0, 200},
+    {123475, -3, true, 13, 200}
+  };
+  const size_t quoteCount = sizeof(quotes) / sizeof(quotes[0]);
+
+  void encodeQuotes(Codecs::TemplateRegistryPtr & templateRegistry, std::string & fast)
+  {
+    Codecs::Encoder encoder(templateRegistry);
+    Codecs::DataDestination destination;
+    for(size_t nQuote = 0; nQuote < quoteCount; ++nQuote)
+    {
+      const Quote & quote = quotes[nQuote];
+      Messages::Message msg(3);
+      msg.addField(identity_Price, Messages::FieldDecimal::create(Decimal(quote.price, quote.priceExponent, false)));
+      if(quote.hasYield)
+      {
+        msg.addField(identity_Yield, Messages::FieldDecimal::create(Decimal(quote.yield, -2, false)));
+      }
+      msg.addField(identity_Size, Messages::FieldDecimal::create(Decimal(quote.size, 0, false)));
+      encoder.encodeMessage(destination, 1, msg);
+    }
+    destination.toString(fast);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testFusedDecimalDecoding)
+{
+  Codecs::XMLTemplateParser parser;
+  std::stringstream templateStream(decimalTemplates);
+  Codecs::TemplateRegistryPtr templateRegistry = parser.parse(templateStream);
+  BOOST_REQUIRE(templateRegistry);
+  std::string fast;
+  encodeQuotes(templateRegistry, fast);
+
+  Codecs::Decoder decoder(templateRegistry);
+  Codecs::DataSourceString source(fast);
+  Codecs::SingleMessageConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+  for(size_t nQuote = 0; nQuote < quoteCount; ++nQuote)
+  {
+    const Quote & quote = quotes[nQuote];
+    decoder.decodeMessage(source, builder);
+    Messages::Message & msgOut(consumer.message());
+    Messages::FieldCPtr value;
+    BOOST_REQUIRE(msgOut.getField("Price", value));
+    BOOST_CHECK_EQUAL(value->toDecimal(), Decimal(quote.price, quote.priceExponent));
+    BOOST_CHECK_EQUAL(msgOut.getField("Yield", value), quote.hasYield);
+    if(quote.hasYield)
+    {
+      BOOST_CHECK_EQUAL(value->toDecimal(), Decimal(quote.yield, -2));
+    }
+    BOOST_REQUIRE(msgOut.getField("Size", value));
+    BOOST_CHECK_EQUAL(value->toDecimal(), Decimal(quote.size, 0));
+  }
+  BOOST_CHECK_EQUAL(source.bytesAvailable(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(testFixedPointDecimalDecoding)
+{
+  Codecs::XMLTemplateParser parser;
+  std::stringstream templateStream(decimalTemplates);
+  Codecs::TemplateRegistryPtr templateRegistry = parser.parse(templateStream);
+  BOOST_REQUIRE(templateRegistry);
+  std::string fast;
+  encodeQuotes(templateRegistry, fast);
+
+  Codecs::TemplatePtr quoteTemplate;
+  BOOST_REQUIRE(templateRegistry->findNamedTemplate("Quote", "", quoteTemplate));
+  const char * names[] = {"Price", "Size"};
+  for(size_t nName = 0; nName < 2; ++nName)
+  {
+    Codecs::FieldInstructionPtr instruction;
+    BOOST_REQUIRE(quoteTemplate->getMutableInstruction(names[nName], instruction));
+    Codecs::FieldInstructionDecimal * decimal =
+      dynamic_cast<Codecs::FieldInstructionDecimal *>(instruction.get());
+    BOOST_REQUIRE(decimal != 0);
+    decimal->setFixedPointExponent(-4);
+    exponent_t exponent = 0;
+    BOOST_CHECK(decimal->getFixedPointExponent(exponent));
+    BOOST_CHECK_EQUAL(exponent, -4);
+  }
+
+  Codecs::Decoder decoder(templateRegistry);
+  Codecs::DataSourceString source(fast);
+  Codecs::SingleMessageConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+  const int64 expectedPrice[] = {1234500, 1235000, 1234000, 1234750};
+  for(size_t nQuote = 0; nQuote < quoteCount; ++nQuote)
+  {
+    decoder.decodeMessage(source, builder);
+    Messages::Message & msgOut(consumer.message());
+    Messages::FieldCPtr value;
+    BOOST_REQUIRE(msgOut.getField("Price", value));
+    BOOST_CHECK_EQUAL(value->toInt64(), expectedPrice[nQuote]);
+    BOOST_REQUIRE(msgOut.getField("Size", value));
+    BOOST_CHECK_EQUAL(value->toInt64(), int64(quotes[nQuote].size) * 10000);
+    // not converted
+    if(msgOut.getField("Yield", value))
+    {
+      BOOST_CHECK_EQUAL(value->getType(), ValueType::DECIMAL);
+    }
+  }
+}
+
+namespace
+{
+  const char fixedPointTemplates[] =
+    "<templates>"
+    "  <template name=\"Trade\" id=\"2\">"
+    "    <decimal name=\"Price\" fixed_point_exponent=\"-2\">"
+    "      <exponent><copy/></exponent>"
+    "      <mantissa><delta/></mantissa>"
+    "    </decimal>"
+    "  </template>"
+    "</templates>";
+
+  class ErrorCountingDecoder : public Codecs::Decoder
+  {
+  public:
+    explicit ErrorCountingDecoder(Codecs::TemplateRegistryPtr registry)
+      : Codecs::Decoder(registry)
+    {
+    }
+
+    using Codecs::Decoder::reportError;
+    virtual void reportError(
+      const std::string & errorCode,
+      const std::string & /*message*/,
+      const Messages::FieldIdentity & /*identity*/)
+    {
+      errors_.push_back(errorCode);
+    }
+
+    std::vector<std::string> errors_;
+  };
+}
+
+BOOST_AUTO_TEST_CASE(testFixedPointDecimalErrors)
+{
+  Codecs::XMLTemplateParser parser;
+  std::stringstream templateStream(fixedPointTemplates);
+  Codecs::TemplateRegistryPtr templateRegistry = parser.parse(templateStream);
+  BOOST_REQUIRE(templateRegistry);
+
+  const Decimal prices[] = {
+    Decimal(12345, -2, false),
+    Decimal(123475, -3, false),       // loses a digit
+    Decimal(LLONG_MAX / 10, 0, false), // overflows
+    Decimal(0, 63, false)             // zero at any scale is zero
+  };
+  Codecs::Encoder encoder(templateRegistry);
+  Codecs::DataDestination destination;
+  for(size_t nPrice = 0; nPrice < sizeof(prices) / sizeof(prices[0]); ++nPrice)
+  {
+    Messages::Message msg(1);
+    msg.addField(identity_Price, Messages::FieldDecimal::create(prices[nPrice]));
+    encoder.encodeMessage(destination, 2, msg);
+  }
+  std::string fast;
+  destination.toString(fast);
+
+  // by default errors throw
+  {
+    Codecs::Decoder decoder(templateRegistry);
+    Codecs::DataSourceString source(fast);
+    Codecs::SingleMessageConsumer consumer;
+    Codecs::GenericMessageBuilder builder(consumer);
+    decoder.decodeMessage(source, builder);
+    BOOST_CHECK_THROW(decoder.decodeMessage(source, builder), EncodingError);
+  }
+
+  ErrorCountingDecoder decoder(templateRegistry);
+  Codecs::DataSourceString source(fast);
+  Codecs::SingleMessageConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+  Messages::FieldCPtr value;
+
+  decoder.decodeMessage(source, builder);
+  BOOST_REQUIRE(consumer.message().getField("Price", value));
+  BOOST_CHECK_EQUAL(value->toInt64(), 12345);
+  BOOST_CHECK(decoder.errors_.empty());
+
+  decoder.decodeMessage(source, builder);
+  BOOST_REQUIRE(consumer.message().getField("Price", value));
+  BOOST_CHECK_EQUAL(value->toInt64(), 12347);
+  BOOST_REQUIRE_EQUAL(decoder.errors_.size(), 1);
+  BOOST_CHECK_EQUAL(decoder.errors_[0], "[ERR U12]");
+
+  decoder.decodeMessage(source, builder);
+  BOOST_REQUIRE(consumer.message().getField("Price", value));
+  BOOST_CHECK_EQUAL(value->toInt64(), LLONG_MAX);
+  BOOST_REQUIRE_EQUAL(decoder.errors_.size(), 2);
+  BOOST_CHECK_EQUAL(decoder.errors_[1], "[ERR R4]");
+
+  decoder.decodeMessage(source, builder);
+  BOOST_REQUIRE(consumer.message().getField("Price", value));
+  BOOST_CHECK_EQUAL(value->toInt64(), 0);
+  BOOST_CHECK_EQUAL(decoder.errors_.size(), 2u);
+}
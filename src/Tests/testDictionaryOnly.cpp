@@ -0,0 +1,209 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/XMLTemplateParser.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/DataSourceString.h>
+#include <Codecs/SingleMessageConsumer.h>
+#include <Codecs/GenericMessageBuilder.h>
+
+#include <Messages/Message.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldAscii.h>
+#include <Messages/FieldDecimal.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  const char dictionaryOnlyTemplates[] =
+    "<templates>"
+    "  <template name=\"Quote\" id=\"1\">"
+    "    <string name=\"Symbol\">"
+    "      <copy/>"
+    "    </string>"
+    "    <uInt32 name=\"Size\">"
+    "      <increment/>"
+    "    </uInt32>"
+    "  </template>"
+    "  <template name=\"Heartbeat\" id=\"2\">"
+    "    <uInt32 name=\"SeqNum\"/>"
+    "    <string name=\"Text\"/>"
+    "  </template>"
+    "  <template name=\"Trade\" id=\"3\">"
+    "    <decimal name=\"Price\">"
+    "      <exponent><copy/></exponent>"
+    "      <mantissa><delta/></mantissa>"
+    "    </decimal>"
+    "  </template>"
+    "</templates>";
+
+  Messages::FieldIdentity identity_Symbol("Symbol");
+  Messages::FieldIdentity identity_Size("Size");
+  Messages::FieldIdentity identity_SeqNum("SeqNum");
+  Messages::FieldIdentity identity_Text("Text");
+  Messages::FieldIdentity identity_Price("Price");
+
+  size_t encodeQuote(Codecs::Encoder & encoder, std::string & fast, const std::string & symbol, uint32 size)
+  {
+    Messages::Message msg(2);
+    msg.addField(identity_Symbol, Messages::FieldAscii::create(symbol));
+    msg.addField(identity_Size, Messages::FieldUInt32::create(size));
+    Codecs::DataDestination destination;
+    encoder.encodeMessage(destination, 1, msg);
+    std::string encoded;
+    destination.toString(encoded);
+    fast += encoded;
+    return encoded.size();
+  }
+
+  size_t encodeHeartbeat(Codecs::Encoder & encoder, std::string & fast, uint32 seqNum)
+  {
+    Messages::Message msg(2);
+    msg.addField(identity_SeqNum, Messages::FieldUInt32::create(seqNum));
+    msg.addField(identity_Text, Messages::FieldAscii::create("still here"));
+    Codecs::DataDestination destination;
+    encoder.encodeMessage(destination, 2, msg);
+    std::string encoded;
+    destination.toString(encoded);
+    fast += encoded;
+    return encoded.size();
+  }
+
+  size_t encodeTrade(Codecs::Encoder & encoder, std::string & fast, mantissa_t price)
+  {
+    Messages::Message msg(1);
+    msg.addField(identity_Price, Messages::FieldDecimal::create(Decimal(price, -2, false)));
+    Codecs::DataDestination destination;
+    encoder.encodeMessage(destination, 3, msg);
+    std::string encoded;
+    destination.toString(encoded);
+    fast += encoded;
+    return encoded.size();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testDictionaryOnly)
+{
+  Codecs::XMLTemplateParser parser;
+  std::stringstream templateStream(dictionaryOnlyTemplates);
+  Codecs::TemplateRegistryPtr templateRegistry = parser.parse(templateStream);
+  BOOST_REQUIRE(templateRegistry);
+
+  Codecs::Encoder encoder(templateRegistry);
+  std::string fast;
+  std::vector<size_t> sizes;
+  sizes.push_back(encodeQuote(encoder, fast, "IBM", 100));
+  sizes.push_back(encodeHeartbeat(encoder, fast, 1));
+  sizes.push_back(encodeQuote(encoder, fast, "IBM", 101));
+  sizes.push_back(encodeHeartbeat(encoder, fast, 2));
+  // The symbol is omitted from the stream. The decoder finds it in the dictionary.
+  sizes.push_back(encodeQuote(encoder, fast, "IBM", 102));
+
+  Codecs::Decoder decoder(templateRegistry);
+  decoder.setDictionaryOnly(1);
+  decoder.setDictionaryOnly(2);
+  BOOST_CHECK(decoder.isDictionaryOnly(1));
+  BOOST_CHECK(decoder.isDictionaryOnly(2));
+
+  Codecs::DataSourceString source(fast);
+  Codecs::SingleMessageConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+
+  // nothing is delivered for suppressed templates
+  for(size_t nMessage = 0; nMessage < 4; ++nMessage)
+  {
+    decoder.decodeMessage(source, builder, sizes[nMessage]);
+  }
+  Messages::FieldCPtr value;
+  BOOST_CHECK(!consumer.message().getField("Symbol", value));
+  BOOST_CHECK(!consumer.message().getField("SeqNum", value));
+
+  decoder.setDictionaryOnly(1, false);
+  BOOST_CHECK(!decoder.isDictionaryOnly(1));
+  decoder.decodeMessage(source, builder, sizes[4]);
+  Messages::Message & msgOut(consumer.message());
+  BOOST_REQUIRE(msgOut.getField("Symbol", value));
+  BOOST_CHECK_EQUAL(value->toAscii(), "IBM");
+  BOOST_REQUIRE(msgOut.getField("Size", value));
+  BOOST_CHECK_EQUAL(value->toUInt32(), 102);
+  BOOST_CHECK_EQUAL(source.bytesAvailable(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(testDictionaryOnlyUnknownSize)
+{
+  Codecs::XMLTemplateParser parser;
+  std::stringstream templateStream(dictionaryOnlyTemplates);
+  Codecs::TemplateRegistryPtr templateRegistry = parser.parse(templateStream);
+  BOOST_REQUIRE(templateRegistry);
+
+  Codecs::Encoder encoder(templateRegistry);
+  std::string fast;
+  encodeHeartbeat(encoder, fast, 1);
+  encodeQuote(encoder, fast, "MSFT", 100);
+  encodeHeartbeat(encoder, fast, 2);
+  encodeQuote(encoder, fast, "MSFT", 101);
+
+  // Without the message size every message must be decoded to find the next one.
+  Codecs::Decoder decoder(templateRegistry);
+  decoder.setDictionaryOnly(2);
+  Codecs::DataSourceString source(fast);
+  Codecs::SingleMessageConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+
+  Messages::FieldCPtr value;
+  decoder.decodeMessage(source, builder);
+  decoder.decodeMessage(source, builder);
+  BOOST_REQUIRE(consumer.message().getField("Size", value));
+  BOOST_CHECK_EQUAL(value->toUInt32(), 100);
+  decoder.decodeMessage(source, builder);
+  decoder.decodeMessage(source, builder);
+  BOOST_REQUIRE(consumer.message().getField("Symbol", value));
+  BOOST_CHECK_EQUAL(value->toAscii(), "MSFT");
+  BOOST_REQUIRE(consumer.message().getField("Size", value));
+  BOOST_CHECK_EQUAL(value->toUInt32(), 101);
+  BOOST_CHECK(!consumer.message().getField("SeqNum", value));
+}
+
+BOOST_AUTO_TEST_CASE(testDictionaryOnlySplitDecimal)
+{
+  Codecs::XMLTemplateParser parser;
+  std::stringstream templateStream(dictionaryOnlyTemplates);
+  Codecs::TemplateRegistryPtr templateRegistry = parser.parse(templateStream);
+  BOOST_REQUIRE(templateRegistry);
+
+  Codecs::Encoder encoder(templateRegistry);
+  std::string fast;
+  std::vector<size_t> sizes;
+  sizes.push_back(encodeTrade(encoder, fast, 12345));
+  sizes.push_back(encodeTrade(encoder, fast, 12350));
+  // Only the change in mantissa is sent. The exponent is copied.
+  sizes.push_back(encodeTrade(encoder, fast, 12360));
+
+  // The exponent and mantissa operators update the dictionary, so the
+  // suppressed messages must be decoded rather than skipped.
+  Codecs::Decoder decoder(templateRegistry);
+  decoder.setDictionaryOnly(3);
+  Codecs::DataSourceString source(fast);
+  Codecs::SingleMessageConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+  decoder.decodeMessage(source, builder, sizes[0]);
+  decoder.decodeMessage(source, builder, sizes[1]);
+  Messages::FieldCPtr value;
+  BOOST_CHECK(!consumer.message().getField("Price", value));
+
+  decoder.setDictionaryOnly(3, false);
+  decoder.decodeMessage(source, builder, sizes[2]);
+  BOOST_REQUIRE(consumer.message().getField("Price", value));
+  BOOST_CHECK_EQUAL(value->toDecimal(), Decimal(12360, -2, false));
+  BOOST_CHECK_EQUAL(source.bytesAvailable(), 0);
+}
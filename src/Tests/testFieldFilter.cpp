@@ -0,0 +1,230 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/XMLTemplateParser.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Template.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/FieldFilter.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/DataSourceString.h>
+#include <Codecs/SingleMessageConsumer.h>
+#include <Codecs/GenericMessageBuilder.h>
+
+#include <Messages/Message.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldInt32.h>
+#include <Messages/FieldAscii.h>
+#include <Messages/FieldByteVector.h>
+#include <Messages/FieldSequence.h>
+#include <Messages/Sequence.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  const char filterTemplates[] =
+    "<templates>"
+    "  <template name=\"Definition\" id=\"1\">"
+    "    <uInt32 name=\"SecurityID\" id=\"48\"/>"
+    "    <string name=\"Symbol\" id=\"55\"/>"
+    "    <string name=\"Description\" id=\"107\">"
+    "      <copy/>"
+    "    </string>"
+    "    <byteVector name=\"Payload\" presence=\"optional\"/>"
+    "    <int32 name=\"Price\" id=\"44\">"
+    "      <delta/>"
+    "    </int32>"
+    "    <sequence name=\"Entries\">"
+    "      <length name=\"NoEntries\" id=\"268\"/>"
+    "      <uInt32 name=\"EntryType\" id=\"269\">"
+    "        <copy/>"
+    "      </uInt32>"
+    "      <int32 name=\"EntryPx\" id=\"270\"/>"
+    "      <string name=\"EntryText\"/>"
+    "    </sequence>"
+    "  </template>"
+    "</templates>";
+
+  Messages::FieldIdentity identity_SecurityID("SecurityID");
+  Messages::FieldIdentity identity_Symbol("Symbol");
+  Messages::FieldIdentity identity_Description("Description");
+  Messages::FieldIdentity identity_Payload("Payload");
+  Messages::FieldIdentity identity_Price("Price");
+  Messages::FieldIdentity identity_Entries("Entries");
+  Messages::FieldIdentity identity_NoEntries("NoEntries");
+  Messages::FieldIdentity identity_EntryType("EntryType");
+  Messages::FieldIdentity identity_EntryPx("EntryPx");
+  Messages::FieldIdentity identity_EntryText("EntryText");
+
+  void addEntry(Messages::SequencePtr & sequence, uint32 type, int32 px, const std::string & text)
+  {
+    Messages::FieldSetPtr entry(new Messages::FieldSet(3));
+    entry->addField(identity_EntryType, Messages::FieldUInt32::create(type));
+    entry->addField(identity_EntryPx, Messages::FieldInt32::create(px));
+    entry->addField(identity_EntryText, Messages::FieldAscii::create(text));
+    sequence->addEntry(Messages::FieldSetCPtr(entry));
+  }
+
+  void encodeMessage(
+    Codecs::Encoder & encoder,
+    Codecs::DataDestination & destination,
+    uint32 securityId,
+    int32 price,
+    int32 entryBase)
+  {
+    Messages::Message msg(6);
+    msg.addField(identity_SecurityID, Messages::FieldUInt32::create(securityId));
+    msg.addField(identity_Symbol, Messages::FieldAscii::create("SYMBOL"));
+    msg.addField(identity_Description, Messages::FieldAscii::create("A long description that nobody reads"));
+    msg.addField(identity_Payload, Messages::FieldByteVector::create("\x01\x02\x03\x04"));
+    msg.addField(identity_Price, Messages::FieldInt32::create(price));
+    Messages::SequencePtr entries(new Messages::Sequence(identity_NoEntries, 2));
+    addEntry(entries, 0, entryBase, "bid");
+    addEntry(entries, 1, entryBase + 1, "offer");
+    msg.addField(identity_Entries, Messages::FieldSequence::create(entries));
+    encoder.encodeMessage(destination, 1, msg);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testFieldFilter)
+{
+  Codecs::XMLTemplateParser parser;
+  std::stringstream templateStream(filterTemplates);
+  Codecs::TemplateRegistryPtr templateRegistry = parser.parse(templateStream);
+  BOOST_REQUIRE(templateRegistry);
+
+  Codecs::Encoder encoder(templateRegistry);
+  Codecs::DataDestination destination;
+  encodeMessage(encoder, destination, 1001, 12345, 100);
+  encodeMessage(encoder, destination, 1002, 12340, 200);
+  std::string fastString;
+  destination.toString(fastString);
+
+  Codecs::FieldFilterPtr filter(new Codecs::FieldFilter);
+  filter->selectField(1, "SecurityID");
+  filter->selectFieldId(1, "44"); // Price
+  filter->selectField(1, "EntryPx");
+
+  Codecs::Decoder decoder(templateRegistry);
+  decoder.setFieldFilter(filter);
+  Codecs::DataSourceString source(fastString);
+  Codecs::SingleMessageConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+
+  Messages::FieldCPtr value;
+  for(int32 nMessage = 0; nMessage < 2; ++nMessage)
+  {
+    decoder.decodeMessage(source, builder);
+    Messages::Message & msgOut(consumer.message());
+
+    BOOST_CHECK(msgOut.getField("SecurityID", value));
+    BOOST_CHECK_EQUAL(value->toUInt32(), uint32(1001 + nMessage));
+    BOOST_CHECK(msgOut.getField("Price", value));
+    BOOST_CHECK_EQUAL(value->toInt32(), 12345 - 5 * nMessage);
+
+    BOOST_CHECK(!msgOut.getField("Symbol", value));
+    BOOST_CHECK(!msgOut.getField("Description", value));
+    BOOST_CHECK(!msgOut.getField("Payload", value));
+
+    BOOST_REQUIRE(msgOut.getField("Entries", value));
+    const Messages::SequenceCPtr & entries = value->toSequence();
+    BOOST_REQUIRE_EQUAL(entries->size(), 2);
+    for(size_t nEntry = 0; nEntry < entries->size(); ++nEntry)
+    {
+      Messages::FieldSetCPtr entry = (*entries)[nEntry];
+      BOOST_CHECK(entry->getField("EntryPx", value));
+      BOOST_CHECK_EQUAL(value->toInt32(), int32(100 * (nMessage + 1) + nEntry));
+      BOOST_CHECK(!entry->getField("EntryType", value));
+      BOOST_CHECK(!entry->getField("EntryText", value));
+    }
+  }
+
+  // Without a filter all fields are delivered.
+  Codecs::Decoder fullDecoder(templateRegistry);
+  Codecs::DataSourceString fullSource(fastString);
+  fullDecoder.decodeMessage(fullSource, builder);
+  Messages::Message & fullOut(consumer.message());
+  BOOST_CHECK(fullOut.getField("Symbol", value));
+  BOOST_CHECK_EQUAL(value->toAscii(), "SYMBOL");
+  BOOST_CHECK(fullOut.getField("Description", value));
+}
+
+BOOST_AUTO_TEST_CASE(testFieldFilterWholeSequence)
+{
+  Codecs::XMLTemplateParser parser;
+  std::stringstream templateStream(filterTemplates);
+  Codecs::TemplateRegistryPtr templateRegistry = parser.parse(templateStream);
+  BOOST_REQUIRE(templateRegistry);
+
+  Codecs::Encoder encoder(templateRegistry);
+  Codecs::DataDestination destination;
+  encodeMessage(encoder, destination, 1001, 12345, 100);
+  encodeMessage(encoder, destination, 1002, 12340, 200);
+  std::string fastString;
+  destination.toString(fastString);
+
+  Codecs::FieldFilterPtr filter(new Codecs::FieldFilter);
+  filter->selectField(1, "Entries");
+
+  Codecs::Decoder decoder(templateRegistry);
+  decoder.setFieldFilter(filter);
+  Codecs::DataSourceString source(fastString);
+  Codecs::SingleMessageConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+
+  Messages::FieldCPtr value;
+  decoder.decodeMessage(source, builder);
+  decoder.decodeMessage(source, builder);
+  Messages::Message & msgOut(consumer.message());
+  BOOST_CHECK(!msgOut.getField("SecurityID", value));
+  BOOST_CHECK(!msgOut.getField("Price", value));
+  BOOST_REQUIRE(msgOut.getField("Entries", value));
+  const Messages::SequenceCPtr & entries = value->toSequence();
+  BOOST_REQUIRE_EQUAL(entries->size(), 2);
+  Messages::FieldSetCPtr entry = (*entries)[1];
+  BOOST_CHECK(entry->getField("EntryType", value));
+  BOOST_CHECK_EQUAL(value->toUInt32(), 1);
+  BOOST_CHECK(entry->getField("EntryText", value));
+  BOOST_CHECK_EQUAL(value->toAscii(), "offer");
+}
+
+BOOST_AUTO_TEST_CASE(testFieldFilterFinalizeIsACopy)
+{
+  Codecs::XMLTemplateParser parser;
+  std::stringstream firstStream(filterTemplates);
+  Codecs::TemplateRegistryPtr first = parser.parse(firstStream);
+  BOOST_REQUIRE(first);
+  std::stringstream secondStream(filterTemplates);
+  Codecs::TemplateRegistryPtr second = parser.parse(secondStream);
+  BOOST_REQUIRE(second);
+
+  Codecs::FieldFilterPtr filter(new Codecs::FieldFilter);
+  filter->selectField(1, "SecurityID");
+
+  // Decoders that share a filter each index it for their own templates
+  // without changing the filter the other one is using.
+  Codecs::FieldFilterCPtr firstIndex = filter->finalize(*first);
+  Codecs::FieldFilterCPtr secondIndex = filter->finalize(*second);
+  BOOST_CHECK(firstIndex != secondIndex);
+
+  Codecs::TemplateCPtr firstTemplate;
+  BOOST_REQUIRE(first->getTemplate(1, firstTemplate));
+  Codecs::TemplateCPtr secondTemplate;
+  BOOST_REQUIRE(second->getTemplate(1, secondTemplate));
+
+  BOOST_REQUIRE(filter->getSelection(1) != 0);
+  BOOST_CHECK(filter->getSelection(1)->dispositions(*firstTemplate) == 0);
+  BOOST_REQUIRE(firstIndex->getSelection(1) != 0);
+  BOOST_CHECK(firstIndex->getSelection(1)->dispositions(*firstTemplate) != 0);
+  BOOST_CHECK(firstIndex->getSelection(1)->dispositions(*secondTemplate) == 0);
+  BOOST_REQUIRE(secondIndex->getSelection(1) != 0);
+  BOOST_CHECK(secondIndex->getSelection(1)->dispositions(*secondTemplate) != 0);
+}
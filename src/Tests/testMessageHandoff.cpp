@@ -0,0 +1,175 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/XMLTemplateParser.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/DataSourceString.h>
+#include <Codecs/GenericMessageBuilder.h>
+#include <Codecs/MessageHandoff.h>
+
+#include <Messages/MessagePool.h>
+#include <Messages/Message.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldAscii.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  const char handoffTemplates[] =
+    "<templates>"
+    "  <template name=\"Quote\" id=\"1\">"
+    "    <uInt32 name=\"SeqNum\"/>"
+    "    <string name=\"Symbol\"/>"
+    "  </template>"
+    "</templates>";
+
+  Messages::FieldIdentity identity_SeqNum("SeqNum");
+  Messages::FieldIdentity identity_Symbol("Symbol");
+
+  class QuietLogger : public Common::Logger
+  {
+  public:
+    virtual bool wantLog(unsigned short /*level*/){return false;}
+    virtual bool logMessage(unsigned short /*level*/, const std::string & /*logMessage*/){return true;}
+    virtual bool reportDecodingError(const std::string & /*errorMessage*/){return false;}
+    virtual bool reportCommunicationError(const std::string & /*errorMessage*/){return false;}
+  };
+
+  Messages::MessagePtr makeQuote(uint32 seqNum)
+  {
+    Messages::MessagePtr message(new Messages::Message(2));
+    message->addField(identity_SeqNum, Messages::FieldUInt32::create(seqNum));
+    message->addField(identity_Symbol, Messages::FieldAscii::create("IBM"));
+    return message;
+  }
+
+  uint32 seqNumOf(const Messages::MessagePtr & message)
+  {
+    Messages::FieldCPtr field;
+    BOOST_REQUIRE(message->getField(identity_SeqNum, field));
+    return field->toUInt32();
+  }
+
+  void decodeAll(
+    Codecs::Decoder & decoder,
+    Codecs::DataSourceString & source,
+    Codecs::GenericMessageBuilder & builder,
+    Codecs::MessageHandoff & handoff)
+  {
+    handoff.decodingStarted();
+    while(source.bytesAvailable() > 0)
+    {
+      decoder.decodeMessage(source, builder);
+    }
+    handoff.decodingStopped();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testMessageHandoffPolicies)
+{
+  QuietLogger logger;
+  {
+    Codecs::MessageHandoff handoff(4, Codecs::MessageHandoff::COUNT_AND_DROP, logger);
+    BOOST_CHECK_EQUAL(handoff.capacity(), 4);
+    for(uint32 seqNum = 1; seqNum <= 6; ++seqNum)
+    {
+      handoff.consumeSharedMessage(makeQuote(seqNum));
+    }
+    BOOST_CHECK_EQUAL(handoff.size(), 4);
+    BOOST_CHECK_EQUAL(handoff.dropped(), 2);
+    Messages::MessagePtr message;
+    for(uint32 seqNum = 1; seqNum <= 4; ++seqNum)
+    {
+      BOOST_REQUIRE(handoff.pop(message));
+      BOOST_CHECK_EQUAL(seqNumOf(message), seqNum);
+    }
+    BOOST_CHECK(!handoff.pop(message));
+  }
+  {
+    Codecs::MessageHandoff handoff(3, Codecs::MessageHandoff::DROP_OLDEST, logger);
+    BOOST_CHECK_EQUAL(handoff.capacity(), 4);
+    for(uint32 seqNum = 1; seqNum <= 6; ++seqNum)
+    {
+      handoff.consumeSharedMessage(makeQuote(seqNum));
+    }
+    BOOST_CHECK_EQUAL(handoff.dropped(), 2);
+    Messages::MessagePtr message;
+    for(uint32 seqNum = 3; seqNum <= 6; ++seqNum)
+    {
+      BOOST_REQUIRE(handoff.pop(message));
+      BOOST_CHECK_EQUAL(seqNumOf(message), seqNum);
+    }
+    BOOST_CHECK(!handoff.pop(message));
+
+    // Messages that are not copied into the ring stay with the caller.
+    Messages::Message unshared(2);
+    unshared.addField(identity_SeqNum, Messages::FieldUInt32::create(7));
+    handoff.consumeMessage(unshared);
+    unshared.clear();
+    BOOST_REQUIRE(handoff.pop(message));
+    BOOST_CHECK_EQUAL(seqNumOf(message), 7);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testMessageHandoffThreads)
+{
+  Codecs::XMLTemplateParser parser;
+  std::stringstream templateStream(handoffTemplates);
+  Codecs::TemplateRegistryPtr templateRegistry = parser.parse(templateStream);
+  BOOST_REQUIRE(templateRegistry);
+
+  const uint32 messageCount = 5000;
+  std::string fast;
+  {
+    Codecs::Encoder encoder(templateRegistry);
+    for(uint32 seqNum = 1; seqNum <= messageCount; ++seqNum)
+    {
+      Messages::MessagePtr quote = makeQuote(seqNum);
+      Codecs::DataDestination destination;
+      encoder.encodeMessage(destination, 1, *quote);
+      std::string encoded;
+      destination.toString(encoded);
+      fast += encoded;
+    }
+  }
+
+  QuietLogger logger;
+  const size_t capacity = 16;
+  Codecs::MessageHandoff handoff(capacity, Codecs::MessageHandoff::BLOCK, logger);
+  handoff.setSpinCount(10);
+  Messages::MessagePoolPtr pool(new Messages::MessagePool);
+  Codecs::GenericMessageBuilder builder(handoff);
+  builder.setMessagePool(pool);
+  Codecs::Decoder decoder(templateRegistry);
+  Codecs::DataSourceString source(fast);
+
+  boost::thread decoding(boost::bind(decodeAll,
+    boost::ref(decoder), boost::ref(source), boost::ref(builder), boost::ref(handoff)));
+
+  uint32 expected = 1;
+  Messages::MessagePtr message;
+  while(handoff.popWait(message))
+  {
+    BOOST_REQUIRE_EQUAL(seqNumOf(message), expected);
+    ++expected;
+    message.reset();
+  }
+  decoding.join();
+  BOOST_CHECK_EQUAL(expected, messageCount + 1);
+  BOOST_CHECK_EQUAL(handoff.dropped(), 0);
+
+  // Nothing is lost with BLOCK, and the messages were recycled rather than
+  // allocated: no more exist than fit in the ring plus the ones in hand.
+  BOOST_CHECK(pool->created() <= capacity + 2);
+  BOOST_CHECK_EQUAL(pool->idle(), pool->created());
+}
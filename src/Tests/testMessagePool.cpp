@@ -0,0 +1,224 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/XMLTemplateParser.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/DataSourceString.h>
+#include <Codecs/GenericMessageBuilder.h>
+
+#include <Messages/MessagePool.h>
+#include <Messages/Message.h>
+#include <Messages/Group.h>
+#include <Messages/Sequence.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldAscii.h>
+#include <Messages/FieldGroup.h>
+#include <Messages/FieldSequence.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  const char poolTemplates[] =
+    "<templates>"
+    "  <template name=\"Order\" id=\"1\">"
+    "    <uInt32 name=\"SeqNum\"/>"
+    "    <string name=\"Symbol\"/>"
+    "    <group name=\"Header\">"
+    "      <typeRef name=\"Header\"/>"
+    "      <uInt32 name=\"Sender\"/>"
+    "    </group>"
+    "    <sequence name=\"Legs\">"
+    "      <length name=\"NoLegs\"/>"
+    "      <uInt32 name=\"LegQty\"/>"
+    "    </sequence>"
+    "  </template>"
+    "</templates>";
+
+  Messages::FieldIdentity identity_SeqNum("SeqNum");
+  Messages::FieldIdentity identity_Symbol("Symbol");
+  Messages::FieldIdentity identity_Header("Header");
+  Messages::FieldIdentity identity_Sender("Sender");
+  Messages::FieldIdentity identity_Legs("Legs");
+  Messages::FieldIdentity identity_NoLegs("NoLegs");
+  Messages::FieldIdentity identity_LegQty("LegQty");
+
+  void encodeOrder(Codecs::Encoder & encoder, std::string & fast, uint32 seqNum, size_t legs)
+  {
+    Messages::FieldSet msg(4);
+    msg.addField(identity_SeqNum, Messages::FieldUInt32::create(seqNum));
+    msg.addField(identity_Symbol, Messages::FieldAscii::create("IBM"));
+
+    Messages::GroupPtr header(new Messages::Group(1));
+    header->addField(identity_Sender, Messages::FieldUInt32::create(seqNum * 10));
+    msg.addField(identity_Header, Messages::FieldGroup::create(header));
+
+    Messages::SequencePtr sequence(new Messages::Sequence(identity_NoLegs, legs));
+    for(size_t nLeg = 0; nLeg < legs; ++nLeg)
+    {
+      Messages::FieldSetPtr leg(new Messages::FieldSet(1));
+      leg->addField(identity_LegQty, Messages::FieldUInt32::create(uint32(seqNum + nLeg)));
+      sequence->addEntry(leg);
+    }
+    msg.addField(identity_Legs, Messages::FieldSequence::create(sequence));
+
+    Codecs::DataDestination destination;
+    encoder.encodeMessage(destination, 1, msg);
+    std::string encoded;
+    destination.toString(encoded);
+    fast += encoded;
+  }
+
+  /// Holds on to the messages it is told to keep.
+  class HoldingConsumer : public Codecs::MessageConsumer
+  {
+  public:
+    HoldingConsumer()
+      : keep_(false)
+      , consumed_(0)
+    {
+    }
+    virtual bool consumeMessage(Messages::Message & /*message*/)
+    {
+      BOOST_FAIL("The shared form should be used.");
+      return false;
+    }
+    virtual bool consumeSharedMessage(const Messages::MessagePtr & message)
+    {
+      ++consumed_;
+      if(keep_)
+      {
+        kept_.push_back(message);
+      }
+      return true;
+    }
+    virtual void decodingStarted(){}
+    virtual void decodingStopped(){}
+    virtual bool wantLog(unsigned short /*level*/){return false;}
+    virtual bool logMessage(unsigned short /*level*/, const std::string & /*logMessage*/){return true;}
+    virtual bool reportDecodingError(const std::string & /*errorMessage*/){return false;}
+    virtual bool reportCommunicationError(const std::string & /*errorMessage*/){return false;}
+
+    bool keep_;
+    size_t consumed_;
+    std::vector<Messages::MessagePtr> kept_;
+  };
+
+  void checkOrder(const Messages::Message & message, uint32 seqNum, size_t legs)
+  {
+    Messages::FieldCPtr field;
+    BOOST_REQUIRE(message.getField("SeqNum", field));
+    BOOST_CHECK_EQUAL(field->toUInt32(), seqNum);
+    BOOST_REQUIRE(message.getField("Header", field));
+    Messages::GroupCPtr header = field->toGroup();
+    BOOST_REQUIRE(header->getField("Sender", field));
+    BOOST_CHECK_EQUAL(field->toUInt32(), seqNum * 10);
+    BOOST_REQUIRE(message.getField("Legs", field));
+    Messages::SequenceCPtr sequence = field->toSequence();
+    BOOST_REQUIRE_EQUAL(sequence->size(), legs);
+    for(size_t nLeg = 0; nLeg < legs; ++nLeg)
+    {
+      BOOST_REQUIRE((*sequence)[nLeg]->getField("LegQty", field));
+      BOOST_CHECK_EQUAL(field->toUInt32(), seqNum + nLeg);
+    }
+  }
+
+  Codecs::TemplateRegistryPtr parseTemplates()
+  {
+    Codecs::XMLTemplateParser parser;
+    std::stringstream templateStream(poolTemplates);
+    return parser.parse(templateStream);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testMessagePoolReuse)
+{
+  Codecs::TemplateRegistryPtr templateRegistry = parseTemplates();
+  BOOST_REQUIRE(templateRegistry);
+
+  const uint32 messageCount = 20;
+  std::string fast;
+  {
+    Codecs::Encoder encoder(templateRegistry);
+    for(uint32 seqNum = 1; seqNum <= messageCount; ++seqNum)
+    {
+      encodeOrder(encoder, fast, seqNum, 3);
+    }
+  }
+
+  Messages::MessagePoolPtr pool(new Messages::MessagePool);
+  HoldingConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+  builder.setMessagePool(pool);
+  Codecs::Decoder decoder(templateRegistry);
+  Codecs::DataSourceString source(fast);
+
+  // The first message fills the pool: one message, one group, one sequence, three entries.
+  decoder.decodeMessage(source, builder);
+  BOOST_CHECK_EQUAL(pool->created(), 6);
+  BOOST_CHECK_EQUAL(pool->idle(), 6);
+
+  // Messages that are not kept are built from the recycled objects.
+  for(uint32 seqNum = 2; seqNum <= 10; ++seqNum)
+  {
+    decoder.decodeMessage(source, builder);
+  }
+  BOOST_CHECK_EQUAL(pool->created(), 6);
+  BOOST_CHECK_EQUAL(pool->reused(), 9 * 6);
+
+  // Messages that are kept stay intact while more are decoded.
+  consumer.keep_ = true;
+  decoder.decodeMessage(source, builder);
+  decoder.decodeMessage(source, builder);
+  consumer.keep_ = false;
+  for(uint32 seqNum = 13; seqNum <= messageCount; ++seqNum)
+  {
+    decoder.decodeMessage(source, builder);
+  }
+  BOOST_CHECK_EQUAL(source.bytesAvailable(), 0);
+  BOOST_CHECK_EQUAL(consumer.consumed_, messageCount);
+  BOOST_REQUIRE_EQUAL(consumer.kept_.size(), 2);
+  checkOrder(*consumer.kept_[0], 11, 3);
+  checkOrder(*consumer.kept_[1], 12, 3);
+  BOOST_CHECK_EQUAL(pool->created(), 3 * 6);
+
+  // Releasing them returns everything to the pool.
+  consumer.kept_.clear();
+  BOOST_CHECK_EQUAL(pool->idle(), 3 * 6);
+}
+
+BOOST_AUTO_TEST_CASE(testMessagePoolOutlived)
+{
+  Codecs::TemplateRegistryPtr templateRegistry = parseTemplates();
+  BOOST_REQUIRE(templateRegistry);
+
+  std::string fast;
+  {
+    Codecs::Encoder encoder(templateRegistry);
+    encodeOrder(encoder, fast, 5, 2);
+  }
+
+  HoldingConsumer consumer;
+  consumer.keep_ = true;
+  {
+    Messages::MessagePoolPtr pool(new Messages::MessagePool(0));
+    Codecs::GenericMessageBuilder builder(consumer);
+    builder.setMessagePool(pool);
+    Codecs::Decoder decoder(templateRegistry);
+    Codecs::DataSourceString source(fast);
+    decoder.decodeMessage(source, builder);
+  }
+  // The pool and the builder are gone but the message is still good.
+  BOOST_REQUIRE_EQUAL(consumer.kept_.size(), 1);
+  checkOrder(*consumer.kept_[0], 5, 2);
+  consumer.kept_.clear();
+}
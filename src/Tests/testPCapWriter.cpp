@@ -0,0 +1,61 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+
+#include <Communication/PCapWriter.h>
+#include <Communication/PCapReader.h>
+
+using namespace QuickFAST;
+
+BOOST_AUTO_TEST_CASE(TestPCapWriterRoundTrip)
+{
+  std::string root (std::getenv ("QUICKFAST_ROOT"));
+  std::string fileName = root + "/src/Tests/resources/pcapWriterTest.out";
+  boost::filesystem::remove(fileName);
+
+  std::vector<std::string> packets;
+  packets.push_back(std::string("\xC0\x81\x83\x45\x53\xDA", 6));
+  packets.push_back(std::string(1400, '\x80'));
+  packets.push_back(std::string());
+  packets.push_back("final packet");
+
+  {
+    Communication::PCapWriter writer;
+    BOOST_REQUIRE(writer.open(fileName.c_str()));
+    writer.setAddresses(0x0A000002, 1234, 0xEF010203, 5678);
+    for(size_t nPacket = 0; nPacket < packets.size(); ++nPacket)
+    {
+      writer.write(
+        reinterpret_cast<const unsigned char *>(packets[nPacket].data()),
+        packets[nPacket].size(),
+        1262304000,
+        uint32(nPacket * 100));
+    }
+    BOOST_CHECK(writer.good());
+    // file header + per packet: record header, Ethernet, IP, UDP
+    size_t expected = 24;
+    for(size_t nPacket = 0; nPacket < packets.size(); ++nPacket)
+    {
+      expected += 16 + 14 + 20 + 8 + packets[nPacket].size();
+    }
+    BOOST_CHECK_EQUAL(writer.bytesWritten(), expected);
+    writer.close();
+  }
+
+  Communication::PCapReader reader;
+  reader.set32bit(true);
+  BOOST_REQUIRE(reader.open(fileName.c_str()));
+  for(size_t nPacket = 0; nPacket < packets.size(); ++nPacket)
+  {
+    const unsigned char * buffer = 0;
+    size_t size = 0;
+    BOOST_REQUIRE(reader.read(buffer, size));
+    BOOST_CHECK_EQUAL(std::string(reinterpret_cast<const char *>(buffer), size), packets[nPacket]);
+  }
+  boost::filesystem::remove(fileName);
+}
@@ -0,0 +1,132 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/XMLTemplateParser.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/PacketDestination.h>
+#include <Communication/Sender.h>
+#include <Communication/LinkedBuffer.h>
+
+#include <Messages/Message.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldAscii.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  const char packetTemplates[] =
+    "<templates>"
+    "  <template name=\"Status\" id=\"3\">"
+    "    <uInt32 name=\"SeqNum\"/>"
+    "    <string name=\"Text\"/>"
+    "  </template>"
+    "</templates>";
+
+  Messages::FieldIdentity identity_SeqNum("SeqNum");
+  Messages::FieldIdentity identity_Text("Text");
+
+  /// A Sender that remembers what it was asked to send.
+  class CapturingSender : public Communication::Sender
+  {
+  public:
+    CapturingSender(Communication::BufferRecycler & recycler)
+      : Sender(recycler)
+    {
+    }
+
+    virtual void open()
+    {
+    }
+
+    virtual void send(Communication::LinkedBuffer * buffer)
+    {
+      packets_.push_back(std::string(reinterpret_cast<const char *>(buffer->get()), buffer->used()));
+      recycle(buffer);
+    }
+
+    virtual void stop()
+    {
+    }
+
+    virtual void close()
+    {
+    }
+
+    std::vector<std::string> packets_;
+  };
+
+  void encodeStatus(Codecs::Encoder & encoder, Codecs::DataDestination & destination, uint32 seqNum)
+  {
+    Messages::Message msg(2);
+    msg.addField(identity_SeqNum, Messages::FieldUInt32::create(seqNum));
+    msg.addField(identity_Text, Messages::FieldAscii::create(std::string(seqNum % 7 + 3, 'x')));
+    encoder.encodeMessage(destination, 3, msg);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testPacketDestination)
+{
+  Codecs::XMLTemplateParser parser;
+  std::stringstream templateStream(packetTemplates);
+  Codecs::TemplateRegistryPtr templateRegistry = parser.parse(templateStream);
+  BOOST_REQUIRE(templateRegistry);
+
+  const size_t messageCount = 50;
+  const size_t maxPacketSize = 40;
+
+  // the expected stream of messages without packet boundaries
+  Codecs::Encoder referenceEncoder(templateRegistry);
+  Codecs::DataDestination reference;
+  for(uint32 seqNum = 0; seqNum < messageCount; ++seqNum)
+  {
+    encodeStatus(referenceEncoder, reference, seqNum);
+  }
+  std::string expected;
+  reference.toString(expected);
+
+  Codecs::PacketDestination destination(maxPacketSize);
+  CapturingSender sender(destination);
+  destination.setSender(sender);
+  destination.setSequenceNumber(1000);
+
+  Codecs::Encoder encoder(templateRegistry);
+  encoder.setSinglePass(true);
+  for(uint32 seqNum = 0; seqNum < messageCount; ++seqNum)
+  {
+    encodeStatus(encoder, destination, seqNum);
+    destination.packMessage();
+  }
+  destination.flush();
+
+  BOOST_REQUIRE(sender.packets_.size() > 1);
+  BOOST_CHECK_EQUAL(destination.packetCount(), sender.packets_.size());
+  // buffers are recycled by the sender, so only one is ever in use
+  BOOST_CHECK_EQUAL(destination.allocatedCount(), 1);
+
+  std::string actual;
+  for(size_t nPacket = 0; nPacket < sender.packets_.size(); ++nPacket)
+  {
+    const std::string & packet = sender.packets_[nPacket];
+    BOOST_CHECK(packet.size() <= maxPacketSize);
+    BOOST_REQUIRE(packet.size() > 4);
+    uint32 sequence =
+      (uint32(uchar(packet[0])) << 24) |
+      (uint32(uchar(packet[1])) << 16) |
+      (uint32(uchar(packet[2])) << 8) |
+      uint32(uchar(packet[3]));
+    BOOST_CHECK_EQUAL(sequence, 1000 + nPacket);
+    actual.append(packet, 4, std::string::npos);
+  }
+  // the template ID is only sent when it changes, so the packed
+  // stream must match the unpacked stream byte for byte.
+  BOOST_CHECK(actual == expected);
+}
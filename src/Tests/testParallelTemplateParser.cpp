@@ -0,0 +1,237 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/ParallelTemplateParser.h>
+#include <Codecs/XMLTemplateParser.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/DataSourceString.h>
+#include <Codecs/SingleMessageConsumer.h>
+#include <Codecs/GenericMessageBuilder.h>
+#include <Common/Exceptions.h>
+
+#include <Messages/Message.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldAscii.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  const char venueA[] =
+    "<templates dictionary=\"A\">"
+    "  <template name=\"Header\">"
+    "    <uInt32 name=\"SeqNum\">"
+    "      <increment/>"
+    "    </uInt32>"
+    "  </template>"
+    "  <template name=\"QuoteA\" id=\"1\">"
+    "    <templateRef name=\"Header\"/>"
+    "    <string name=\"Symbol\">"
+    "      <copy/>"
+    "    </string>"
+    "    <uInt32 name=\"Size\">"
+    "      <copy/>"
+    "    </uInt32>"
+    "  </template>"
+    "</templates>";
+
+  // Refers to a template from venue A.
+  const char venueB[] =
+    "<templates>"
+    "  <template name=\"QuoteB\" id=\"2\">"
+    "    <templateRef name=\"Header\"/>"
+    "    <string name=\"Symbol\">"
+    "      <copy/>"
+    "    </string>"
+    "  </template>"
+    "</templates>";
+
+  const char venueC[] =
+    "<templates>"
+    "  <template name=\"QuoteC\" id=\"3\">"
+    "    <string name=\"Symbol\">"
+    "      <copy/>"
+    "    </string>"
+    "    <uInt32 name=\"Size\">"
+    "      <copy/>"
+    "    </uInt32>"
+    "  </template>"
+    "</templates>";
+
+  // The same templates in a single file.
+  const char combined[] =
+    "<templates>"
+    "  <template name=\"Header\" dictionary=\"A\">"
+    "    <uInt32 name=\"SeqNum\">"
+    "      <increment/>"
+    "    </uInt32>"
+    "  </template>"
+    "  <template name=\"QuoteA\" id=\"1\" dictionary=\"A\">"
+    "    <templateRef name=\"Header\"/>"
+    "    <string name=\"Symbol\">"
+    "      <copy/>"
+    "    </string>"
+    "    <uInt32 name=\"Size\">"
+    "      <copy/>"
+    "    </uInt32>"
+    "  </template>"
+    "  <template name=\"QuoteB\" id=\"2\">"
+    "    <templateRef name=\"Header\"/>"
+    "    <string name=\"Symbol\">"
+    "      <copy/>"
+    "    </string>"
+    "  </template>"
+    "  <template name=\"QuoteC\" id=\"3\">"
+    "    <string name=\"Symbol\">"
+    "      <copy/>"
+    "    </string>"
+    "    <uInt32 name=\"Size\">"
+    "      <copy/>"
+    "    </uInt32>"
+    "  </template>"
+    "</templates>";
+
+  Messages::FieldIdentity identity_SeqNum("SeqNum");
+  Messages::FieldIdentity identity_Symbol("Symbol");
+  Messages::FieldIdentity identity_Size("Size");
+
+  std::string display(const Codecs::TemplateRegistry & registry)
+  {
+    std::stringstream result;
+    registry.display(result);
+    return result.str();
+  }
+
+  void encode(
+    Codecs::Encoder & encoder,
+    std::string & fast,
+    template_id_t templateId,
+    uint32 seqNum,
+    const std::string & symbol,
+    uint32 size)
+  {
+    Messages::Message msg(3);
+    if(templateId != 3)
+    {
+      msg.addField(identity_SeqNum, Messages::FieldUInt32::create(seqNum));
+    }
+    msg.addField(identity_Symbol, Messages::FieldAscii::create(symbol));
+    if(templateId != 2)
+    {
+      msg.addField(identity_Size, Messages::FieldUInt32::create(size));
+    }
+    Codecs::DataDestination destination;
+    encoder.encodeMessage(destination, templateId, msg);
+    std::string encoded;
+    destination.toString(encoded);
+    fast += encoded;
+  }
+
+  Codecs::TemplateRegistryPtr parseVenues(size_t threads)
+  {
+    Codecs::ParallelTemplateParser parser;
+    parser.setThreadCount(threads);
+    parser.addTemplates("venueA", venueA);
+    parser.addTemplates("venueB", venueB);
+    parser.addTemplates("venueC", venueC);
+    Codecs::TemplateRegistryPtr registry = parser.parse();
+    // B refers to A, so it is finalized after the merge.
+    BOOST_CHECK_EQUAL(parser.finalizedInParallel(), 2);
+    return registry;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testParallelTemplateParser)
+{
+  Codecs::XMLTemplateParser xmlParser;
+  std::stringstream combinedStream(combined);
+  Codecs::TemplateRegistryPtr expected = xmlParser.parse(combinedStream);
+  BOOST_REQUIRE(expected);
+
+  // Encoded with the single file
+  std::string fast;
+  {
+    Codecs::Encoder encoder(expected);
+    encode(encoder, fast, 1, 1, "IBM", 100);
+    encode(encoder, fast, 3, 0, "IBM", 200);
+    encode(encoder, fast, 2, 2, "IBM", 0);
+    encode(encoder, fast, 1, 3, "IBM", 100);
+    encode(encoder, fast, 3, 0, "MSFT", 200);
+  }
+
+  size_t threadCounts[] = {1, 2, 4};
+  for(size_t nCount = 0; nCount < sizeof(threadCounts)/sizeof(threadCounts[0]); ++nCount)
+  {
+    Codecs::TemplateRegistryPtr registry = parseVenues(threadCounts[nCount]);
+    BOOST_REQUIRE(registry);
+    BOOST_CHECK_EQUAL(registry->size(), expected->size());
+    BOOST_CHECK_EQUAL(registry->dictionarySize(), expected->dictionarySize());
+    BOOST_CHECK_EQUAL(registry->presenceMapBits(), expected->presenceMapBits());
+    BOOST_CHECK_EQUAL(registry->maxFieldCount(), expected->maxFieldCount());
+    BOOST_CHECK_EQUAL(display(*registry), display(*expected));
+
+    // ...decoded with the merged registry.
+    Codecs::Decoder decoder(registry);
+    Codecs::DataSourceString source(fast);
+    Codecs::SingleMessageConsumer consumer;
+    Codecs::GenericMessageBuilder builder(consumer);
+    Messages::FieldCPtr value;
+
+    decoder.decodeMessage(source, builder);
+    decoder.decodeMessage(source, builder);
+    decoder.decodeMessage(source, builder);
+    BOOST_REQUIRE(consumer.message().getField("SeqNum", value));
+    BOOST_CHECK_EQUAL(value->toUInt32(), 2);
+    BOOST_REQUIRE(consumer.message().getField("Symbol", value));
+    BOOST_CHECK_EQUAL(value->toAscii(), "IBM");
+
+    decoder.decodeMessage(source, builder);
+    BOOST_REQUIRE(consumer.message().getField("SeqNum", value));
+    BOOST_CHECK_EQUAL(value->toUInt32(), 3);
+    BOOST_REQUIRE(consumer.message().getField("Size", value));
+    BOOST_CHECK_EQUAL(value->toUInt32(), 100);
+
+    decoder.decodeMessage(source, builder);
+    BOOST_REQUIRE(consumer.message().getField("Symbol", value));
+    BOOST_CHECK_EQUAL(value->toAscii(), "MSFT");
+    BOOST_REQUIRE(consumer.message().getField("Size", value));
+    BOOST_CHECK_EQUAL(value->toUInt32(), 200);
+    BOOST_CHECK_EQUAL(source.bytesAvailable(), 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testParallelTemplateParserErrors)
+{
+  {
+    // The same template ID in two files
+    Codecs::ParallelTemplateParser parser;
+    parser.setThreadCount(2);
+    parser.addTemplates("venueA", venueA);
+    parser.addTemplates("venueA again", venueA);
+    BOOST_CHECK_THROW(parser.parse(), TemplateDefinitionError);
+  }
+  {
+    // B needs A
+    Codecs::ParallelTemplateParser parser;
+    parser.setThreadCount(2);
+    parser.addTemplates("venueB", venueB);
+    parser.addTemplates("venueC", venueC);
+    BOOST_CHECK_THROW(parser.parse(), TemplateDefinitionError);
+  }
+  {
+    Codecs::ParallelTemplateParser parser;
+    parser.setThreadCount(2);
+    parser.addTemplates("venueC", venueC);
+    parser.addFile("no/such/templates.xml");
+    BOOST_CHECK_THROW(parser.parse(), TemplateDefinitionError);
+  }
+}
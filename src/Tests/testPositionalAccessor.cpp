@@ -0,0 +1,152 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/XMLTemplateParser.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/PositionalAccessor.h>
+
+#include <Messages/Message.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldInt64.h>
+#include <Messages/FieldDecimal.h>
+#include <Messages/FieldAscii.h>
+#include <Messages/FieldGroup.h>
+#include <Messages/FieldSequence.h>
+#include <Messages/Sequence.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  const char positionalTemplates[] =
+    "<templates>"
+    "  <template name=\"Trade\" id=\"7\">"
+    "    <uInt32 name=\"SeqNum\"><increment/></uInt32>"
+    "    <string name=\"Symbol\"><copy/></string>"
+    "    <int64 name=\"Quantity\" presence=\"optional\"/>"
+    "    <decimal name=\"Price\"><delta/></decimal>"
+    "    <group name=\"Venue\" presence=\"optional\">"
+    "      <string name=\"MIC\"><copy/></string>"
+    "    </group>"
+    "    <sequence name=\"Legs\">"
+    "      <length name=\"NoLegs\"/>"
+    "      <uInt32 name=\"LegRatio\"><copy/></uInt32>"
+    "    </sequence>"
+    "  </template>"
+    "</templates>";
+
+  Messages::FieldIdentity identity_SeqNum("SeqNum");
+  Messages::FieldIdentity identity_Symbol("Symbol");
+  Messages::FieldIdentity identity_Quantity("Quantity");
+  Messages::FieldIdentity identity_Price("Price");
+  Messages::FieldIdentity identity_Venue("Venue");
+  Messages::FieldIdentity identity_MIC("MIC");
+  Messages::FieldIdentity identity_Legs("Legs");
+  Messages::FieldIdentity identity_NoLegs("NoLegs");
+  Messages::FieldIdentity identity_LegRatio("LegRatio");
+
+  void buildFieldSet(Messages::Message & msg, uint32 seqNum, bool withQuantity)
+  {
+    msg.addField(identity_SeqNum, Messages::FieldUInt32::create(seqNum));
+    msg.addField(identity_Symbol, Messages::FieldAscii::create("OCI"));
+    if(withQuantity)
+    {
+      msg.addField(identity_Quantity, Messages::FieldInt64::create(-500));
+    }
+    msg.addField(identity_Price, Messages::FieldDecimal::create(Decimal(12345 + seqNum, -2)));
+    Messages::FieldSetPtr venue(new Messages::FieldSet(1));
+    venue->addField(identity_MIC, Messages::FieldAscii::create("XCME"));
+    msg.addField(identity_Venue, Messages::FieldGroup::create(venue));
+    Messages::SequencePtr legs(new Messages::Sequence(identity_NoLegs, 2));
+    for(uint32 nLeg = 0; nLeg < 2; ++nLeg)
+    {
+      Messages::FieldSetPtr leg(new Messages::FieldSet(1));
+      leg->addField(identity_LegRatio, Messages::FieldUInt32::create(nLeg + 1));
+      legs->addEntry(leg);
+    }
+    msg.addField(identity_Legs, Messages::FieldSequence::create(legs));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testPositionalAccessor)
+{
+  Codecs::XMLTemplateParser parser;
+  std::stringstream templateStream(positionalTemplates);
+  Codecs::TemplateRegistryPtr templateRegistry = parser.parse(templateStream);
+  BOOST_REQUIRE(templateRegistry);
+  Codecs::TemplateCPtr trade;
+  BOOST_REQUIRE(templateRegistry->getTemplate(7, trade));
+
+  // encode the reference data using field sets
+  Codecs::Encoder fieldSetEncoder(templateRegistry);
+  Codecs::DataDestination fieldSetDestination;
+  for(uint32 seqNum = 1; seqNum <= 3; ++seqNum)
+  {
+    Messages::Message msg(6);
+    buildFieldSet(msg, seqNum, seqNum != 2);
+    fieldSetEncoder.encodeMessage(fieldSetDestination, 7, msg);
+  }
+  std::string expected;
+  fieldSetDestination.toString(expected);
+
+  // bind the positional accessors once
+  Codecs::PositionalAccessor accessor(trade);
+  BOOST_CHECK_EQUAL(accessor.size(), 6);
+  size_t seqNumIndex = 0;
+  size_t symbolIndex = 0;
+  size_t quantityIndex = 0;
+  size_t priceIndex = 0;
+  size_t venueIndex = 0;
+  size_t legsIndex = 0;
+  BOOST_REQUIRE(accessor.fieldIndex("SeqNum", seqNumIndex));
+  BOOST_REQUIRE(accessor.fieldIndex("Symbol", symbolIndex));
+  BOOST_REQUIRE(accessor.fieldIndex("Quantity", quantityIndex));
+  BOOST_REQUIRE(accessor.fieldIndex("Price", priceIndex));
+  BOOST_REQUIRE(accessor.fieldIndex("Venue", venueIndex));
+  BOOST_REQUIRE(accessor.fieldIndex("Legs", legsIndex));
+  size_t unused = 0;
+  BOOST_CHECK(!accessor.fieldIndex("NoSuchField", unused));
+
+  Codecs::SegmentBodyPtr venueSegment;
+  BOOST_REQUIRE(accessor.getSegmentBody(venueIndex, venueSegment));
+  Codecs::PositionalAccessor venue(venueSegment);
+  venue.setString(0, "XCME");
+
+  Codecs::SegmentBodyPtr legSegment;
+  BOOST_REQUIRE(accessor.getSegmentBody(legsIndex, legSegment));
+  Codecs::PositionalAccessor leg1(legSegment);
+  Codecs::PositionalAccessor leg2(legSegment);
+  leg1.setUnsignedInteger(0, 1);
+  leg2.setUnsignedInteger(0, 2);
+  const Messages::MessageAccessor * legs[] = {&leg1, &leg2};
+
+  Codecs::Encoder positionalEncoder(templateRegistry);
+  Codecs::DataDestination positionalDestination;
+  for(uint32 seqNum = 1; seqNum <= 3; ++seqNum)
+  {
+    accessor.clear();
+    accessor.setUnsignedInteger(seqNumIndex, seqNum);
+    accessor.setString(symbolIndex, "OCI");
+    if(seqNum != 2)
+    {
+      accessor.setSignedInteger(quantityIndex, -500);
+    }
+    accessor.setDecimal(priceIndex, Decimal(12345 + seqNum, -2));
+    accessor.setGroup(venueIndex, venue);
+    accessor.setSequence(legsIndex, legs, 2);
+    positionalEncoder.encodeMessage(positionalDestination, 7, accessor);
+  }
+  std::string actual;
+  positionalDestination.toString(actual);
+
+  BOOST_CHECK_EQUAL(actual.size(), expected.size());
+  BOOST_CHECK(actual == expected);
+}
@@ -346,3 +346,71 @@ BOOST_AUTO_TEST_CASE(testRoundTripOptionalTemplateRefs)
 
   BOOST_CHECK(compareMessages(*delFlatMessage, consumerDel.message()));
 }
+
+BOOST_AUTO_TEST_CASE(testRoundTripStringDeltaAndTail)
+{
+  // Delta and tail edit the dictionary entry in place.  Exercise front and
+  // back deltas, shrinking, and values longer than the entry's internal buffer.
+  const std::string deltaTemplates =
+    "<templates>"
+    "  <template name=\"strings\" id=\"1\">"
+    "    <string name=\"asciiDelta\"><delta/></string>"
+    "    <string name=\"asciiTail\"><tail value=\"ABC\"/></string>"
+    "    <string name=\"optionalDelta\" presence=\"optional\"><delta/></string>"
+    "    <byteVector name=\"blobDelta\"><delta/></byteVector>"
+    "    <byteVector name=\"blobTail\"><tail/></byteVector>"
+    "  </template>"
+    "</templates>";
+  Messages::FieldIdentity asciiDelta("asciiDelta");
+  Messages::FieldIdentity asciiTail("asciiTail");
+  Messages::FieldIdentity optionalDelta("optionalDelta");
+  Messages::FieldIdentity blobDelta("blobDelta");
+  Messages::FieldIdentity blobTail("blobTail");
+
+  Codecs::XMLTemplateParser parser;
+  std::stringstream templateStream(deltaTemplates);
+  Codecs::TemplateRegistryPtr templateRegistry = parser.parse(templateStream);
+
+  const std::string longValue(200, 'L');
+  const char * deltaValues[] = {"IBM", "IBMX", "XIBMX", "MX", "", "ZZZ", 0};
+  const char * tailValues[] = {"ABC", "ABD", "ABDEF", "ABDEG", "ABXYZW", "ABXYZW", 0};
+
+  std::vector<Messages::MessagePtr> messages;
+  for(size_t nMsg = 0; deltaValues[nMsg] != 0; ++nMsg)
+  {
+    Messages::MessagePtr msg(new Messages::Message(templateRegistry->maxFieldCount()));
+    std::string delta(deltaValues[nMsg]);
+    if(nMsg == 3)
+    {
+      delta = longValue + delta;
+    }
+    msg->addField(asciiDelta, Messages::FieldAscii::create(delta));
+    msg->addField(asciiTail, Messages::FieldAscii::create(tailValues[nMsg]));
+    if(nMsg != 2)
+    {
+      msg->addField(optionalDelta, Messages::FieldAscii::create(delta + "opt"));
+    }
+    msg->addField(blobDelta, Messages::FieldByteVector::create(delta));
+    msg->addField(blobTail, Messages::FieldByteVector::create(tailValues[nMsg]));
+    messages.push_back(msg);
+  }
+
+  Codecs::Encoder encoder(templateRegistry);
+  Codecs::DataDestination destination;
+  for(size_t nMsg = 0; nMsg < messages.size(); ++nMsg)
+  {
+    encoder.encodeMessage(destination, 1, *messages[nMsg]);
+  }
+  std::string encoded;
+  destination.toString(encoded);
+
+  Codecs::Decoder decoder(templateRegistry);
+  Codecs::DataSourceString source(encoded);
+  for(size_t nMsg = 0; nMsg < messages.size(); ++nMsg)
+  {
+    Codecs::SingleMessageConsumer consumer;
+    Codecs::GenericMessageBuilder builder(consumer);
+    decoder.decodeMessage(source, builder);
+    BOOST_CHECK(compareMessages(*messages[nMsg], consumer.message()));
+  }
+}
@@ -0,0 +1,220 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/XMLTemplateParser.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Template.h>
+#include <Codecs/FieldInstructionSequence.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/DataSourceString.h>
+#include <Codecs/SingleMessageConsumer.h>
+#include <Codecs/GenericMessageBuilder.h>
+
+#include <Messages/Message.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldInt64.h>
+#include <Messages/FieldDecimal.h>
+#include <Messages/FieldAscii.h>
+#include <Messages/FieldSequence.h>
+#include <Messages/Sequence.h>
+#include <Messages/SequenceColumns.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  const char columnTemplates[] =
+    "<templates>"
+    "  <template name=\"Book\" id=\"1\">"
+    "    <uInt32 name=\"SeqNum\"><increment/></uInt32>"
+    "    <sequence name=\"Levels\">"
+    "      <length name=\"NoLevels\"/>"
+    "      <uInt32 name=\"Level\"><increment/></uInt32>"
+    "      <int64 name=\"Size\"><delta/></int64>"
+    "      <decimal name=\"Price\"><copy/></decimal>"
+    "      <uInt32 name=\"Orders\" presence=\"optional\"><copy/></uInt32>"
+    "    </sequence>"
+    "    <sequence name=\"Notes\">"
+    "      <length name=\"NoNotes\"/>"
+    "      <string name=\"Text\"><copy/></string>"
+    "    </sequence>"
+    "  </template>"
+    "</templates>";
+
+  Messages::FieldIdentity identity_SeqNum("SeqNum");
+  Messages::FieldIdentity identity_Levels("Levels");
+  Messages::FieldIdentity identity_NoLevels("NoLevels");
+  Messages::FieldIdentity identity_Level("Level");
+  Messages::FieldIdentity identity_Size("Size");
+  Messages::FieldIdentity identity_Price("Price");
+  Messages::FieldIdentity identity_Orders("Orders");
+  Messages::FieldIdentity identity_Notes("Notes");
+  Messages::FieldIdentity identity_NoNotes("NoNotes");
+  Messages::FieldIdentity identity_Text("Text");
+
+  const size_t levelCount = 5;
+
+  void encodeBooks(Codecs::TemplateRegistryPtr & templateRegistry, size_t bookCount, std::string & fast)
+  {
+    Codecs::Encoder encoder(templateRegistry);
+    Codecs::DataDestination destination;
+    for(size_t nBook = 0; nBook < bookCount; ++nBook)
+    {
+      Messages::Message msg(3);
+      msg.addField(identity_SeqNum, Messages::FieldUInt32::create(uint32(nBook + 1)));
+      Messages::SequencePtr levels(new Messages::Sequence(identity_NoLevels, levelCount));
+      for(size_t nLevel = 0; nLevel < levelCount; ++nLevel)
+      {
+        Messages::FieldSetPtr level(new Messages::FieldSet(4));
+        level->addField(identity_Level, Messages::FieldUInt32::create(uint32(nLevel + 1)));
+        level->addField(identity_Size, Messages::FieldInt64::create(int64(nBook * 100) - int64(nLevel * 7)));
+        level->addField(identity_Price, Messages::FieldDecimal::create(Decimal(mantissa_t(10000 - nLevel * 25), -2)));
+        if(nLevel % 2 == 0)
+        {
+          level->addField(identity_Orders, Messages::FieldUInt32::create(uint32(nLevel + nBook)));
+        }
+        levels->addEntry(level);
+      }
+      msg.addField(identity_Levels, Messages::FieldSequence::create(levels));
+      Messages::SequencePtr notes(new Messages::Sequence(identity_NoNotes, 1));
+      Messages::FieldSetPtr note(new Messages::FieldSet(1));
+      note->addField(identity_Text, Messages::FieldAscii::create("note"));
+      notes->addEntry(note);
+      msg.addField(identity_Notes, Messages::FieldSequence::create(notes));
+      encoder.encodeMessage(destination, 1, msg);
+    }
+    destination.toString(fast);
+  }
+
+  /// Accept columns, check them, then replay them so the message matches a normal decode.
+  class ColumnBuilder : public Codecs::GenericMessageBuilder
+  {
+  public:
+    explicit ColumnBuilder(Codecs::MessageConsumer & consumer)
+      : Codecs::GenericMessageBuilder(consumer)
+      , columnCount_(0)
+    {
+    }
+
+    virtual bool wantSequenceColumns()const
+    {
+      return true;
+    }
+
+    virtual void addSequenceColumns(
+      const Messages::FieldIdentity & identity,
+      const Messages::SequenceColumns & columns)
+    {
+      ++columnCount_;
+      BOOST_CHECK_EQUAL(identity.name(), "Levels");
+      BOOST_CHECK_EQUAL(columns.lengthIdentity().name(), "NoLevels");
+      BOOST_CHECK_EQUAL(columns.length(), levelCount);
+      BOOST_CHECK_EQUAL(columns.columnCount(), 4);
+      size_t level = 0;
+      size_t price = 0;
+      size_t orders = 0;
+      BOOST_REQUIRE(columns.columnIndex("Level", level));
+      BOOST_REQUIRE(columns.columnIndex("Price", price));
+      BOOST_REQUIRE(columns.columnIndex("Orders", orders));
+      BOOST_CHECK(!columns.columnIndex("Text", orders));
+      BOOST_CHECK_EQUAL(columns.type(price), ValueType::DECIMAL);
+      const int64 * levels = columns.values(level);
+      const uchar * present = columns.presence(orders);
+      for(size_t row = 0; row < columns.length(); ++row)
+      {
+        BOOST_CHECK_EQUAL(levels[row], int64(row + 1));
+        BOOST_CHECK_EQUAL(columns.getDecimal(price, row), Decimal(mantissa_t(10000 - row * 25), -2));
+        BOOST_CHECK_EQUAL(present[row] != 0, row % 2 == 0);
+      }
+      columns.replay(*this, identity);
+    }
+
+    size_t columnCount_;
+  };
+
+  void compareMessages(const Messages::Message & expected, const Messages::Message & actual)
+  {
+    BOOST_REQUIRE_EQUAL(actual.size(), expected.size());
+    Messages::FieldCPtr expectedField;
+    Messages::FieldCPtr actualField;
+    BOOST_REQUIRE(expected.getField("Levels", expectedField));
+    BOOST_REQUIRE(actual.getField("Levels", actualField));
+    const Messages::SequenceCPtr & expectedLevels = expectedField->toSequence();
+    const Messages::SequenceCPtr & actualLevels = actualField->toSequence();
+    BOOST_REQUIRE_EQUAL(actualLevels->size(), expectedLevels->size());
+    for(size_t nLevel = 0; nLevel < expectedLevels->size(); ++nLevel)
+    {
+      const Messages::FieldSetCPtr & expectedEntry = (*expectedLevels)[nLevel];
+      const Messages::FieldSetCPtr & actualEntry = (*actualLevels)[nLevel];
+      BOOST_REQUIRE_EQUAL(actualEntry->size(), expectedEntry->size());
+      for(Messages::FieldSet::const_iterator it = expectedEntry->begin(); it != expectedEntry->end(); ++it)
+      {
+        BOOST_REQUIRE(actualEntry->getField(it->name(), actualField));
+        const Messages::FieldCPtr & expectedValue = it->getField();
+        BOOST_REQUIRE_EQUAL(actualField->getType(), expectedValue->getType());
+        if(expectedValue->getType() == ValueType::DECIMAL)
+        {
+          BOOST_CHECK_EQUAL(actualField->toDecimal(), expectedValue->toDecimal());
+        }
+        else
+        {
+          BOOST_CHECK_EQUAL(actualField->displayString(), expectedValue->displayString());
+        }
+      }
+    }
+    BOOST_CHECK(actual.getField("Notes", actualField));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testSequenceColumns)
+{
+  Codecs::XMLTemplateParser parser;
+  std::stringstream templateStream(columnTemplates);
+  Codecs::TemplateRegistryPtr templateRegistry = parser.parse(templateStream);
+  BOOST_REQUIRE(templateRegistry);
+
+  Codecs::TemplateCPtr book;
+  BOOST_REQUIRE(templateRegistry->getTemplate(1, book));
+  Codecs::FieldInstructionCPtr instruction;
+  BOOST_REQUIRE(book->getInstruction(1, instruction));
+  const Codecs::FieldInstructionSequence * levels =
+    dynamic_cast<const Codecs::FieldInstructionSequence *>(instruction.get());
+  BOOST_REQUIRE(levels != 0);
+  BOOST_CHECK(levels->isColumnar());
+  BOOST_REQUIRE(book->getInstruction(2, instruction));
+  const Codecs::FieldInstructionSequence * notes =
+    dynamic_cast<const Codecs::FieldInstructionSequence *>(instruction.get());
+  BOOST_REQUIRE(notes != 0);
+  BOOST_CHECK(!notes->isColumnar());
+
+  const size_t bookCount = 3;
+  std::string fast;
+  encodeBooks(templateRegistry, bookCount, fast);
+
+  Codecs::Decoder rowDecoder(templateRegistry);
+  Codecs::DataSourceString rowSource(fast);
+  Codecs::SingleMessageConsumer rowConsumer;
+  Codecs::GenericMessageBuilder rowBuilder(rowConsumer);
+
+  Codecs::Decoder columnDecoder(templateRegistry);
+  Codecs::DataSourceString columnSource(fast);
+  Codecs::SingleMessageConsumer columnConsumer;
+  ColumnBuilder columnBuilder(columnConsumer);
+
+  for(size_t nBook = 0; nBook < bookCount; ++nBook)
+  {
+    rowDecoder.decodeMessage(rowSource, rowBuilder);
+    columnDecoder.decodeMessage(columnSource, columnBuilder);
+    compareMessages(rowConsumer.message(), columnConsumer.message());
+  }
+  BOOST_CHECK_EQUAL(columnBuilder.columnCount_, bookCount);
+  BOOST_CHECK_EQUAL(columnSource.bytesAvailable(), 0);
+}
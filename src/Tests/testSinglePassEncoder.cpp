@@ -0,0 +1,157 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/XMLTemplateParser.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/DataDestination.h>
+
+#include <Messages/Message.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldAscii.h>
+#include <Messages/FieldGroup.h>
+#include <Messages/FieldSequence.h>
+#include <Messages/Sequence.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  const char singlePassTemplates[] =
+    "<templates>"
+    "  <template name=\"Wide\" id=\"1\">"
+    "    <uInt32 name=\"F1\"><copy/></uInt32>"
+    "    <uInt32 name=\"F2\"><copy/></uInt32>"
+    "    <uInt32 name=\"F3\"><copy/></uInt32>"
+    "    <uInt32 name=\"F4\"><copy/></uInt32>"
+    "    <uInt32 name=\"F5\"><copy/></uInt32>"
+    "    <uInt32 name=\"F6\"><copy/></uInt32>"
+    "    <uInt32 name=\"F7\"><copy/></uInt32>"
+    "    <uInt32 name=\"F8\"><copy/></uInt32>"
+    "    <uInt32 name=\"F9\"><copy/></uInt32>"
+    "    <group name=\"Instrument\" presence=\"optional\">"
+    "      <string name=\"Symbol\"><copy/></string>"
+    "      <uInt32 name=\"Exchange\" presence=\"optional\"><default value=\"1\"/></uInt32>"
+    "    </group>"
+    "    <sequence name=\"Entries\">"
+    "      <length name=\"NoEntries\"/>"
+    "      <uInt32 name=\"EntryType\"><copy/></uInt32>"
+    "      <uInt32 name=\"EntrySize\"><increment/></uInt32>"
+    "    </sequence>"
+    "  </template>"
+    "  <template name=\"Narrow\" id=\"2\">"
+    "    <uInt32 name=\"SeqNum\"/>"
+    "  </template>"
+    "</templates>";
+
+  Messages::FieldIdentity identity_Instrument("Instrument");
+  Messages::FieldIdentity identity_Symbol("Symbol");
+  Messages::FieldIdentity identity_Exchange("Exchange");
+  Messages::FieldIdentity identity_Entries("Entries");
+  Messages::FieldIdentity identity_NoEntries("NoEntries");
+  Messages::FieldIdentity identity_EntryType("EntryType");
+  Messages::FieldIdentity identity_EntrySize("EntrySize");
+  Messages::FieldIdentity identity_SeqNum("SeqNum");
+  Messages::FieldIdentity identity_F[] = {
+    Messages::FieldIdentity("F1"), Messages::FieldIdentity("F2"), Messages::FieldIdentity("F3"),
+    Messages::FieldIdentity("F4"), Messages::FieldIdentity("F5"), Messages::FieldIdentity("F6"),
+    Messages::FieldIdentity("F7"), Messages::FieldIdentity("F8"), Messages::FieldIdentity("F9")};
+
+  void buildWide(Messages::Message & msg, uint32 base)
+  {
+    for(uint32 nField = 1; nField <= 9; ++nField)
+    {
+      // vary only some fields so the copy operator leaves gaps in the presence map
+      msg.addField(identity_F[nField - 1], Messages::FieldUInt32::create(nField % 3 == 0 ? base : nField));
+    }
+    if(base % 2 == 0)
+    {
+      Messages::FieldSetPtr instrument(new Messages::FieldSet(2));
+      instrument->addField(identity_Symbol, Messages::FieldAscii::create("QF"));
+      instrument->addField(identity_Exchange, Messages::FieldUInt32::create(base));
+      msg.addField(identity_Instrument, Messages::FieldGroup::create(instrument));
+    }
+    Messages::SequencePtr entries(new Messages::Sequence(identity_NoEntries, 3));
+    for(uint32 nEntry = 0; nEntry < 3; ++nEntry)
+    {
+      Messages::FieldSetPtr entry(new Messages::FieldSet(2));
+      entry->addField(identity_EntryType, Messages::FieldUInt32::create(nEntry / 2));
+      entry->addField(identity_EntrySize, Messages::FieldUInt32::create(base + nEntry));
+      entries->addEntry(entry);
+    }
+    msg.addField(identity_Entries, Messages::FieldSequence::create(entries));
+  }
+
+  void encodeAll(Codecs::Encoder & encoder, Codecs::DataDestination & destination)
+  {
+    for(uint32 nMessage = 0; nMessage < 6; ++nMessage)
+    {
+      if(nMessage % 3 == 2)
+      {
+        Messages::Message msg(1);
+        msg.addField(identity_SeqNum, Messages::FieldUInt32::create(nMessage));
+        encoder.encodeMessage(destination, 2, msg);
+      }
+      else
+      {
+        Messages::Message msg(12);
+        buildWide(msg, 100 + nMessage);
+        encoder.encodeMessage(destination, 1, msg);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testSinglePassEncoder)
+{
+  Codecs::XMLTemplateParser parser;
+  std::stringstream templateStream(singlePassTemplates);
+  Codecs::TemplateRegistryPtr templateRegistry = parser.parse(templateStream);
+  BOOST_REQUIRE(templateRegistry);
+
+  Codecs::Encoder spliceEncoder(templateRegistry);
+  BOOST_CHECK(!spliceEncoder.getSinglePass());
+  Codecs::DataDestination spliceDestination;
+  encodeAll(spliceEncoder, spliceDestination);
+  std::string spliced;
+  spliceDestination.toString(spliced);
+
+  Codecs::Encoder singleEncoder(templateRegistry);
+  singleEncoder.setSinglePass(true);
+  Codecs::DataDestination singleDestination;
+  encodeAll(singleEncoder, singleDestination);
+  // everything was written into one buffer
+  BOOST_CHECK_EQUAL(singleDestination.size(), 1);
+  std::string single;
+  singleDestination.toString(single);
+
+  BOOST_CHECK_EQUAL(single.size(), spliced.size());
+  BOOST_CHECK(single == spliced);
+}
+
+BOOST_AUTO_TEST_CASE(testWorkingBufferReplace)
+{
+  WorkingBuffer buffer;
+  buffer.clear(false, 4);
+  const uchar initial[] = {'a', '-', '-', '-', 'b', 'c'};
+  for(size_t pos = 0; pos < sizeof(initial); ++pos)
+  {
+    buffer.push(initial[pos]);
+  }
+  const uchar fill[] = {'x', 'y', 'z', 'w'};
+  // close a gap
+  buffer.replace(1, 3, fill, 1);
+  std::string result;
+  buffer.toString(result);
+  BOOST_CHECK_EQUAL(result, "axbc");
+  // open a gap
+  buffer.replace(1, 1, fill, 4);
+  buffer.toString(result);
+  BOOST_CHECK_EQUAL(result, "axyzwbc");
+}
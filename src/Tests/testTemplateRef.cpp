@@ -154,3 +154,56 @@ BOOST_AUTO_TEST_CASE(testStaticTemplateRefB)
   BOOST_REQUIRE(msgOut.getField("field3", value));
   BOOST_CHECK_EQUAL(value->toUInt32(), 3);
 }
+
+namespace
+{
+  // The reference precedes the definition of the template it references.
+  const char forwardRefXML[] =
+    "<templates xmlns=\"http://www.fixprotocol.org/ns/fast/td/1.1\">\n"
+    "  <template name=\"TEMPLATE_20\" id=\"20\">\n"
+    "    <templateRef name=\"LATER\"/>\n"
+    "  </template>\n"
+    "  <template name=\"LATER\">\n"
+    "    <uInt32 name=\"field1\"><increment value =\"1\"/></uInt32>\n"
+    "    <uInt32 name=\"field2\"><increment value =\"2\"/></uInt32>\n"
+    "  </template>\n"
+    "</templates>\n"
+    ;
+
+  const char template20Messages[] =
+    "\xF0\x94\x8b\x8c"
+    "\xC0\x94";
+}
+
+BOOST_AUTO_TEST_CASE(testStaticTemplateRefForward)
+{
+  Codecs::XMLTemplateParser parser;
+  std::stringstream templateSource(forwardRefXML);
+  Codecs::TemplateRegistryPtr templateRegistry =
+    parser.parse(templateSource);
+  BOOST_REQUIRE(templateRegistry);
+
+  Codecs::TemplateCPtr template20;
+  BOOST_REQUIRE(templateRegistry->getTemplate(20, template20));
+  BOOST_CHECK(template20->isFinalized());
+  BOOST_CHECK_EQUAL(template20->fieldCount(), 2);
+
+  std::string testString(template20Messages, sizeof(template20Messages) - 1);
+  std::istringstream sourceStream(testString, std::ios::binary);
+  Codecs::DataSourceStream source(sourceStream);
+
+  Codecs::Decoder decoder(templateRegistry);
+  Codecs::SingleMessageConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+
+  Messages::FieldCPtr value;
+  decoder.decodeMessage(source, builder);
+  BOOST_REQUIRE(consumer.message().getField("field2", value));
+  BOOST_CHECK_EQUAL(value->toUInt32(), 12);
+
+  decoder.decodeMessage(source, builder);
+  BOOST_REQUIRE(consumer.message().getField("field1", value));
+  BOOST_CHECK_EQUAL(value->toUInt32(), 12);
+  BOOST_REQUIRE(consumer.message().getField("field2", value));
+  BOOST_CHECK_EQUAL(value->toUInt32(), 13);
+}
@@ -0,0 +1,201 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/XMLTemplateParser.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/TemplateRegistryPublisher.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/DataSourceString.h>
+#include <Codecs/SingleMessageConsumer.h>
+#include <Codecs/GenericMessageBuilder.h>
+
+#include <Messages/Message.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldAscii.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  const char originalTemplates[] =
+    "<templates>"
+    "  <template name=\"Quote\" id=\"1\">"
+    "    <string name=\"Symbol\">"
+    "      <copy/>"
+    "    </string>"
+    "    <uInt32 name=\"Size\">"
+    "      <increment/>"
+    "    </uInt32>"
+    "  </template>"
+    "</templates>";
+
+  // Adds a field to the quote and a new template.
+  const char revisedTemplates[] =
+    "<templates>"
+    "  <template name=\"Quote\" id=\"1\">"
+    "    <string name=\"Symbol\">"
+    "      <copy/>"
+    "    </string>"
+    "    <uInt32 name=\"Size\">"
+    "      <increment/>"
+    "    </uInt32>"
+    "    <uInt32 name=\"Price\">"
+    "      <copy/>"
+    "    </uInt32>"
+    "  </template>"
+    "  <template name=\"Heartbeat\" id=\"2\">"
+    "    <uInt32 name=\"SeqNum\"/>"
+    "  </template>"
+    "</templates>";
+
+  Messages::FieldIdentity identity_Symbol("Symbol");
+  Messages::FieldIdentity identity_Size("Size");
+  Messages::FieldIdentity identity_Price("Price");
+
+  Codecs::TemplateRegistryPtr parseTemplates(const char * xml)
+  {
+    Codecs::XMLTemplateParser parser;
+    std::stringstream templateStream(xml);
+    return parser.parse(templateStream);
+  }
+
+  void encodeQuote(
+    Codecs::Encoder & encoder,
+    std::string & fast,
+    const std::string & symbol,
+    uint32 size,
+    uint32 price = 0)
+  {
+    Messages::Message msg(3);
+    msg.addField(identity_Symbol, Messages::FieldAscii::create(symbol));
+    msg.addField(identity_Size, Messages::FieldUInt32::create(size));
+    if(price != 0)
+    {
+      msg.addField(identity_Price, Messages::FieldUInt32::create(price));
+    }
+    Codecs::DataDestination destination;
+    encoder.encodeMessage(destination, 1, msg);
+    std::string encoded;
+    destination.toString(encoded);
+    fast += encoded;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testTemplateReloadAtMessage)
+{
+  Codecs::TemplateRegistryPtr original = parseTemplates(originalTemplates);
+  BOOST_REQUIRE(original);
+  boost::weak_ptr<Codecs::TemplateRegistry> watchOriginal(original);
+
+  std::string fast;
+  {
+    Codecs::Encoder encoder(original);
+    encodeQuote(encoder, fast, "IBM", 100);
+    encodeQuote(encoder, fast, "IBM", 101);
+  }
+  // The sender starts over with the new templates.
+  Codecs::TemplateRegistryPtr revised = parseTemplates(revisedTemplates);
+  BOOST_REQUIRE(revised);
+  {
+    Codecs::Encoder encoder(revised);
+    encodeQuote(encoder, fast, "MSFT", 200, 25);
+    encodeQuote(encoder, fast, "MSFT", 201, 25);
+  }
+
+  Codecs::TemplateRegistryPublisherPtr publisher(new Codecs::TemplateRegistryPublisher(original));
+  original.reset();
+  long generation = publisher->generation();
+
+  Codecs::Decoder decoder(publisher->current());
+  decoder.followRegistry(publisher);
+  Codecs::DataSourceString source(fast);
+  Codecs::SingleMessageConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+
+  Messages::FieldCPtr value;
+  decoder.decodeMessage(source, builder);
+  decoder.decodeMessage(source, builder);
+  BOOST_REQUIRE(consumer.message().getField("Symbol", value));
+  BOOST_CHECK_EQUAL(value->toAscii(), "IBM");
+  BOOST_REQUIRE(consumer.message().getField("Size", value));
+  BOOST_CHECK_EQUAL(value->toUInt32(), 101);
+  BOOST_CHECK(!consumer.message().getField("Price", value));
+
+  publisher->publish(revised);
+  BOOST_CHECK(publisher->generation() != generation);
+  // The decoder still holds the original.
+  BOOST_CHECK(!watchOriginal.expired());
+  BOOST_CHECK_EQUAL(publisher->liveRegistries(), 2);
+
+  decoder.decodeMessage(source, builder);
+  BOOST_CHECK(decoder.getTemplateRegistry() == revised);
+  BOOST_REQUIRE(consumer.message().getField("Symbol", value));
+  BOOST_CHECK_EQUAL(value->toAscii(), "MSFT");
+  BOOST_REQUIRE(consumer.message().getField("Price", value));
+  BOOST_CHECK_EQUAL(value->toUInt32(), 25);
+
+  // Copied fields come from the new dictionaries.
+  decoder.decodeMessage(source, builder);
+  BOOST_REQUIRE(consumer.message().getField("Symbol", value));
+  BOOST_CHECK_EQUAL(value->toAscii(), "MSFT");
+  BOOST_REQUIRE(consumer.message().getField("Size", value));
+  BOOST_CHECK_EQUAL(value->toUInt32(), 201);
+  BOOST_CHECK_EQUAL(source.bytesAvailable(), 0);
+
+  // Nothing uses the original any more.
+  BOOST_CHECK(watchOriginal.expired());
+  BOOST_CHECK_EQUAL(publisher->liveRegistries(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(testTemplateReloadOnReset)
+{
+  Codecs::TemplateRegistryPtr original = parseTemplates(originalTemplates);
+  Codecs::TemplateRegistryPtr revised = parseTemplates(revisedTemplates);
+  BOOST_REQUIRE(original);
+  BOOST_REQUIRE(revised);
+
+  std::string before;
+  {
+    Codecs::Encoder encoder(original);
+    encodeQuote(encoder, before, "IBM", 100);
+    encodeQuote(encoder, before, "IBM", 101);
+  }
+  std::string after;
+  {
+    Codecs::Encoder encoder(revised);
+    encodeQuote(encoder, after, "MSFT", 200, 25);
+  }
+
+  Codecs::TemplateRegistryPublisherPtr publisher(new Codecs::TemplateRegistryPublisher(original));
+  Codecs::Decoder decoder(original);
+  decoder.followRegistry(publisher, Codecs::Decoder::SWAP_ON_RESET);
+  Codecs::SingleMessageConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+  Messages::FieldCPtr value;
+
+  Codecs::DataSourceString source(before);
+  decoder.decodeMessage(source, builder);
+  // Published in the middle of the stream: not used until the decoder is reset.
+  publisher->publish(revised);
+  decoder.decodeMessage(source, builder);
+  BOOST_CHECK(decoder.getTemplateRegistry() == original);
+  BOOST_REQUIRE(consumer.message().getField("Size", value));
+  BOOST_CHECK_EQUAL(value->toUInt32(), 101);
+
+  decoder.resetDecoder();
+  BOOST_CHECK(decoder.getTemplateRegistry() == revised);
+  Codecs::DataSourceString source2(after);
+  decoder.decodeMessage(source2, builder);
+  BOOST_REQUIRE(consumer.message().getField("Price", value));
+  BOOST_CHECK_EQUAL(value->toUInt32(), 25);
+  BOOST_REQUIRE(consumer.message().getField("Symbol", value));
+  BOOST_CHECK_EQUAL(value->toAscii(), "MSFT");
+}